@@ -0,0 +1,30 @@
+#include <immintrin.h>
+
+#ifndef __x86_64__
+#error "Runtime SIMD dispatch is only implemented for x86-64"
+#endif
+
+__attribute__((target("avx2")))
+static void test_avx2( char * data ) {
+  __m256i v = _mm256_loadu_si256( (const __m256i *) data );
+  _mm256_storeu_si256( (__m256i *) data , _mm256_shuffle_epi8( v , v ));
+}
+
+
+__attribute__((target("ssse3")))
+static void test_ssse3( char * data ) {
+  __m128i v = _mm_loadu_si128( (const __m128i *) data );
+  _mm_storeu_si128( (__m128i *) data , _mm_shuffle_epi8( v , v ));
+}
+
+
+int main(int argc, char ** argv) {
+  char data[32] = {0};
+  if (__builtin_cpu_supports("avx2"))
+    test_avx2( data );
+
+  if (__builtin_cpu_supports("ssse3"))
+    test_ssse3( data );
+
+  return data[0];
+}
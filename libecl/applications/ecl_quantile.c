@@ -16,21 +16,17 @@
    for more details.
 */
 
-#define  _GNU_SOURCE   /* Must define this to get access to pthread_rwlock_t */
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
 #include <unistd.h>
-#include <pthread.h>
 #include <glob.h>
 
 #include <ert/util/util.h>
-#include <ert/util/double_vector.h>
 #include <ert/util/time_t_vector.h>
-#include <ert/util/statistics.h>
 #include <ert/util/vector.h>
-#include <ert/util/arg_pack.h>
-#include <ert/util/thread_pool.h>
+#include <ert/util/stringlist.h>
+#include <ert/util/hash.h>
 
 #include <ert/config/config_parser.h>
 #include <ert/config/config_content.h>
@@ -39,11 +35,12 @@
 #include <ert/config/config_content_node.h>
 
 #include <ert/ecl/ecl_sum.h>
+#include <ert/ecl/ecl_sum_ensemble.h>
 
 #define DEFAULT_NUM_INTERP  50
+#define DEFAULT_NUM_THREADS  4
 #define SUMMARY_JOIN       ":"
 #define MIN_SIZE            10
-#define LOAD_THREADS         4
 
 
 typedef enum {
@@ -53,15 +50,6 @@ typedef enum {
 } format_type;
 
 
-typedef struct {
-  ecl_sum_type             * ecl_sum;
-  double_vector_type       * interp_data;
-  const time_t_vector_type * interp_time;
-  time_t                     start_time;
-  time_t                     end_time;
-} sum_case_type;
-
-
 /**
    Microscopic data structure representing one column of data;
    i.e. one ECLIPSE summary key and one accompanying quantile value.
@@ -82,14 +70,20 @@ typedef struct  {
 
 
 
+/*
+  The heavy lifting - i.e. loading, resampling and calculating the
+  quantiles - is done by the ecl_sum_ensemble implementation in
+  libecl; the ensemble_type is a thin wrapper holding the settings
+  from the config file.
+*/
+
 typedef struct {
-  vector_type         * data;
-  time_t_vector_type  * interp_time;
-  int                   num_interp;
-  time_t                start_time;
-  time_t                end_time;
-  const ecl_sum_type  * refcase;     /* Pointer to an arbitrary ecl_sum instance in the ensemble - to have access to indexing functions. */
-  pthread_rwlock_t      rwlock;
+  ecl_sum_ensemble_type      * sum_ensemble;
+  const time_t_vector_type   * interp_time;
+  int                          num_interp;
+  int                          num_threads;
+  time_t                       start_time;
+  const ecl_sum_type         * refcase;     /* Pointer to an arbitrary ecl_sum instance in the ensemble - to have access to indexing functions. */
 } ensemble_type;
 
 
@@ -121,84 +115,14 @@ static void quant_key_free__( void * qkey ) {
 
 /*****************************************************************/
 
-sum_case_type * sum_case_fread_alloc( const char * data_file , const time_t_vector_type * interp_time ) {
-  sum_case_type * sum_case = util_malloc( sizeof * sum_case );
-
-  sum_case->ecl_sum     = ecl_sum_fread_alloc_case( data_file , SUMMARY_JOIN );
-  sum_case->interp_data = double_vector_alloc(0 , 0);
-  sum_case->interp_time = interp_time;
-  sum_case->start_time  = ecl_sum_get_start_time( sum_case->ecl_sum );
-  sum_case->end_time    = ecl_sum_get_end_time( sum_case->ecl_sum );
-  return sum_case;
-}
-
-
-void sum_case_free( sum_case_type * sum_case) {
-  ecl_sum_free( sum_case->ecl_sum );
-  double_vector_free( sum_case->interp_data );
-  free( sum_case );
-}
-
-
-void sum_case_free__( void * sum_case) {
-  sum_case_free( (sum_case_type *) sum_case);
-}
-
-
-/*****************************************************************/
-
-
-void ensemble_add_case( ensemble_type * ensemble , const char * data_file ) {
-  sum_case_type * sum_case = sum_case_fread_alloc( data_file , ensemble->interp_time );
-
-  pthread_rwlock_wrlock( &ensemble->rwlock );
-  {
-    printf("Loading case: %s \n", data_file );
-    vector_append_owned_ref( ensemble->data , sum_case , sum_case_free__ );
-    if (ensemble->start_time > 0)
-      ensemble->start_time = util_time_t_min( ensemble->start_time , sum_case->start_time);
-    else
-      ensemble->start_time = ecl_sum_get_start_time( sum_case->ecl_sum );
-
-    ensemble->end_time   = util_time_t_max( ensemble->end_time   , sum_case->end_time);
-  }
-  pthread_rwlock_unlock( &ensemble->rwlock );
-
-}
-
-void * ensemble_add_case__( void * arg ) {
-  arg_pack_type * arg_pack = arg_pack_safe_cast( arg );
-  ensemble_type * ensemble = arg_pack_iget_ptr( arg , 0 );
-  const char * data_file   = arg_pack_iget_ptr( arg , 1 );
-  ensemble_add_case( ensemble , data_file );
-  arg_pack_free( arg_pack );
-  return NULL;
-}
-
-
-
-
-void ensemble_init_time_interp( ensemble_type * ensemble ) {
-  int i;
-  for (i = 0; i < ensemble->num_interp; i++)
-    time_t_vector_append( ensemble->interp_time , ensemble->start_time + i * (ensemble->end_time - ensemble->start_time) / (ensemble->num_interp - 1));
-}
-
-
 
-
-
-void ensemble_load_from_glob( ensemble_type * ensemble , const char * pattern , thread_pool_type * tp) {
+void ensemble_glob_cases( stringlist_type * case_list , const char * pattern ) {
   glob_t pglob;
   int    i;
   glob( pattern , GLOB_NOSORT , NULL , &pglob );
 
-  for (i=0; i < pglob.gl_pathc; i++) {
-    arg_pack_type * arg_pack = arg_pack_alloc( );
-    arg_pack_append_ptr( arg_pack , ensemble );
-    arg_pack_append_owned_ptr( arg_pack , util_alloc_string_copy( pglob.gl_pathv[i] ) , free );
-    thread_pool_add_job( tp , ensemble_add_case__ , arg_pack );
-  }
+  for (i=0; i < pglob.gl_pathc; i++)
+    stringlist_append_copy( case_list , pglob.gl_pathv[i] );
 
   globfree( &pglob );
 }
@@ -208,12 +132,12 @@ void ensemble_load_from_glob( ensemble_type * ensemble , const char * pattern ,
 ensemble_type * ensemble_alloc( ) {
   ensemble_type * ensemble = util_malloc( sizeof * ensemble );
 
-  ensemble->num_interp  = DEFAULT_NUM_INTERP;
-  ensemble->start_time  = -1;
-  ensemble->end_time    = -1;
-  ensemble->data        = vector_alloc_new();
-  ensemble->interp_time = time_t_vector_alloc( 0 , -1 );
-  pthread_rwlock_init( &ensemble->rwlock , NULL );
+  ensemble->num_interp   = DEFAULT_NUM_INTERP;
+  ensemble->num_threads  = DEFAULT_NUM_THREADS;
+  ensemble->start_time   = -1;
+  ensemble->sum_ensemble = NULL;
+  ensemble->interp_time  = NULL;
+  ensemble->refcase      = NULL;
   return ensemble;
 }
 
@@ -221,41 +145,44 @@ ensemble_type * ensemble_alloc( ) {
 void ensemble_init( ensemble_type * ensemble , config_content_type * config) {
 
   /*1 : Loading ensembles and settings from the config instance */
+  if (config_content_has_item( config , "NUM_THREADS" ))
+    ensemble->num_threads = config_content_iget_as_int( config , "NUM_THREADS" , 0 , 0 );
+  ensemble->sum_ensemble = ecl_sum_ensemble_alloc( ensemble->num_threads );
+
   /*1a: Loading the eclipse summary cases. */
   {
-    thread_pool_type * tp = thread_pool_alloc( LOAD_THREADS , true );
-    {
-      int i,j;
-      if (config_content_has_item( config , "CASE_LIST")) {
-        const config_content_item_type * case_item = config_content_get_item( config , "CASE_LIST" );
-        for (j=0; j < config_content_item_get_size( case_item ); j++) {
-          const config_content_node_type * case_node = config_content_item_iget_node( case_item , j );
-          for (i=0; i < config_content_node_get_size( case_node ); i++) {
-            const char * case_glob = config_content_node_iget( case_node , i );
-            ensemble_load_from_glob( ensemble , case_glob , tp);
-          }
+    stringlist_type * case_list = stringlist_alloc_new();
+    int i,j;
+    if (config_content_has_item( config , "CASE_LIST")) {
+      const config_content_item_type * case_item = config_content_get_item( config , "CASE_LIST" );
+      for (j=0; j < config_content_item_get_size( case_item ); j++) {
+        const config_content_node_type * case_node = config_content_item_iget_node( case_item , j );
+        for (i=0; i < config_content_node_get_size( case_node ); i++) {
+          const char * case_glob = config_content_node_iget( case_node , i );
+          ensemble_glob_cases( case_list , case_glob );
         }
       }
-
     }
-    thread_pool_join( tp );
-    thread_pool_free( tp );
-  }
 
-  {
-    const sum_case_type * tmp = vector_iget_const( ensemble->data , 0 );
-    ensemble->refcase = tmp->ecl_sum;
+    printf("Loading %d cases with %d threads \n", stringlist_get_size( case_list ) , ensemble->num_threads );
+    ecl_sum_ensemble_load_cases( ensemble->sum_ensemble , case_list , SUMMARY_JOIN );
+    stringlist_free( case_list );
   }
 
+  if (ecl_sum_ensemble_get_size( ensemble->sum_ensemble ) < MIN_SIZE )
+    util_exit("Sorry - quantiles make no sense with with < %d realizations; should have ~> 100.\n" , MIN_SIZE);
+
+  ensemble->refcase    = ecl_sum_ensemble_iget_case( ensemble->sum_ensemble , 0 );
+  ensemble->start_time = ecl_sum_ensemble_get_start_time( ensemble->sum_ensemble );
+
   /*1b: Other config settings */
   if (config_content_has_item( config , "NUM_INTERP" ))
     ensemble->num_interp  = config_content_iget_as_int( config , "NUM_INTERP" , 0 , 0 );
 
 
   /*2: Remaining initialization */
-  ensemble_init_time_interp( ensemble );
-  if (vector_get_size( ensemble->data ) < MIN_SIZE )
-    util_exit("Sorry - quantiles make no sense with with < %d realizations; should have ~> 100.\n" , MIN_SIZE);
+  ecl_sum_ensemble_init_time_interp( ensemble->sum_ensemble , ensemble->num_interp );
+  ensemble->interp_time = ecl_sum_ensemble_get_time_interp( ensemble->sum_ensemble );
 }
 
 const ecl_sum_type * ensemble_get_refcase( const ensemble_type * ensemble ) {
@@ -264,8 +191,8 @@ const ecl_sum_type * ensemble_get_refcase( const ensemble_type * ensemble ) {
 
 
 void ensemble_free( ensemble_type * ensemble ) {
-  vector_free( ensemble->data );
-  time_t_vector_free( ensemble->interp_time );
+  if (ensemble->sum_ensemble)
+    ecl_sum_ensemble_free( ensemble->sum_ensemble );
   free( ensemble );
 }
 
@@ -606,7 +533,13 @@ void output_save( const output_type * output , ensemble_type * ensemble , const
 
 
 
-void output_run_line( const output_type * output , ensemble_type * ensemble) {
+/*
+   The quantiles of all the OUTPUT lines are registered with the
+   ensemble, so that all the quantiles for all keys and all times are
+   calculated in one parallel pass over the resampled ensemble data.
+*/
+
+void output_run_line( const output_type * output , ensemble_type * ensemble ) {
 
   const int    data_columns = vector_get_size( output->keys );
   const int    data_rows    = time_t_vector_size( ensemble->interp_time );
@@ -623,93 +556,72 @@ void output_run_line( const output_type * output , ensemble_type * ensemble) {
 
   printf("Creating output file: %s \n",output->file );
 
-
-  /*
-     Go through all the cases and check that they have this key;
-     exit if missing. Could also ignore the missing keys and just
-     continue; and even defer the checking to the inner loop.
-  */
-  for (column_nr = 0; column_nr < vector_get_size( output->keys ); column_nr++) {
+  for (column_nr = 0; column_nr < data_columns; column_nr++) {
     const quant_key_type * qkey = vector_iget( output->keys , column_nr );
-    {
-      bool OK = true;
-
-      for (int iens = 0; iens < vector_get_size( ensemble->data ); iens++) {
-        const sum_case_type * sum_case = vector_iget_const( ensemble->data , iens );
+    const int key_index = ecl_sum_ensemble_get_key_index( ensemble->sum_ensemble , qkey->sum_key );
+    const int iq = ecl_sum_ensemble_get_quantile_index( ensemble->sum_ensemble , qkey->quantile );
 
-        if (!ecl_sum_has_general_var(sum_case->ecl_sum , qkey->sum_key)) {
-          OK = false;
-          fprintf(stderr,"** Sorry: the case:%s does not have the summary key:%s \n", ecl_sum_get_case( sum_case->ecl_sum ), qkey->sum_key);
-        }
-      }
-
-      if (!OK)
-        util_exit("Exiting due to missing summary vector(s).\n");
-    }
+    for (row_nr = 0; row_nr < data_rows; row_nr++)
+      data[row_nr][column_nr] = ecl_sum_ensemble_iget_quantile( ensemble->sum_ensemble , key_index , row_nr , iq );
   }
 
+  output_save( output , ensemble , (const double **) data);
+  for (row_nr=0; row_nr < data_rows; row_nr++)
+    free( data[row_nr] );
+  free( data );
+}
 
-  /* The main loop - outer loop is running over time. */
-  {
-    /**
-       In the quite typical case that we are asking for several
-       quantiles of the quantity, i.e.
 
-       WWCT:OP_1:0.10  WWCT:OP_1:0.50  WWCT:OP_1:0.90
 
-       the interp_data_cache construction will ensure that the
-       underlying ecl_sum object is only queried once; and also the
-       sorting will be performed once.
-    */
+void output_table_run( hash_type * output_table , ensemble_type * ensemble ) {
+  /*
+     Register all the keys and quantiles with the ensemble; exit if
+     some of the cases are missing keys. The ecl_sum_ensemble
+     implementation would silently ignore the cases with missing keys.
+  */
+  {
+    hash_iter_type * iter = hash_iter_alloc( output_table);
+    stringlist_type * missing_cases = stringlist_alloc_new();
+    bool OK = true;
 
-    hash_type * interp_data_cache = hash_alloc();
+    while (!hash_iter_is_complete( iter )) {
+      const output_type * output = hash_iter_get_next_value( iter );
+      int column_nr;
 
-    for (row_nr = 0; row_nr < data_rows; row_nr++) {
-      time_t interp_time = time_t_vector_iget( ensemble->interp_time , row_nr);
       for (column_nr = 0; column_nr < vector_get_size( output->keys ); column_nr++) {
         const quant_key_type * qkey = vector_iget( output->keys , column_nr );
-        double_vector_type * interp_data;
-
-        /* Check if we have the vector in the cache table - if not create it. */
-        if (!hash_has_key( interp_data_cache , qkey->sum_key)) {
-          interp_data = double_vector_alloc(0 , 0);
-          hash_insert_hash_owned_ref( interp_data_cache , qkey->sum_key , interp_data , double_vector_free__);
-        }
-        interp_data = hash_get( interp_data_cache , qkey->sum_key );
-
-        /* Check if the vector has data - if not initialize it. */
-        if (double_vector_size( interp_data ) == 0) {
-          for (int iens = 0; iens < vector_get_size( ensemble->data ); iens++) {
-            const sum_case_type * sum_case = vector_iget_const( ensemble->data , iens );
 
-            if ((interp_time >= sum_case->start_time) && (interp_time <= sum_case->end_time))  /* We allow the different simulations to have differing length */
-              double_vector_append( interp_data , ecl_sum_get_general_var_from_sim_time( sum_case->ecl_sum , interp_time , qkey->sum_key)) ;
-
-            double_vector_sort( interp_data );
+        if (ecl_sum_ensemble_get_key_index( ensemble->sum_ensemble , qkey->sum_key ) < 0) {
+          stringlist_clear( missing_cases );
+          if (!ecl_sum_ensemble_has_key( ensemble->sum_ensemble , qkey->sum_key , missing_cases )) {
+            int i;
+            OK = false;
+            for (i = 0; i < stringlist_get_size( missing_cases ); i++)
+              fprintf(stderr,"** Sorry: the case:%s does not have the summary key:%s \n", stringlist_iget( missing_cases , i ), qkey->sum_key);
           }
+          ecl_sum_ensemble_add_key( ensemble->sum_ensemble , qkey->sum_key );
         }
-        data[row_nr][column_nr] = statistics_empirical_quantile__( interp_data , qkey->quantile );
+        ecl_sum_ensemble_add_quantile( ensemble->sum_ensemble , qkey->quantile );
       }
-      hash_apply( interp_data_cache , double_vector_reset__ );
     }
-    hash_free( interp_data_cache );
-  }
-
-  output_save( output , ensemble , (const double **) data);
-  for (row_nr=0; row_nr < data_rows; row_nr++)
-    free( data[row_nr] );
-  free( data );
-}
-
+    stringlist_free( missing_cases );
+    hash_iter_free( iter );
 
+    if (!OK)
+      util_exit("Exiting due to missing summary vector(s).\n");
+  }
 
-void output_table_run( hash_type * output_table , ensemble_type * ensemble ) {
-  hash_iter_type * iter = hash_iter_alloc( output_table);
+  /* The main work - resampling and quantiles for all keys in parallel. */
+  ecl_sum_ensemble_calculate( ensemble->sum_ensemble );
+  {
+    hash_iter_type * iter = hash_iter_alloc( output_table);
 
-  while (!hash_iter_is_complete( iter )) {
-    const char * output_file     = hash_iter_get_next_key( iter );
-    const output_type * output   = hash_get( output_table , output_file );
-    output_run_line( output, ensemble );
+    while (!hash_iter_is_complete( iter )) {
+      const char * output_file     = hash_iter_get_next_key( iter );
+      const output_type * output   = hash_get( output_table , output_file );
+      output_run_line( output, ensemble );
+    }
+    hash_iter_free( iter );
   }
 }
 
@@ -723,6 +635,7 @@ void config_init( config_parser_type * config ) {
 
   config_add_schema_item( config , "CASE_LIST"      , true );
   config_add_key_value( config , "NUM_INTERP" , false , CONFIG_INT);
+  config_add_key_value( config , "NUM_THREADS" , false , CONFIG_INT);
 
   {
     config_schema_item_type * item;
@@ -809,6 +722,10 @@ void usage() {
   printf("  between ECLIPSE report steps, the might therefore look a bit jagged\n");
   printf("  if NUM_INTERP is set too high. This keyword is optional.\n");
   printf("\n");
+  printf("\n");
+  printf("NUM_THREADS: The number of threads used when loading the cases and\n");
+  printf("  calculating the quantiles; the default is %d. This keyword is optional.\n", DEFAULT_NUM_THREADS);
+  printf("\n");
   printf("All filenames in the configuration file will be interpreted relative to\n");
   printf("the location of the configuration file, i.e. irrespective of the current\n");
   printf("working directory when invoking the ecl_quantile program.\n\n");
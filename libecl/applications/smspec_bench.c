@@ -0,0 +1,113 @@
+/*
+   Copyright (C) 2017  Statoil ASA, Norway.
+
+   The file 'smspec_bench.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+#include <stdlib.h>
+#include <stdio.h>
+
+#include <ert/util/util.h>
+#include <ert/util/timer.h>
+
+#include <ert/ecl/ecl_sum.h>
+#include <ert/ecl/ecl_smspec.h>
+
+/*
+  Small benchmark of loading large SMSPEC headers. A synthetic case
+  with a given number of wells is written to the current directory;
+  every well has a set of well variables, and one completion and one
+  block variable per layer, giving ~40 nodes per well. The header is
+  then loaded repeatedly with ecl_smspec_fread_alloc(). The number of
+  wells and the number of repetitions can be given on the commandline:
+
+     smspec_bench [num_wells] [repeat]
+
+  The case files BENCH.SMSPEC and BENCH.UNSMRY are removed when the
+  benchmark is complete.
+*/
+
+#define NUM_LAYERS 10
+
+static const char * well_vars[] = {"WOPR" , "WWPR" , "WGPR" , "WOPT" , "WWPT" , "WGPT" , "WBHP" , "WTHP" , "WWCT" , "WGOR" ,
+                                   "WOPRH" , "WWPRH" , "WGPRH" , "WBHPH" , "WWIR" , "WGIR" , "WWIT" , "WGIT"};
+
+
+static void write_case( const char * case_name , int num_wells ) {
+  const int nx = 100;
+  const int ny = 100;
+  const int nz = NUM_LAYERS;
+  ecl_sum_type * ecl_sum = ecl_sum_alloc_writer( case_name , false , true , ":" , util_make_date_utc( 1,1,2010 ) , true , nx , ny , nz );
+  int well_nr;
+
+  for (well_nr = 0; well_nr < num_wells; well_nr++) {
+    char * well = util_alloc_sprintf("W%05d" , well_nr);
+    int i = well_nr % nx;
+    int j = (well_nr / nx) % ny;
+    int var , k;
+
+    for (var = 0; var < (int) (sizeof well_vars / sizeof well_vars[0]); var++)
+      ecl_sum_add_var( ecl_sum , well_vars[var] , well , 0 , "SM3/DAY" , 0 );
+
+    for (k = 0; k < nz; k++) {
+      int global_index = i + j * nx + k * nx * ny;
+      ecl_sum_add_var( ecl_sum , "COPR" , well , global_index + 1 , "SM3/DAY" , 0 );
+      ecl_sum_add_var( ecl_sum , "BPR" , NULL , global_index + 1 , "BARS" , 0 );
+    }
+    free( well );
+  }
+
+  ecl_sum_add_tstep( ecl_sum , 1 , 0 );
+  ecl_sum_fwrite( ecl_sum );
+  ecl_sum_free( ecl_sum );
+}
+
+
+int main(int argc , char ** argv) {
+  const char * case_name = "BENCH";
+  int num_wells = 2000;
+  int repeat = 5;
+  if (argc > 1)
+    util_sscanf_int( argv[1] , &num_wells );
+  if (argc > 2)
+    util_sscanf_int( argv[2] , &repeat );
+
+  {
+    timer_type * timer = timer_alloc( false );
+    char * header_file = util_alloc_sprintf("%s.SMSPEC" , case_name );
+    char * data_file = util_alloc_sprintf("%s.UNSMRY" , case_name );
+    int params_size = 0;
+    int i;
+
+    write_case( case_name , num_wells );
+    for (i = 0; i < repeat; i++) {
+      ecl_smspec_type * smspec;
+      timer_start( timer );
+      smspec = ecl_smspec_fread_alloc( header_file , ":" , false );
+      timer_stop( timer );
+      params_size = ecl_smspec_get_params_size( smspec );
+      ecl_smspec_free( smspec );
+    }
+
+    printf("%d wells  %d nodes\n" , num_wells , params_size );
+    printf("%-30s  min:%8.3f s  avg:%8.3f s\n" , "ecl_smspec_fread_alloc" , timer_get_min_time( timer ) , timer_get_avg_time( timer ));
+
+    util_unlink_existing( header_file );
+    util_unlink_existing( data_file );
+    free( header_file );
+    free( data_file );
+    timer_free( timer );
+  }
+  exit(0);
+}
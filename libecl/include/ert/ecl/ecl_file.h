@@ -38,8 +38,10 @@ extern "C" {
 
 #define ECL_FILE_FLAGS_ENUM_DEFS \
   {.value =   1 , .name="ECL_FILE_CLOSE_STREAM"}, \
-  {.value =   2 , .name="ECL_FILE_WRITABLE"}
-#define ECL_FILE_FLAGS_ENUM_SIZE 2
+  {.value =   2 , .name="ECL_FILE_WRITABLE"}, \
+  {.value =   4 , .name="ECL_FILE_MMAP"}, \
+  {.value =   8 , .name="ECL_FILE_INDEX"}
+#define ECL_FILE_FLAGS_ENUM_SIZE 4
 
 
 
@@ -47,6 +49,10 @@ extern "C" {
   typedef struct ecl_file_struct ecl_file_type;
   bool             ecl_file_load_all( ecl_file_type * ecl_file );
   ecl_file_type  * ecl_file_open( const char * filename , int flags);
+  ecl_file_type  * ecl_file_fast_open( const char * filename , const char * index_filename , int flags);
+  bool             ecl_file_write_index( const ecl_file_type * ecl_file , const char * index_filename );
+  bool             ecl_file_index_valid( const char * filename , const char * index_filename );
+  char           * ecl_file_alloc_index_filename( const char * filename );
   void             ecl_file_close( ecl_file_type * ecl_file );
   void             ecl_file_fortio_detach( ecl_file_type * ecl_file );
   void             ecl_file_free__(void * arg);
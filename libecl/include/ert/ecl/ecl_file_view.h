@@ -43,6 +43,19 @@ typedef enum {
                                     must still exist and be readable. I.e. this should not compared with the normal:
                                     fopen(filename , "w") where an existing file is truncated to zero upon successfull
                                     open.
+                                 */ ,
+  //
+  ECL_FILE_MMAP          =  4    /*
+                                    This flag will memory map an unformatted file which is opened for reading; the
+                                    keywords are then loaded directly from the mapping, and small numeric keywords
+                                    borrow their storage from the mapping instead of allocating a private copy. If
+                                    the file can not be mapped the flag is silently ignored.
+                                 */ ,
+  //
+  ECL_FILE_INDEX         =  8    /*
+                                    With this flag ecl_file_open() will use a binary index file '<filename>.index'
+                                    instead of scanning through the complete file, and write the index file if it is
+                                    missing or stale; see ecl_file_fast_open() and ecl_file_write_index().
                                  */
 } ecl_file_flag_type;
 
@@ -60,6 +73,7 @@ typedef struct ecl_file_view_struct ecl_file_view_type;
   ecl_file_kw_type * ecl_file_view_iget_named_file_kw( const ecl_file_view_type * ecl_file_view , const char * kw, int ith);
   ecl_kw_type * ecl_file_view_iget_kw( const ecl_file_view_type * ecl_file_view , int index);
   void ecl_file_view_index_fload_kw(const ecl_file_view_type * ecl_file_view, const char* kw, int index, const int_vector_type * index_map, char* buffer);
+  void ecl_file_view_range_fload_kw(const ecl_file_view_type * ecl_file_view, const char* kw, int index, int first_element, int num_elements, char* buffer);
   int ecl_file_view_find_kw_value( const ecl_file_view_type * ecl_file_view , const char * kw , const void * value);
   const char * ecl_file_view_iget_distinct_kw( const ecl_file_view_type * ecl_file_view , int index);
   int ecl_file_view_get_num_distinct_kw( const ecl_file_view_type * ecl_file_view );
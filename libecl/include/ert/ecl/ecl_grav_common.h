@@ -25,13 +25,24 @@ extern "C" {
 #endif
 #include <stdbool.h>
 
+#include <ert/util/int_vector.h>
+
 #include <ert/ecl/ecl_grid_cache.h>
 #include <ert/ecl/ecl_file.h>
+#include <ert/ecl/ecl_region.h>
 
   bool   * ecl_grav_common_alloc_aquifer_cell( const ecl_grid_cache_type * grid_cache , const ecl_file_type * init_file);
   double   ecl_grav_common_eval_biot_savart( const ecl_grid_cache_type * grid_cache , ecl_region_type * region , const bool * aquifer , const double * weight ,  double utm_x , double utm_y , double depth);
   double ecl_grav_common_eval_geertsma( const ecl_grid_cache_type * grid_cache , ecl_region_type * region , const bool * aquifer , const double * weight , double utm_x , double utm_y , double depth, double poisson_ratio, double seabed);
 
+  int_vector_type * ecl_grav_common_alloc_index_list( const ecl_grid_cache_type * grid_cache , ecl_region_type * region , const bool * aquifer);
+  void ecl_grav_common_eval_biot_savart_stations( const ecl_grid_cache_type * grid_cache , const int_vector_type * index_list , const double * weight ,
+                                                  int num_stations , const double * utm_x , const double * utm_y , const double * depth ,
+                                                  int num_threads , double * result);
+  void ecl_grav_common_eval_geertsma_stations( const ecl_grid_cache_type * grid_cache , const int_vector_type * index_list , const double * weight ,
+                                               int num_stations , const double * utm_x , const double * utm_y , const double * depth ,
+                                               double poisson_ratio , double seabed , int num_threads , double * result);
+
 #ifdef __cplusplus
 }
 
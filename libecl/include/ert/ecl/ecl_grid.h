@@ -89,6 +89,10 @@ extern "C" {
   bool            ecl_grid_cell_contains1(const ecl_grid_type * grid , int global_index , double x , double y , double z);
   bool            ecl_grid_cell_contains3(const ecl_grid_type * grid , int i , int j ,int k , double x , double y , double z);
   int             ecl_grid_get_global_index_from_xyz(ecl_grid_type * grid , double x , double y , double z , int start_index);
+  void            ecl_grid_get_global_index_from_xyz_list(ecl_grid_type * grid , int num_points , const double * x , const double * y , const double * z , int * global_index);
+  void            ecl_grid_init_search_index( ecl_grid_type * grid );
+  void            ecl_grid_freeze( ecl_grid_type * grid );
+  bool            ecl_grid_is_frozen( const ecl_grid_type * grid );
   bool            ecl_grid_get_ijk_from_xyz(ecl_grid_type * grid , double x , double y , double z , int start_index, int *i, int *j, int *k );
   bool            ecl_grid_get_ij_from_xy( const ecl_grid_type * grid , double x , double y , int k , int* i, int* j);
   const  char   * ecl_grid_get_name( const ecl_grid_type * );
@@ -112,8 +116,15 @@ extern "C" {
   ecl_grid_type * ecl_grid_alloc_GRDECL_data(int , int , int , const float *  , const float *  , const int * , bool apply_mapaxes , const float * mapaxes);
   ecl_grid_type * ecl_grid_alloc_GRID_data(int num_coords , int nx, int ny , int nz , int coords_size , int ** coords , float ** corners , bool apply_mapaxes, const float * mapaxes);
   ecl_grid_type * ecl_grid_alloc(const char * );
+  ecl_grid_type * ecl_grid_alloc_compact(const char * grid_file );
+  bool            ecl_grid_is_compact( const ecl_grid_type * grid );
+  void            ecl_grid_set_init_threads( int num_threads );
+  int             ecl_grid_get_init_threads( void );
   ecl_grid_type * ecl_grid_load_case( const char * case_input );
   ecl_grid_type * ecl_grid_load_case__( const char * case_input , bool apply_mapaxes);
+  ecl_grid_type * ecl_grid_load_case_cached( const char * case_input , const char * cache_file);
+  bool            ecl_grid_fwrite_cache( const ecl_grid_type * grid , const char * cache_file , const char * source_file);
+  ecl_grid_type * ecl_grid_fread_cache( const char * cache_file , const char * source_file , bool verify_checksum);
   ecl_grid_type * ecl_grid_alloc_rectangular( int nx , int ny , int nz , double dx , double dy , double dz , const int * actnum);
   ecl_grid_type * ecl_grid_alloc_regular( int nx, int ny , int nz , const double * ivec, const double * jvec , const double * kvec , const int * actnum);
   ecl_grid_type * ecl_grid_alloc_dxv_dyv_dzv( int nx, int ny , int nz , const double * dxv , const double * dyv , const double * dzv , const int * actnum);
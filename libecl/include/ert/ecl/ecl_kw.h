@@ -91,6 +91,9 @@ extern "C" {
   ecl_kw_type *  ecl_kw_fread_alloc(fortio_type *);
   void           ecl_kw_free_data(ecl_kw_type *);
   void           ecl_kw_fread_indexed_data(fortio_type * fortio, offset_type data_offset, ecl_data_type, int element_count, const int_vector_type* index_map, char* buffer);
+  void           ecl_kw_fread_data_range(fortio_type * fortio, offset_type data_offset, ecl_data_type, int element_count, int first_element, int num_elements, char* buffer);
+  bool           ecl_kw_fread_mapped_data(ecl_kw_type * ecl_kw , const fortio_type * fortio , offset_type data_offset);
+  ecl_kw_type *  ecl_kw_fread_alloc_mapped( const fortio_type * fortio , offset_type offset );
   void           ecl_kw_free(ecl_kw_type *);
   void           ecl_kw_free__(void *);
   ecl_kw_type *  ecl_kw_alloc_copy (const ecl_kw_type *);
@@ -17,9 +17,9 @@
 */
 
 /*
- This header does not define datatypes; just a couple of functions. It should
- be included from the ecl_kw.h header, so applications do not need to include this
- header explicitly.
+ This header only defines the opaque ecl_kw_grdecl_index datatype; apart from
+ that just a couple of functions. It should be included from the ecl_kw.h header,
+ so applications do not need to include this header explicitly.
 */
 
 #ifndef ERT_ECL_KW_GRDECL_H
@@ -50,6 +50,20 @@ extern "C" {
   void           ecl_kw_fprintf_grdecl(const ecl_kw_type * ecl_kw , FILE * stream);
   void           ecl_kw_fprintf_grdecl__(const ecl_kw_type * ecl_kw , const char * special_header , FILE * stream);
 
+  typedef struct ecl_kw_grdecl_index_struct ecl_kw_grdecl_index_type;
+
+  ecl_kw_grdecl_index_type * ecl_kw_grdecl_index_alloc( FILE * stream , bool use_mmap );
+  void                       ecl_kw_grdecl_index_free( ecl_kw_grdecl_index_type * index );
+  bool                       ecl_kw_grdecl_index_is_instance( const void * __arg );
+  bool                       ecl_kw_grdecl_index_is_mapped( const ecl_kw_grdecl_index_type * index );
+  int                        ecl_kw_grdecl_index_get_size( const ecl_kw_grdecl_index_type * index );
+  const char               * ecl_kw_grdecl_index_iget_kw( const ecl_kw_grdecl_index_type * index , int kw_nr);
+  offset_type                ecl_kw_grdecl_index_iget_offset( const ecl_kw_grdecl_index_type * index , int kw_nr);
+  bool                       ecl_kw_grdecl_index_has_kw( const ecl_kw_grdecl_index_type * index , const char * kw);
+  bool                       ecl_kw_grdecl_index_fseek_kw( const ecl_kw_grdecl_index_type * index , const char * kw , bool rewind , FILE * stream);
+  ecl_kw_type              * ecl_kw_grdecl_index_alloc_kw__( const ecl_kw_grdecl_index_type * index , const char * kw , bool strict , int size , ecl_data_type data_type);
+  ecl_kw_type              * ecl_kw_grdecl_index_alloc_kw( const ecl_kw_grdecl_index_type * index , const char * kw , int size , ecl_data_type data_type);
+
 #ifdef __cplusplus
 }
 #endif
@@ -43,6 +43,26 @@ extern "C" {
                                                     ecl_region_type * region , 
                                                     double utm_x, double utm_y , double depth, double compressibility, double poisson_ratio);
 
+  double                       ecl_subsidence_eval_geertsma( const ecl_subsidence_type * subsidence ,
+                                                             const char * base, const char * monitor ,
+                                                             ecl_region_type * region ,
+                                                             double utm_x, double utm_y , double depth,
+                                                             double youngs_modulus, double poisson_ratio, double seabed);
+
+  void                         ecl_subsidence_eval_stations( const ecl_subsidence_type * subsidence ,
+                                                             const char * base, const char * monitor ,
+                                                             ecl_region_type * region ,
+                                                             int num_stations , const double * utm_x, const double * utm_y , const double * depth,
+                                                             double compressibility, double poisson_ratio,
+                                                             int num_threads , double * deltaz);
+
+  void                         ecl_subsidence_eval_geertsma_stations( const ecl_subsidence_type * subsidence ,
+                                                                      const char * base, const char * monitor ,
+                                                                      ecl_region_type * region ,
+                                                                      int num_stations , const double * utm_x, const double * utm_y , const double * depth,
+                                                                      double youngs_modulus, double poisson_ratio, double seabed,
+                                                                      int num_threads , double * deltaz);
+
 
 #ifdef __plusplus
 }
@@ -94,6 +94,8 @@ typedef struct ecl_sum_struct       ecl_sum_type;
   ecl_sum_type   * ecl_sum_fread_alloc(const char * , const stringlist_type * data_files, const char * key_join_string);
   ecl_sum_type   * ecl_sum_fread_alloc_case(const char *  , const char * key_join_string);
   ecl_sum_type   * ecl_sum_fread_alloc_case__(const char *  , const char * key_join_string , bool include_restart);
+  ecl_sum_type   * ecl_sum_fread_alloc_case_parallel(const char * input_file , const char * key_join_string , bool include_restart , int load_threads);
+  int              ecl_sum_fread_refresh( ecl_sum_type * ecl_sum );
   bool             ecl_sum_case_exists( const char * input_file );
 
   /* Accessor functions : */
@@ -158,6 +160,10 @@ typedef struct ecl_sum_struct       ecl_sum_type;
 
   void                 ecl_sum_init_data_vector( const ecl_sum_type * ecl_sum , double_vector_type * data_vector , int data_index , bool report_only );
   double_vector_type * ecl_sum_alloc_data_vector( const ecl_sum_type * ecl_sum  , int data_index , bool report_only);
+  const float        * ecl_sum_iget_column( ecl_sum_type * ecl_sum , int params_index , int * length);
+  const float        * ecl_sum_get_column( ecl_sum_type * ecl_sum , const char * gen_key , int * length);
+  void                 ecl_sum_compress( ecl_sum_type * ecl_sum );
+  bool                 ecl_sum_is_compressed( const ecl_sum_type * ecl_sum );
   time_t_vector_type * ecl_sum_alloc_time_vector( const ecl_sum_type * ecl_sum  , bool report_only);
   time_t       ecl_sum_get_data_start( const ecl_sum_type * ecl_sum );
   time_t       ecl_sum_get_end_time( const ecl_sum_type * ecl_sum);
@@ -207,6 +213,7 @@ typedef struct ecl_sum_struct       ecl_sum_type;
   bool                  ecl_sum_report_step_equal( const ecl_sum_type * ecl_sum1 , const ecl_sum_type * ecl_sum2);
   bool                  ecl_sum_report_step_compatible( const ecl_sum_type * ecl_sum1 , const ecl_sum_type * ecl_sum2);
   void                  ecl_sum_export_csv(const ecl_sum_type * ecl_sum , const char * filename  , const stringlist_type * var_list , const char * date_format , const char * sep);
+  void                  ecl_sum_export_columns(const ecl_sum_type * ecl_sum , const char * filename , const stringlist_type * var_list);
 
 
   double_vector_type * ecl_sum_alloc_seconds_solution( const ecl_sum_type * ecl_sum , const char * gen_key , double cmp_value , bool rates_clamp_lower);
@@ -0,0 +1,48 @@
+/*
+   Copyright (C) 2017  Statoil ASA, Norway.
+
+   The file 'ecl_sum_compressed.h' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+
+#ifndef ERT_ECL_SUM_COMPRESSED_H
+#define ERT_ECL_SUM_COMPRESSED_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdlib.h>
+
+#include <ert/util/type_macros.h>
+
+typedef struct ecl_sum_compressed_struct ecl_sum_compressed_type;
+
+  ecl_sum_compressed_type * ecl_sum_compressed_alloc( int row_size );
+  void                      ecl_sum_compressed_free( ecl_sum_compressed_type * compressed );
+  void                      ecl_sum_compressed_append_row( ecl_sum_compressed_type * compressed , const float * row );
+  void                      ecl_sum_compressed_shrink( ecl_sum_compressed_type * compressed );
+  int                       ecl_sum_compressed_get_num_rows( const ecl_sum_compressed_type * compressed );
+  int                       ecl_sum_compressed_get_row_size( const ecl_sum_compressed_type * compressed );
+  float                     ecl_sum_compressed_iget( const ecl_sum_compressed_type * compressed , int row , int column );
+  void                      ecl_sum_compressed_get_row( const ecl_sum_compressed_type * compressed , int row , float * target );
+  void                      ecl_sum_compressed_get_column( const ecl_sum_compressed_type * compressed , int column , float * target );
+  size_t                    ecl_sum_compressed_get_byte_size( const ecl_sum_compressed_type * compressed );
+
+  UTIL_IS_INSTANCE_HEADER( ecl_sum_compressed );
+
+#ifdef __cplusplus
+}
+#endif
+#endif
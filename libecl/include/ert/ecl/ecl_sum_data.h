@@ -42,6 +42,9 @@ typedef struct ecl_sum_data_struct ecl_sum_data_type ;
   void                     ecl_sum_data_fwrite( const ecl_sum_data_type * data , const char * ecl_case , bool fmt_case , bool unified);
   bool                     ecl_sum_data_fread( ecl_sum_data_type * data , const stringlist_type * filelist);
   void                     ecl_sum_data_fread_restart( ecl_sum_data_type * data , const stringlist_type * filelist);
+  int                      ecl_sum_data_fread_tail( ecl_sum_data_type * data , const stringlist_type * filelist);
+  void                     ecl_sum_data_set_load_threads( ecl_sum_data_type * data , int load_threads);
+  int                      ecl_sum_data_get_load_threads( const ecl_sum_data_type * data );
   ecl_sum_data_type      * ecl_sum_data_alloc_writer( ecl_smspec_type * smspec );
   ecl_sum_data_type      * ecl_sum_data_alloc( ecl_smspec_type * smspec);
   double                   ecl_sum_data_time2days( const ecl_sum_data_type * data , time_t sim_time);
@@ -51,6 +54,11 @@ typedef struct ecl_sum_data_struct ecl_sum_data_type ;
   bool                     ecl_sum_data_check_sim_days( const ecl_sum_data_type * data , double sim_days);
   int                      ecl_sum_data_get_num_ministep( const ecl_sum_data_type * data );
   double_vector_type     * ecl_sum_data_alloc_data_vector( const ecl_sum_data_type * data , int data_index , bool report_only);
+  void                     ecl_sum_data_build_columns( ecl_sum_data_type * data );
+  bool                     ecl_sum_data_has_columns( const ecl_sum_data_type * data );
+  const float            * ecl_sum_data_get_column( ecl_sum_data_type * data , int params_index , int * length);
+  void                     ecl_sum_data_compress( ecl_sum_data_type * data );
+  bool                     ecl_sum_data_is_compressed( const ecl_sum_data_type * data );
   void                     ecl_sum_data_init_data_vector( const ecl_sum_data_type * data , double_vector_type * data_vector , int data_index , bool report_only);
   void                     ecl_sum_data_init_time_vector( const ecl_sum_data_type * data , time_t_vector_type * time_vector , bool report_only);
   time_t_vector_type     * ecl_sum_data_alloc_time_vector( const ecl_sum_data_type * data , bool report_only);
@@ -91,6 +99,7 @@ typedef struct ecl_sum_data_struct ecl_sum_data_type ;
   bool                     ecl_sum_data_report_step_equal( const ecl_sum_data_type * data1 , const ecl_sum_data_type * data2);
   bool                     ecl_sum_data_report_step_compatible( const ecl_sum_data_type * data1 , const ecl_sum_data_type * data2);
   void                     ecl_sum_data_fwrite_interp_csv_line(const ecl_sum_data_type * data , time_t sim_time, const ecl_sum_vector_type * keylist, FILE *fp);
+  void                     ecl_sum_data_init_data_matrix( const ecl_sum_data_type * data , const ecl_sum_vector_type * keylist , const time_t_vector_type * sim_time , double * matrix);
 
   double_vector_type * ecl_sum_data_alloc_seconds_solution( const ecl_sum_data_type * data , const smspec_node_type * node , double value, bool rates_clamp_lower);
 
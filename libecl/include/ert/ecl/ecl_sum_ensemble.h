@@ -0,0 +1,69 @@
+/*
+   Copyright (C) 2017  Statoil ASA, Norway.
+
+   The file 'ecl_sum_ensemble.h' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+
+#ifndef ERT_ECL_SUM_ENSEMBLE_H
+#define ERT_ECL_SUM_ENSEMBLE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <time.h>
+
+#include <ert/util/type_macros.h>
+#include <ert/util/stringlist.h>
+#include <ert/util/time_t_vector.h>
+
+#include <ert/ecl/ecl_sum.h>
+
+typedef struct ecl_sum_ensemble_struct ecl_sum_ensemble_type;
+
+  ecl_sum_ensemble_type    * ecl_sum_ensemble_alloc( int num_threads );
+  void                       ecl_sum_ensemble_free( ecl_sum_ensemble_type * ensemble );
+  void                       ecl_sum_ensemble_set_compress( ecl_sum_ensemble_type * ensemble , bool compress );
+  int                        ecl_sum_ensemble_load_cases( ecl_sum_ensemble_type * ensemble , const stringlist_type * case_list , const char * key_join_string );
+  void                       ecl_sum_ensemble_add_case( ecl_sum_ensemble_type * ensemble , ecl_sum_type * ecl_sum );
+  int                        ecl_sum_ensemble_get_size( const ecl_sum_ensemble_type * ensemble );
+  const ecl_sum_type       * ecl_sum_ensemble_iget_case( const ecl_sum_ensemble_type * ensemble , int iens );
+  time_t                     ecl_sum_ensemble_get_start_time( const ecl_sum_ensemble_type * ensemble );
+  time_t                     ecl_sum_ensemble_get_end_time( const ecl_sum_ensemble_type * ensemble );
+
+  void                       ecl_sum_ensemble_init_time_interp( ecl_sum_ensemble_type * ensemble , int num_interp );
+  void                       ecl_sum_ensemble_set_time_interp( ecl_sum_ensemble_type * ensemble , const time_t_vector_type * interp_time );
+  const time_t_vector_type * ecl_sum_ensemble_get_time_interp( const ecl_sum_ensemble_type * ensemble );
+
+  int                        ecl_sum_ensemble_add_key( ecl_sum_ensemble_type * ensemble , const char * key );
+  int                        ecl_sum_ensemble_get_key_index( const ecl_sum_ensemble_type * ensemble , const char * key );
+  int                        ecl_sum_ensemble_get_num_keys( const ecl_sum_ensemble_type * ensemble );
+  bool                       ecl_sum_ensemble_has_key( const ecl_sum_ensemble_type * ensemble , const char * key , stringlist_type * missing_cases );
+  void                       ecl_sum_ensemble_resample( ecl_sum_ensemble_type * ensemble );
+  double                     ecl_sum_ensemble_iget_resampled( const ecl_sum_ensemble_type * ensemble , int iens , int key_index , int time_index );
+  double                   * ecl_sum_ensemble_alloc_quantiles( const ecl_sum_ensemble_type * ensemble , int num_quantiles , const double * quantiles );
+
+  int                        ecl_sum_ensemble_add_quantile( ecl_sum_ensemble_type * ensemble , double quantile );
+  int                        ecl_sum_ensemble_get_quantile_index( const ecl_sum_ensemble_type * ensemble , double quantile );
+  int                        ecl_sum_ensemble_get_num_quantiles( const ecl_sum_ensemble_type * ensemble );
+  void                       ecl_sum_ensemble_calculate( ecl_sum_ensemble_type * ensemble );
+  double                     ecl_sum_ensemble_iget_quantile( const ecl_sum_ensemble_type * ensemble , int key_index , int time_index , int quantile_index );
+
+  UTIL_IS_INSTANCE_HEADER( ecl_sum_ensemble );
+
+#ifdef __cplusplus
+}
+#endif
+#endif
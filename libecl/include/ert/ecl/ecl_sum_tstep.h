@@ -42,6 +42,10 @@ typedef struct ecl_sum_tstep_struct ecl_sum_tstep_type;
 
   ecl_sum_tstep_type * ecl_sum_tstep_alloc_new( int report_step , int ministep , float sim_seconds , const ecl_smspec_type * smspec );
 
+  const float * ecl_sum_tstep_get_data(const ecl_sum_tstep_type * ministep);
+  int ecl_sum_tstep_get_data_size(const ecl_sum_tstep_type * ministep);
+  void ecl_sum_tstep_drop_data( ecl_sum_tstep_type * ministep );
+  void ecl_sum_tstep_set_data( ecl_sum_tstep_type * ministep , const float * data , int data_size);
   double ecl_sum_tstep_iget(const ecl_sum_tstep_type * ministep , int index);
   time_t ecl_sum_tstep_get_sim_time(const ecl_sum_tstep_type * ministep);
   double ecl_sum_tstep_get_sim_days(const ecl_sum_tstep_type * ministep);
@@ -39,6 +39,9 @@ typedef struct ecl_sum_vector_struct ecl_sum_vector_type;
   int ecl_sum_vector_iget_param_index(const ecl_sum_vector_type * ecl_sum_vector, int index);
   int ecl_sum_vector_get_size(const ecl_sum_vector_type * ecl_sum_vector);
 
+  /* Implemented in ecl_sum.c - declared here because it needs the ecl_sum_vector_type. */
+  void ecl_sum_init_data_matrix( const ecl_sum_type * ecl_sum , const ecl_sum_vector_type * keylist , const time_t_vector_type * sim_time , double * matrix);
+
   UTIL_IS_INSTANCE_HEADER( ecl_sum_vector);
 
 
@@ -124,6 +124,7 @@ typedef struct ecl_type_struct ecl_data_type;
 ecl_data_type      ecl_type_create_from_name(const char *);
 ecl_data_type      ecl_type_create(const ecl_type_enum, const size_t);
 ecl_data_type      ecl_type_create_from_type(const ecl_type_enum);
+bool               ecl_type_is_valid_name(const char *);
 
 ecl_type_enum      ecl_type_get_type(const ecl_data_type);
 const char *       ecl_type_get_name(const ecl_data_type);
@@ -56,9 +56,10 @@ typedef struct fortio_struct fortio_type;
   bool               fortio_complete_read(fortio_type *, int record_size);
   void               fortio_init_write(fortio_type * , int);
   void               fortio_complete_write(fortio_type * , int record_size);
-  void               fortio_fskip_buffer(fortio_type *, int );
+  void               fortio_fskip_buffer(fortio_type *, size_t buffer_size);
   int                fortio_fskip_record(fortio_type *);
-  bool               fortio_fread_buffer(fortio_type * , char * buffer, int buffer_size);
+  bool               fortio_fread_buffer(fortio_type * , char * buffer, size_t buffer_size);
+  bool               fortio_fread_buffer_endian_flip(fortio_type * , char * buffer, size_t buffer_size, int element_size);
   void               fortio_fwrite_record(fortio_type * , const char * buffer, int buffer_size);
   FILE        *      fortio_get_FILE(const fortio_type *);
   void               fortio_fflush(fortio_type * ) ;
@@ -80,6 +81,11 @@ typedef struct fortio_struct fortio_type;
   bool               fortio_assert_stream_open( fortio_type * fortio );
   bool               fortio_read_at_eof( fortio_type * fortio );
 
+  bool               fortio_mmap( fortio_type * fortio );
+  void               fortio_munmap( fortio_type * fortio );
+  bool               fortio_is_mapped( const fortio_type * fortio );
+  char        *      fortio_mmap_record( const fortio_type * fortio , offset_type offset , int * record_size);
+
 UTIL_IS_INSTANCE_HEADER( fortio );
 UTIL_SAFE_CAST_HEADER( fortio );
 
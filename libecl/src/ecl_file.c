@@ -138,6 +138,8 @@ struct ecl_file_struct {
   int             flags;
   vector_type   * map_stack;
   inv_map_type  * inv_view;
+  offset_type     scan_size;         /* The size of the file when the index was created; used by ecl_file_write_index(). */
+  time_t          scan_mtime;
 };
 
 
@@ -183,6 +185,8 @@ ecl_file_type * ecl_file_alloc_empty( int flags ) {
   ecl_file->map_stack = vector_alloc_new();
   ecl_file->inv_view  = inv_map_alloc( );
   ecl_file->flags     = flags;
+  ecl_file->scan_size = 0;
+  ecl_file->scan_mtime = 0;
   return ecl_file;
 }
 
@@ -512,14 +516,15 @@ ecl_file_view_type * ecl_file_get_summary_view( ecl_file_type * ecl_file , int r
    map.
 */
 
-static bool ecl_file_scan( ecl_file_type * ecl_file ) {
+static bool ecl_file_scan( ecl_file_type * ecl_file , offset_type start_offset) {
   bool scan_ok = false;
-  fortio_fseek( ecl_file->fortio , 0 , SEEK_SET );
+  fortio_fseek( ecl_file->fortio , start_offset , SEEK_SET );
   {
     ecl_kw_type * work_kw = ecl_kw_alloc_new("WORK-KW" , 0 , ECL_INT , NULL);
 
     while (true) {
       if (fortio_read_at_eof(ecl_file->fortio)) {
+        ecl_file->scan_size = fortio_ftell( ecl_file->fortio );
         scan_ok = true;
         break;
       }
@@ -563,6 +568,209 @@ void ecl_file_select_global( ecl_file_type * ecl_file ) {
 }
 
 
+/*****************************************************************/
+/*
+  The index which is created by ecl_file_scan() can be saved in a
+  binary index file with ecl_file_write_index(), and used to open the
+  file later with ecl_file_fast_open() without scanning through the
+  file. The index file contains the size and modification time of the
+  file when it was scanned, followed by the header information of all
+  the keywords:
+
+     | ECL_FILE_INDEX_MAGIC | version | size | mtime | num_kw | kw_0 | kw_1 | ..... |
+
+  If the file has grown since the index was written, e.g. because a
+  simulator is still appending to it, the keywords in the index are
+  used as they are and only the tail of the file is scanned. Before
+  that is done the first and the last keyword of the index are checked
+  against the file, and the last keyword must end at the recorded
+  size. If any part of the index is not valid the whole file is
+  scanned.
+*/
+
+#define ECL_FILE_INDEX_MAGIC    "ECLINDEX"
+#define ECL_FILE_INDEX_VERSION  1
+
+
+bool ecl_file_write_index( const ecl_file_type * ecl_file , const char * index_filename ) {
+  FILE * stream = fopen( index_filename , "wb" );
+  if (stream) {
+    int num_kw = ecl_file_view_get_size( ecl_file->global_view );
+    int i;
+
+    util_fwrite( ECL_FILE_INDEX_MAGIC , 1 , strlen( ECL_FILE_INDEX_MAGIC ) , stream , __func__ );
+    util_fwrite_int( ECL_FILE_INDEX_VERSION , stream );
+    util_fwrite( &ecl_file->scan_size , sizeof ecl_file->scan_size , 1 , stream , __func__ );
+    util_fwrite_time_t( ecl_file->scan_mtime , stream );
+    util_fwrite_int( num_kw , stream );
+
+    for (i=0; i < num_kw; i++)
+      ecl_file_kw_fwrite( ecl_file_view_iget_file_kw( ecl_file->global_view , i ) , stream );
+
+    fclose( stream );
+    return true;
+  } else
+    return false;
+}
+
+
+static bool ecl_file_fread_index_header( FILE * stream , offset_type * size , time_t * mtime , int * num_kw) {
+  char magic[sizeof ECL_FILE_INDEX_MAGIC];
+  int version;
+  size_t magic_length = strlen( ECL_FILE_INDEX_MAGIC );
+
+  if (fread( magic , 1 , magic_length , stream ) != magic_length)
+    return false;
+
+  if (memcmp( magic , ECL_FILE_INDEX_MAGIC , magic_length ) != 0)
+    return false;
+
+  if (fread( &version , sizeof version , 1 , stream ) != 1)
+    return false;
+
+  if (version != ECL_FILE_INDEX_VERSION)
+    return false;
+
+  if (fread( size , sizeof * size , 1 , stream ) != 1)
+    return false;
+
+  if (fread( mtime , sizeof * mtime , 1 , stream ) != 1)
+    return false;
+
+  if (fread( num_kw , sizeof * num_kw , 1 , stream ) != 1)
+    return false;
+
+  return (*num_kw >= 0);
+}
+
+
+/*
+  Checks that a keyword in the index is found at the expected offset
+  in the file; used before the index is extended with the tail of a
+  file which has grown. On success the file is positioned at the end
+  of the keyword.
+*/
+
+static bool ecl_file_index_check_kw( ecl_file_type * ecl_file , const ecl_file_kw_type * file_kw) {
+  bool kw_ok = false;
+  ecl_kw_type * work_kw = ecl_kw_alloc_new("WORK-KW" , 0 , ECL_INT , NULL);
+
+  fortio_fseek( ecl_file->fortio , ecl_file_kw_get_offset( file_kw ) , SEEK_SET );
+  if (ecl_kw_fread_header( work_kw , ecl_file->fortio ) == ECL_KW_READ_OK) {
+    if ((strcmp( ecl_kw_get_header( work_kw ) , ecl_file_kw_get_header( file_kw )) == 0) &&
+        (ecl_kw_get_size( work_kw ) == ecl_file_kw_get_size( file_kw )) &&
+        ecl_type_is_equal( ecl_kw_get_data_type( work_kw ) , ecl_file_kw_get_data_type( file_kw )))
+      kw_ok = ecl_file_kw_fskip_data( file_kw , ecl_file->fortio );
+  }
+
+  ecl_kw_free( work_kw );
+  return kw_ok;
+}
+
+
+/*
+  Will try to initialize the global view from the index file; the
+  return value is true if the global view has been initialized, and
+  the *scan_offset will then be set to the position in the file where
+  ecl_file_scan() should continue; if the index was complete
+  *scan_offset is set to the size of the file.
+*/
+
+static bool ecl_file_load_index( ecl_file_type * ecl_file , const char * filename , const char * index_filename , offset_type * scan_offset) {
+  bool index_ok = false;
+  FILE * stream;
+
+  if (!util_file_exists( index_filename ))
+    return false;
+
+  stream = fopen( index_filename , "rb" );
+  if (stream) {
+    offset_type index_size;
+    time_t index_mtime;
+    int num_kw;
+
+    if (ecl_file_fread_index_header( stream , &index_size , &index_mtime , &num_kw)) {
+      offset_type file_size = util_file_size( filename );
+      time_t file_mtime = util_file_mtime( filename );
+      bool complete = ((file_size == index_size) && (file_mtime == index_mtime));
+      bool append   = ((file_size > index_size) && (file_mtime >= index_mtime));
+
+      if (complete || append) {
+        offset_type prev_offset = -1;
+        int i;
+        index_ok = true;
+        for (i=0; i < num_kw; i++) {
+          ecl_file_kw_type * file_kw = ecl_file_kw_fread_alloc( stream );
+          if (file_kw) {
+            offset_type offset = ecl_file_kw_get_offset( file_kw );
+            ecl_file_view_add_kw( ecl_file->global_view , file_kw );
+            if ((offset <= prev_offset) || (offset >= index_size)) {
+              index_ok = false;
+              break;
+            }
+            prev_offset = offset;
+          } else {
+            index_ok = false;
+            break;
+          }
+        }
+
+        if (index_ok && append) {
+          if (num_kw > 0)
+            index_ok = ecl_file_index_check_kw( ecl_file , ecl_file_view_iget_file_kw( ecl_file->global_view , 0 )) &&
+                       ecl_file_index_check_kw( ecl_file , ecl_file_view_iget_file_kw( ecl_file->global_view , num_kw - 1)) &&
+                       (fortio_ftell( ecl_file->fortio ) == index_size);
+          else
+            index_ok = (index_size == 0);
+        }
+
+        if (index_ok) {
+          *scan_offset = index_size;
+          ecl_file->scan_size  = index_size;
+          ecl_file->scan_mtime = file_mtime;
+        } else {
+          /* Discard the partially loaded index. */
+          ecl_file_view_free( ecl_file->global_view );
+          ecl_file->global_view = ecl_file_view_alloc( ecl_file->fortio , &ecl_file->flags , ecl_file->inv_view , true );
+        }
+      }
+    }
+    fclose( stream );
+  }
+  return index_ok;
+}
+
+
+/*
+  Will return true if the index file @index_filename can be used to
+  open the file @filename with ecl_file_fast_open() without scanning
+  the file.
+*/
+
+bool ecl_file_index_valid( const char * filename , const char * index_filename ) {
+  bool valid = false;
+  if (util_file_exists( filename ) && util_file_exists( index_filename )) {
+    FILE * stream = fopen( index_filename , "rb" );
+    if (stream) {
+      offset_type index_size;
+      time_t index_mtime;
+      int num_kw;
+
+      if (ecl_file_fread_index_header( stream , &index_size , &index_mtime , &num_kw))
+        valid = ((util_file_size( filename ) == index_size) && (util_file_mtime( filename ) == index_mtime));
+
+      fclose( stream );
+    }
+  }
+  return valid;
+}
+
+
+char * ecl_file_alloc_index_filename( const char * filename ) {
+  return util_alloc_sprintf( "%s.index" , filename );
+}
+
+
 
 /**
    The fundamental open file function; all alternative open()
@@ -576,7 +784,7 @@ void ecl_file_select_global( ecl_file_type * ecl_file ) {
 */
 
 
-ecl_file_type * ecl_file_open( const char * filename , int flags) {
+static ecl_file_type * ecl_file_open__( const char * filename , const char * index_filename , int flags) {
   fortio_type * fortio;
   bool          fmt_file;
 
@@ -589,25 +797,78 @@ ecl_file_type * ecl_file_open( const char * filename , int flags) {
 
   if (fortio) {
     ecl_file_type * ecl_file = ecl_file_alloc_empty( flags );
+    if (ecl_file_view_check_flags(flags , ECL_FILE_MMAP) && !ecl_file_view_check_flags(flags , ECL_FILE_WRITABLE))
+      fortio_mmap( fortio );
+
     ecl_file->fortio = fortio;
     ecl_file->global_view = ecl_file_view_alloc( ecl_file->fortio , &ecl_file->flags , ecl_file->inv_view , true );
+    ecl_file->scan_mtime  = util_file_mtime( filename );
+
+    {
+      offset_type scan_offset = 0;
+      bool scan_ok;
+
+      if (index_filename && ecl_file_load_index( ecl_file , filename , index_filename , &scan_offset ))
+        scan_ok = ecl_file_scan( ecl_file , scan_offset );
+      else
+        scan_ok = ecl_file_scan( ecl_file , 0 );
+
+      if (!scan_ok) {
+        ecl_file_close( ecl_file );
+        return NULL;
+      }
+    }
 
-    if (ecl_file_scan( ecl_file )) {
+    {
       ecl_file_select_global( ecl_file );
 
       if (ecl_file_view_check_flags( ecl_file->flags , ECL_FILE_CLOSE_STREAM))
         fortio_fclose_stream( ecl_file->fortio );
 
       return ecl_file;
-    } else {
-      ecl_file_close( ecl_file );
-      return NULL;
     }
   } else
     return NULL;
 }
 
 
+/**
+   If the flag ECL_FILE_INDEX is set ecl_file_open() will use the
+   index file "<filename>.index" when opening the file, and write a
+   new index file if the existing one is missing or stale. Failure to
+   write the index file, e.g. because the directory is not writable,
+   is silently ignored.
+*/
+
+ecl_file_type * ecl_file_open( const char * filename , int flags) {
+  if (ecl_file_view_check_flags( flags , ECL_FILE_INDEX )) {
+    char * index_filename = ecl_file_alloc_index_filename( filename );
+    ecl_file_type * ecl_file = ecl_file_open__( filename , index_filename , flags );
+
+    if (ecl_file && !ecl_file_index_valid( filename , index_filename ))
+      ecl_file_write_index( ecl_file , index_filename );
+
+    free( index_filename );
+    return ecl_file;
+  } else
+    return ecl_file_open__( filename , NULL , flags );
+}
+
+
+/**
+   Will open the file @filename using the index file
+   @index_filename, which should have been created with
+   ecl_file_write_index(). If the index file is missing or invalid
+   the function will fall back to scanning the whole file, i.e. it
+   behaves as ecl_file_open(); if the file has grown since the index
+   was written only the new tail of the file is scanned.
+*/
+
+ecl_file_type * ecl_file_fast_open( const char * filename , const char * index_filename , int flags) {
+  return ecl_file_open__( filename , index_filename , flags );
+}
+
+
 
 
 
@@ -664,12 +925,21 @@ void ecl_file_close_fortio_stream(ecl_file_type * ecl_file) {
    already, but if you try on-demand loading of a keyword you will get
    crash-and-burn. To ensure that all keywords are in memory you can
    call ecl_file_load_all() prior to the detach call.
+
+   If the file has been opened with the ECL_FILE_MMAP flag the loaded
+   keywords might borrow their storage from the memory mapping; in
+   that case only the stream is closed, and the mapping is retained
+   until ecl_file_close() is called.
 */
 
 
 void ecl_file_fortio_detach( ecl_file_type * ecl_file ) {
-  fortio_fclose( ecl_file->fortio );
-  ecl_file->fortio = NULL;
+  if (fortio_is_mapped( ecl_file->fortio ))
+    fortio_fclose_stream( ecl_file->fortio );
+  else {
+    fortio_fclose( ecl_file->fortio );
+    ecl_file->fortio = NULL;
+  }
 }
 
 
@@ -175,6 +175,57 @@ ecl_file_kw_type * ecl_file_kw_alloc_copy( const ecl_file_kw_type * src ) {
 
 
 
+/**
+   The header information of an ecl_file_kw instance can be stored in
+   a binary index file, see ecl_file_write_index(). The layout of one
+   entry is:
+
+      | header (8 chars) | size (int) | type (4 chars) | offset (offset_type) |
+
+   The ecl_file_kw_fread_alloc() function will return NULL if the
+   entry can not be read, or if it is not valid; i.e. an unknown type
+   name or a negative size or offset.
+*/
+
+void ecl_file_kw_fwrite( const ecl_file_kw_type * file_kw , FILE * stream ) {
+  char header[ECL_STRING8_LENGTH + 1];
+  sprintf( header , "%-8s" , file_kw->header );
+
+  util_fwrite( header , 1 , ECL_STRING8_LENGTH , stream , __func__ );
+  util_fwrite_int( file_kw->kw_size , stream );
+  util_fwrite( ecl_type_get_name( file_kw->data_type ) , 1 , ECL_TYPE_LENGTH , stream , __func__ );
+  util_fwrite( &file_kw->file_offset , sizeof file_kw->file_offset , 1 , stream , __func__ );
+}
+
+
+ecl_file_kw_type * ecl_file_kw_fread_alloc( FILE * stream ) {
+  const char null_char = '\0';
+  char header[ECL_STRING8_LENGTH + 1];
+  char type_name[ECL_TYPE_LENGTH + 1];
+  int kw_size;
+  offset_type file_offset;
+
+  if ((fread( header , 1 , ECL_STRING8_LENGTH , stream ) == ECL_STRING8_LENGTH) &&
+      (fread( &kw_size , sizeof kw_size , 1 , stream ) == 1) &&
+      (fread( type_name , 1 , ECL_TYPE_LENGTH , stream ) == ECL_TYPE_LENGTH) &&
+      (fread( &file_offset , sizeof file_offset , 1 , stream ) == 1)) {
+
+    header[ECL_STRING8_LENGTH] = null_char;
+    type_name[ECL_TYPE_LENGTH] = null_char;
+    if (!ecl_type_is_valid_name( type_name ) || (kw_size < 0) || (file_offset < 0))
+      return NULL;
+
+    {
+      char * strip_header = util_alloc_strip_copy( header );
+      ecl_file_kw_type * file_kw = ecl_file_kw_alloc__( strip_header , ecl_type_create_from_name( type_name ) , kw_size , file_offset );
+      free( strip_header );
+      return file_kw;
+    }
+  } else
+    return NULL;
+}
+
+
 void ecl_file_kw_free( ecl_file_kw_type * file_kw ) {
   if (file_kw->kw != NULL) {
     ecl_kw_free( file_kw->kw );
@@ -223,7 +274,13 @@ static void ecl_file_kw_load_kw( ecl_file_kw_type * file_kw , fortio_type * fort
   if (file_kw->kw != NULL)
     ecl_file_kw_drop_kw( file_kw , inv_map );
 
-  {
+  if (fortio_is_mapped( fortio )) {
+    file_kw->kw = ecl_kw_fread_alloc_mapped( fortio , file_kw->file_offset );
+    if (file_kw->kw == NULL)
+      util_abort("%s: failed to load keyword:%s from memory mapped file:%s \n",__func__ , file_kw->header , fortio_filename_ref( fortio ));
+    ecl_file_kw_assert_kw( file_kw );
+    inv_map_add_kw( inv_map , file_kw , file_kw->kw );
+  } else {
     fortio_fseek( fortio , file_kw->file_offset , SEEK_SET );
     file_kw->kw = ecl_kw_fread_alloc( fortio );
     ecl_file_kw_assert_kw( file_kw );
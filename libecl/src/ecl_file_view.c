@@ -93,12 +93,17 @@ int ecl_file_view_get_global_index( const ecl_file_view_type * ecl_file_view , c
    must be called every time the content of the kw_list vector is
    modified (otherwise the ecl_file instance will be in an
    inconsistent state).
+
+   The kw_index is rebuilt from scratch in a new hash table, which is
+   frozen when it is complete; lookups in the index can then be done
+   from several threads without taking the hash lock.
 */
 
 
 void ecl_file_view_make_index( ecl_file_view_type * ecl_file_view ) {
   stringlist_clear( ecl_file_view->distinct_kw );
-  hash_clear( ecl_file_view->kw_index );
+  hash_free( ecl_file_view->kw_index );
+  ecl_file_view->kw_index = hash_alloc();
   {
     int i;
     for (i=0; i < vector_get_size( ecl_file_view->kw_list ); i++) {
@@ -116,6 +121,7 @@ void ecl_file_view_make_index( ecl_file_view_type * ecl_file_view ) {
       }
     }
   }
+  hash_freeze( ecl_file_view->kw_index );
 }
 
 bool ecl_file_view_has_kw( const ecl_file_view_type * ecl_file_view, const char * kw) {
@@ -147,11 +153,22 @@ void ecl_file_view_add_flag( ecl_file_view_type * file_view , int flag)  {
 }
 
 
+/*
+  A memory mapped file can be read without an open stream.
+*/
+static bool ecl_file_view_assert_readable( const ecl_file_view_type * ecl_file_view ) {
+  if (fortio_is_mapped( ecl_file_view->fortio ))
+    return true;
+  else
+    return fortio_assert_stream_open( ecl_file_view->fortio );
+}
+
+
 ecl_kw_type * ecl_file_view_iget_kw( const ecl_file_view_type * ecl_file_view , int index) {
   ecl_file_kw_type * file_kw = ecl_file_view_iget_file_kw( ecl_file_view , index );
   ecl_kw_type * ecl_kw = ecl_file_kw_get_kw_ptr( file_kw , ecl_file_view->fortio , ecl_file_view->inv_map);
   if (!ecl_kw) {
-    if (fortio_assert_stream_open( ecl_file_view->fortio )) {
+    if (ecl_file_view_assert_readable( ecl_file_view )) {
 
       ecl_kw = ecl_file_kw_get_kw( file_kw , ecl_file_view->fortio , ecl_file_view->inv_map);
 
@@ -175,6 +192,25 @@ void ecl_file_view_index_fload_kw(const ecl_file_view_type * ecl_file_view, cons
 }
 
 
+/**
+   Will read the elements [first_element, first_element + num_elements)
+   of keyword @kw directly from the file into @buffer, without loading
+   the full keyword.
+*/
+
+void ecl_file_view_range_fload_kw(const ecl_file_view_type * ecl_file_view, const char* kw, int index, int first_element, int num_elements, char* buffer) {
+    ecl_file_kw_type * file_kw = ecl_file_view_iget_named_file_kw( ecl_file_view , kw , index);
+
+    if (fortio_assert_stream_open( ecl_file_view->fortio )) {
+        offset_type offset = ecl_file_kw_get_offset(file_kw);
+        ecl_data_type data_type = ecl_file_kw_get_data_type(file_kw);
+        int element_count = ecl_file_kw_get_size(file_kw);
+
+        ecl_kw_fread_data_range(ecl_file_view->fortio, offset + ECL_KW_HEADER_FORTIO_SIZE, data_type, element_count, first_element, num_elements, buffer);
+    }
+}
+
+
 int ecl_file_view_find_kw_value( const ecl_file_view_type * ecl_file_view , const char * kw , const void * value) {
   int global_index = -1;
   if ( ecl_file_view_has_kw( ecl_file_view , kw)) {
@@ -225,7 +261,7 @@ ecl_kw_type * ecl_file_view_iget_named_kw( const ecl_file_view_type * ecl_file_v
   ecl_file_kw_type * file_kw = ecl_file_view_iget_named_file_kw( ecl_file_view , kw , ith);
   ecl_kw_type * ecl_kw = ecl_file_kw_get_kw_ptr( file_kw , ecl_file_view->fortio , ecl_file_view->inv_map );
   if (!ecl_kw) {
-    if (fortio_assert_stream_open( ecl_file_view->fortio )) {
+    if (ecl_file_view_assert_readable( ecl_file_view )) {
 
       ecl_kw = ecl_file_kw_get_kw( file_kw , ecl_file_view->fortio , ecl_file_view->inv_map);
 
@@ -274,7 +310,7 @@ void ecl_file_view_replace_kw( ecl_file_view_type * ecl_file_view , ecl_kw_type
 bool ecl_file_view_load_all( ecl_file_view_type * ecl_file_view ) {
   bool loadOK = false;
 
-  if (fortio_assert_stream_open( ecl_file_view->fortio )) {
+  if (ecl_file_view_assert_readable( ecl_file_view )) {
     int index;
     for (index = 0; index < vector_get_size( ecl_file_view->kw_list); index++) {
       ecl_file_kw_type * ikw = vector_iget( ecl_file_view->kw_list , index );
@@ -561,6 +561,58 @@ static double ecl_grav_survey_eval( const ecl_grav_survey_type * base_survey,
   return deltag;
 }
 
+/**
+   Evaluates the gravity change for @num_stations stations in one
+   pass. The mass difference is linear in the biot savart sum, so
+   the mass changes of all the selected phases are added up in one
+   weight vector before the stations are evaluated.
+*/
+
+static void ecl_grav_survey_eval_stations( const ecl_grav_survey_type * base_survey,
+                                           const ecl_grav_survey_type * monitor_survey ,
+                                           ecl_region_type * region ,
+                                           int num_stations ,
+                                           const double * utm_x , const double * utm_y , const double * depth,
+                                           int phase_mask , int num_threads , double * deltag) {
+  const ecl_grid_cache_type * grid_cache = base_survey->grid_cache;
+  const int size = ecl_grid_cache_get_size( grid_cache );
+  double * mass_diff = util_calloc( size , sizeof * mass_diff );
+  int phase_nr;
+  int index;
+
+  for (index = 0; index < size; index++)
+    mass_diff[index] = 0;
+
+  for (phase_nr = 0; phase_nr < vector_get_size( base_survey->phase_list ); phase_nr++) {
+    const ecl_grav_phase_type * base_phase = vector_iget_const( base_survey->phase_list , phase_nr );
+    if (base_phase->phase & phase_mask) {
+      if (monitor_survey != NULL) {
+        const ecl_grav_phase_type * monitor_phase = vector_iget_const( monitor_survey->phase_list , phase_nr );
+        if (base_phase->phase != monitor_phase->phase)
+          util_abort("%s comparing different phases ... \n",__func__);
+
+        for (index = 0; index < size; index++)
+          mass_diff[index] += monitor_phase->fluid_mass[index] - base_phase->fluid_mass[index];
+      } else {
+        for (index = 0; index < size; index++)
+          mass_diff[index] -= base_phase->fluid_mass[index];
+      }
+    }
+  }
+
+  {
+    int_vector_type * index_list = ecl_grav_common_alloc_index_list( grid_cache , region , base_survey->aquifer_cell );
+    int station;
+
+    ecl_grav_common_eval_biot_savart_stations( grid_cache , index_list , mass_diff , num_stations , utm_x , utm_y , depth , num_threads , deltag );
+    for (station = 0; station < num_stations; station++)
+      deltag[station] *= 6.67428E-3;
+
+    int_vector_free( index_list );
+  }
+  free( mass_diff );
+}
+
 /*****************************************************************/
 /**
    The grid instance is only used during the construction phase. The
@@ -645,6 +697,22 @@ double ecl_grav_eval( const ecl_grav_type * grav , const char * base, const char
 }
 
 
+/**
+   Batched version of ecl_grav_eval(); the gravity change at station i,
+   i.e. (utm_x[i], utm_y[i], depth[i]), is stored in deltag[i]. The
+   stations can be evaluated in parallel with @num_threads threads.
+*/
+
+void ecl_grav_eval_stations( const ecl_grav_type * grav , const char * base, const char * monitor , ecl_region_type * region ,
+                             int num_stations , const double * utm_x, const double * utm_y , const double * depth,
+                             int phase_mask , int num_threads , double * deltag) {
+  ecl_grav_survey_type * base_survey    = ecl_grav_get_survey( grav , base );
+  ecl_grav_survey_type * monitor_survey = ecl_grav_get_survey( grav , monitor );
+
+  ecl_grav_survey_eval_stations( base_survey , monitor_survey , region , num_stations , utm_x , utm_y , depth , phase_mask , num_threads , deltag);
+}
+
+
 /******************************************************************/
 /* The functions ecl_grav_new_std_density() and ecl_grav_add_std_density() are
    used to "install" standard conditions densities for the various phases
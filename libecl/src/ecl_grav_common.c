@@ -22,6 +22,12 @@
 #include <math.h>
 
 #include <ert/util/util.h>
+#include <ert/util/int_vector.h>
+#include <ert/util/ert_api_config.h>
+
+#ifdef ERT_HAVE_THREAD_POOL
+#include <ert/util/thread_pool.h>
+#endif
 
 #include <ert/ecl/ecl_kw.h>
 #include <ert/ecl/ecl_file.h>
@@ -99,11 +105,11 @@ double ecl_grav_common_eval_biot_savart( const ecl_grid_cache_type * grid_cache
 }
 
 
-static inline double ecl_grav_common_eval_geertsma_kernel(int index, const double * xpos, const double * ypos, const double * zpos , double utm_x , double utm_y , double depth, double poisson_ratio, double seabed) {
-  double z = zpos[index];
+static inline double ecl_grav_common_eval_geertsma_kernel(double xpos, double ypos, double zpos , double utm_x , double utm_y , double depth, double poisson_ratio, double seabed) {
+  double z = zpos;
   z -= seabed;
-  double dist_x  = xpos[index] - utm_x;
-  double dist_y  = ypos[index] - utm_y;
+  double dist_x  = xpos - utm_x;
+  double dist_y  = ypos - utm_y;
 
   double dist_z1 = z - depth;
   double dist_z2 = dist_z1 - 2*z;
@@ -135,7 +141,7 @@ double ecl_grav_common_eval_geertsma( const ecl_grid_cache_type * grid_cache , e
     for ( index = 0; index < size; index++) {
       if (!aquifer[index]) {
 
-        double displacement = ecl_grav_common_eval_geertsma_kernel( index, xpos , ypos , zpos, utm_x, utm_y , depth, poisson_ratio, seabed);
+        double displacement = ecl_grav_common_eval_geertsma_kernel( xpos[index] , ypos[index] , zpos[index] , utm_x, utm_y , depth, poisson_ratio, seabed);
 
         /**
             For numerical precision it might be benficial to use the
@@ -152,7 +158,7 @@ double ecl_grav_common_eval_geertsma( const ecl_grid_cache_type * grid_cache , e
     for (i = 0; i < size; i++) {
       index = index_list[i];
       if (!aquifer[index]) {
-        double displacement = ecl_grav_common_eval_geertsma_kernel( index, xpos , ypos , zpos, utm_x, utm_y , depth , poisson_ratio, seabed);
+        double displacement = ecl_grav_common_eval_geertsma_kernel( xpos[index] , ypos[index] , zpos[index] , utm_x, utm_y , depth , poisson_ratio, seabed);
         sum += weight[index] * displacement;
       }
     }
@@ -161,3 +167,243 @@ double ecl_grav_common_eval_geertsma( const ecl_grid_cache_type * grid_cache , e
 }
 
 
+
+/*****************************************************************/
+/*
+  Batched evaluation of many stations in one pass over the grid.
+
+  The cells to include are first compiled into a plain index list
+  with ecl_grav_common_alloc_index_list(), i.e. the region selection
+  and the aquifer mask are resolved once instead of being tested for
+  every (cell,station) pair.
+
+  The evaluation is tiled: a block of STATION_BLOCK_SIZE cells is
+  gathered into small contiguous arrays, and then all the stations
+  are evaluated against that block before moving on to the next
+  block. The per cell terms for one station are computed in a simple
+  loop without any reduction or branching, so that the compiler can
+  vectorize it; the terms are summed in a separate loop afterwards.
+  With gcc this file is compiled with -fno-math-errno and the dynamic
+  vectorizer cost model, see libecl/src/CMakeLists.txt; without those
+  flags the sqrt() calls keep the loops scalar.
+
+  When the thread pool is available the stations can be split
+  between several threads; each thread evaluates a contiguous range
+  of stations, and the result for each station is independent of the
+  number of threads.
+*/
+
+#define STATION_BLOCK_SIZE 256
+
+typedef enum {
+  GRAV_COMMON_BIOT_SAVART = 1,
+  GRAV_COMMON_GEERTSMA    = 2
+} grav_common_kernel_enum;
+
+
+typedef struct {
+  grav_common_kernel_enum   kernel;
+  const double            * xpos;
+  const double            * ypos;
+  const double            * zpos;
+  const double            * weight;
+  const int               * index_list;
+  int                       num_cells;
+  const double            * utm_x;
+  const double            * utm_y;
+  const double            * depth;
+  double                    poisson_ratio;
+  double                    seabed;
+  double                  * result;
+  int                       station1;
+  int                       station2;
+} station_job_type;
+
+
+
+int_vector_type * ecl_grav_common_alloc_index_list( const ecl_grid_cache_type * grid_cache , ecl_region_type * region , const bool * aquifer) {
+  int_vector_type * index_list = int_vector_alloc( 0 , 0 );
+  if (region == NULL) {
+    const int size = ecl_grid_cache_get_size( grid_cache );
+    int index;
+    for (index = 0; index < size; index++)
+      if (!aquifer[index])
+        int_vector_append( index_list , index );
+  } else {
+    const int_vector_type * region_list = ecl_region_get_active_list( region );
+    const int * region_ptr = int_vector_get_const_ptr( region_list );
+    int i;
+    for (i = 0; i < int_vector_size( region_list ); i++) {
+      int index = region_ptr[i];
+      if (!aquifer[index])
+        int_vector_append( index_list , index );
+    }
+  }
+  return index_list;
+}
+
+
+static void ecl_grav_common_eval_station_block( const station_job_type * job ,
+                                                int block_size ,
+                                                const double * x ,
+                                                const double * y ,
+                                                const double * z ,
+                                                const double * w ,
+                                                double * term) {
+  int station;
+  for (station = job->station1; station < job->station2; station++) {
+    const double utm_x = job->utm_x[station];
+    const double utm_y = job->utm_y[station];
+    const double depth = job->depth[station];
+    double sum = 0;
+    int i;
+
+    if (job->kernel == GRAV_COMMON_BIOT_SAVART) {
+      for (i = 0; i < block_size; i++) {
+        double dist_x  = x[i] - utm_x;
+        double dist_y  = y[i] - utm_y;
+        double dist_z  = z[i] - depth;
+        double dist    = sqrt( dist_x*dist_x + dist_y*dist_y + dist_z*dist_z );
+        term[i] = w[i] * dist_z / (dist * dist * dist);
+      }
+    } else {
+      for (i = 0; i < block_size; i++)
+        term[i] = w[i] * ecl_grav_common_eval_geertsma_kernel( x[i] , y[i] , z[i] , utm_x , utm_y , depth , job->poisson_ratio , job->seabed );
+    }
+
+    for (i = 0; i < block_size; i++)
+      sum += term[i];
+
+    job->result[station] += sum;
+  }
+}
+
+
+static void * ecl_grav_common_eval_stations__( void * arg ) {
+  const station_job_type * job = arg;
+  double x[STATION_BLOCK_SIZE];
+  double y[STATION_BLOCK_SIZE];
+  double z[STATION_BLOCK_SIZE];
+  double w[STATION_BLOCK_SIZE];
+  double term[STATION_BLOCK_SIZE];
+  int station;
+  int offset;
+
+  for (station = job->station1; station < job->station2; station++)
+    job->result[station] = 0;
+
+  for (offset = 0; offset < job->num_cells; offset += STATION_BLOCK_SIZE) {
+    int block_size = util_int_min( STATION_BLOCK_SIZE , job->num_cells - offset );
+    int i;
+
+    for (i = 0; i < block_size; i++) {
+      int index = job->index_list[offset + i];
+      x[i] = job->xpos[index];
+      y[i] = job->ypos[index];
+      z[i] = job->zpos[index];
+      w[i] = job->weight[index];
+    }
+
+    ecl_grav_common_eval_station_block( job , block_size , x , y , z , w , term );
+  }
+  return NULL;
+}
+
+
+static void ecl_grav_common_eval_stations( const station_job_type * template_job , int num_stations , int num_threads) {
+#ifdef ERT_HAVE_THREAD_POOL
+  num_threads = util_int_min( num_threads , num_stations );
+  if (num_threads > 1) {
+    station_job_type * jobs = util_calloc( num_threads , sizeof * jobs );
+    thread_pool_type * tp = thread_pool_alloc( num_threads , true );
+    int ithread;
+
+    for (ithread = 0; ithread < num_threads; ithread++) {
+      station_job_type * job = &jobs[ithread];
+      *job = *template_job;
+      job->station1 = (ithread * num_stations) / num_threads;
+      job->station2 = ((ithread + 1) * num_stations) / num_threads;
+      thread_pool_add_job( tp , ecl_grav_common_eval_stations__ , job );
+    }
+    thread_pool_join( tp );
+    thread_pool_free( tp );
+    free( jobs );
+    return;
+  }
+#endif
+  {
+    station_job_type job = *template_job;
+    job.station1 = 0;
+    job.station2 = num_stations;
+    ecl_grav_common_eval_stations__( &job );
+  }
+}
+
+
+static void ecl_grav_common_init_station_job( station_job_type * job ,
+                                              grav_common_kernel_enum kernel ,
+                                              const ecl_grid_cache_type * grid_cache ,
+                                              const int_vector_type * index_list ,
+                                              const double * weight ,
+                                              const double * utm_x ,
+                                              const double * utm_y ,
+                                              const double * depth ,
+                                              double * result) {
+  job->kernel        = kernel;
+  job->xpos          = ecl_grid_cache_get_xpos( grid_cache );
+  job->ypos          = ecl_grid_cache_get_ypos( grid_cache );
+  job->zpos          = ecl_grid_cache_get_zpos( grid_cache );
+  job->weight        = weight;
+  job->index_list    = int_vector_get_const_ptr( index_list );
+  job->num_cells     = int_vector_size( index_list );
+  job->utm_x         = utm_x;
+  job->utm_y         = utm_y;
+  job->depth         = depth;
+  job->poisson_ratio = 0;
+  job->seabed        = 0;
+  job->result        = result;
+  job->station1      = 0;
+  job->station2      = 0;
+}
+
+
+/**
+   Will evaluate the biot savart sum for @num_stations stations, the
+   result for station i is stored in result[i]. The @index_list should
+   be created with ecl_grav_common_alloc_index_list(). The
+   @num_threads argument is ignored if the thread pool is not
+   available.
+*/
+
+void ecl_grav_common_eval_biot_savart_stations( const ecl_grid_cache_type * grid_cache ,
+                                                const int_vector_type * index_list ,
+                                                const double * weight ,
+                                                int num_stations ,
+                                                const double * utm_x ,
+                                                const double * utm_y ,
+                                                const double * depth ,
+                                                int num_threads ,
+                                                double * result) {
+  station_job_type job;
+  ecl_grav_common_init_station_job( &job , GRAV_COMMON_BIOT_SAVART , grid_cache , index_list , weight , utm_x , utm_y , depth , result );
+  ecl_grav_common_eval_stations( &job , num_stations , num_threads );
+}
+
+
+void ecl_grav_common_eval_geertsma_stations( const ecl_grid_cache_type * grid_cache ,
+                                             const int_vector_type * index_list ,
+                                             const double * weight ,
+                                             int num_stations ,
+                                             const double * utm_x ,
+                                             const double * utm_y ,
+                                             const double * depth ,
+                                             double poisson_ratio ,
+                                             double seabed ,
+                                             int num_threads ,
+                                             double * result) {
+  station_job_type job;
+  ecl_grav_common_init_station_job( &job , GRAV_COMMON_GEERTSMA , grid_cache , index_list , weight , utm_x , utm_y , depth , result );
+  job.poisson_ratio = poisson_ratio;
+  job.seabed        = seabed;
+  ecl_grav_common_eval_stations( &job , num_stations , num_threads );
+}
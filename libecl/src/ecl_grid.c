@@ -20,14 +20,28 @@
 #include <string.h>
 #include <stdio.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <math.h>
+#include <float.h>
+#include <limits.h>
+#include <errno.h>
 
+#include <ert/util/ert_api_config.h>
 #include <ert/util/util.h>
 #include <ert/util/double_vector.h>
 #include <ert/util/int_vector.h>
 #include <ert/util/hash.h>
 #include <ert/util/vector.h>
 #include <ert/util/stringlist.h>
+#ifdef ERT_HAVE_THREAD_POOL
+#include <ert/util/thread_pool.h>
+#endif
+#ifdef ERT_HAVE_MMAP
+#include <sys/mman.h>
+#endif
+#ifdef ERT_HAVE_UNISTD
+#include <unistd.h>
+#endif
 
 #include <ert/geometry/geo_util.h>
 #include <ert/geometry/geo_polygon.h>
@@ -42,6 +56,7 @@
 #include <ert/ecl/ecl_grid.h>
 #include <ert/ecl/grid_dims.h>
 #include <ert/ecl/nnc_info.h>
+#include <ert/ecl/nnc_vector.h>
 
 
 /**
@@ -670,7 +685,6 @@ static void point_copy_values(point_type * p , const point_type * src) {
 #define HOST_CELL_NONE     -1
 
 #define CELL_FLAG_VALID    1     /* In the case of GRID files not necessarily all cells geometry values set - in that case this will be left as false. */
-#define CELL_FLAG_CENTER   2     /* Has the center value been calculated - this is by default not done to speed up loading a tiny bit. */
 #define CELL_FLAG_TAINTED  4     /* lazy fucking stupid reservoir engineers make invalid grid
                                     cells - for kicks??  must try to keep those cells out of
                                     real-world calculations with some hysteric heuristics.*/
@@ -683,28 +697,35 @@ typedef struct ecl_cell_struct           ecl_cell_type;
 #define METER_TO_FEET_SCALE_FACTOR   3.28084
 #define METER_TO_CM_SCALE_FACTOR   100.0
 
-struct ecl_cell_struct {
-  point_type center;
-  point_type corner_list[8];
+/*
+  The ecl_cell struct only holds the dense per cell metadata. The
+  geometry of the cells, the lgr refining a cell and the nnc
+  information are stored in separate arrays in the ecl_grid structure;
+  see the documentation of cell storage further down.
+*/
 
+struct ecl_cell_struct {
   double                 volume;             /* Cache volume - whether it is initialized or not is handled by a cell_flags. */
   int                    active;
   int                    active_index[2];    /* [0]: The active matrix index; [1]: the active fracture index */
-  const ecl_grid_type   *lgr;                /* if this cell is part of an lgr; this will point to a grid instance for that lgr; NULL if not part of lgr. */
   int                    host_cell;          /* the global index of the host cell for an lgr cell, set to -1 for normal cells. */
   int                    coarse_group;       /* The index of the coarse group holding this cell -1 for non-coarsened cells. */
   int                    cell_flags;
-  nnc_info_type        * nnc_info;           /* Non-neighbour connection info*/
 };
 
 
 
 static void          ecl_grid_init_mapaxes_data_float( const ecl_grid_type * grid , float * mapaxes);
 float *              ecl_grid_alloc_coord_data( const ecl_grid_type * grid );
+void                 ecl_grid_assert_coord_kw( ecl_grid_type * grid );
 static const float * ecl_grid_get_mapaxes( const ecl_grid_type * grid );
 
 #define ECL_GRID_ID       991010
 
+typedef struct ecl_grid_search_index_struct ecl_grid_search_index_type;
+static void ecl_grid_search_index_free( ecl_grid_search_index_type * search_index );
+static void ecl_grid_cache_release_data( void * data , size_t size );
+
 struct ecl_grid_struct {
   UTIL_TYPE_ID_DECLARATION;
   int                   lgr_nr;        /* EGRID files: corresponds to item 4 in gridhead - 0 for the main grid.
@@ -714,7 +735,6 @@ struct ecl_grid_struct {
   int                   size;          /* == nx*ny*nz */
   int                   total_active;
   int                   total_active_fracture;
-  bool                * visited;                /* internal helper struct used when searching for index - can be NULL. */
   int                 * index_map;              /* this a list of nx*ny*nz elements, where value -1 means inactive cell .*/
   int                 * inv_index_map;          /* this is list of total_active elements - which point back to the index_map. */
 
@@ -722,6 +742,17 @@ struct ecl_grid_struct {
   int                 * inv_fracture_index_map; /* For fractures: this is list of total_active elements - which point back to the index_map. */
 
   ecl_cell_type      *  cells;
+  bool                  compact;          /* Compact grids store the corners in single precision. */
+  bool                  frozen;           /* Frozen grids have all lazy state initialized, and can be queried from several threads. */
+  point_type          * corners;          /* The eight corners of every cell - NULL for compact grids. */
+  float               * compact_corners;  /* The eight corners of every cell as x,y,z float triplets - only for compact grids. */
+  point_type            compact_origin;   /* The compact_corners are stored relative to this point. */
+  bool                  cells_mapped;     /* The cells and compact_corners point into the cache data of the main grid. */
+  void                * cache_data;       /* Main grid only: the cache file mapped by ecl_grid_fread_cache() - can be NULL. */
+  size_t                cache_size;
+  const ecl_grid_type** cell_lgr;         /* The lgr refining each cell; allocated when the first lgr is installed. */
+  nnc_info_type      ** cell_nnc_info;    /* The nnc_info of each cell; allocated when the first nnc is added. */
+  ecl_grid_search_index_type * search_index; /* Spatial index for xyz lookup; created on demand - can be NULL. */
 
   char                * parent_name;   /* the name of the parent for a nested lgr - for the main grid, and also a
                                           lgr descending directly from the main grid this will be NULL. */
@@ -763,9 +794,7 @@ struct ecl_grid_struct {
   int                   eclipse_version;
 };
 
-static void ecl_cell_compare(const ecl_cell_type * c1 , const ecl_cell_type * c2,  bool include_nnc , bool * equal) {
-  int i;
-
+static void ecl_cell_compare(const ecl_cell_type * c1 , const ecl_cell_type * c2, bool * equal) {
   if (c1->active != c2->active)
     *equal = false;
 
@@ -781,43 +810,41 @@ static void ecl_cell_compare(const ecl_cell_type * c1 , const ecl_cell_type * c2
 
   if (c1->host_cell != c2->host_cell)
     *equal = false;
+}
 
-  if (*equal) {
-    for (i=0; i < 8; i++)
-      point_compare( &c1->corner_list[i] , &c2->corner_list[i] , equal );
-
-  }
-
-  if (include_nnc) {
-    if (*equal)
-      *equal = nnc_info_equal( c1->nnc_info , c2->nnc_info );
-  }
 
+static void ecl_cell_compare_corners(const point_type * corner_list1 , const point_type * corner_list2 , bool * equal) {
+  int i;
+  for (i=0; i < 8; i++)
+    point_compare( &corner_list1[i] , &corner_list2[i] , equal );
 }
 
 
-static void ecl_cell_dump( const ecl_cell_type * cell , FILE * stream) {
+static void ecl_cell_dump( const point_type * corner_list , FILE * stream) {
   int i;
   for (i=0; i < 8; i++)
-    point_dump( &cell->corner_list[i] , stream );
+    point_dump( &corner_list[i] , stream );
 }
 
 
-static void ecl_cell_assert_center( ecl_cell_type * cell);
+static void ecl_cell_get_center( const point_type * corner_list , point_type * center);
 
-static void ecl_cell_dump_ascii( ecl_cell_type * cell , int i , int j , int k , FILE * stream , const double * offset) {
+static void ecl_cell_dump_ascii( const ecl_cell_type * cell , const point_type * corner_list , int i , int j , int k , FILE * stream , const double * offset) {
   fprintf(stream , "Cell: i:%3d  j:%3d    k:%3d   host_cell:%d  CoarseGroup:%4d active_nr:%6d  active:%d \nCorners:\n",i,j,k,cell->host_cell, cell->coarse_group , cell->active_index[MATRIX_INDEX], cell->active);
 
-  ecl_cell_assert_center( cell );
-  fprintf(stream , "Center   : ");
-  point_dump_ascii( &cell->center , stream , offset);
-  fprintf(stream , "\n");
+  {
+    point_type center;
+    ecl_cell_get_center( corner_list , &center );
+    fprintf(stream , "Center   : ");
+    point_dump_ascii( &center , stream , offset);
+    fprintf(stream , "\n");
+  }
 
   {
     int l;
     for (l=0; l < 8; l++) {
       fprintf(stream , "Corner %d : ",l);
-      point_dump_ascii( &cell->corner_list[l] , stream , offset);
+      point_dump_ascii( &corner_list[l] , stream , offset);
       fprintf(stream , "\n");
     }
   }
@@ -825,7 +852,7 @@ static void ecl_cell_dump_ascii( ecl_cell_type * cell , int i , int j , int k ,
 }
 
 
-static void ecl_cell_fwrite_GRID( const ecl_grid_type * grid , const ecl_cell_type * cell , bool fracture_cell , int coords_size , int i, int j , int k , int global_index , ecl_kw_type * coords_kw , ecl_kw_type * corners_kw, fortio_type * fortio) {
+static void ecl_cell_fwrite_GRID( const ecl_grid_type * grid , const ecl_cell_type * cell , const point_type * corner_list , bool fracture_cell , int coords_size , int i, int j , int k , int global_index , ecl_kw_type * coords_kw , ecl_kw_type * corners_kw, fortio_type * fortio) {
   ecl_kw_iset_int( coords_kw , 0 , i + 1);
   ecl_kw_iset_int( coords_kw , 1 , j + 1);
   ecl_kw_iset_int( coords_kw , 2 , k + 1);
@@ -852,7 +879,7 @@ static void ecl_cell_fwrite_GRID( const ecl_grid_type * grid , const ecl_cell_ty
     int c;
 
     for (c = 0; c < 8; c++) {
-      point_copy_values( &point , &cell->corner_list[c] );
+      point_copy_values( &point , &corner_list[c] );
       if (grid->use_mapaxes)
         point_mapaxes_invtransform( &point , grid->origo , grid->unit_x , grid->unit_y );
 
@@ -865,7 +892,7 @@ static void ecl_cell_fwrite_GRID( const ecl_grid_type * grid , const ecl_cell_ty
 }
 
 //static const size_t cellMappingECLRi[8] = { 0, 1, 3, 2, 4, 5, 7, 6 };
-static void ecl_cell_ri_export( const ecl_cell_type * cell , double * ri_points) {
+static void ecl_cell_ri_export( const point_type * corner_list , double * ri_points) {
   int ecl_offset = 4;
   int ri_offset =  ecl_offset * 3;
   {
@@ -873,14 +900,14 @@ static void ecl_cell_ri_export( const ecl_cell_type * cell , double * ri_points)
     // Handling the points 0,1 & 4,5 which map directly between ECLIPSE and RI
     for (point_nr =0; point_nr < 2; point_nr++) {
       // Points 0 & 1
-      ri_points[ point_nr * 3     ] =  cell->corner_list[point_nr].x;
-      ri_points[ point_nr * 3 + 1 ] =  cell->corner_list[point_nr].y;
-      ri_points[ point_nr * 3 + 2 ] = -cell->corner_list[point_nr].z;
+      ri_points[ point_nr * 3     ] =  corner_list[point_nr].x;
+      ri_points[ point_nr * 3 + 1 ] =  corner_list[point_nr].y;
+      ri_points[ point_nr * 3 + 2 ] = -corner_list[point_nr].z;
 
       // Points 4 & 5
-      ri_points[ ri_offset + point_nr * 3     ] =  cell->corner_list[ecl_offset + point_nr].x;
-      ri_points[ ri_offset + point_nr * 3 + 1 ] =  cell->corner_list[ecl_offset + point_nr].y;
-      ri_points[ ri_offset + point_nr * 3 + 2 ] = -cell->corner_list[ecl_offset + point_nr].z;
+      ri_points[ ri_offset + point_nr * 3     ] =  corner_list[ecl_offset + point_nr].x;
+      ri_points[ ri_offset + point_nr * 3 + 1 ] =  corner_list[ecl_offset + point_nr].y;
+      ri_points[ ri_offset + point_nr * 3 + 2 ] = -corner_list[ecl_offset + point_nr].z;
     }
   }
 
@@ -893,15 +920,15 @@ static void ecl_cell_ri_export( const ecl_cell_type * cell , double * ri_points)
     for (ecl_point =2; ecl_point < 4; ecl_point++) {
       int ri_point = 5 - ecl_point;
       // Points 2 & 3
-      ri_points[ ri_point * 3     ] =  cell->corner_list[ecl_point].x;
-      ri_points[ ri_point * 3 + 1 ] =  cell->corner_list[ecl_point].y;
-      ri_points[ ri_point * 3 + 2 ] = -cell->corner_list[ecl_point].z;
+      ri_points[ ri_point * 3     ] =  corner_list[ecl_point].x;
+      ri_points[ ri_point * 3 + 1 ] =  corner_list[ecl_point].y;
+      ri_points[ ri_point * 3 + 2 ] = -corner_list[ecl_point].z;
 
 
       // Points 6 & 7
-      ri_points[ ri_offset + ri_point * 3     ] =  cell->corner_list[ecl_offset + ecl_point].x;
-      ri_points[ ri_offset + ri_point * 3 + 1 ] =  cell->corner_list[ecl_offset + ecl_point].y;
-      ri_points[ ri_offset + ri_point * 3 + 2 ] = -cell->corner_list[ecl_offset + ecl_point].z;
+      ri_points[ ri_offset + ri_point * 3     ] =  corner_list[ecl_offset + ecl_point].x;
+      ri_points[ ri_offset + ri_point * 3 + 1 ] =  corner_list[ecl_offset + ecl_point].y;
+      ri_points[ ri_offset + ri_point * 3 + 2 ] = -corner_list[ecl_offset + ecl_point].z;
     }
   }
 }
@@ -936,12 +963,12 @@ static  double min8( double x1 , double x2 , double x3, double x4 , double x5 ,
 
 /*****************************************************************/
 
-static double ecl_cell_min_z( const ecl_cell_type * cell) {
-  return min4( cell->corner_list[0].z , cell->corner_list[1].z , cell->corner_list[2].z , cell->corner_list[3].z);
+static double ecl_cell_min_z( const point_type * corner_list) {
+  return min4( corner_list[0].z , corner_list[1].z , corner_list[2].z , corner_list[3].z);
 }
 
-static double ecl_cell_max_z( const ecl_cell_type * cell ) {
-  return max4( cell->corner_list[4].z , cell->corner_list[5].z , cell->corner_list[6].z , cell->corner_list[7].z );
+static double ecl_cell_max_z( const point_type * corner_list ) {
+  return max4( corner_list[4].z , corner_list[5].z , corner_list[6].z , corner_list[7].z );
 }
 
 
@@ -950,26 +977,26 @@ static double ecl_cell_max_z( const ecl_cell_type * cell ) {
    plane for the x/y min/max.
 */
 
-static double ecl_cell_min_x( const ecl_cell_type * cell) {
-  return min8( cell->corner_list[0].x , cell->corner_list[1].x , cell->corner_list[2].x , cell->corner_list[3].x,
-               cell->corner_list[4].x , cell->corner_list[5].x , cell->corner_list[6].x , cell->corner_list[7].x );
+static double ecl_cell_min_x( const point_type * corner_list) {
+  return min8( corner_list[0].x , corner_list[1].x , corner_list[2].x , corner_list[3].x,
+               corner_list[4].x , corner_list[5].x , corner_list[6].x , corner_list[7].x );
 }
 
 
-static double ecl_cell_max_x( const ecl_cell_type * cell ) {
-  return max8( cell->corner_list[0].x , cell->corner_list[1].x , cell->corner_list[2].x , cell->corner_list[3].x,
-               cell->corner_list[4].x , cell->corner_list[5].x , cell->corner_list[6].x , cell->corner_list[7].x );
+static double ecl_cell_max_x( const point_type * corner_list ) {
+  return max8( corner_list[0].x , corner_list[1].x , corner_list[2].x , corner_list[3].x,
+               corner_list[4].x , corner_list[5].x , corner_list[6].x , corner_list[7].x );
 }
 
-static double ecl_cell_min_y( const ecl_cell_type * cell) {
-  return min8( cell->corner_list[0].y , cell->corner_list[1].y , cell->corner_list[2].y , cell->corner_list[3].y,
-               cell->corner_list[4].y , cell->corner_list[5].y , cell->corner_list[6].y , cell->corner_list[7].y );
+static double ecl_cell_min_y( const point_type * corner_list) {
+  return min8( corner_list[0].y , corner_list[1].y , corner_list[2].y , corner_list[3].y,
+               corner_list[4].y , corner_list[5].y , corner_list[6].y , corner_list[7].y );
 }
 
 
-static double ecl_cell_max_y( const ecl_cell_type * cell ) {
-  return max8( cell->corner_list[0].y , cell->corner_list[1].y , cell->corner_list[2].y , cell->corner_list[3].y,
-               cell->corner_list[4].y , cell->corner_list[5].y , cell->corner_list[6].y , cell->corner_list[7].y );
+static double ecl_cell_max_y( const point_type * corner_list ) {
+  return max8( corner_list[0].y , corner_list[1].y , corner_list[2].y , corner_list[3].y,
+               corner_list[4].y , corner_list[5].y , corner_list[6].y , corner_list[7].y );
 }
 
 
@@ -1009,10 +1036,10 @@ static double ecl_cell_max_y( const ecl_cell_type * cell ) {
  */
 
 
-static void ecl_cell_taint_cell( ecl_cell_type * cell ) {
+static void ecl_cell_taint_cell( ecl_cell_type * cell , const point_type * corner_list ) {
   int c;
   for (c = 0; c < 8; c++) {
-    const point_type p = cell->corner_list[c];
+    const point_type p = corner_list[c];
     if ((p.x == 0) && (p.y == 0)) {
       SET_CELL_FLAG(cell , CELL_FLAG_TAINTED);
       break;
@@ -1024,10 +1051,10 @@ static void ecl_cell_taint_cell( ecl_cell_type * cell ) {
   */
   if (cell->active == CELL_NOT_ACTIVE) {
     if (!GET_CELL_FLAG(cell , CELL_FLAG_TAINTED)) {
-      const point_type p0 = cell->corner_list[0];
+      const point_type p0 = corner_list[0];
       int cell_index = 1;
       while (true) {
-        const point_type pi = cell->corner_list[cell_index];
+        const point_type pi = corner_list[cell_index];
         if (pi.z != p0.z)
           // There is a difference - the cell is certainly valid.
           break;
@@ -1047,12 +1074,12 @@ static void ecl_cell_taint_cell( ecl_cell_type * cell ) {
 
 
 
-static int ecl_cell_get_twist( const ecl_cell_type * cell ) {
+static int ecl_cell_get_twist( const point_type * corner_list ) {
   int twist_count = 0;
 
   for (int c = 0; c < 4; c++) {
-    const point_type * p1 = &cell->corner_list[c];
-    const point_type * p2 = &cell->corner_list[c + 4];
+    const point_type * p1 = &corner_list[c];
+    const point_type * p2 = &corner_list[c + 4];
     if ((p2->z - p1->z) < 0)
       twist_count += 1;
   }
@@ -1074,7 +1101,6 @@ static int ecl_cell_get_twist( const ecl_cell_type * cell ) {
 
 static void ecl_cell_init( ecl_cell_type * cell , bool init_valid) {
   cell->active                = CELL_NOT_ACTIVE;
-  cell->lgr                   = NULL;
   cell->host_cell             = HOST_CELL_NONE;
   cell->coarse_group          = COARSE_GROUP_NONE;
   cell->cell_flags            = 0;
@@ -1082,8 +1108,6 @@ static void ecl_cell_init( ecl_cell_type * cell , bool init_valid) {
   cell->active_index[FRACTURE_INDEX] = -1;
   if (init_valid)
     cell->cell_flags = CELL_FLAG_VALID;
-
-  cell->nnc_info = NULL;
 }
 
 
@@ -1095,23 +1119,19 @@ static int ecl_cell_get_tetrahedron_method( int i , int j , int k) {
 #undef mod
 */
 
-static void ecl_cell_set_center( ecl_cell_type * cell) {
-  point_set(&cell->center , 0 , 0 , 0);
+/*
+  The center is not stored; it is the plain average of the eight
+  corners and is calculated when needed.
+*/
+
+static void ecl_cell_get_center( const point_type * corner_list , point_type * center) {
+  point_set(center , 0 , 0 , 0);
   {
     int c;
     for (c = 0; c < 8; c++)
-      point_inplace_add(&cell->center , &cell->corner_list[c]);
+      point_inplace_add(center , &corner_list[c]);
   }
-  point_inplace_scale(&cell->center , 1.0 / 8.0);
-
-  SET_CELL_FLAG( cell , CELL_FLAG_CENTER );
-}
-
-
-
-static void ecl_cell_assert_center( ecl_cell_type * cell) {
-  if (!GET_CELL_FLAG(cell , CELL_FLAG_CENTER))
-    ecl_cell_set_center( cell );
+  point_inplace_scale(center , 1.0 / 8.0);
 }
 
 
@@ -1120,10 +1140,6 @@ static void ecl_cell_memcpy( ecl_cell_type * target_cell , const ecl_cell_type *
   memcpy( target_cell , src_cell , sizeof * target_cell );
 }
 
-static void ecl_cell_install_lgr( ecl_cell_type * cell , const ecl_grid_type * lgr_grid) {
-  cell->lgr       = lgr_grid;
-}
-
 static double C(double *r,int f1,int f2,int f3){
   if (f1 == 0) {
     if (f2 == 0) {
@@ -1153,7 +1169,7 @@ static double C(double *r,int f1,int f2,int f3){
 }
 
 
-static double ecl_cell_get_volume_tskille( ecl_cell_type * cell ) {
+static double ecl_cell_get_volume_tskille( const point_type * corner_list ) {
   double volume = 0;
   int pb,pg,qa,qg,ra,rb;
   double X[8];
@@ -1162,9 +1178,9 @@ static double ecl_cell_get_volume_tskille( ecl_cell_type * cell ) {
   {
     int c;
     for (c = 0; c < 8; c++) {
-      X[c] = cell->corner_list[c].x;
-      Y[c] = cell->corner_list[c].y;
-      Z[c] = cell->corner_list[c].z;
+      X[c] = corner_list[c].x;
+      Y[c] = corner_list[c].y;
+      Z[c] = corner_list[c].z;
     }
   }
 
@@ -1260,19 +1276,19 @@ static bool tetrahedron_contains(tetrahedron_type tet, const point_type p) {
  * when used in opm-parser and has been optimised significantly. This means
  * inlining several operations, e.g. vector operations, and other tricks.
  */
-static double ecl_cell_get_signed_volume( ecl_cell_type * cell) {
+static double ecl_cell_get_signed_volume( ecl_cell_type * cell , const point_type * corner_list) {
   if (GET_CELL_FLAG(cell , CELL_FLAG_VOLUME))
     return cell->volume;
 
-  ecl_cell_assert_center( cell );
   {
     /*
      * We make an activation record local copy of the cell's corners for less
      * jumping in memory and better cache performance.
      */
-    point_type center = cell->center;
+    point_type center;
     point_type corners[ 8 ];
-    memcpy( corners, cell->corner_list, sizeof( point_type ) * 8 );
+    memcpy( corners, corner_list, sizeof( point_type ) * 8 );
+    ecl_cell_get_center( corners , &center );
 
     tetrahedron_type tet = { .p0 = center };
     double           volume = 0;
@@ -1323,8 +1339,8 @@ static double ecl_cell_get_signed_volume( ecl_cell_type * cell) {
 }
 
 
-static double ecl_cell_get_volume( ecl_cell_type * cell ) {
-  return fabs( ecl_cell_get_signed_volume(cell));
+static double ecl_cell_get_volume( ecl_cell_type * cell , const point_type * corner_list ) {
+  return fabs( ecl_cell_get_signed_volume(cell , corner_list));
 }
 
 
@@ -1425,7 +1441,7 @@ static bool triangle_contains3d(const point_type *p0 , const point_type * p1 , c
 */
 
 
-static bool ecl_cell_layer_contains_xy( const ecl_cell_type * cell , bool lower_layer , double x , double y) {
+static bool ecl_cell_layer_contains_xy( const ecl_cell_type * cell , const point_type * corner_list , bool lower_layer , double x , double y) {
   if (GET_CELL_FLAG(cell,CELL_FLAG_TAINTED))
     return false;
   {
@@ -1437,10 +1453,10 @@ static bool ecl_cell_layer_contains_xy( const ecl_cell_type * cell , bool lower_
       else
         corner_offset = 4;
 
-      p0 = &cell->corner_list[corner_offset + 0];
-      p1 = &cell->corner_list[corner_offset + 1];
-      p2 = &cell->corner_list[corner_offset + 2];
-      p3 = &cell->corner_list[corner_offset + 3];
+      p0 = &corner_list[corner_offset + 0];
+      p1 = &corner_list[corner_offset + 1];
+      p2 = &corner_list[corner_offset + 2];
+      p3 = &corner_list[corner_offset + 3];
     }
 
     if (triangle_contains(p0,p1,p2,x,y))
@@ -1459,23 +1475,23 @@ static bool ecl_cell_layer_contains_xy( const ecl_cell_type * cell , bool lower_
          |   |           |   |
          0---1           4---5
 */
-static void ecl_cell_init_regular( ecl_cell_type * cell , const double * offset , int i , int j , int k , int global_index , const double * ivec , const double * jvec , const double * kvec , const int * actnum ) {
-  point_set(&cell->corner_list[0] , offset[0] , offset[1] , offset[2] ); // Point 0
+static void ecl_cell_init_regular( ecl_cell_type * cell , point_type * corner_list , const double * offset , int i , int j , int k , int global_index , const double * ivec , const double * jvec , const double * kvec , const int * actnum ) {
+  point_set(&corner_list[0] , offset[0] , offset[1] , offset[2] ); // Point 0
 
-  cell->corner_list[1] = cell->corner_list[0];                       // Point 1
-  point_shift(&cell->corner_list[1] , ivec[0] , ivec[1] , ivec[2]);
+  corner_list[1] = corner_list[0];                       // Point 1
+  point_shift(&corner_list[1] , ivec[0] , ivec[1] , ivec[2]);
 
-  cell->corner_list[2] = cell->corner_list[0];                       // Point 2
-  point_shift(&cell->corner_list[2] , jvec[0] , jvec[1] , jvec[2]);
+  corner_list[2] = corner_list[0];                       // Point 2
+  point_shift(&corner_list[2] , jvec[0] , jvec[1] , jvec[2]);
 
-  cell->corner_list[3] = cell->corner_list[1];                       // Point 3
-  point_shift(&cell->corner_list[3] , jvec[0] , jvec[1] , jvec[2]);
+  corner_list[3] = corner_list[1];                       // Point 3
+  point_shift(&corner_list[3] , jvec[0] , jvec[1] , jvec[2]);
 
   {
     int i;
     for (i=0; i < 4; i++) {
-      cell->corner_list[i+4] = cell->corner_list[i];                      // Point 4-7
-      point_shift(&cell->corner_list[i+4] , kvec[0] , kvec[1] , kvec[2]);
+      corner_list[i+4] = corner_list[i];                      // Point 4-7
+      point_shift(&corner_list[i+4] , kvec[0] , kvec[1] , kvec[2]);
     }
   }
 
@@ -1503,32 +1519,279 @@ static ecl_cell_type * ecl_grid_get_cell(const ecl_grid_type * grid , int global
 }
 
 
+/*
+  Cell storage
+  ------------
+
+  The cell information is stored as a structure of arrays in the grid
+  instance:
+
+    cells: The small ecl_cell structs with the per cell metadata;
+       active status, active index, host cell, coarse group, flags and
+       the cached volume.
+
+    corners / compact_corners: The eight corner points of every
+       cell. For an ordinary grid the corners are stored as point_type
+       instances with double precision in the corners array. For a
+       grid loaded with ecl_grid_alloc_compact() the corners are
+       stored in the compact_corners array as 24 float values per
+       cell, relative to the compact_origin point of the grid. This
+       roughly halves the memory footprint of the grid.
+
+       The origin is taken from the first pillar, or the first cell,
+       of the main grid, after the mapaxes transformation; the lgrs
+       share the origin of the main grid. With
+       absolute coordinates the float resolution at UTM northings of
+       ~7e6 would be ~0.5 m; relative to the origin the rounding
+       error is bounded by 2^-24 (~6e-8) times the distance from the
+       origin, i.e. below 1 mm for a field extending 10 km from the
+       origin. That is in addition to the single precision of the
+       COORD/ZCORN and CORNERS keywords themselves.
+
+       For a grid loaded from a cache file the cells and
+       compact_corners arrays point into the (private) mapping of the
+       cache file, which is owned by the main grid; see the grid cache
+       further down.
+
+    cell_lgr / cell_nnc_info: Only a small fraction of the cells are
+       refined by an lgr or have nnc connections; these arrays are
+       allocated when the first lgr or nnc is installed.
+
+  The corners should always be accessed with the
+  ecl_grid_get_cell_corners() and ecl_grid_set_cell_corners()
+  functions.
+*/
+
+#define CELL_CORNER_FLOATS 24
+
+/*
+  Will return a pointer to the eight corners of cell @global_index. For
+  compact grids the corners are converted to double precision and
+  stored in @buffer, which must have room for eight points, and the
+  returned pointer will point to @buffer.
+*/
+
+static const point_type * ecl_grid_get_cell_corners( const ecl_grid_type * grid , int global_index , point_type * buffer) {
+  if (grid->compact) {
+    const float * src = &grid->compact_corners[ (size_t) global_index * CELL_CORNER_FLOATS ];
+    const point_type * origin = &grid->compact_origin;
+    int c;
+    for (c = 0; c < 8; c++)
+      point_set( &buffer[c] , origin->x + src[3*c] , origin->y + src[3*c + 1] , origin->z + src[3*c + 2]);
+    return buffer;
+  } else
+    return &grid->corners[ global_index * 8 ];
+}
+
+
+static void ecl_grid_set_cell_corners( ecl_grid_type * grid , int global_index , const point_type * corner_list) {
+  if (grid->compact) {
+    float * target = &grid->compact_corners[ (size_t) global_index * CELL_CORNER_FLOATS ];
+    const point_type * origin = &grid->compact_origin;
+    int c;
+    for (c = 0; c < 8; c++) {
+      target[3*c]     = corner_list[c].x - origin->x;
+      target[3*c + 1] = corner_list[c].y - origin->y;
+      target[3*c + 2] = corner_list[c].z - origin->z;
+    }
+  } else
+    memcpy( &grid->corners[ global_index * 8 ] , corner_list , 8 * sizeof * corner_list );
+}
+
+
+/*
+  Sets the origin of the compact corners to the point (x,y,z) in the
+  grid file, i.e. before the mapaxes transformation. Must be called
+  before the first corner is set. Only called for the main grid; an
+  lgr gets a copy of the main grid origin in ecl_grid_alloc_empty().
+*/
+
+static void ecl_grid_set_compact_origin( ecl_grid_type * grid , double x , double y , double z) {
+  point_set( &grid->compact_origin , x , y , z );
+  if (grid->use_mapaxes)
+    point_mapaxes_transform( &grid->compact_origin , grid->origo , grid->unit_x , grid->unit_y );
+}
+
+
+static void ecl_grid_get_cell_center( const ecl_grid_type * grid , int global_index , point_type * center) {
+  point_type buffer[8];
+  ecl_cell_get_center( ecl_grid_get_cell_corners( grid , global_index , buffer ) , center );
+}
+
+
+static nnc_info_type * ecl_grid_get_cell_nnc_info__( const ecl_grid_type * grid , int global_index ) {
+  if (grid->cell_nnc_info)
+    return grid->cell_nnc_info[ global_index ];
+  else
+    return NULL;
+}
+
+
+static const ecl_grid_type * ecl_grid_get_cell_lgr__( const ecl_grid_type * grid , int global_index ) {
+  if (grid->cell_lgr)
+    return grid->cell_lgr[ global_index ];
+  else
+    return NULL;
+}
+
+
+static void ecl_grid_install_cell_lgr( ecl_grid_type * grid , int global_index , const ecl_grid_type * lgr_grid) {
+  if (!grid->cell_lgr) {
+    grid->cell_lgr = util_calloc( grid->size , sizeof * grid->cell_lgr );
+    for (int i=0; i < grid->size; i++)
+      grid->cell_lgr[i] = NULL;
+  }
+
+  grid->cell_lgr[ global_index ] = lgr_grid;
+}
+
+
+/*
+  Parallel initialization
+  -----------------------
+
+  The per cell work when a grid is created - the corner calculations
+  from COORD/ZCORN, the active index and index maps and the tainting
+  - can be split in consecutive ranges which are processed on a
+  thread pool. Every range only writes to the cells in its own range,
+  and the ranges are combined in order, so the result is identical to
+  the serial initialization.
+
+  The number of threads is a process wide setting controlled with
+  ecl_grid_set_init_threads(); the default is one thread, i.e. serial
+  initialization. Small grids, like most lgrs, are always initialized
+  serially.
+*/
+
+#define ECL_GRID_MIN_RANGE_SIZE 16384
+
+static int ecl_grid_init_threads = 1;
+
+void ecl_grid_set_init_threads( int num_threads ) {
+  ecl_grid_init_threads = util_int_max( 1 , num_threads );
+}
+
+
+int ecl_grid_get_init_threads( void ) {
+  return ecl_grid_init_threads;
+}
+
+
+typedef void (ecl_grid_range_ftype) ( ecl_grid_type * grid , int range_nr , int index1 , int index2 , void * arg);
+
+typedef struct {
+  ecl_grid_range_ftype * func;
+  ecl_grid_type        * grid;
+  void                 * arg;
+  int                    range_nr;
+  int                    index1;
+  int                    index2;
+} ecl_grid_range_job_type;
+
+
+/*
+  Will return the number of ranges [0,size) should be split in; every
+  range should have at least @min_range_size elements.
+*/
+
+static int ecl_grid_get_num_ranges( int size , int min_range_size ) {
+#ifdef ERT_HAVE_THREAD_POOL
+  return util_int_max( 1 , util_int_min( ecl_grid_init_threads , size / min_range_size ));
+#else
+  return 1;
+#endif
+}
+
+
+#ifdef ERT_HAVE_THREAD_POOL
+static void * ecl_grid_range_job__( void * arg ) {
+  ecl_grid_range_job_type * job = arg;
+  job->func( job->grid , job->range_nr , job->index1 , job->index2 , job->arg );
+  return NULL;
+}
+#endif
+
+
+static void ecl_grid_run_ranges( ecl_grid_type * grid , int size , int num_ranges , ecl_grid_range_ftype * func , void * arg) {
+#ifdef ERT_HAVE_THREAD_POOL
+  if (num_ranges > 1) {
+    ecl_grid_range_job_type * jobs = util_calloc( num_ranges , sizeof * jobs );
+    thread_pool_type * tp = thread_pool_alloc( num_ranges , true );
+    int range_nr;
+
+    for (range_nr = 0; range_nr < num_ranges; range_nr++) {
+      ecl_grid_range_job_type * job = &jobs[range_nr];
+      job->func     = func;
+      job->grid     = grid;
+      job->arg      = arg;
+      job->range_nr = range_nr;
+      job->index1   = (int) (((int64_t) range_nr * size) / num_ranges);
+      job->index2   = (int) (((int64_t) (range_nr + 1) * size) / num_ranges);
+      thread_pool_add_job( tp , ecl_grid_range_job__ , job );
+    }
+    thread_pool_join( tp );
+    thread_pool_free( tp );
+    free( jobs );
+    return;
+  }
+#endif
+  func( grid , 0 , 0 , size , arg );
+}
+
+
 /**
    this function uses heuristics (ahhh - i hate it) in an attempt to
    mark cells with fucked geometry - see further comments in the
    function ecl_cell_taint_cell() which actually does it.
+
+   When the grid is initialized with more than one thread the cell
+   volumes are calculated in the same pass, instead of lazily on first
+   access.
 */
 
-static void ecl_grid_taint_cells( ecl_grid_type * ecl_grid ) {
+static void ecl_grid_taint_cells__( ecl_grid_type * ecl_grid , int range_nr , int index1 , int index2 , void * arg) {
+  const bool * init_volume = arg;
   int index;
-  for (index = 0; index < ecl_grid->size; index++) {
+  point_type buffer[8];
+  for (index = index1; index < index2; index++) {
     ecl_cell_type * cell = ecl_grid_get_cell( ecl_grid , index );
-    ecl_cell_taint_cell( cell );
+    const point_type * corner_list = ecl_grid_get_cell_corners( ecl_grid , index , buffer );
+    ecl_cell_taint_cell( cell , corner_list );
+    if (*init_volume)
+      ecl_cell_get_signed_volume( cell , corner_list );
   }
 }
 
 
-static void ecl_grid_free_cells( ecl_grid_type * grid ) {
-  if (!grid->cells)
-    return;
+static void ecl_grid_taint_cells( ecl_grid_type * ecl_grid ) {
+  int num_ranges = ecl_grid_get_num_ranges( ecl_grid->size , ECL_GRID_MIN_RANGE_SIZE );
+  bool init_volume = (num_ranges > 1);
+  ecl_grid_run_ranges( ecl_grid , ecl_grid->size , num_ranges , ecl_grid_taint_cells__ , &init_volume );
+}
 
-  for (int i=0; i < grid->size; i++) {
-    ecl_cell_type * cell = ecl_grid_get_cell( grid , i );
-    if (cell->nnc_info)
-      nnc_info_free(cell->nnc_info);
+
+static void ecl_grid_assert_not_frozen( const ecl_grid_type * grid , const char * caller) {
+  if (grid->frozen)
+    util_abort("%s: the grid:%s is frozen and can not be modified\n", caller , grid->name);
+}
+
+
+static void ecl_grid_free_cells( ecl_grid_type * grid ) {
+  if (grid->cell_nnc_info) {
+    for (int i=0; i < grid->size; i++) {
+      nnc_info_type * nnc_info = grid->cell_nnc_info[i];
+      if (nnc_info)
+        nnc_info_free(nnc_info);
+    }
+    free( grid->cell_nnc_info );
   }
-  free( grid->cells );
 
+  util_safe_free( grid->cell_lgr );
+  util_safe_free( grid->corners );
+  if (!grid->cells_mapped) {
+    util_safe_free( grid->compact_corners );
+    util_safe_free( grid->cells );
+  }
 }
 
 static bool ecl_grid_alloc_cells( ecl_grid_type * grid , bool init_valid) {
@@ -1536,6 +1799,16 @@ static bool ecl_grid_alloc_cells( ecl_grid_type * grid , bool init_valid) {
   if (!grid->cells)
     return false;
 
+  if (grid->compact) {
+    grid->compact_corners = calloc( (size_t) grid->size * CELL_CORNER_FLOATS , sizeof * grid->compact_corners );
+    if (!grid->compact_corners)
+      return false;
+  } else {
+    grid->corners = calloc( (size_t) grid->size * 8 , sizeof * grid->corners );
+    if (!grid->corners)
+      return false;
+  }
+
   {
     ecl_cell_type * cell0 = ecl_grid_get_cell( grid , 0 );
     ecl_cell_init( cell0 , init_valid );
@@ -1556,9 +1829,14 @@ static bool ecl_grid_alloc_cells( ecl_grid_type * grid , bool init_valid) {
    transformations; and set the global_grid pointer of the new grid
    instance. apart from that no further lgr-relationsip initialisation
    is performed.
+
+   lgr instances inherit the compact setting from the global grid;
+   the @compact argument is only used for the main grid. If
+   @alloc_cells is false the cells and corners are not allocated,
+   and must be installed by the calling scope.
 */
 
-static ecl_grid_type * ecl_grid_alloc_empty(ecl_grid_type * global_grid , int dualp_flag , int nx , int ny , int nz, int lgr_nr, bool init_valid) {
+static ecl_grid_type * ecl_grid_alloc_empty__(ecl_grid_type * global_grid , int dualp_flag , int nx , int ny , int nz, int lgr_nr, bool init_valid, bool compact, bool alloc_cells) {
   ecl_grid_type * grid = util_malloc(sizeof * grid );
   UTIL_TYPE_ID_INIT(grid , ECL_GRID_ID);
   grid->total_active   = 0;
@@ -1574,13 +1852,26 @@ static ecl_grid_type * ecl_grid_alloc_empty(ecl_grid_type * global_grid , int du
 
   grid->dualp_flag            = dualp_flag;
   grid->coord_kw              = NULL;
-  grid->visited               = NULL;
+  grid->search_index          = NULL;
   grid->inv_index_map         = NULL;
   grid->index_map             = NULL;
   grid->fracture_index_map    = NULL;
   grid->inv_fracture_index_map = NULL;
   grid->unit_system            = ECL_METRIC_UNITS;
-
+  grid->cells                  = NULL;
+  grid->corners                = NULL;
+  grid->compact_corners        = NULL;
+  grid->cell_lgr               = NULL;
+  grid->cell_nnc_info          = NULL;
+  grid->cells_mapped           = false;
+  grid->cache_data             = NULL;
+  grid->cache_size             = 0;
+  grid->compact                = global_grid ? global_grid->compact : compact;
+  if (global_grid)
+    grid->compact_origin = global_grid->compact_origin;
+  else
+    point_set( &grid->compact_origin , 0 , 0 , 0 );
+  grid->frozen                 = false;
 
   if (global_grid != NULL) {
     /*
@@ -1625,7 +1916,7 @@ static ecl_grid_type * ecl_grid_alloc_empty(ecl_grid_type * global_grid , int du
   grid->eclipse_version = 0;
 
   /* This is the large allocation - which can potentially fail. */
-  if (!ecl_grid_alloc_cells( grid , init_valid )) {
+  if (alloc_cells && !ecl_grid_alloc_cells( grid , init_valid )) {
     ecl_grid_free( grid );
     grid = NULL;
   }
@@ -1633,6 +1924,11 @@ static ecl_grid_type * ecl_grid_alloc_empty(ecl_grid_type * global_grid , int du
 }
 
 
+static ecl_grid_type * ecl_grid_alloc_empty(ecl_grid_type * global_grid , int dualp_flag , int nx , int ny , int nz, int lgr_nr, bool init_valid, bool compact) {
+  return ecl_grid_alloc_empty__( global_grid , dualp_flag , nx , ny , nz , lgr_nr , init_valid , compact , true );
+}
+
+
 
 
 static  int ecl_grid_get_global_index__(const ecl_grid_type * ecl_grid , int i , int j , int k) {
@@ -1646,17 +1942,19 @@ static void ecl_grid_set_cell_EGRID(ecl_grid_type * ecl_grid , int i, int j , in
 
   const int global_index   = ecl_grid_get_global_index__(ecl_grid , i , j  , k );
   ecl_cell_type * cell     = ecl_grid_get_cell( ecl_grid , global_index );
+  point_type corner_list[8];
   int ip , iz;
 
   for (iz = 0; iz < 2; iz++) {
     for (ip = 0; ip < 4; ip++) {
       int c = ip + iz * 4;
-      point_set(&cell->corner_list[c] , x[ip][iz] , y[ip][iz] , z[ip][iz]);
+      point_set(&corner_list[c] , x[ip][iz] , y[ip][iz] , z[ip][iz]);
 
       if (ecl_grid->use_mapaxes)
-        point_mapaxes_transform( &cell->corner_list[c] , ecl_grid->origo , ecl_grid->unit_x , ecl_grid->unit_y );
+        point_mapaxes_transform( &corner_list[c] , ecl_grid->origo , ecl_grid->unit_x , ecl_grid->unit_y );
     }
   }
+  ecl_grid_set_cell_corners( ecl_grid , global_index , corner_list );
 
 
 
@@ -1757,13 +2055,15 @@ static void ecl_grid_set_cell_GRID(ecl_grid_type * ecl_grid , int coords_size ,
     }
 
     if (matrix_cell) {
+      point_type corner_list[8];
       for (c = 0; c < 8; c++) {
-        point_set(&cell->corner_list[c] , corners[3*c] , corners[3*c + 1] , corners[3*c + 2]);
+        point_set(&corner_list[c] , corners[3*c] , corners[3*c + 1] , corners[3*c + 2]);
 
         if (ecl_grid->use_mapaxes)
-          point_mapaxes_transform( &cell->corner_list[c] , ecl_grid->origo , ecl_grid->unit_x , ecl_grid->unit_y );
+          point_mapaxes_transform( &corner_list[c] , ecl_grid->origo , ecl_grid->unit_x , ecl_grid->unit_y );
 
       }
+      ecl_grid_set_cell_corners( ecl_grid , global_index , corner_list );
     }
   }
   SET_CELL_FLAG(cell , CELL_FLAG_VALID );
@@ -1776,21 +2076,38 @@ static void ecl_grid_set_cell_GRID(ecl_grid_type * ecl_grid , int coords_size ,
    ecl_grid->total_active is correct.
 */
 
-static void ecl_grid_init_index_map__( ecl_grid_type * ecl_grid , int * index_map , int * inv_index_map , int active_mask, int type_index) {
+typedef struct {
+  int * index_map;
+  int * inv_index_map;
+  int   active_mask;
+  int   type_index;
+} index_map_arg_type;
+
+
+static void ecl_grid_init_index_map_range( ecl_grid_type * ecl_grid , int range_nr , int index1 , int index2 , void * arg) {
+  const index_map_arg_type * map_arg = arg;
+  int * index_map = map_arg->index_map;
+  int * inv_index_map = map_arg->inv_index_map;
   int global_index;
 
-  for (global_index = 0; global_index < ecl_grid->size; global_index++) {
+  for (global_index = index1; global_index < index2; global_index++) {
     const ecl_cell_type * cell = ecl_grid_get_cell( ecl_grid , global_index);
-    if (cell->active & active_mask) {
-      index_map[global_index] = cell->active_index[type_index];
+    if (cell->active & map_arg->active_mask) {
+      index_map[global_index] = cell->active_index[map_arg->type_index];
 
       if (cell->coarse_group == COARSE_GROUP_NONE)
-        inv_index_map[cell->active_index[type_index]] = global_index;
+        inv_index_map[cell->active_index[map_arg->type_index]] = global_index;
       //else: In the case of coarse groups the inv_index_map is set below.
     } else
       index_map[global_index] = -1;
   }
+}
+
 
+static void ecl_grid_init_index_map__( ecl_grid_type * ecl_grid , int * index_map , int * inv_index_map , int active_mask, int type_index) {
+  index_map_arg_type map_arg = { index_map , inv_index_map , active_mask , type_index };
+  int num_ranges = ecl_grid_get_num_ranges( ecl_grid->size , ECL_GRID_MIN_RANGE_SIZE );
+  ecl_grid_run_ranges( ecl_grid , ecl_grid->size , num_ranges , ecl_grid_init_index_map_range , &map_arg );
 }
 
 
@@ -1851,6 +2168,50 @@ static void ecl_grid_realloc_index_map(ecl_grid_type * ecl_grid) {
 
 
 
+/*
+  The active index of the cells without coarse groups is set in two
+  passes over the ranges: first the number of active cells in each
+  range is counted, and then the active index is assigned starting
+  from the number of active cells in the preceeding ranges.
+*/
+
+typedef struct {
+  bool   dualp;
+  bool   assign;
+  int  * matrix_offset;
+  int  * fracture_offset;
+} active_index_arg_type;
+
+
+static void ecl_grid_set_active_index_range( ecl_grid_type * ecl_grid , int range_nr , int index1 , int index2 , void * arg) {
+  active_index_arg_type * active_arg = arg;
+  int active_index = active_arg->matrix_offset[range_nr];
+  int active_fracture_index = active_arg->fracture_offset[range_nr];
+  int global_index;
+
+  for (global_index = index1; global_index < index2; global_index++) {
+    ecl_cell_type * cell = ecl_grid_get_cell( ecl_grid , global_index);
+
+    if (cell->active & CELL_ACTIVE_MATRIX) {
+      if (active_arg->assign)
+        cell->active_index[MATRIX_INDEX] = active_index;
+      active_index++;
+    }
+
+    if (active_arg->dualp && (cell->active & CELL_ACTIVE_FRACTURE)) {
+      if (active_arg->assign)
+        cell->active_index[FRACTURE_INDEX] = active_fracture_index;
+      active_fracture_index++;
+    }
+  }
+
+  if (!active_arg->assign) {
+    active_arg->matrix_offset[range_nr] = active_index;
+    active_arg->fracture_offset[range_nr] = active_fracture_index;
+  }
+}
+
+
 /*
   This function goes through the entire grid and sets the active_index
   of all the cells. The functione ecl_grid_realloc_index_map()
@@ -1865,26 +2226,44 @@ static void ecl_grid_set_active_index(ecl_grid_type * ecl_grid) {
   if (!ecl_grid_have_coarse_cells( ecl_grid )) {
     /* Keeping a fast path for the 99% most common case of no coarse
        groups and single porosity. */
-    {
-      for (global_index = 0; global_index < ecl_grid->size; global_index++) {
-        ecl_cell_type * cell = ecl_grid_get_cell( ecl_grid , global_index);
-
-        if (cell->active & CELL_ACTIVE_MATRIX) {
-          cell->active_index[MATRIX_INDEX] = active_index;
-          active_index++;
-        }
-      }
+    int num_ranges = ecl_grid_get_num_ranges( ecl_grid->size , ECL_GRID_MIN_RANGE_SIZE );
+    active_index_arg_type active_arg;
+    int range_nr;
+
+    active_arg.dualp           = (ecl_grid->dualp_flag != FILEHEAD_SINGLE_POROSITY);
+    active_arg.matrix_offset   = util_calloc( num_ranges , sizeof * active_arg.matrix_offset );
+    active_arg.fracture_offset = util_calloc( num_ranges , sizeof * active_arg.fracture_offset );
+    for (range_nr = 0; range_nr < num_ranges; range_nr++) {
+      active_arg.matrix_offset[range_nr] = 0;
+      active_arg.fracture_offset[range_nr] = 0;
     }
 
-    if (ecl_grid->dualp_flag != FILEHEAD_SINGLE_POROSITY) {
-      for (global_index = 0; global_index < ecl_grid->size; global_index++) {
-        ecl_cell_type * cell = ecl_grid_get_cell( ecl_grid , global_index);
-        if (cell->active & CELL_ACTIVE_FRACTURE) {
-          cell->active_index[FRACTURE_INDEX] = active_fracture_index;
-          active_fracture_index++;
-        }
+    if (num_ranges > 1) {
+      active_arg.assign = false;
+      ecl_grid_run_ranges( ecl_grid , ecl_grid->size , num_ranges , ecl_grid_set_active_index_range , &active_arg );
+      for (range_nr = 0; range_nr < num_ranges; range_nr++) {
+        int matrix_count = active_arg.matrix_offset[range_nr];
+        int fracture_count = active_arg.fracture_offset[range_nr];
+
+        active_arg.matrix_offset[range_nr] = active_index;
+        active_arg.fracture_offset[range_nr] = active_fracture_index;
+        active_index += matrix_count;
+        active_fracture_index += fracture_count;
       }
+    } else {
+      active_arg.assign = false;
+      ecl_grid_set_active_index_range( ecl_grid , 0 , 0 , ecl_grid->size , &active_arg );
+      active_index = active_arg.matrix_offset[0];
+      active_fracture_index = active_arg.fracture_offset[0];
+      active_arg.matrix_offset[0] = 0;
+      active_arg.fracture_offset[0] = 0;
     }
+
+    active_arg.assign = true;
+    ecl_grid_run_ranges( ecl_grid , ecl_grid->size , num_ranges , ecl_grid_set_active_index_range , &active_arg );
+
+    free( active_arg.matrix_offset );
+    free( active_arg.fracture_offset );
   } else {
     /* --- More involved path in the case of coarsening groups. --- */
 
@@ -2142,9 +2521,8 @@ static void ecl_grid_install_lgr_EGRID(ecl_grid_type * host_grid , ecl_grid_type
   for (global_lgr_index = 0; global_lgr_index < lgr_grid->size; global_lgr_index++) {
     int host_index = hostnum[ global_lgr_index ] - 1;
     ecl_cell_type * lgr_cell  = ecl_grid_get_cell( lgr_grid , global_lgr_index);
-    ecl_cell_type * host_cell = ecl_grid_get_cell( host_grid ,  host_index );
 
-    ecl_cell_install_lgr( host_cell , lgr_grid );
+    ecl_grid_install_cell_lgr( host_grid , host_index , lgr_grid );
     lgr_cell->host_cell = host_index;
   }
   ecl_grid_install_lgr_common( host_grid , lgr_grid );
@@ -2159,8 +2537,7 @@ static void ecl_grid_install_lgr_GRID(ecl_grid_type * host_grid , ecl_grid_type
 
   for (global_lgr_index = 0; global_lgr_index < lgr_grid->size; global_lgr_index++) {
     ecl_cell_type * lgr_cell = ecl_grid_get_cell( lgr_grid , global_lgr_index);
-    ecl_cell_type * host_cell = ecl_grid_get_cell( host_grid , lgr_cell->host_cell );
-    ecl_cell_install_lgr( host_cell , lgr_grid );
+    ecl_grid_install_cell_lgr( host_grid , lgr_cell->host_cell , lgr_grid );
   }
   ecl_grid_install_lgr_common( host_grid , lgr_grid );
 }
@@ -2316,12 +2693,29 @@ static void ecl_grid_init_GRDECL_data_jslice(ecl_grid_type * ecl_grid ,  const f
 }
 
 
+typedef struct {
+  const float * zcorn;
+  const float * coord;
+  const int   * actnum;
+  const int   * corsnum;
+} GRDECL_data_arg_type;
+
+
+static void ecl_grid_init_GRDECL_data_range( ecl_grid_type * ecl_grid , int range_nr , int j1 , int j2 , void * arg) {
+  const GRDECL_data_arg_type * data = arg;
+  int j;
+  for (j = j1; j < j2; j++)
+    ecl_grid_init_GRDECL_data_jslice( ecl_grid , data->zcorn , data->coord , data->actnum , data->corsnum , j );
+}
+
+
 void ecl_grid_init_GRDECL_data(ecl_grid_type * ecl_grid ,  const float * zcorn , const float * coord , const int * actnum, const int * corsnum) {
+  GRDECL_data_arg_type data = { zcorn , coord , actnum , corsnum };
   const int ny = ecl_grid->ny;
-  int j;
-#pragma omp parallel for
-  for ( j=0; j < ny; j++)
-    ecl_grid_init_GRDECL_data_jslice( ecl_grid , zcorn, coord , actnum , corsnum , j );
+  const int slice_size = util_int_max( 1 , ecl_grid->nx * ecl_grid->nz );
+  int num_ranges = ecl_grid_get_num_ranges( ny , 1 + ECL_GRID_MIN_RANGE_SIZE / slice_size );
+
+  ecl_grid_run_ranges( ecl_grid , ny , num_ranges , ecl_grid_init_GRDECL_data_range , &data );
 }
 
 
@@ -2335,9 +2729,9 @@ void ecl_grid_init_GRDECL_data(ecl_grid_type * ecl_grid ,  const float * zcorn ,
 static ecl_grid_type * ecl_grid_alloc_GRDECL_data__(ecl_grid_type * global_grid ,
                                                     int dualp_flag , bool apply_mapaxes, int nx , int ny , int nz ,
                                                     const float * zcorn , const float * coord , const int * actnum, const float * mapaxes, const int * corsnum,
-                                                    int lgr_nr) {
+                                                    int lgr_nr, bool compact) {
 
-  ecl_grid_type * ecl_grid = ecl_grid_alloc_empty(global_grid , dualp_flag , nx,ny,nz,lgr_nr,true);
+  ecl_grid_type * ecl_grid = ecl_grid_alloc_empty(global_grid , dualp_flag , nx,ny,nz,lgr_nr,true,compact);
   if (ecl_grid) {
     if (mapaxes != NULL)
       ecl_grid_init_mapaxes( ecl_grid , apply_mapaxes, mapaxes );
@@ -2345,6 +2739,9 @@ static ecl_grid_type * ecl_grid_alloc_GRDECL_data__(ecl_grid_type * global_grid
     if (corsnum != NULL)
       ecl_grid->coarsening_active = true;
 
+    if (ecl_grid->compact && (global_grid == NULL))
+      ecl_grid_set_compact_origin( ecl_grid , coord[0] , coord[1] , coord[2] );
+
     ecl_grid->coord_kw = ecl_kw_alloc_new("COORD" , 6*(nx + 1) * (ny + 1) , ECL_FLOAT , coord );
     ecl_grid_init_GRDECL_data( ecl_grid , zcorn , coord , actnum , corsnum);
 
@@ -2378,8 +2775,23 @@ static void ecl_grid_copy_content( ecl_grid_type * target_grid , const ecl_grid_
     const ecl_cell_type * src_cell = ecl_grid_get_cell( src_grid , global_index );
 
     ecl_cell_memcpy( target_cell , src_cell );
-    if (src_cell->nnc_info)
-      target_cell->nnc_info = nnc_info_alloc_copy( src_cell->nnc_info );
+  }
+
+  target_grid->compact_origin = src_grid->compact_origin;
+  if (src_grid->compact)
+    memcpy( target_grid->compact_corners , src_grid->compact_corners , (size_t) src_grid->size * CELL_CORNER_FLOATS * sizeof * src_grid->compact_corners );
+  else
+    memcpy( target_grid->corners , src_grid->corners , (size_t) src_grid->size * 8 * sizeof * src_grid->corners );
+
+  if (src_grid->cell_nnc_info) {
+    target_grid->cell_nnc_info = util_calloc( src_grid->size , sizeof * target_grid->cell_nnc_info );
+    for (global_index = 0; global_index < src_grid->size; global_index++) {
+      const nnc_info_type * nnc_info = src_grid->cell_nnc_info[ global_index ];
+      if (nnc_info)
+        target_grid->cell_nnc_info[ global_index ] = nnc_info_alloc_copy( nnc_info );
+      else
+        target_grid->cell_nnc_info[ global_index ] = NULL;
+    }
   }
   ecl_grid_copy_mapaxes( target_grid , src_grid );
 
@@ -2397,7 +2809,8 @@ static ecl_grid_type * ecl_grid_alloc_copy__( const ecl_grid_type * src_grid,  e
                                                     ecl_grid_get_ny( src_grid ) ,
                                                     ecl_grid_get_nz( src_grid ) ,
                                                     0 ,
-                                                    false );
+                                                    false ,
+                                                    src_grid->compact );
   if (copy_grid) {
     ecl_grid_copy_content( copy_grid , src_grid );  // This will handle everything except LGR relationships which is established in the calling routine
     ecl_grid_update_index( copy_grid );
@@ -2429,9 +2842,8 @@ ecl_grid_type * ecl_grid_alloc_copy( const ecl_grid_type * src_grid ) {
 
         for (global_lgr_index = 0; global_lgr_index < copy_lgr->size; global_lgr_index++) {
           ecl_cell_type * lgr_cell  = ecl_grid_get_cell( copy_lgr , global_lgr_index);
-          ecl_cell_type * host_cell = ecl_grid_get_cell( host_grid , lgr_cell->host_cell );
 
-          ecl_cell_install_lgr( host_cell , copy_lgr );
+          ecl_grid_install_cell_lgr( host_grid , lgr_cell->host_cell , copy_lgr );
         }
         ecl_grid_install_lgr_common( host_grid , copy_lgr );
 
@@ -2489,7 +2901,7 @@ ecl_grid_type * ecl_grid_alloc_processed_copy( const ecl_grid_type * src_grid ,
 */
 
 ecl_grid_type * ecl_grid_alloc_GRDECL_data(int nx , int ny , int nz , const float * zcorn , const float * coord , const int * actnum, bool apply_mapaxes , const float * mapaxes) {
-  return ecl_grid_alloc_GRDECL_data__(NULL , FILEHEAD_SINGLE_POROSITY , apply_mapaxes , nx , ny , nz , zcorn , coord , actnum , mapaxes , NULL , 0);
+  return ecl_grid_alloc_GRDECL_data__(NULL , FILEHEAD_SINGLE_POROSITY , apply_mapaxes , nx , ny , nz , zcorn , coord , actnum , mapaxes , NULL , 0 , false);
 }
 
 
@@ -2518,7 +2930,8 @@ static ecl_grid_type * ecl_grid_alloc_GRDECL_kw__(ecl_grid_type * global_grid ,
                                                   const ecl_kw_type * coord_kw ,
                                                   const ecl_kw_type * actnum_kw ,    /* Can be NULL */
                                                   const ecl_kw_type * mapaxes_kw ,   /* Can be NULL */
-                                                  const ecl_kw_type * corsnum_kw) {   /* Can be NULL */
+                                                  const ecl_kw_type * corsnum_kw,     /* Can be NULL */
+                                                  bool compact) {
    int gtype, nx,ny,nz, lgr_nr;
 
   gtype   = ecl_kw_iget_int(gridhead_kw , GRIDHEAD_TYPE_INDEX);
@@ -2562,7 +2975,8 @@ static ecl_grid_type * ecl_grid_alloc_GRDECL_kw__(ecl_grid_type * global_grid ,
                                         actnum_data,
                                         mapaxes_data,
                                         corsnum_data,
-                                        lgr_nr);
+                                        lgr_nr,
+                                        compact);
   }
 }
 
@@ -2582,7 +2996,7 @@ ecl_grid_type * ecl_grid_alloc_GRDECL_kw( int nx, int ny , int nz ,
 
   bool apply_mapaxes = true;
   ecl_kw_type * gridhead_kw = ecl_grid_alloc_gridhead_kw( nx , ny , nz , 0);
-  ecl_grid_type * ecl_grid = ecl_grid_alloc_GRDECL_kw__(NULL , FILEHEAD_SINGLE_POROSITY , apply_mapaxes , gridhead_kw , zcorn_kw , coord_kw , actnum_kw , mapaxes_kw , NULL);
+  ecl_grid_type * ecl_grid = ecl_grid_alloc_GRDECL_kw__(NULL , FILEHEAD_SINGLE_POROSITY , apply_mapaxes , gridhead_kw , zcorn_kw , coord_kw , actnum_kw , mapaxes_kw , NULL , false);
   ecl_kw_free( gridhead_kw );
   return ecl_grid;
 
@@ -2593,11 +3007,17 @@ ecl_grid_type * ecl_grid_alloc_GRDECL_kw( int nx, int ny , int nz ,
 
 
 
-static void ecl_grid_init_cell_nnc_info(ecl_grid_type * ecl_grid, int global_index) {
-  ecl_cell_type * grid_cell = ecl_grid_get_cell(ecl_grid, global_index);
+static nnc_info_type * ecl_grid_init_cell_nnc_info(ecl_grid_type * ecl_grid, int global_index) {
+  if (!ecl_grid->cell_nnc_info) {
+    ecl_grid->cell_nnc_info = util_calloc( ecl_grid->size , sizeof * ecl_grid->cell_nnc_info );
+    for (int i=0; i < ecl_grid->size; i++)
+      ecl_grid->cell_nnc_info[i] = NULL;
+  }
+
+  if (!ecl_grid->cell_nnc_info[global_index])
+    ecl_grid->cell_nnc_info[global_index] = nnc_info_alloc(ecl_grid->lgr_nr);
 
-  if (!grid_cell->nnc_info)
-    grid_cell->nnc_info = nnc_info_alloc(ecl_grid->lgr_nr);
+  return ecl_grid->cell_nnc_info[global_index];
 }
 
 /*
@@ -2644,9 +3064,10 @@ static void ecl_grid_init_cell_nnc_info(ecl_grid_type * ecl_grid, int global_ind
 */
 
 void ecl_grid_add_self_nnc( ecl_grid_type * grid, int cell_index1, int cell_index2, int nnc_index) {
-  ecl_cell_type * grid_cell = ecl_grid_get_cell(grid, cell_index1);
-  ecl_grid_init_cell_nnc_info(grid, cell_index1);
-  nnc_info_add_nnc(grid_cell->nnc_info, grid->lgr_nr, cell_index2, nnc_index);
+  nnc_info_type * nnc_info;
+  ecl_grid_assert_not_frozen( grid , __func__ );
+  nnc_info = ecl_grid_init_cell_nnc_info(grid, cell_index1);
+  nnc_info_add_nnc(nnc_info, grid->lgr_nr, cell_index2, nnc_index);
 }
 
 /*
@@ -2708,9 +3129,8 @@ static void ecl_grid_init_nnc_cells( ecl_grid_type * grid1, ecl_grid_type * grid
 
 
     {
-      ecl_cell_type * grid1_cell = ecl_grid_get_cell(grid1, grid1_cell_index);
-      ecl_grid_init_cell_nnc_info(grid1, grid1_cell_index);
-      nnc_info_add_nnc(grid1_cell->nnc_info, grid2->lgr_nr, grid2_cell_index , nnc_index);
+      nnc_info_type * nnc_info = ecl_grid_init_cell_nnc_info(grid1, grid1_cell_index);
+      nnc_info_add_nnc(nnc_info, grid2->lgr_nr, grid2_cell_index , nnc_index);
     }
   }
 }
@@ -2805,7 +3225,7 @@ static void ecl_grid_init_nnc_amalgamated(ecl_grid_type * main_grid, ecl_file_ty
 */
 
 
-static ecl_grid_type * ecl_grid_alloc_EGRID__( ecl_grid_type * main_grid , const ecl_file_type * ecl_file , int grid_nr, bool apply_mapaxes) {
+static ecl_grid_type * ecl_grid_alloc_EGRID__( ecl_grid_type * main_grid , const ecl_file_type * ecl_file , int grid_nr, bool apply_mapaxes, bool compact) {
   ecl_kw_type * gridhead_kw  = ecl_file_iget_named_kw( ecl_file , GRIDHEAD_KW  , grid_nr);
   ecl_kw_type * zcorn_kw     = ecl_file_iget_named_kw( ecl_file , ZCORN_KW     , grid_nr);
   ecl_kw_type * coord_kw     = ecl_file_iget_named_kw( ecl_file , COORD_KW     , grid_nr);
@@ -2848,7 +3268,8 @@ static ecl_grid_type * ecl_grid_alloc_EGRID__( ecl_grid_type * main_grid , const
                                                            coord_kw ,
                                                            actnum_kw ,
                                                            mapaxes_kw ,
-                                                           corsnum_kw );
+                                                           corsnum_kw ,
+                                                           compact );
 
     if (ECL_GRID_MAINGRID_LGR_NR != grid_nr) ecl_grid_set_lgr_name_EGRID(ecl_grid , ecl_file , grid_nr);
     ecl_grid->eclipse_version = eclipse_version;
@@ -2858,7 +3279,7 @@ static ecl_grid_type * ecl_grid_alloc_EGRID__( ecl_grid_type * main_grid , const
 
 
 
-ecl_grid_type * ecl_grid_alloc_EGRID(const char * grid_file, bool apply_mapaxes) {
+static ecl_grid_type * ecl_grid_alloc_EGRID_file__(const char * grid_file, bool apply_mapaxes, bool compact) {
   ecl_file_enum   file_type;
   file_type = ecl_util_get_file_type(grid_file , NULL , NULL);
   if (file_type != ECL_EGRID_FILE)
@@ -2867,11 +3288,11 @@ ecl_grid_type * ecl_grid_alloc_EGRID(const char * grid_file, bool apply_mapaxes)
     ecl_file_type * ecl_file   = ecl_file_open( grid_file , 0);
     if (ecl_file) {
       int num_grid               = ecl_file_get_num_named_kw( ecl_file , GRIDHEAD_KW );
-      ecl_grid_type * main_grid  = ecl_grid_alloc_EGRID__( NULL , ecl_file , 0 , apply_mapaxes);
+      ecl_grid_type * main_grid  = ecl_grid_alloc_EGRID__( NULL , ecl_file , 0 , apply_mapaxes, compact);
       int grid_nr;
 
       for ( grid_nr = 1; grid_nr < num_grid; grid_nr++) {
-        ecl_grid_type * lgr_grid = ecl_grid_alloc_EGRID__( main_grid , ecl_file , grid_nr , false);  /* The apply_mapaxes argument is ignored for LGR - it inherits from parent anyway. */
+        ecl_grid_type * lgr_grid = ecl_grid_alloc_EGRID__( main_grid , ecl_file , grid_nr , false, compact);  /* The apply_mapaxes argument is ignored for LGR - it inherits from parent anyway. */
         ecl_grid_add_lgr( main_grid , lgr_grid );
         {
           ecl_grid_type * host_grid;
@@ -2896,18 +3317,26 @@ ecl_grid_type * ecl_grid_alloc_EGRID(const char * grid_file, bool apply_mapaxes)
 }
 
 
+ecl_grid_type * ecl_grid_alloc_EGRID(const char * grid_file, bool apply_mapaxes) {
+  return ecl_grid_alloc_EGRID_file__( grid_file , apply_mapaxes , false );
+}
+
+
 
 
 
-static ecl_grid_type * ecl_grid_alloc_GRID_data__(ecl_grid_type * global_grid , int num_coords , int dualp_flag , bool apply_mapaxes, int nx, int ny , int nz , int grid_nr , int coords_size , int ** coords , float ** corners , const float * mapaxes) {
+static ecl_grid_type * ecl_grid_alloc_GRID_data__(ecl_grid_type * global_grid , int num_coords , int dualp_flag , bool apply_mapaxes, int nx, int ny , int nz , int grid_nr , int coords_size , int ** coords , float ** corners , const float * mapaxes, bool compact) {
   if (dualp_flag != FILEHEAD_SINGLE_POROSITY)
     nz = nz / 2;
   {
-    ecl_grid_type * grid = ecl_grid_alloc_empty( global_grid , dualp_flag , nx , ny , nz , grid_nr, false);
+    ecl_grid_type * grid = ecl_grid_alloc_empty( global_grid , dualp_flag , nx , ny , nz , grid_nr, false, compact);
     if (grid) {
       if (mapaxes != NULL)
         ecl_grid_init_mapaxes( grid , apply_mapaxes , mapaxes);
 
+      if (grid->compact && (global_grid == NULL) && (num_coords > 0))
+        ecl_grid_set_compact_origin( grid , corners[0][0] , corners[0][1] , corners[0][2] );
+
       {
         int index;
         for ( index=0; index < num_coords; index++)
@@ -2933,7 +3362,7 @@ ecl_grid_type * ecl_grid_alloc_GRID_data(int num_coords , int nx , int ny , int
                                      num_coords ,
                                      FILEHEAD_SINGLE_POROSITY , /* Does currently not support to determine dualp_flag from inspection. */
                                      apply_mapaxes,
-                                     nx , ny , nz , 0 , coords_size , coords , corners , mapaxes);
+                                     nx , ny , nz , 0 , coords_size , coords , corners , mapaxes , false);
 }
 
 
@@ -2980,7 +3409,7 @@ static int ecl_grid_dual_porosity_GRID_check( ecl_file_type * ecl_file ) {
 }
 
 
-static ecl_grid_type * ecl_grid_alloc_GRID__(ecl_grid_type * global_grid , const ecl_file_type * ecl_file , int cell_offset , int grid_nr, int dualp_flag, bool apply_mapaxes) {
+static ecl_grid_type * ecl_grid_alloc_GRID__(ecl_grid_type * global_grid , const ecl_file_type * ecl_file , int cell_offset , int grid_nr, int dualp_flag, bool apply_mapaxes, bool compact) {
   int           nx,ny,nz;
   const float * mapaxes_data = NULL;
   ecl_grid_type * grid;
@@ -3075,7 +3504,7 @@ static ecl_grid_type * ecl_grid_alloc_GRID__(ecl_grid_type * global_grid , const
         coords_size = ecl_kw_get_size( coords_kw );
       }
       // Create the grid:
-      grid = ecl_grid_alloc_GRID_data__( global_grid , num_coords , dualp_flag , apply_mapaxes, nx , ny , nz , grid_nr , coords_size , coords , corners , mapaxes_data );
+      grid = ecl_grid_alloc_GRID_data__( global_grid , num_coords , dualp_flag , apply_mapaxes, nx , ny , nz , grid_nr , coords_size , coords , corners , mapaxes_data , compact );
 
       free( coords );
       free( corners );
@@ -3090,7 +3519,7 @@ static ecl_grid_type * ecl_grid_alloc_GRID__(ecl_grid_type * global_grid , const
 
 
 
-ecl_grid_type * ecl_grid_alloc_GRID(const char * grid_file, bool apply_mapaxes) {
+static ecl_grid_type * ecl_grid_alloc_GRID_file__(const char * grid_file, bool apply_mapaxes, bool compact) {
 
   ecl_file_enum   file_type;
   file_type = ecl_util_get_file_type(grid_file , NULL , NULL);
@@ -3106,11 +3535,11 @@ ecl_grid_type * ecl_grid_alloc_GRID(const char * grid_file, bool apply_mapaxes)
     int dualp_flag;
 
     dualp_flag = ecl_grid_dual_porosity_GRID_check( ecl_file );
-    main_grid  = ecl_grid_alloc_GRID__(NULL , ecl_file , cell_offset , 0,dualp_flag , apply_mapaxes);
+    main_grid  = ecl_grid_alloc_GRID__(NULL , ecl_file , cell_offset , 0,dualp_flag , apply_mapaxes , compact);
     cell_offset += ecl_grid_get_global_size( main_grid );
 
     for (grid_nr = 1; grid_nr < num_grid; grid_nr++) {
-      ecl_grid_type * lgr_grid = ecl_grid_alloc_GRID__(main_grid , ecl_file , cell_offset , grid_nr , dualp_flag, false);
+      ecl_grid_type * lgr_grid = ecl_grid_alloc_GRID__(main_grid , ecl_file , cell_offset , grid_nr , dualp_flag, false, compact);
       cell_offset += ecl_grid_get_global_size( lgr_grid );
       ecl_grid_add_lgr( main_grid , lgr_grid );
       {
@@ -3131,6 +3560,11 @@ ecl_grid_type * ecl_grid_alloc_GRID(const char * grid_file, bool apply_mapaxes)
 }
 
 
+ecl_grid_type * ecl_grid_alloc_GRID(const char * grid_file, bool apply_mapaxes) {
+  return ecl_grid_alloc_GRID_file__( grid_file , apply_mapaxes , false );
+}
+
+
 /**
    This function will allocate a new regular grid with dimensions nx x
    ny x nz. The cells in the grid are spanned by the the three unit
@@ -3142,7 +3576,7 @@ ecl_grid_type * ecl_grid_alloc_GRID(const char * grid_file, bool apply_mapaxes)
    which case all cells will be active.
 */
 ecl_grid_type * ecl_grid_alloc_regular( int nx, int ny , int nz , const double * ivec, const double * jvec , const double * kvec , const int * actnum) {
-  ecl_grid_type * grid = ecl_grid_alloc_empty(NULL , FILEHEAD_SINGLE_POROSITY , nx , ny , nz , 0, true);
+  ecl_grid_type * grid = ecl_grid_alloc_empty(NULL , FILEHEAD_SINGLE_POROSITY , nx , ny , nz , 0, true, false);
   if (grid) {
     const double grid_offset[3] = {0,0,0};
 
@@ -3158,7 +3592,9 @@ ecl_grid_type * ecl_grid_alloc_regular( int nx, int ny , int nz , const double *
           };
 
           ecl_cell_type * cell = ecl_grid_get_cell(grid , global_index );
-          ecl_cell_init_regular( cell , offset , i,j,k,global_index , ivec , jvec , kvec , actnum );
+          point_type corner_list[8];
+          ecl_cell_init_regular( cell , corner_list , offset , i,j,k,global_index , ivec , jvec , kvec , actnum );
+          ecl_grid_set_cell_corners( grid , global_index , corner_list );
         }
       }
     }
@@ -3202,7 +3638,7 @@ ecl_grid_type * ecl_grid_alloc_dxv_dyv_dzv( int nx, int ny , int nz , const doub
     ecl_grid_type* grid = ecl_grid_alloc_empty(NULL,
                                                FILEHEAD_SINGLE_POROSITY,
                                                nx, ny, nz,
-                                               /*lgr_nr=*/0, /*init_valid=*/true);
+                                               /*lgr_nr=*/0, /*init_valid=*/true, /*compact=*/false);
     if (grid) {
       double ivec[3] = { 0, 0, 0 };
       double jvec[3] = { 0, 0, 0 };
@@ -3221,12 +3657,14 @@ ecl_grid_type * ecl_grid_alloc_dxv_dyv_dzv( int nx, int ny , int nz , const doub
           for (i=0; i < nx; i++) {
             int global_index = i + j*nx + k*nx*ny;
             ecl_cell_type* cell = ecl_grid_get_cell(grid, global_index);
+            point_type corner_list[8];
             ivec[0] = dxv[i];
 
-            ecl_cell_init_regular(cell, offset,
+            ecl_cell_init_regular(cell, corner_list, offset,
                                   i,j,k,global_index,
                                   ivec,jvec,kvec,
                                   actnum);
+            ecl_grid_set_cell_corners(grid, global_index, corner_list);
             offset[0] += dxv[i];
           }
           offset[1] += dyv[j];
@@ -3245,7 +3683,7 @@ ecl_grid_type * ecl_grid_alloc_dxv_dyv_dzv_depthz( int nx, int ny , int nz , con
     ecl_grid_type* grid = ecl_grid_alloc_empty(NULL,
                                                FILEHEAD_SINGLE_POROSITY,
                                                nx, ny, nz,
-                                               /*lgr_nr=*/0, /*init_valid=*/true);
+                                               /*lgr_nr=*/0, /*init_valid=*/true, /*compact=*/false);
 
 
     /* First layer - where the DEPTHZ keyword applies. */
@@ -3257,24 +3695,25 @@ ecl_grid_type * ecl_grid_alloc_dxv_dyv_dzv_depthz( int nx, int ny , int nz , con
         double x0 = 0;
         for (i = 0; i < nx; i++) {
           int global_index = i + j*nx + k*nx*ny;
-          ecl_cell_type* cell = ecl_grid_get_cell(grid, global_index);
+          point_type corner_list[8];
           double z0 = depthz[ i     + j*(nx + 1)];
           double z1 = depthz[ i + 1 + j*(nx + 1)];
           double z2 = depthz[ i +     (j + 1)*(nx + 1)];
           double z3 = depthz[ i + 1 + (j + 1)*(nx + 1)];
 
 
-          point_set(&cell->corner_list[0] , x0 , y0 , z0);
-          point_set(&cell->corner_list[1] , x0 + dxv[i] , y0 , z1);
-          point_set(&cell->corner_list[2] , x0          , y0 + dyv[j] , z2);
-          point_set(&cell->corner_list[3] , x0 + dxv[i] , y0 + dyv[j] , z3);
+          point_set(&corner_list[0] , x0 , y0 , z0);
+          point_set(&corner_list[1] , x0 + dxv[i] , y0 , z1);
+          point_set(&corner_list[2] , x0          , y0 + dyv[j] , z2);
+          point_set(&corner_list[3] , x0 + dxv[i] , y0 + dyv[j] , z3);
           {
             int c;
             for (c = 0; c < 4; c++) {
-              cell->corner_list[c + 4] = cell->corner_list[c];
-              point_shift(&cell->corner_list[c + 4] , 0 , 0 , dzv[0]);
+              corner_list[c + 4] = corner_list[c];
+              point_shift(&corner_list[c + 4] , 0 , 0 , dzv[0]);
             }
           }
+          ecl_grid_set_cell_corners(grid, global_index, corner_list);
           x0 += dxv[i];
         }
         y0 += dyv[j];
@@ -3289,15 +3728,17 @@ ecl_grid_type * ecl_grid_alloc_dxv_dyv_dzv_depthz( int nx, int ny , int nz , con
           for (i=0; i < nx; i++) {
             int g2 = i + j*nx + k*nx*ny;
             int g1 = i + j*nx + (k - 1)*nx*ny;
-            ecl_cell_type* cell2 = ecl_grid_get_cell(grid, g2);
-            ecl_cell_type* cell1 = ecl_grid_get_cell(grid, g1);
+            point_type buffer[8];
+            point_type corner_list2[8];
+            const point_type * corner_list1 = ecl_grid_get_cell_corners(grid, g1, buffer);
             int c;
 
             for (c = 0; c < 4; c++) {
-              cell2->corner_list[c] = cell1->corner_list[c + 4];
-              cell2->corner_list[c + 4] = cell1->corner_list[c + 4];
-              point_shift( &cell2->corner_list[c + 4] , 0 , 0 , dzv[k]);
+              corner_list2[c] = corner_list1[c + 4];
+              corner_list2[c + 4] = corner_list1[c + 4];
+              point_shift( &corner_list2[c + 4] , 0 , 0 , dzv[k]);
             }
+            ecl_grid_set_cell_corners(grid, g2, corner_list2);
           }
         }
       }
@@ -3349,7 +3790,7 @@ ecl_grid_type * ecl_grid_alloc_dx_dy_dz_tops( int nx, int ny , int nz , const do
   ecl_grid_type* grid = ecl_grid_alloc_empty(NULL,
                                              FILEHEAD_SINGLE_POROSITY,
                                              nx, ny, nz,
-                                             0, true);
+                                             0, true, false);
   if (grid) {
     int i, j, k;
     double * y0 = util_calloc( nx, sizeof * y0 );
@@ -3363,17 +3804,19 @@ ecl_grid_type * ecl_grid_alloc_dx_dy_dz_tops( int nx, int ny , int nz , const do
         for (i=0; i < nx; i++) {
           int g = i + j*nx + k*nx*ny;
           ecl_cell_type* cell = ecl_grid_get_cell(grid, g);
+          point_type corner_list[8];
           double z0 = tops[ g ];
 
-          point_set(&cell->corner_list[0] , x0         , y0[i]         , z0);
-          point_set(&cell->corner_list[1] , x0 + dx[g] , y0[i]         , z0);
-          point_set(&cell->corner_list[2] , x0         , y0[i] + dy[g] , z0);
-          point_set(&cell->corner_list[3] , x0 + dx[g] , y0[i] + dy[g] , z0);
+          point_set(&corner_list[0] , x0         , y0[i]         , z0);
+          point_set(&corner_list[1] , x0 + dx[g] , y0[i]         , z0);
+          point_set(&corner_list[2] , x0         , y0[i] + dy[g] , z0);
+          point_set(&corner_list[3] , x0 + dx[g] , y0[i] + dy[g] , z0);
 
-          point_set(&cell->corner_list[4] , x0         , y0[i]         , z0 + dz[g]);
-          point_set(&cell->corner_list[5] , x0 + dx[g] , y0[i]         , z0 + dz[g]);
-          point_set(&cell->corner_list[6] , x0         , y0[i] + dy[g] , z0 + dz[g]);
-          point_set(&cell->corner_list[7] , x0 + dx[g] , y0[i] + dy[g] , z0 + dz[g]);
+          point_set(&corner_list[4] , x0         , y0[i]         , z0 + dz[g]);
+          point_set(&corner_list[5] , x0 + dx[g] , y0[i]         , z0 + dz[g]);
+          point_set(&corner_list[6] , x0         , y0[i] + dy[g] , z0 + dz[g]);
+          point_set(&corner_list[7] , x0 + dx[g] , y0[i] + dy[g] , z0 + dz[g]);
+          ecl_grid_set_cell_corners(grid, g, corner_list);
 
           x0    += dx[g];
           y0[i] += dy[g];
@@ -3404,15 +3847,15 @@ ecl_grid_type * ecl_grid_alloc_dx_dy_dz_tops( int nx, int ny , int nz , const do
    with these keywords.
 */
 
-ecl_grid_type * ecl_grid_alloc__(const char * grid_file , bool apply_mapaxes) {
+static ecl_grid_type * ecl_grid_alloc_file__(const char * grid_file , bool apply_mapaxes , bool compact) {
   ecl_file_enum    file_type;
   ecl_grid_type  * ecl_grid = NULL;
 
   file_type = ecl_util_get_file_type(grid_file , NULL ,  NULL);
   if (file_type == ECL_GRID_FILE)
-    ecl_grid = ecl_grid_alloc_GRID(grid_file, apply_mapaxes);
+    ecl_grid = ecl_grid_alloc_GRID_file__(grid_file, apply_mapaxes, compact);
   else if (file_type == ECL_EGRID_FILE)
-    ecl_grid = ecl_grid_alloc_EGRID(grid_file, apply_mapaxes);
+    ecl_grid = ecl_grid_alloc_EGRID_file__(grid_file, apply_mapaxes, compact);
   else
     util_abort("%s must have .GRID or .EGRID file - %s not recognized \n", __func__ , grid_file);
 
@@ -3420,12 +3863,37 @@ ecl_grid_type * ecl_grid_alloc__(const char * grid_file , bool apply_mapaxes) {
 }
 
 
+ecl_grid_type * ecl_grid_alloc__(const char * grid_file , bool apply_mapaxes) {
+  return ecl_grid_alloc_file__( grid_file , apply_mapaxes , false );
+}
+
+
 ecl_grid_type * ecl_grid_alloc(const char * grid_file ) {
   bool apply_mapaxes = true;
   return ecl_grid_alloc__( grid_file , apply_mapaxes );
 }
 
 
+/**
+   Will load the grid in the same way as ecl_grid_alloc(), but the
+   cell corners are stored in single precision; i.e. with the same
+   precision as the COORD/ZCORN and CORNERS keywords in the grid
+   file. For large grids this roughly halves the memory used by the
+   grid; the geometry queries will give results which might differ
+   from a grid loaded with ecl_grid_alloc() in the last digits.
+*/
+
+ecl_grid_type * ecl_grid_alloc_compact(const char * grid_file ) {
+  bool apply_mapaxes = true;
+  return ecl_grid_alloc_file__( grid_file , apply_mapaxes , true );
+}
+
+
+bool ecl_grid_is_compact( const ecl_grid_type * grid ) {
+  return grid->compact;
+}
+
+
 static void ecl_grid_file_nactive_dims( fortio_type * data_fortio , int * dims) {
   if (data_fortio) {
     if (ecl_kw_fseek_kw( INTEHEAD_KW , false , false , data_fortio )) {
@@ -3641,62 +4109,875 @@ bool ecl_grid_exists( const char * case_input ) {
 }
 
 
-static bool ecl_grid_compare_coarse_cells(const ecl_grid_type * g1 , const ecl_grid_type * g2, bool verbose) {
-  if (vector_get_size( g1->coarse_cells ) == vector_get_size( g2->coarse_cells )) {
-    bool equal = true;
-    int c;
+/*****************************************************************/
+/* Grid cache */
 
-    for (c = 0; c < vector_get_size( g1->coarse_cells ); c++) {
-      const ecl_coarse_cell_type * coarse_cell1 = vector_iget_const( g1->coarse_cells , c);
-      const ecl_coarse_cell_type * coarse_cell2 = vector_iget_const( g2->coarse_cells , c);
+/*
+  The grid cache is a binary snapshot of a fully initialized grid,
+  including the lgrs, which can be loaded much faster than the grid
+  file it was created from; the cells, index maps and nnc information
+  are stored in their processed form, i.e. nothing is recalculated
+  when the cache is loaded.
+
+  The geometry is stored in the compact form, i.e. as float corners
+  relative to the compact origin of the grid, and the grids loaded
+  from the cache are always compact. The cache file is mapped into
+  memory, the cells and the compact corners are used directly from
+  the mapping and the pages are only read from disk when they are
+  accessed. The mapping is private, pages which are modified, e.g.
+  when a cell volume is cached, are copied by the operating system
+  and the file is never updated. On platforms without mmap() the
+  file is read into a memory buffer instead.
+
+  The cache is keyed on the size and the modification time of the
+  source GRID/EGRID file; when the source file changes the cache is
+  silently ignored. The modification time only has a resolution of
+  one second, a checksum of the complete source file is therefor
+  also stored in the cache and can optionally be verified when the
+  cache is loaded. The cache file is a raw image of the in memory
+  data structures, it is only valid on the same platform, with the
+  same version of the library. Each array is stored 8 byte aligned
+  in the file.
+
+  File layout:
+
+    header:     magic, version, sizeof(ecl_cell_type), sizeof(point_type),
+                number of grids, source size, source mtime, source checksum
+    for each grid, the main grid first and then the lgrs in the
+    order they were loaded:
+      grid header: dimensions, flags, name, parent name, mapaxes
+      cells[size]
+      compact_origin, compact_corners[24*size]
+      index_map[size] , inv_index_map[total_active]
+      fracture_index_map[size] , inv_fracture_index_map[total_active_fracture]  (dual porosity only)
+      coord[coord_size]  (if the grid has a coord keyword)
+      nnc: for each cell with nnc: global index and the nnc vectors.
+*/
 
-      equal = ecl_coarse_cell_equal( coarse_cell1 , coarse_cell2 );
-      if (!equal)
-        if (verbose) fprintf(stderr,"Difference in coarse cell:%d \n",c );
+#define ECL_GRID_CACHE_MAGIC         "ECLGRIDC"
+#define ECL_GRID_CACHE_VERSION       3
+#define ECL_GRID_CACHE_ALIGN         8
+#define ECL_GRID_CACHE_BUFFER        (1 << 20)
+#define ECL_GRID_CACHE_HEADER_SIZE   13
 
-    }
-    return equal;
-  } else
-    return false;
-}
 
+typedef struct {
+  FILE   * stream;
+  size_t   pos;
+  bool     ok;
+} ecl_grid_cache_writer_type;
 
-static bool ecl_grid_compare_cells(const ecl_grid_type * g1 , const ecl_grid_type * g2, bool include_nnc , bool verbose) {
-  int g;
-  bool equal = true;
-  for (g = 0; g < g1->size; g++) {
-    bool this_equal = true;
-    ecl_cell_type *c1 = ecl_grid_get_cell( g1 , g );
-    ecl_cell_type *c2 = ecl_grid_get_cell( g2 , g );
-    ecl_cell_compare(c1 , c2 ,  include_nnc , &this_equal);
 
-    if (!this_equal) {
-      if (verbose) {
-        int i,j,k;
-        ecl_grid_get_ijk1( g1 , g , &i , &j , &k);
+typedef struct {
+  char   * data;
+  size_t   size;
+  size_t   offset;
+} ecl_grid_cache_reader_type;
 
-        printf("Difference in cell: %d : %d,%d,%d  nnc_equal:%d Volume:%g \n",g,i,j,k , nnc_info_equal( c1->nnc_info , c2->nnc_info) , ecl_cell_get_volume( c1 ));
-        printf("-----------------------------------------------------------------\n");
-        ecl_cell_dump_ascii( c1 , i , j , k , stdout , NULL);
-        printf("-----------------------------------------------------------------\n");
-        ecl_cell_dump_ascii( c2 , i , j , k , stdout , NULL );
-        printf("-----------------------------------------------------------------\n");
 
+/*
+  Will calculate a 64 bit checksum of the content of the file; the
+  file is processed eight bytes at a time. Will return false if the
+  file can not be read.
+*/
+
+static bool ecl_grid_cache_checksum( const char * filename , uint64_t * checksum) {
+  FILE * stream = util_fopen__( filename , "r");
+  if (!stream)
+    return false;
+  {
+    const uint64_t prime = 0x100000001b3ULL;
+    char * buffer = util_malloc( ECL_GRID_CACHE_BUFFER );
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    int64_t size = 0;
+    size_t bytes_read;
+
+    do {
+      bytes_read = fread( buffer , 1 , ECL_GRID_CACHE_BUFFER , stream );
+      {
+        size_t offset = 0;
+        while (offset + sizeof(uint64_t) <= bytes_read) {
+          uint64_t word;
+          memcpy( &word , &buffer[offset] , sizeof word );
+          hash = (hash ^ word) * prime;
+          hash ^= hash >> 29;
+          offset += sizeof(uint64_t);
+        }
+        /* Only the last block can have a tail. */
+        while (offset < bytes_read) {
+          hash = (hash ^ (unsigned char) buffer[offset]) * prime;
+          offset++;
+        }
       }
-      equal = false;
-      break;
+      size += bytes_read;
+    } while (bytes_read == ECL_GRID_CACHE_BUFFER);
+
+    {
+      bool ok = (ferror( stream ) == 0);
+      fclose( stream );
+      free( buffer );
+
+      *checksum = (hash ^ (uint64_t) size) * prime;
+      return ok;
     }
   }
-  return equal;
 }
 
-static bool ecl_grid_compare_index(const ecl_grid_type * g1 , const ecl_grid_type * g2, bool verbose) {
-  bool equal = true;
 
-  if (g1->total_active != g2->total_active) {
-    if (verbose)
-      fprintf(stderr,"Difference in total active:%d / %d\n",g1->total_active , g2->total_active);
-    equal = false;
+static bool ecl_grid_cache_source_key( const char * filename , int64_t * size , int64_t * mtime) {
+  stat_type stat_buffer;
+  if (util_stat( filename , &stat_buffer ) != 0)
+    return false;
+
+  *size = stat_buffer.st_size;
+  *mtime = stat_buffer.st_mtime;
+  return true;
+}
+
+
+/*
+  The writer functions use plain fwrite() and record the first
+  failure in the ok flag of the writer; failure to write the cache is
+  not an error, and must not abort the process.
+*/
+
+static void ecl_grid_cache_write( ecl_grid_cache_writer_type * writer , const void * data , size_t element_size , size_t count) {
+  if (writer->ok && (count > 0)) {
+    if (fwrite( data , element_size , count , writer->stream ) == count)
+      writer->pos += element_size * count;
+    else
+      writer->ok = false;
+  }
+}
+
+
+static void ecl_grid_cache_write_int( ecl_grid_cache_writer_type * writer , int value) {
+  ecl_grid_cache_write( writer , &value , sizeof value , 1 );
+}
+
+
+static void ecl_grid_cache_write_align( ecl_grid_cache_writer_type * writer ) {
+  const char zero[ECL_GRID_CACHE_ALIGN] = {0};
+  size_t pad = (ECL_GRID_CACHE_ALIGN - (writer->pos % ECL_GRID_CACHE_ALIGN)) % ECL_GRID_CACHE_ALIGN;
+  ecl_grid_cache_write( writer , zero , 1 , pad );
+}
+
+
+static void ecl_grid_cache_write_array( ecl_grid_cache_writer_type * writer , const void * data , size_t element_size , size_t count) {
+  ecl_grid_cache_write_align( writer );
+  ecl_grid_cache_write( writer , data , element_size , count );
+}
+
+
+/*
+  The strings are stored as length followed by the characters; a
+  length of -1 is used for NULL.
+*/
+
+static void ecl_grid_cache_write_string( ecl_grid_cache_writer_type * writer , const char * s) {
+  if (s) {
+    int len = strlen( s );
+    ecl_grid_cache_write_int( writer , len );
+    ecl_grid_cache_write( writer , s , 1 , len );
+  } else
+    ecl_grid_cache_write_int( writer , -1 );
+}
+
+
+/*
+  Will return a pointer to the next @count elements in the cache
+  data, after skipping the alignment padding. Will return NULL if the
+  data is truncated.
+*/
+
+static void * ecl_grid_cache_get_array( ecl_grid_cache_reader_type * reader , size_t element_size , size_t count) {
+  size_t offset = reader->offset + (ECL_GRID_CACHE_ALIGN - (reader->offset % ECL_GRID_CACHE_ALIGN)) % ECL_GRID_CACHE_ALIGN;
+  if (offset > reader->size)
+    return NULL;
+
+  if (count > (reader->size - offset) / element_size)
+    return NULL;
+
+  reader->offset = offset + element_size * count;
+  return &reader->data[offset];
+}
+
+
+static bool ecl_grid_cache_read_array( ecl_grid_cache_reader_type * reader , void * target , size_t element_size , size_t count) {
+  const void * src = ecl_grid_cache_get_array( reader , element_size , count );
+  if (!src)
+    return false;
+
+  memcpy( target , src , element_size * count );
+  return true;
+}
+
+
+static bool ecl_grid_cache_read( ecl_grid_cache_reader_type * reader , void * target , size_t size) {
+  if (size > reader->size - reader->offset)
+    return false;
+
+  memcpy( target , &reader->data[reader->offset] , size );
+  reader->offset += size;
+  return true;
+}
+
+
+static bool ecl_grid_cache_read_int( ecl_grid_cache_reader_type * reader , int * value) {
+  return ecl_grid_cache_read( reader , value , sizeof * value );
+}
+
+
+static bool ecl_grid_cache_read_string( ecl_grid_cache_reader_type * reader , char ** s) {
+  int len;
+  *s = NULL;
+  if (!ecl_grid_cache_read_int( reader , &len ))
+    return false;
+
+  if (len < 0)
+    return true;
+
+  *s = util_calloc( len + 1 , sizeof * *s );
+  if (!ecl_grid_cache_read( reader , *s , len )) {
+    free( *s );
+    *s = NULL;
+    return false;
+  }
+  return true;
+}
+
+
+/*
+  Will map the complete cache file into memory, or read it into a
+  memory buffer on platforms without mmap(). The data is released
+  with ecl_grid_cache_release_data().
+*/
+
+static bool ecl_grid_cache_load_data( const char * cache_file , ecl_grid_cache_reader_type * reader) {
+  FILE * stream = util_fopen__( cache_file , "r");
+  bool ok = false;
+  if (!stream)
+    return false;
+
+  reader->data = NULL;
+  reader->offset = 0;
+  reader->size = 0;
+  if (fseek( stream , 0 , SEEK_END ) == 0) {
+    long size = ftell( stream );
+    if (size > 0) {
+      reader->size = size;
+#ifdef ERT_HAVE_MMAP
+      {
+        void * data = mmap( NULL , reader->size , PROT_READ | PROT_WRITE , MAP_PRIVATE , fileno( stream ) , 0 );
+        if (data != MAP_FAILED) {
+          reader->data = data;
+          ok = true;
+        }
+      }
+#else
+      reader->data = malloc( reader->size );
+      if (reader->data) {
+        ok = (fseek( stream , 0 , SEEK_SET ) == 0) &&
+             (fread( reader->data , 1 , reader->size , stream ) == reader->size);
+        if (!ok) {
+          free( reader->data );
+          reader->data = NULL;
+        }
+      }
+#endif
+    }
+  }
+  fclose( stream );
+  return ok;
+}
+
+
+static void ecl_grid_cache_release_data( void * data , size_t size) {
+#ifdef ERT_HAVE_MMAP
+  munmap( data , size );
+#else
+  free( data );
+#endif
+}
+
+
+static void ecl_grid_cache_write_nnc( ecl_grid_cache_writer_type * writer , const ecl_grid_type * grid) {
+  int num_nnc_cells = 0;
+  int global_index;
+
+  if (grid->cell_nnc_info) {
+    for (global_index = 0; global_index < grid->size; global_index++)
+      if (grid->cell_nnc_info[global_index])
+        num_nnc_cells++;
+  }
+
+  ecl_grid_cache_write_align( writer );
+  ecl_grid_cache_write_int( writer , num_nnc_cells );
+  if (num_nnc_cells == 0)
+    return;
+
+  for (global_index = 0; global_index < grid->size; global_index++) {
+    const nnc_info_type * nnc_info = grid->cell_nnc_info[global_index];
+    if (nnc_info) {
+      int num_vectors = nnc_info_get_size( nnc_info );
+      int ivec;
+
+      ecl_grid_cache_write_int( writer , global_index );
+      ecl_grid_cache_write_int( writer , num_vectors );
+      for (ivec = 0; ivec < num_vectors; ivec++) {
+        const nnc_vector_type * nnc_vector = nnc_info_iget_vector( nnc_info , ivec );
+        const int_vector_type * grid_index_list = nnc_vector_get_grid_index_list( nnc_vector );
+        const int_vector_type * nnc_index_list = nnc_vector_get_nnc_index_list( nnc_vector );
+        int size = nnc_vector_get_size( nnc_vector );
+
+        ecl_grid_cache_write_int( writer , nnc_vector_get_lgr_nr( nnc_vector ) );
+        ecl_grid_cache_write_int( writer , size );
+        ecl_grid_cache_write( writer , int_vector_get_const_ptr( grid_index_list ) , sizeof(int) , size );
+        ecl_grid_cache_write( writer , int_vector_get_const_ptr( nnc_index_list ) , sizeof(int) , size );
+      }
+    }
+  }
+}
+
+
+static bool ecl_grid_cache_read_nnc( ecl_grid_cache_reader_type * reader , ecl_grid_type * grid) {
+  int num_nnc_cells;
+  bool ok = true;
+  int icell;
+
+  if (!ecl_grid_cache_get_array( reader , 1 , 0 ))
+    return false;
+
+  if (!ecl_grid_cache_read_int( reader , &num_nnc_cells ))
+    return false;
+
+  for (icell = 0; ok && (icell < num_nnc_cells); icell++) {
+    int global_index, num_vectors, ivec;
+
+    ok = ecl_grid_cache_read_int( reader , &global_index ) &&
+         ecl_grid_cache_read_int( reader , &num_vectors ) &&
+         (global_index >= 0) && (global_index < grid->size);
+
+    for (ivec = 0; ok && (ivec < num_vectors); ivec++) {
+      int lgr_nr, size;
+      ok = ecl_grid_cache_read_int( reader , &lgr_nr ) &&
+           ecl_grid_cache_read_int( reader , &size ) &&
+           (size >= 0) &&
+           ((size_t) size <= (reader->size - reader->offset) / (2 * sizeof(int)));
+
+      if (ok) {
+        nnc_info_type * nnc_info = ecl_grid_init_cell_nnc_info( grid , global_index );
+        const char * grid_index_data = &reader->data[reader->offset];
+        const char * nnc_index_data = &reader->data[reader->offset + size * sizeof(int)];
+        int i;
+        for (i = 0; i < size; i++) {
+          int grid_index, nnc_index;
+          memcpy( &grid_index , &grid_index_data[i * sizeof(int)] , sizeof grid_index );
+          memcpy( &nnc_index , &nnc_index_data[i * sizeof(int)] , sizeof nnc_index );
+          nnc_info_add_nnc( nnc_info , lgr_nr , grid_index , nnc_index );
+        }
+        reader->offset += 2 * size * sizeof(int);
+      }
+    }
+  }
+  return ok;
+}
+
+
+/*
+  The corners are always stored in compact form; for a grid which is
+  not compact the corners are converted in blocks, relative to the
+  first corner of the grid.
+*/
+
+static void ecl_grid_cache_write_corners( ecl_grid_cache_writer_type * writer , const ecl_grid_type * grid) {
+  if (grid->compact) {
+    ecl_grid_cache_write_array( writer , &grid->compact_origin , sizeof grid->compact_origin , 1 );
+    ecl_grid_cache_write_array( writer , grid->compact_corners , sizeof * grid->compact_corners , (size_t) grid->size * CELL_CORNER_FLOATS );
+  } else {
+    const int block_size = 4096;
+    const point_type * origin = &grid->corners[0];
+    float * buffer = util_malloc( block_size * CELL_CORNER_FLOATS * sizeof * buffer );
+    int block_start;
+
+    ecl_grid_cache_write_array( writer , origin , sizeof * origin , 1 );
+    ecl_grid_cache_write_align( writer );
+    for (block_start = 0; block_start < grid->size; block_start += block_size) {
+      int block_end = util_int_min( grid->size , block_start + block_size );
+      int global_index;
+      for (global_index = block_start; global_index < block_end; global_index++) {
+        const point_type * corners = &grid->corners[ (size_t) global_index * 8 ];
+        float * target = &buffer[ (global_index - block_start) * CELL_CORNER_FLOATS ];
+        int c;
+        for (c = 0; c < 8; c++) {
+          target[3*c]     = corners[c].x - origin->x;
+          target[3*c + 1] = corners[c].y - origin->y;
+          target[3*c + 2] = corners[c].z - origin->z;
+        }
+      }
+      ecl_grid_cache_write( writer , buffer , sizeof * buffer , (size_t) (block_end - block_start) * CELL_CORNER_FLOATS );
+    }
+    free( buffer );
+  }
+}
+
+
+static void ecl_grid_cache_write_grid( ecl_grid_cache_writer_type * writer , const ecl_grid_type * grid) {
+  ecl_grid_cache_write_int( writer , grid->lgr_nr );
+  ecl_grid_cache_write_int( writer , grid->nx );
+  ecl_grid_cache_write_int( writer , grid->ny );
+  ecl_grid_cache_write_int( writer , grid->nz );
+  ecl_grid_cache_write_int( writer , grid->dualp_flag );
+  ecl_grid_cache_write_int( writer , grid->total_active );
+  ecl_grid_cache_write_int( writer , grid->total_active_fracture );
+  ecl_grid_cache_write_int( writer , grid->coarsening_active ? 1 : 0 );
+  ecl_grid_cache_write_int( writer , grid->use_mapaxes ? 1 : 0 );
+  ecl_grid_cache_write_int( writer , grid->unit_system );
+  ecl_grid_cache_write_int( writer , grid->eclipse_version );
+  ecl_grid_cache_write_int( writer , grid->mapaxes ? 1 : 0 );
+  ecl_grid_cache_write_int( writer , grid->coord_kw ? ecl_kw_get_size( grid->coord_kw ) : 0 );
+  ecl_grid_cache_write_string( writer , grid->name );
+  ecl_grid_cache_write_string( writer , grid->parent_name );
+
+  ecl_grid_cache_write_array( writer , grid->unit_x , sizeof grid->unit_x[0] , 2 );
+  ecl_grid_cache_write_array( writer , grid->unit_y , sizeof grid->unit_y[0] , 2 );
+  ecl_grid_cache_write_array( writer , grid->origo , sizeof grid->origo[0] , 2 );
+  if (grid->mapaxes)
+    ecl_grid_cache_write_array( writer , grid->mapaxes , sizeof * grid->mapaxes , 6 );
+
+  ecl_grid_cache_write_array( writer , grid->cells , sizeof * grid->cells , grid->size );
+  ecl_grid_cache_write_corners( writer , grid );
+
+  ecl_grid_cache_write_array( writer , grid->index_map , sizeof * grid->index_map , grid->size );
+  ecl_grid_cache_write_array( writer , grid->inv_index_map , sizeof * grid->inv_index_map , grid->total_active );
+  if (grid->dualp_flag != FILEHEAD_SINGLE_POROSITY) {
+    ecl_grid_cache_write_array( writer , grid->fracture_index_map , sizeof * grid->fracture_index_map , grid->size );
+    ecl_grid_cache_write_array( writer , grid->inv_fracture_index_map , sizeof * grid->inv_fracture_index_map , grid->total_active_fracture );
+  }
+
+  if (grid->coord_kw)
+    ecl_grid_cache_write_array( writer , ecl_kw_get_void_ptr( grid->coord_kw ) , sizeof(float) , ecl_kw_get_size( grid->coord_kw ) );
+
+  ecl_grid_cache_write_nnc( writer , grid );
+}
+
+
+/*
+  Will allocate a grid and load the content from the cache data; the
+  cells and the compact corners of the grid point directly into the
+  cache data. The lgr relationships are established by the calling
+  scope. Will return NULL if the content is not as expected.
+*/
+
+static ecl_grid_type * ecl_grid_cache_read_grid( ecl_grid_cache_reader_type * reader , ecl_grid_type * main_grid) {
+  int header[ECL_GRID_CACHE_HEADER_SIZE];
+  int i;
+  for (i = 0; i < ECL_GRID_CACHE_HEADER_SIZE; i++)
+    if (!ecl_grid_cache_read_int( reader , &header[i] ))
+      return NULL;
+
+  {
+    const int lgr_nr                = header[0];
+    const int nx                    = header[1];
+    const int ny                    = header[2];
+    const int nz                    = header[3];
+    const int dualp_flag            = header[4];
+    const int total_active          = header[5];
+    const int total_active_fracture = header[6];
+    const bool has_mapaxes          = (header[11] != 0);
+    const int coord_size            = header[12];
+    ecl_grid_type * grid;
+
+    if ((nx <= 0) || (ny <= 0) || (nz <= 0) || (coord_size < 0))
+      return NULL;
+
+    if ((total_active < 0) || (total_active > nx*ny*nz) || (total_active_fracture < 0) || (total_active_fracture > nx*ny*nz))
+      return NULL;
+
+    if ((main_grid == NULL) != (lgr_nr == ECL_GRID_MAINGRID_LGR_NR))
+      return NULL;
+
+    grid = ecl_grid_alloc_empty__( main_grid , dualp_flag , nx , ny , nz , lgr_nr , false , true , false );
+    grid->cells_mapped          = true;
+    grid->total_active          = total_active;
+    grid->total_active_fracture = total_active_fracture;
+    grid->coarsening_active     = (header[7] != 0);
+    grid->use_mapaxes           = (header[8] != 0);
+    grid->unit_system           = header[9];
+    grid->eclipse_version       = header[10];
+
+    grid->index_map     = util_malloc( grid->size * sizeof * grid->index_map );
+    grid->inv_index_map = util_malloc( grid->total_active * sizeof * grid->inv_index_map );
+    if (dualp_flag != FILEHEAD_SINGLE_POROSITY) {
+      grid->fracture_index_map     = util_malloc( grid->size * sizeof * grid->fracture_index_map );
+      grid->inv_fracture_index_map = util_malloc( grid->total_active_fracture * sizeof * grid->inv_fracture_index_map );
+    }
+    if (has_mapaxes)
+      grid->mapaxes = util_malloc( 6 * sizeof * grid->mapaxes );
+    if (coord_size > 0)
+      grid->coord_kw = ecl_kw_alloc( COORD_KW , coord_size , ECL_FLOAT );
+
+    {
+      bool ok = ecl_grid_cache_read_string( reader , &grid->name ) &&
+                ecl_grid_cache_read_string( reader , &grid->parent_name ) &&
+                ecl_grid_cache_read_array( reader , grid->unit_x , sizeof grid->unit_x[0] , 2 ) &&
+                ecl_grid_cache_read_array( reader , grid->unit_y , sizeof grid->unit_y[0] , 2 ) &&
+                ecl_grid_cache_read_array( reader , grid->origo , sizeof grid->origo[0] , 2 );
+
+      if (ok && has_mapaxes)
+        ok = ecl_grid_cache_read_array( reader , grid->mapaxes , sizeof * grid->mapaxes , 6 );
+
+      if (ok) {
+        grid->cells = ecl_grid_cache_get_array( reader , sizeof * grid->cells , grid->size );
+        ok = (grid->cells != NULL) &&
+             ecl_grid_cache_read_array( reader , &grid->compact_origin , sizeof grid->compact_origin , 1 );
+      }
+
+      if (ok) {
+        grid->compact_corners = ecl_grid_cache_get_array( reader , sizeof * grid->compact_corners , (size_t) grid->size * CELL_CORNER_FLOATS );
+        ok = (grid->compact_corners != NULL);
+      }
+
+      if (ok)
+        ok = ecl_grid_cache_read_array( reader , grid->index_map , sizeof * grid->index_map , grid->size ) &&
+             ecl_grid_cache_read_array( reader , grid->inv_index_map , sizeof * grid->inv_index_map , grid->total_active );
+
+      if (ok && (dualp_flag != FILEHEAD_SINGLE_POROSITY))
+        ok = ecl_grid_cache_read_array( reader , grid->fracture_index_map , sizeof * grid->fracture_index_map , grid->size ) &&
+             ecl_grid_cache_read_array( reader , grid->inv_fracture_index_map , sizeof * grid->inv_fracture_index_map , grid->total_active_fracture );
+
+      if (ok && grid->coord_kw)
+        ok = ecl_grid_cache_read_array( reader , ecl_kw_get_void_ptr( grid->coord_kw ) , sizeof(float) , coord_size );
+
+      if (ok)
+        ok = ecl_grid_cache_read_nnc( reader , grid );
+
+      if (!ok) {
+        ecl_grid_free( grid );
+        return NULL;
+      }
+    }
+
+    ecl_grid_init_coarse_cells( grid );
+    return grid;
+  }
+}
+
+
+static bool ecl_grid_cache_write_file( const ecl_grid_type * grid , FILE * stream , int64_t source_size , int64_t source_mtime , uint64_t checksum) {
+  ecl_grid_cache_writer_type writer;
+  writer.stream = stream;
+  writer.pos = 0;
+  writer.ok = true;
+
+  {
+    int num_lgr = vector_get_size( grid->LGR_list );
+    int lgr_index;
+
+    ecl_grid_cache_write( &writer , ECL_GRID_CACHE_MAGIC , 1 , strlen( ECL_GRID_CACHE_MAGIC ));
+    ecl_grid_cache_write_int( &writer , ECL_GRID_CACHE_VERSION );
+    ecl_grid_cache_write_int( &writer , sizeof(ecl_cell_type) );
+    ecl_grid_cache_write_int( &writer , sizeof(point_type) );
+    ecl_grid_cache_write_int( &writer , num_lgr + 1 );
+    ecl_grid_cache_write( &writer , &source_size , sizeof source_size , 1 );
+    ecl_grid_cache_write( &writer , &source_mtime , sizeof source_mtime , 1 );
+    ecl_grid_cache_write( &writer , &checksum , sizeof checksum , 1 );
+
+    ecl_grid_cache_write_grid( &writer , grid );
+    for (lgr_index = 0; lgr_index < num_lgr; lgr_index++)
+      ecl_grid_cache_write_grid( &writer , vector_iget_const( grid->LGR_list , lgr_index ));
+  }
+
+  if (fclose( writer.stream ) != 0)
+    writer.ok = false;
+
+  return writer.ok;
+}
+
+
+/*
+  Will create a new temporary file next to @cache_file; the file is
+  opened in exclusive mode ("wx", i.e. O_CREAT|O_EXCL) and the name
+  contains the pid, so concurrent writers will never share a
+  temporary file. Returns NULL if no file could be created.
+*/
+
+static FILE * ecl_grid_cache_fopen_tmp( const char * cache_file , char ** tmp_file ) {
+#ifdef ERT_HAVE_UNISTD
+  const int pid = getpid();
+#else
+  const int pid = 0;
+#endif
+  int attempt;
+
+  for (attempt = 0; attempt < 1000; attempt++) {
+    FILE * stream;
+    *tmp_file = util_alloc_sprintf("%s.%d.%d.tmp" , cache_file , pid , attempt);
+    stream = util_fopen__( *tmp_file , "wx");
+    if (stream)
+      return stream;
+
+    free( *tmp_file );
+    *tmp_file = NULL;
+    if (errno != EEXIST)
+      break;
+  }
+  return NULL;
+}
+
+
+/*
+  Will write a cache of the grid to @cache_file, the cache is keyed
+  on the size, modification time and checksum of @source_file, which
+  should be the GRID/EGRID file the grid was loaded from. The cache is
+  first written to a temporary file private to this writer, which is
+  renamed to @cache_file when it is complete; a reader will never see
+  a partially written cache file, and when several processes write
+  the same cache the last rename wins. Will return false if the
+  source file can not be read, or the cache file can not be written.
+*/
+
+bool ecl_grid_fwrite_cache( const ecl_grid_type * grid , const char * cache_file , const char * source_file) {
+  int64_t source_size, source_mtime;
+  uint64_t checksum;
+  bool ok;
+
+  if (grid->lgr_nr != ECL_GRID_MAINGRID_LGR_NR)
+    util_abort("%s: tried to write cache for lgr:%s - only the main grid can be cached\n",__func__ , grid->name);
+
+  if (!ecl_grid_cache_source_key( source_file , &source_size , &source_mtime ))
+    return false;
+
+  if (!ecl_grid_cache_checksum( source_file , &checksum ))
+    return false;
+
+  {
+    char * tmp_file = NULL;
+    FILE * stream = ecl_grid_cache_fopen_tmp( cache_file , &tmp_file );
+    if (stream == NULL)
+      return false;
+
+    ok = ecl_grid_cache_write_file( grid , stream , source_size , source_mtime , checksum );
+    if (ok)
+      ok = (rename( tmp_file , cache_file ) == 0);
+
+    if (!ok)
+      remove( tmp_file );
+
+    free( tmp_file );
+  }
+  return ok;
+}
+
+
+static ecl_grid_type * ecl_grid_cache_read_grids( ecl_grid_cache_reader_type * reader , int num_grids) {
+  ecl_grid_type * main_grid = ecl_grid_cache_read_grid( reader , NULL );
+  if (main_grid) {
+    int grid_nr;
+    for (grid_nr = 1; grid_nr < num_grids; grid_nr++) {
+      ecl_grid_type * lgr_grid = ecl_grid_cache_read_grid( reader , main_grid );
+      ecl_grid_type * host_grid;
+
+      if (lgr_grid == NULL || lgr_grid->name == NULL) {
+        if (lgr_grid)
+          ecl_grid_free( lgr_grid );
+        ecl_grid_free( main_grid );
+        return NULL;
+      }
+
+      ecl_grid_add_lgr( main_grid , lgr_grid );
+      if (lgr_grid->parent_name == NULL)
+        host_grid = main_grid;
+      else
+        host_grid = ecl_grid_get_lgr( main_grid , lgr_grid->parent_name );
+
+      {
+        int global_lgr_index;
+        for (global_lgr_index = 0; global_lgr_index < lgr_grid->size; global_lgr_index++) {
+          ecl_cell_type * lgr_cell = ecl_grid_get_cell( lgr_grid , global_lgr_index );
+          ecl_grid_install_cell_lgr( host_grid , lgr_cell->host_cell , lgr_grid );
+        }
+      }
+      ecl_grid_install_lgr_common( host_grid , lgr_grid );
+    }
+  }
+  return main_grid;
+}
+
+
+/*
+  Will load a grid from the cache file @cache_file. If the cache file
+  does not exist, is not compatible with the current library, or the
+  size or modification time of @source_file has changed since the
+  cache was created the function will return NULL. If
+  @verify_checksum is true the complete source file is also read and
+  compared with the checksum stored in the cache. The modification
+  time only has a resolution of one second, so without the checksum
+  a rewrite of the same size within that second goes undetected.
+
+  The returned grid is compact, and keeps the cache file mapped until
+  it is freed.
+*/
+
+ecl_grid_type * ecl_grid_fread_cache( const char * cache_file , const char * source_file , bool verify_checksum) {
+  ecl_grid_cache_reader_type reader;
+  ecl_grid_type * main_grid = NULL;
+
+  if (!util_file_exists( cache_file ))
+    return NULL;
+
+  if (!ecl_grid_cache_load_data( cache_file , &reader ))
+    return NULL;
+
+  {
+    int header[4];
+    int64_t cache_source_size, cache_source_mtime;
+    uint64_t cache_checksum;
+    bool valid = (reader.size >= strlen( ECL_GRID_CACHE_MAGIC )) &&
+                 (memcmp( reader.data , ECL_GRID_CACHE_MAGIC , strlen( ECL_GRID_CACHE_MAGIC )) == 0);
+
+    reader.offset = strlen( ECL_GRID_CACHE_MAGIC );
+    if (valid)
+      valid = ecl_grid_cache_read( &reader , header , sizeof header ) &&
+              ecl_grid_cache_read( &reader , &cache_source_size , sizeof cache_source_size ) &&
+              ecl_grid_cache_read( &reader , &cache_source_mtime , sizeof cache_source_mtime ) &&
+              ecl_grid_cache_read( &reader , &cache_checksum , sizeof cache_checksum );
+
+    if (valid)
+      valid = (header[0] == ECL_GRID_CACHE_VERSION) &&
+              (header[1] == sizeof(ecl_cell_type)) &&
+              (header[2] == sizeof(point_type)) &&
+              (header[3] > 0);
+
+    if (valid) {
+      int64_t source_size, source_mtime;
+      valid = ecl_grid_cache_source_key( source_file , &source_size , &source_mtime ) &&
+              (source_size == cache_source_size) &&
+              (source_mtime == cache_source_mtime);
+    }
+
+    if (valid && verify_checksum) {
+      uint64_t checksum;
+      valid = ecl_grid_cache_checksum( source_file , &checksum ) &&
+              (checksum == cache_checksum);
+    }
+
+    if (valid)
+      main_grid = ecl_grid_cache_read_grids( &reader , header[3] );
+  }
+
+  if (main_grid) {
+    main_grid->cache_data = reader.data;
+    main_grid->cache_size = reader.size;
+  } else
+    ecl_grid_cache_release_data( reader.data , reader.size );
+
+  return main_grid;
+}
+
+
+/*
+  Like ecl_grid_load_case(), but will use the cache file @cache_file
+  if it is valid for the grid file; otherwise the grid file is loaded
+  and the cache file is (re)created. If @cache_file is NULL the cache
+  is stored as "<grid_file>.cache" next to the grid file. The size and
+  modification time of the grid file are only used to reject a stale
+  cache quickly; before the cache is used the checksum of the grid
+  file is verified. The grid is always compact, also when the cache is
+  created. Failure to write the cache file is not an error.
+*/
+
+ecl_grid_type * ecl_grid_load_case_cached( const char * case_input , const char * cache_file) {
+  ecl_grid_type * ecl_grid = NULL;
+  char * grid_file = ecl_grid_alloc_case_filename( case_input );
+  if (grid_file != NULL) {
+    if (util_file_exists( grid_file )) {
+      char * cache_filename = cache_file ? util_alloc_string_copy( cache_file ) : util_alloc_sprintf("%s.cache" , grid_file);
+
+      ecl_grid = ecl_grid_fread_cache( cache_filename , grid_file , true );
+      if (ecl_grid == NULL) {
+        ecl_grid = ecl_grid_alloc_compact( grid_file );
+        if (ecl_grid)
+          ecl_grid_fwrite_cache( ecl_grid , cache_filename , grid_file );
+      }
+      free( cache_filename );
+    }
+    free( grid_file );
+  }
+  return ecl_grid;
+}
+
+
+static bool ecl_grid_compare_coarse_cells(const ecl_grid_type * g1 , const ecl_grid_type * g2, bool verbose) {
+  if (vector_get_size( g1->coarse_cells ) == vector_get_size( g2->coarse_cells )) {
+    bool equal = true;
+    int c;
+
+    for (c = 0; c < vector_get_size( g1->coarse_cells ); c++) {
+      const ecl_coarse_cell_type * coarse_cell1 = vector_iget_const( g1->coarse_cells , c);
+      const ecl_coarse_cell_type * coarse_cell2 = vector_iget_const( g2->coarse_cells , c);
+
+      equal = ecl_coarse_cell_equal( coarse_cell1 , coarse_cell2 );
+      if (!equal)
+        if (verbose) fprintf(stderr,"Difference in coarse cell:%d \n",c );
+
+    }
+    return equal;
+  } else
+    return false;
+}
+
+
+static bool ecl_grid_compare_cells(const ecl_grid_type * g1 , const ecl_grid_type * g2, bool include_nnc , bool verbose) {
+  int g;
+  bool equal = true;
+  for (g = 0; g < g1->size; g++) {
+    bool this_equal = true;
+    ecl_cell_type *c1 = ecl_grid_get_cell( g1 , g );
+    ecl_cell_type *c2 = ecl_grid_get_cell( g2 , g );
+    point_type buffer1[8];
+    point_type buffer2[8];
+    const point_type * corners1 = ecl_grid_get_cell_corners( g1 , g , buffer1 );
+    const point_type * corners2 = ecl_grid_get_cell_corners( g2 , g , buffer2 );
+    const nnc_info_type * nnc_info1 = ecl_grid_get_cell_nnc_info__( g1 , g );
+    const nnc_info_type * nnc_info2 = ecl_grid_get_cell_nnc_info__( g2 , g );
+
+    ecl_cell_compare(c1 , c2 , &this_equal);
+    if (this_equal)
+      ecl_cell_compare_corners( corners1 , corners2 , &this_equal );
+
+    if (include_nnc) {
+      if (this_equal)
+        this_equal = nnc_info_equal( nnc_info1 , nnc_info2 );
+    }
+
+    if (!this_equal) {
+      if (verbose) {
+        int i,j,k;
+        ecl_grid_get_ijk1( g1 , g , &i , &j , &k);
+
+        printf("Difference in cell: %d : %d,%d,%d  nnc_equal:%d Volume:%g \n",g,i,j,k , nnc_info_equal( nnc_info1 , nnc_info2) , ecl_cell_get_volume( c1 , corners1 ));
+        printf("-----------------------------------------------------------------\n");
+        ecl_cell_dump_ascii( c1 , corners1 , i , j , k , stdout , NULL);
+        printf("-----------------------------------------------------------------\n");
+        ecl_cell_dump_ascii( c2 , corners2 , i , j , k , stdout , NULL );
+        printf("-----------------------------------------------------------------\n");
+
+      }
+      equal = false;
+      break;
+    }
+  }
+  return equal;
+}
+
+static bool ecl_grid_compare_index(const ecl_grid_type * g1 , const ecl_grid_type * g2, bool verbose) {
+  bool equal = true;
+
+  if (g1->total_active != g2->total_active) {
+    if (verbose)
+      fprintf(stderr,"Difference in total active:%d / %d\n",g1->total_active , g2->total_active);
+    equal = false;
   }
 
   if (equal) {
@@ -3834,23 +5115,23 @@ typedef enum {NOT_ON_FACE, BELONGS_TO_CELL, BELONGS_TO_OTHER} face_status_enum;
     Returns whether the given point is contained within the minimal cube
     encapsulating the cell that has all faces parallel to a coordinate plane.
 */
-static bool ecl_grid_cube_contains(const ecl_cell_type * cell, const point_type * p) {
-  if (p->z < ecl_cell_min_z( cell ))
+static bool ecl_grid_cube_contains(const point_type * corner_list, const point_type * p) {
+  if (p->z < ecl_cell_min_z( corner_list ))
     return false;
 
-  if (p->z > ecl_cell_max_z( cell ))
+  if (p->z > ecl_cell_max_z( corner_list ))
     return false;
 
-  if (p->x < ecl_cell_min_x( cell ))
+  if (p->x < ecl_cell_min_x( corner_list ))
     return false;
 
-  if (p->x > ecl_cell_max_x( cell ))
+  if (p->x > ecl_cell_max_x( corner_list ))
     return false;
 
-  if (p->y < ecl_cell_min_y( cell ))
+  if (p->y < ecl_cell_min_y( corner_list ))
     return false;
 
-  if (p->y > ecl_cell_max_y( cell ))
+  if (p->y > ecl_cell_max_y( corner_list ))
     return false;
 
   return true;
@@ -3859,11 +5140,11 @@ static bool ecl_grid_cube_contains(const ecl_cell_type * cell, const point_type
 /*
    Returns true if and only if p is on plane "plane" of cell when decomposed by "method".
 */
-static bool ecl_grid_on_plane(const ecl_cell_type * cell, const int method,
+static bool ecl_grid_on_plane(const point_type * corner_list, const int method,
         const int plane, const point_type * p) {
-  const point_type * p0 = &cell->corner_list[ tetrahedron_permutations[method][plane][0] ];
-  const point_type * p1 = &cell->corner_list[ tetrahedron_permutations[method][plane][1] ];
-  const point_type * p2 = &cell->corner_list[ tetrahedron_permutations[method][plane][2] ];
+  const point_type * p0 = &corner_list[ tetrahedron_permutations[method][plane][0] ];
+  const point_type * p1 = &corner_list[ tetrahedron_permutations[method][plane][1] ];
+  const point_type * p2 = &corner_list[ tetrahedron_permutations[method][plane][2] ];
   return triangle_contains3d(p0, p1, p2, p);
 }
 
@@ -3885,7 +5166,7 @@ static bool ecl_grid_on_plane(const ecl_cell_type * cell, const int method,
    Note: The correctness of this function relies *HEAVILY* on the permutation of the
    tetrahedrons in the decompositions.
 */
-static face_status_enum ecl_grid_on_cell_face(const ecl_cell_type * cell, const int method,
+static face_status_enum ecl_grid_on_cell_face(const point_type * corner_list, const int method,
         const point_type * p,
         const bool max_i, const bool max_j, const bool max_k) {
 
@@ -3893,8 +5174,8 @@ static face_status_enum ecl_grid_on_cell_face(const ecl_cell_type * cell, const
   bool on[6];
   for(int i = 0; i < 6; ++i) {
     on[i] = (
-        ecl_grid_on_plane(cell, method, 2*i, p) ||
-        ecl_grid_on_plane(cell, method, 2*i+1, p)
+        ecl_grid_on_plane(corner_list, method, 2*i, p) ||
+        ecl_grid_on_plane(corner_list, method, 2*i+1, p)
             );
   }
 
@@ -3976,27 +5257,27 @@ static bool tetrahedron_positive_volume(const point_type * p0,
 
  Note: This function relies *HEAVILY* on the permutation of tetrahedron_permutations.
 */
-static bool concave_cell_contains( const ecl_cell_type * cell, int method, const point_type * p) {
+static bool concave_cell_contains( const point_type * corner_list, int method, const point_type * p) {
 
   const point_type * dia[2][2] = {
       {
-          &cell->corner_list[tetrahedron_permutations[method][0][1]],
-          &cell->corner_list[tetrahedron_permutations[method][0][2]]
+          &corner_list[tetrahedron_permutations[method][0][1]],
+          &corner_list[tetrahedron_permutations[method][0][2]]
       },
       {
-          &cell->corner_list[tetrahedron_permutations[method][10][1]],
-          &cell->corner_list[tetrahedron_permutations[method][10][2]]
+          &corner_list[tetrahedron_permutations[method][10][1]],
+          &corner_list[tetrahedron_permutations[method][10][2]]
       }
   };
 
   const point_type * extra[2][2] = {
       {
-          &cell->corner_list[tetrahedron_permutations[method][0][0]],
-          &cell->corner_list[tetrahedron_permutations[method][1][0]]
+          &corner_list[tetrahedron_permutations[method][0][0]],
+          &corner_list[tetrahedron_permutations[method][1][0]]
       },
       {
-          &cell->corner_list[tetrahedron_permutations[method][10][0]],
-          &cell->corner_list[tetrahedron_permutations[method][11][0]]
+          &corner_list[tetrahedron_permutations[method][10][0]],
+          &corner_list[tetrahedron_permutations[method][11][0]]
       }
   };
 
@@ -4048,15 +5329,19 @@ static bool concave_cell_contains( const ecl_cell_type * cell, int method, const
 */
 bool ecl_grid_cell_contains_xyz3( const ecl_grid_type * ecl_grid , int i, int j , int k, double x , double y , double z) {
   point_type p;
-  ecl_cell_type * cell = ecl_grid_get_cell( ecl_grid , ecl_grid_get_global_index3( ecl_grid , i, j , k ));
+  point_type buffer[8];
+  const int global_index = ecl_grid_get_global_index3( ecl_grid , i, j , k );
+  ecl_cell_type * cell = ecl_grid_get_cell( ecl_grid , global_index );
   point_set( &p , x , y , z);
   int method = (i + j + k) % 2; // Chooses the approperiate decomposition method for the cell
 
   if (GET_CELL_FLAG(cell , CELL_FLAG_TAINTED))
     return false;
 
+  const point_type * corner_list = ecl_grid_get_cell_corners( ecl_grid , global_index , buffer );
+
   // Pruning
-  if (!ecl_grid_cube_contains(cell, &p))
+  if (!ecl_grid_cube_contains(corner_list, &p))
     return false;
 
   // Checks if point is on one of the faces of the cell, and if so whether it
@@ -4064,7 +5349,7 @@ bool ecl_grid_cell_contains_xyz3( const ecl_grid_type * ecl_grid , int i, int j
   bool max_i = (i == ecl_grid->nx-1);
   bool max_j = (j == ecl_grid->ny-1);
   bool max_k = (k == ecl_grid->nz-1);
-  face_status_enum face_status = ecl_grid_on_cell_face(cell, method, &p, max_i, max_j, max_k);
+  face_status_enum face_status = ecl_grid_on_cell_face(corner_list, method, &p, max_i, max_j, max_k);
 
   if(face_status != NOT_ON_FACE) {
     // Since we might get false positives in the case when the cells
@@ -4076,13 +5361,13 @@ bool ecl_grid_cell_contains_xyz3( const ecl_grid_type * ecl_grid , int i, int j
   }
 
   // Twisted cells
-  if (ecl_cell_get_twist(cell) > 0) {
+  if (ecl_cell_get_twist(corner_list) > 0) {
     fprintf(stderr, "** Warning: Point (%g,%g,%g) is in vicinity of twisted cell: (%d,%d,%d) - function:%s might be mistaken.\n", x,y,z,i,j,k, __func__);
     return false;
   }
 
   // We now check whether the point is strictly inside the cell
-  return concave_cell_contains(cell, method, &p);
+  return concave_cell_contains(corner_list, method, &p);
 }
 
 
@@ -4101,10 +5386,12 @@ bool ecl_grid_cell_contains_xyz1( const ecl_grid_type * ecl_grid , int global_in
 int ecl_grid_get_global_index_from_xy( const ecl_grid_type * ecl_grid , int k , bool lower_layer , double x , double y) {
 
   int i,j;
+  point_type buffer[8];
   for (j=0; j < ecl_grid->ny; j++)
     for (i=0; i < ecl_grid->nx; i++) {
       int global_index = ecl_grid_get_global_index3( ecl_grid , i , j , k );
-      if (ecl_cell_layer_contains_xy( ecl_grid_get_cell( ecl_grid , global_index ) , lower_layer , x , y))
+      const point_type * corner_list = ecl_grid_get_cell_corners( ecl_grid , global_index , buffer );
+      if (ecl_cell_layer_contains_xy( ecl_grid_get_cell( ecl_grid , global_index ) , corner_list , lower_layer , x , y))
         return global_index;
     }
   return -1; /* Did not find x,y */
@@ -4121,61 +5408,368 @@ int ecl_grid_get_global_index_from_xy_bottom( const ecl_grid_type * ecl_grid , d
 }
 
 
-static void ecl_grid_clear_visited( ecl_grid_type * grid ) {
-  if (grid->visited == NULL)
-    grid->visited = util_calloc( grid->size , sizeof * grid->visited );
+/*
+  Spatial index for xyz lookup
+  ----------------------------
+
+  To find the cell containing a point (x,y,z) we must in principle
+  check all the cells of the grid with ecl_grid_cell_contains_xyz1(),
+  which is quite expensive. To avoid that the grid has a spatial
+  index which is created the first time it is needed:
+
+    1. For every (i,j) column the cells are grouped in blocks of
+       SEARCH_BLOCK_SIZE layers, and we store the bounding box of each
+       block and the bounding box of the whole column.
+
+    2. The xy extent of the grid is divided in a regular 2D mesh of
+       bins, with roughly one bin per column. For every bin we store
+       the list of columns whose bounding box overlaps the bin.
+
+  A lookup will then find the bin of the point, check the columns in
+  the bin against the column bounding box, then the k blocks against
+  the block bounding box and finally the candidate cells with
+  ecl_grid_cell_contains_xyz1().
+
+  Cells which are tainted or do not have a valid geometry are not
+  included in the index. The search index is not modified after it has
+  been created, i.e. when ecl_grid_init_search_index() has been called
+  the lookup functions can be called from several threads on the same
+  grid.
+*/
+
+#define SEARCH_BLOCK_SIZE 8
+
+typedef struct {
+  double xmin , xmax;
+  double ymin , ymax;
+  double zmin , zmax;
+} search_box_type;
+
+
+struct ecl_grid_search_index_struct {
+  int               num_blocks;     /* Number of k blocks in each column. */
+  search_box_type * column_box;     /* nx*ny column bounding boxes. */
+  search_box_type * block_box;      /* nx*ny*num_blocks bounding boxes; block b of column c at c*num_blocks + b. */
+
+  double            x0 , y0;        /* Origin of the bin mesh. */
+  double            bin_dx , bin_dy;
+  int               nbx , nby;
+  int             * bin_offset;     /* The columns of bin b are bin_columns[bin_offset[b]] ... bin_columns[bin_offset[b+1] - 1]. */
+  int             * bin_columns;
+};
+
+
+static void search_box_init( search_box_type * box ) {
+  box->xmin = box->ymin = box->zmin =  DBL_MAX;
+  box->xmax = box->ymax = box->zmax = -DBL_MAX;
+}
+
+
+static void search_box_add_point( search_box_type * box , const point_type * p) {
+  box->xmin = util_double_min( box->xmin , p->x );
+  box->xmax = util_double_max( box->xmax , p->x );
+  box->ymin = util_double_min( box->ymin , p->y );
+  box->ymax = util_double_max( box->ymax , p->y );
+  box->zmin = util_double_min( box->zmin , p->z );
+  box->zmax = util_double_max( box->zmax , p->z );
+}
+
+
+static void search_box_add_box( search_box_type * box , const search_box_type * other) {
+  box->xmin = util_double_min( box->xmin , other->xmin );
+  box->xmax = util_double_max( box->xmax , other->xmax );
+  box->ymin = util_double_min( box->ymin , other->ymin );
+  box->ymax = util_double_max( box->ymax , other->ymax );
+  box->zmin = util_double_min( box->zmin , other->zmin );
+  box->zmax = util_double_max( box->zmax , other->zmax );
+}
+
+
+static bool search_box_empty( const search_box_type * box ) {
+  return (box->xmin > box->xmax);
+}
+
+
+static bool search_box_contains( const search_box_type * box , double x , double y , double z) {
+  return ((x >= box->xmin) && (x <= box->xmax) &&
+          (y >= box->ymin) && (y <= box->ymax) &&
+          (z >= box->zmin) && (z <= box->zmax));
+}
+
+
+static int ecl_grid_search_index_get_bin( const ecl_grid_search_index_type * search_index , double x , double y , int * bin_i , int * bin_j) {
+  int bi = (int) floor( (x - search_index->x0) / search_index->bin_dx );
+  int bj = (int) floor( (y - search_index->y0) / search_index->bin_dy );
+
+  *bin_i = util_int_min( util_int_max( bi , 0 ) , search_index->nbx - 1);
+  *bin_j = util_int_min( util_int_max( bj , 0 ) , search_index->nby - 1);
+  return *bin_i + *bin_j * search_index->nbx;
+}
+
+
+static void ecl_grid_search_index_init_bins( ecl_grid_search_index_type * search_index , int num_columns) {
+  search_box_type extent;
+  int c;
+
+  search_box_init( &extent );
+  for (c = 0; c < num_columns; c++)
+    if (!search_box_empty( &search_index->column_box[c] ))
+      search_box_add_box( &extent , &search_index->column_box[c] );
+
+  if (search_box_empty( &extent )) {
+    search_index->x0 = search_index->y0 = 0;
+    search_index->bin_dx = search_index->bin_dy = 1;
+    search_index->nbx = search_index->nby = 1;
+  } else {
+    double width  = extent.xmax - extent.xmin;
+    double height = extent.ymax - extent.ymin;
+
+    if (width <= 0)
+      width = 1;
+
+    if (height <= 0)
+      height = 1;
+
+    search_index->nbx = util_int_max( 1 , (int) ceil( sqrt( num_columns * width / height )));
+    search_index->nby = util_int_max( 1 , (int) ceil( 1.0 * num_columns / search_index->nbx ));
+    search_index->x0 = extent.xmin;
+    search_index->y0 = extent.ymin;
+    search_index->bin_dx = width / search_index->nbx;
+    search_index->bin_dy = height / search_index->nby;
+  }
 
+  /*
+    The bin lists are assembled in two passes; first counting the
+    number of columns in each bin, and then filling in the column
+    indices.
+  */
   {
-    int i;
-    for (i=0; i < grid->size; i++)
-      grid->visited[i] = false;
+    const int num_bins = search_index->nbx * search_index->nby;
+    int * bin_fill = util_calloc( num_bins , sizeof * bin_fill );
+    int pass;
+    int b;
+
+    search_index->bin_offset = util_calloc( num_bins + 1 , sizeof * search_index->bin_offset );
+    for (b = 0; b <= num_bins; b++)
+      search_index->bin_offset[b] = 0;
+
+    for (pass = 0; pass < 2; pass++) {
+      for (b = 0; b < num_bins; b++)
+        bin_fill[b] = 0;
+
+      for (c = 0; c < num_columns; c++) {
+        const search_box_type * box = &search_index->column_box[c];
+        if (!search_box_empty( box )) {
+          int bi1 , bj1 , bi2 , bj2;
+          int bi , bj;
+
+          ecl_grid_search_index_get_bin( search_index , box->xmin , box->ymin , &bi1 , &bj1);
+          ecl_grid_search_index_get_bin( search_index , box->xmax , box->ymax , &bi2 , &bj2);
+          for (bj = bj1; bj <= bj2; bj++) {
+            for (bi = bi1; bi <= bi2; bi++) {
+              int bin = bi + bj * search_index->nbx;
+              if (pass == 0)
+                search_index->bin_offset[bin + 1]++;
+              else
+                search_index->bin_columns[ search_index->bin_offset[bin] + bin_fill[bin] ] = c;
+              bin_fill[bin]++;
+            }
+          }
+        }
+      }
+
+      if (pass == 0) {
+        for (b = 0; b < num_bins; b++)
+          search_index->bin_offset[b + 1] += search_index->bin_offset[b];
+        search_index->bin_columns = util_calloc( util_int_max( 1 , search_index->bin_offset[num_bins] ) , sizeof * search_index->bin_columns );
+      }
+    }
+    free( bin_fill );
+  }
+}
+
+
+static ecl_grid_search_index_type * ecl_grid_search_index_alloc( const ecl_grid_type * grid ) {
+  ecl_grid_search_index_type * search_index = util_malloc( sizeof * search_index );
+  const int num_columns = grid->nx * grid->ny;
+  int c;
+
+  search_index->num_blocks = (grid->nz + SEARCH_BLOCK_SIZE - 1) / SEARCH_BLOCK_SIZE;
+  search_index->column_box = util_calloc( num_columns , sizeof * search_index->column_box );
+  search_index->block_box  = util_calloc( (size_t) num_columns * util_int_max( 1 , search_index->num_blocks ) , sizeof * search_index->block_box );
+
+  for (c = 0; c < num_columns; c++) {
+    search_box_type * column_box = &search_index->column_box[c];
+    int b;
+
+    search_box_init( column_box );
+    for (b = 0; b < search_index->num_blocks; b++) {
+      search_box_type * block_box = &search_index->block_box[ c * search_index->num_blocks + b ];
+      int k1 = b * SEARCH_BLOCK_SIZE;
+      int k2 = util_int_min( grid->nz , k1 + SEARCH_BLOCK_SIZE );
+      int k;
+
+      search_box_init( block_box );
+      for (k = k1; k < k2; k++) {
+        const int global_index = c + k * num_columns;
+        const ecl_cell_type * cell = ecl_grid_get_cell( grid , global_index );
+
+        if (GET_CELL_FLAG( cell , CELL_FLAG_VALID ) && !GET_CELL_FLAG( cell , CELL_FLAG_TAINTED )) {
+          point_type buffer[8];
+          const point_type * corner_list = ecl_grid_get_cell_corners( grid , global_index , buffer );
+          int corner;
+
+          for (corner = 0; corner < 8; corner++)
+            search_box_add_point( block_box , &corner_list[corner] );
+        }
+      }
+
+      if (!search_box_empty( block_box ))
+        search_box_add_box( column_box , block_box );
+    }
   }
+
+  ecl_grid_search_index_init_bins( search_index , num_columns );
+  return search_index;
+}
+
+
+static void ecl_grid_search_index_free( ecl_grid_search_index_type * search_index ) {
+  free( search_index->column_box );
+  free( search_index->block_box );
+  free( search_index->bin_offset );
+  free( search_index->bin_columns );
+  free( search_index );
 }
 
 
 /*
-   Box coordinates are not inclusive, i.e. [i1,i2)
+  Will return the lowest global index of the cells containing the
+  point, i.e. the same cell as a linear scan through the grid would
+  find.
 */
-static int ecl_grid_box_contains_xyz( const ecl_grid_type * grid , int i1, int i2 , int j1 , int j2 , int k1 , int k2 , const point_type * p) {
 
-  int i,j,k;
+static int ecl_grid_search_index_find( const ecl_grid_type * grid , const ecl_grid_search_index_type * search_index , double x , double y , double z) {
+  const int num_columns = grid->nx * grid->ny;
   int global_index = -1;
-  for (k=k1; k < k2; k++)
-    for (j=j1; j < j2; j++)
-      for (i=i1; i < i2; i++) {
-        global_index = ecl_grid_get_global_index3( grid , i , j , k);
-        if (!grid->visited[ global_index ]) {
-          grid->visited[ global_index ] = true;
-          if (ecl_grid_cell_contains_xyz1( grid , global_index , p->x , p->y , p->z )) {
-            return global_index;
+
+  if ((x < search_index->x0) || (x > search_index->x0 + search_index->nbx * search_index->bin_dx))
+    return -1;
+
+  if ((y < search_index->y0) || (y > search_index->y0 + search_index->nby * search_index->bin_dy))
+    return -1;
+
+  {
+    int bin_i , bin_j;
+    int bin = ecl_grid_search_index_get_bin( search_index , x , y , &bin_i , &bin_j );
+    int bin_pos;
+
+    for (bin_pos = search_index->bin_offset[bin]; bin_pos < search_index->bin_offset[bin + 1]; bin_pos++) {
+      const int c = search_index->bin_columns[ bin_pos ];
+      int b;
+
+      if (!search_box_contains( &search_index->column_box[c] , x , y , z ))
+        continue;
+
+      for (b = 0; b < search_index->num_blocks; b++) {
+        const int k1 = b * SEARCH_BLOCK_SIZE;
+        const int k2 = util_int_min( grid->nz , k1 + SEARCH_BLOCK_SIZE );
+        int k;
+
+        if ((global_index >= 0) && (c + k1 * num_columns > global_index))
+          break;
+
+        if (!search_box_contains( &search_index->block_box[ c * search_index->num_blocks + b ] , x , y , z))
+          continue;
+
+        for (k = k1; k < k2; k++) {
+          const int g = c + k * num_columns;
+
+          if ((global_index >= 0) && (g > global_index))
+            break;
+
+          if (ecl_grid_cell_contains_xyz1( grid , g , x , y , z )) {
+            global_index = g;
+            break;
           }
         }
       }
-  return -1;  /* Returning -1; did not find xyz. */
+    }
+  }
+
+  return global_index;
 }
 
 
 /**
- * Search for given xyz coordinate around global start_index in a box of size bx
- */
-static int ecl_grid_get_global_index_from_xyz_around_box(ecl_grid_type * grid , double x , double y , double z , int start_index, int bx, point_type * p) {
-  /* Try neighbours */
-    int i,j,k;
-    int i1,i2,j1,j2,k1,k2;
-    int nx,ny,nz;
-    ecl_grid_get_dims( grid , &nx , &ny , &nz , NULL);
-    ecl_grid_get_ijk1( grid , start_index , &i , &j , &k);
+   Will create the spatial index used by the xyz lookup functions, if
+   it has not already been created. The index is otherwise created on
+   the first lookup; if several threads should query the same grid
+   this function must be called first.
+*/
 
-    i1 = util_int_max( 0 , i - bx );
-    j1 = util_int_max( 0 , j - bx );
-    k1 = util_int_max( 0 , k - bx );
+void ecl_grid_init_search_index( ecl_grid_type * grid ) {
+  if (!grid->search_index)
+    grid->search_index = ecl_grid_search_index_alloc( grid );
+}
+
+
+/*
+  Frozen grids
+  ------------
+
+  Several of the query functions initialize state in the grid lazily:
+  the cell volumes are cached in the cells on first access, the
+  spatial index used by the xyz lookup functions is created on the
+  first lookup and the COORD keyword is created when the grid is
+  written. The function ecl_grid_freeze() will initialize all of this
+  up front, for the main grid and all the lgrs; after that the query
+  functions will not modify the grid, and the grid can be queried
+  from several threads without locking.
+
+  The functions which modify the grid, i.e. ecl_grid_reset_actnum(),
+  adding nnc and the blocking functions, will fail for a frozen grid;
+  the blocking functions store the blocked values in the grid, so a
+  thread which needs blocking should use a private copy of the grid
+  from ecl_grid_alloc_copy().
+*/
+
+static void ecl_grid_init_volume_range( ecl_grid_type * grid , int range_nr , int index1 , int index2 , void * arg) {
+  point_type buffer[8];
+  int global_index;
+  for (global_index = index1; global_index < index2; global_index++) {
+    ecl_cell_type * cell = ecl_grid_get_cell( grid , global_index );
+    ecl_cell_get_signed_volume( cell , ecl_grid_get_cell_corners( grid , global_index , buffer ));
+  }
+}
+
+
+static void ecl_grid_freeze__( ecl_grid_type * grid ) {
+  if (grid->frozen)
+    return;
+
+  {
+    int num_ranges = ecl_grid_get_num_ranges( grid->size , ECL_GRID_MIN_RANGE_SIZE );
+    ecl_grid_run_ranges( grid , grid->size , num_ranges , ecl_grid_init_volume_range , NULL );
+  }
+  ecl_grid_init_search_index( grid );
+  ecl_grid_assert_coord_kw( grid );
+  grid->frozen = true;
+}
 
-    i2 = util_int_min( nx , i + bx );
-    j2 = util_int_min( ny , j + bx );
-    k2 = util_int_min( nz , k + bx );
 
-    int global_index = ecl_grid_box_contains_xyz( grid , i1 , i2 , j1 , j2 , k1 , k2 , p);
-    return global_index;
+void ecl_grid_freeze( ecl_grid_type * grid ) {
+  if (grid->LGR_list) {
+    int lgr_index;
+    for (lgr_index = 0; lgr_index < vector_get_size( grid->LGR_list ); lgr_index++)
+      ecl_grid_freeze__( vector_iget( grid->LGR_list , lgr_index ));
+  }
+  ecl_grid_freeze__( grid );
+}
+
+
+bool ecl_grid_is_frozen( const ecl_grid_type * grid ) {
+  return grid->frozen;
 }
 
 
@@ -4185,58 +5779,50 @@ static int ecl_grid_get_global_index_from_xyz_around_box(ecl_grid_type * grid ,
    world coordinates (x,y,z), if no cell can be found the function
    will return -1.
 
-   The function is basically based on scanning through the cells in
-   natural (i fastest) order and querying whether the cell[i,j,k]
-   contains the (x,y,z) point; not very elegant :-(
+   The lookup is based on a spatial index of the grid, which is
+   created on the first call; see ecl_grid_init_search_index(). If
+   several cells contain the point the cell with the lowest global
+   index is returned.
 
    The last argument - 'start_index' - can be used to speed things up
    a bit if you have reasonable guess of where the the (x,y,z) is
-   located. The start_index value is used as this:
-
-
-     start_index == 0: I do not have a clue, start from the beginning
-        and scan through the grid linearly.
-
-
-     start_index != 0:
-        1. Check the cell 'start_index'.
-        2. Check the neighbours (i +/- 1, j +/- 1, k +/- 1 ).
-        3. Give up and do a linear search starting from start_index.
-
+   located; if start_index >= 0 that cell is checked first. Pass a
+   negative value if you do not have a clue.
 */
-int ecl_grid_get_global_index_from_xyz(ecl_grid_type * grid , double x , double y , double z , int start_index) {
-  int global_index;
-  point_type p;
-  point_set( &p , x , y , z);
-  ecl_grid_clear_visited( grid );
 
+int ecl_grid_get_global_index_from_xyz(ecl_grid_type * grid , double x , double y , double z , int start_index) {
   if (start_index >= 0) {
-    /* Try start index */
     if (ecl_grid_cell_contains_xyz1( grid , start_index , x,y,z))
       return start_index;
-    else {
-      /* Try boxes 2, 4, 8, ..., 64  */
-      for (int bx = 1; bx <= 6; bx++) {
-        global_index = ecl_grid_get_global_index_from_xyz_around_box(grid, x, y, z,
-                                                                     start_index,
-                                                                     1<<bx, &p);
-        if (global_index >= 0)
-          return global_index;
-      }
-    }
   }
 
-  /*
-    OK - the attempted shortcuts did not pay off. Perform full linear search.
-  */
+  ecl_grid_init_search_index( grid );
+  return ecl_grid_search_index_find( grid , grid->search_index , x , y , z );
+}
+
 
-  global_index = -1;
+/**
+   Will look up the global index of num_points points in one go; the
+   result for point i is stored in global_index[i] - with -1 for
+   points outside the grid. For every point the cell found for the
+   previous point is checked first, so looking up points along a well
+   trajectory is fast.
+*/
+
+void ecl_grid_get_global_index_from_xyz_list(ecl_grid_type * grid , int num_points , const double * x , const double * y , const double * z , int * global_index) {
+  int last_index = -1;
+  int ip;
+
+  ecl_grid_init_search_index( grid );
+  for (ip = 0; ip < num_points; ip++) {
+    if ((last_index >= 0) && ecl_grid_cell_contains_xyz1( grid , last_index , x[ip] , y[ip] , z[ip]))
+      global_index[ip] = last_index;
+    else
+      global_index[ip] = ecl_grid_search_index_find( grid , grid->search_index , x[ip] , y[ip] , z[ip] );
 
-  for (int index = 0; index < grid->size; index++) {
-    if (ecl_grid_cell_contains_xyz1( grid , index , x , y , z))
-      return index;
+    if (global_index[ip] >= 0)
+      last_index = global_index[ip];
   }
-  return -1;
 }
 
 bool ecl_grid_get_ijk_from_xyz(ecl_grid_type * grid , double x , double y , double z , int start_index, int *i, int *j, int *k ) {
@@ -4337,6 +5923,7 @@ bool ecl_grid_get_ij_from_xy( const ecl_grid_type * grid , double x , double y ,
 
 void ecl_grid_alloc_blocking_variables(ecl_grid_type * grid, int block_dim) {
   int index;
+  ecl_grid_assert_not_frozen( grid , __func__ );
   grid->block_dim = block_dim;
   if (block_dim == 2)
     grid->block_size = grid->nx* grid->ny; // Not supported
@@ -4354,6 +5941,7 @@ void ecl_grid_alloc_blocking_variables(ecl_grid_type * grid, int block_dim) {
 
 void ecl_grid_init_blocking(ecl_grid_type * grid) {
   int index;
+  ecl_grid_assert_not_frozen( grid , __func__ );
   for (index = 0; index < grid->block_size; index++)
     double_vector_reset(grid->values[index]);
   grid->last_block_index = 0;
@@ -4419,8 +6007,11 @@ void ecl_grid_free(ecl_grid_type * grid) {
   vector_free( grid->coarse_cells );
   hash_free( grid->children );
   util_safe_free( grid->parent_name );
-  util_safe_free( grid->visited );
+  if (grid->search_index)
+    ecl_grid_search_index_free( grid->search_index );
   util_safe_free( grid->name );
+  if (grid->cache_data)
+    ecl_grid_cache_release_data( grid->cache_data , grid->cache_size );
   free( grid );
 }
 
@@ -4434,15 +6025,15 @@ void ecl_grid_free__( void * arg ) {
 
 
 void ecl_grid_get_distance(const ecl_grid_type * grid , int global_index1, int global_index2 , double *dx , double *dy , double *dz) {
-  ecl_cell_type * cell1 = ecl_grid_get_cell( grid , global_index1);
-  ecl_cell_type * cell2 = ecl_grid_get_cell( grid , global_index2);
+  point_type center1;
+  point_type center2;
 
-  ecl_cell_assert_center( cell1 );
-  ecl_cell_assert_center( cell2 );
+  ecl_grid_get_cell_center( grid , global_index1 , &center1 );
+  ecl_grid_get_cell_center( grid , global_index2 , &center2 );
   {
-    *dx = cell1->center.x - cell2->center.x;
-    *dy = cell1->center.y - cell2->center.y;
-    *dz = cell1->center.z - cell2->center.z;
+    *dx = center1.x - center2.x;
+    *dy = center1.y - center2.y;
+    *dz = center1.z - center2.z;
   }
 }
 
@@ -4652,12 +6243,12 @@ void ecl_grid_get_ijk1A(const ecl_grid_type *ecl_grid , int active_index , int *
 
 
 void ecl_grid_get_xyz1(const ecl_grid_type * grid , int global_index , double *xpos , double *ypos , double *zpos) {
-  ecl_cell_type * cell = ecl_grid_get_cell( grid , global_index);
-  ecl_cell_assert_center( cell );
+  point_type center;
+  ecl_grid_get_cell_center( grid , global_index , &center );
   {
-    *xpos = cell->center.x;
-    *ypos = cell->center.y;
-    *zpos = cell->center.z;
+    *xpos = center.x;
+    *ypos = center.y;
+    *zpos = center.z;
   }
 }
 
@@ -4680,8 +6271,8 @@ void ecl_grid_get_xyz3(const ecl_grid_type * grid , int i, int j , int k, double
 
 void ecl_grid_get_cell_corner_xyz1(const ecl_grid_type * grid , int global_index , int corner_nr , double * xpos , double * ypos , double * zpos ) {
   if ((corner_nr >= 0) &&  (corner_nr <= 7)) {
-    const ecl_cell_type * cell  = ecl_grid_get_cell( grid , global_index );
-    const point_type      point = cell->corner_list[ corner_nr ];
+    point_type            buffer[8];
+    const point_type      point = ecl_grid_get_cell_corners( grid , global_index , buffer )[ corner_nr ];
     *xpos = point.x;
     *ypos = point.y;
     *zpos = point.z;
@@ -4736,9 +6327,9 @@ void ecl_grid_get_xyz1A(const ecl_grid_type * grid , int active_index , double *
 
 
 double ecl_grid_get_cdepth1(const ecl_grid_type * grid , int global_index) {
-  ecl_cell_type * cell = ecl_grid_get_cell( grid , global_index);
-  ecl_cell_assert_center( cell );
-  return cell->center.z;
+  point_type center;
+  ecl_grid_get_cell_center( grid , global_index , &center );
+  return center.z;
 }
 
 
@@ -4786,12 +6377,13 @@ int ecl_grid_locate_depth( const ecl_grid_type * grid , double depth , int i , i
 */
 
 double ecl_grid_get_top1(const ecl_grid_type * grid , int global_index) {
-  const ecl_cell_type * cell = ecl_grid_get_cell( grid , global_index );
+  point_type buffer[8];
+  const point_type * corner_list = ecl_grid_get_cell_corners( grid , global_index , buffer );
   double depth = 0;
   int ij;
 
   for (ij = 0; ij < 4; ij++)
-    depth += cell->corner_list[ij].z;
+    depth += corner_list[ij].z;
 
   return depth * 0.25;
 }
@@ -4828,12 +6420,13 @@ double ecl_grid_get_top1A(const ecl_grid_type * grid , int active_index) {
 */
 
 double ecl_grid_get_bottom1(const ecl_grid_type * grid , int global_index) {
-  const ecl_cell_type * cell = ecl_grid_get_cell( grid , global_index);
+  point_type buffer[8];
+  const point_type * corner_list = ecl_grid_get_cell_corners( grid , global_index , buffer );
   double depth = 0;
   int ij;
 
   for (ij = 0; ij < 4; ij++)
-    depth += cell->corner_list[ij + 4].z;
+    depth += corner_list[ij + 4].z;
 
   return depth * 0.25;
 }
@@ -4854,12 +6447,13 @@ double ecl_grid_get_bottom1A(const ecl_grid_type * grid , int active_index) {
 
 
 double ecl_grid_get_cell_dz1( const ecl_grid_type * grid , int global_index ) {
-  const ecl_cell_type * cell = ecl_grid_get_cell( grid , global_index);
+  point_type buffer[8];
+  const point_type * corner_list = ecl_grid_get_cell_corners( grid , global_index , buffer );
   double dz = 0;
   int ij;
 
   for (ij = 0; ij < 4; ij++)
-    dz += (cell->corner_list[ij + 4].z - cell->corner_list[ij].z);
+    dz += (corner_list[ij + 4].z - corner_list[ij].z);
 
   return dz * 0.25;
 }
@@ -4894,14 +6488,15 @@ double ecl_grid_get_cell_thickness1A( const ecl_grid_type * grid , int active_in
 
 
 double ecl_grid_get_cell_dx1( const ecl_grid_type * grid , int global_index ) {
-  const ecl_cell_type * cell = ecl_grid_get_cell( grid , global_index);
+  point_type buffer[8];
+  const point_type * corner_list = ecl_grid_get_cell_corners( grid , global_index , buffer );
   double dx = 0;
   double dy = 0;
   int c;
 
   for (c = 1; c < 8; c += 2) {
-    dx += cell->corner_list[c].x - cell->corner_list[c - 1].x;
-    dy += cell->corner_list[c].y - cell->corner_list[c - 1].y;
+    dx += corner_list[c].x - corner_list[c - 1].x;
+    dy += corner_list[c].y - corner_list[c - 1].y;
   }
   dx *= 0.25;
   dy *= 0.25;
@@ -4932,7 +6527,8 @@ double ecl_grid_get_cell_dx1A( const ecl_grid_type * grid , int active_index) {
 */
 
 double ecl_grid_get_cell_dy1( const ecl_grid_type * grid , int global_index ) {
-  const ecl_cell_type * cell = ecl_grid_get_cell( grid , global_index);
+  point_type buffer[8];
+  const point_type * corner_list = ecl_grid_get_cell_corners( grid , global_index , buffer );
   double dx = 0;
   double dy = 0;
 
@@ -4940,8 +6536,8 @@ double ecl_grid_get_cell_dy1( const ecl_grid_type * grid , int global_index ) {
     for (int i = 0; i < 2; i++) {
       int c1 = i + k*4;
       int c2 = c1 + 2;
-      dx += cell->corner_list[c2].x - cell->corner_list[c1].x;
-      dy += cell->corner_list[c2].y - cell->corner_list[c1].y;
+      dx += corner_list[c2].x - corner_list[c1].x;
+      dy += corner_list[c2].y - corner_list[c1].y;
     }
   }
   dx *= 0.25;
@@ -4963,8 +6559,7 @@ double ecl_grid_get_cell_dy1A( const ecl_grid_type * grid , int active_index) {
 
 
 const nnc_info_type * ecl_grid_get_cell_nnc_info1( const ecl_grid_type * grid , int global_index) {
-  const ecl_cell_type * cell = ecl_grid_get_cell( grid , global_index);
-  return cell->nnc_info;
+  return ecl_grid_get_cell_nnc_info__( grid , global_index );
 }
 
 const nnc_info_type * ecl_grid_get_cell_nnc_info3( const ecl_grid_type * grid , int i , int j , int k) {
@@ -5145,8 +6740,7 @@ ecl_grid_type * ecl_grid_get_lgr_from_lgr_nr(const ecl_grid_type * main_grid, in
 
 
 const ecl_grid_type * ecl_grid_get_cell_lgr1(const ecl_grid_type * grid , int global_index ) {
-  const ecl_cell_type * cell = ecl_grid_get_cell( grid , global_index);
-  return cell->lgr;
+  return ecl_grid_get_cell_lgr__( grid , global_index );
 }
 
 
@@ -5274,8 +6868,8 @@ bool ecl_grid_cell_regular3( const ecl_grid_type * ecl_grid, int i,int j,int k)
 */
 
 int ecl_grid_get_cell_twist1( const ecl_grid_type * ecl_grid, int global_index ) {
-  ecl_cell_type * cell = ecl_grid_get_cell( ecl_grid , global_index );
-  return ecl_cell_get_twist( cell );
+  point_type buffer[8];
+  return ecl_cell_get_twist( ecl_grid_get_cell_corners( ecl_grid , global_index , buffer ));
 }
 
 
@@ -5287,9 +6881,12 @@ int ecl_grid_get_cell_twist3(const ecl_grid_type * ecl_grid, int i, int j , int
 
 double ecl_grid_get_cell_volume1( const ecl_grid_type * ecl_grid, int global_index ) {
   ecl_cell_type * cell = ecl_grid_get_cell( ecl_grid , global_index );
-  int i,j,k;
-  ecl_grid_get_ijk1( ecl_grid , global_index, &i , &j , &k);
-  return ecl_cell_get_volume( cell );
+  if (GET_CELL_FLAG( cell , CELL_FLAG_VOLUME ))
+    return fabs( cell->volume );
+  {
+    point_type buffer[8];
+    return ecl_cell_get_volume( cell , ecl_grid_get_cell_corners( ecl_grid , global_index , buffer ));
+  }
 }
 
 
@@ -5301,8 +6898,8 @@ double ecl_grid_get_cell_volume1A( const ecl_grid_type * ecl_grid, int active_in
 
 
 double ecl_grid_get_cell_volume1_tskille( const ecl_grid_type * ecl_grid, int global_index ) {
-  ecl_cell_type * cell = ecl_grid_get_cell( ecl_grid , global_index );
-  return ecl_cell_get_volume_tskille( cell );
+  point_type buffer[8];
+  return ecl_cell_get_volume_tskille( ecl_grid_get_cell_corners( ecl_grid , global_index , buffer ));
 }
 
 
@@ -5682,10 +7279,9 @@ static void ecl_grid_dump__(const ecl_grid_type * grid , FILE * stream) {
 
   {
     int i;
-    for (i=0; i < grid->size; i++) {
-      const ecl_cell_type * cell = ecl_grid_get_cell( grid , i );
-      ecl_cell_dump( cell , stream );
-    }
+    point_type buffer[8];
+    for (i=0; i < grid->size; i++)
+      ecl_cell_dump( ecl_grid_get_cell_corners( grid , i , buffer ) , stream );
   }
 }
 
@@ -5701,12 +7297,13 @@ static void ecl_grid_dump_ascii__(ecl_grid_type * grid , bool active_only , FILE
 
   {
     int l;
+    point_type buffer[8];
     for (l=0; l < grid->size; l++) {
       ecl_cell_type * cell = ecl_grid_get_cell( grid , l );
       if (cell->active_index[MATRIX_INDEX] >= 0 || !active_only) {
         int i,j,k;
         ecl_grid_get_ijk1( grid , l , &i , &j , &k);
-        ecl_cell_dump_ascii( cell , i,j,k , stream , NULL);
+        ecl_cell_dump_ascii( cell , ecl_grid_get_cell_corners( grid , l , buffer ) , i,j,k , stream , NULL);
       }
     }
   }
@@ -5743,16 +7340,18 @@ void ecl_grid_dump_ascii(ecl_grid_type * grid , bool active_only , FILE * stream
 
 void ecl_grid_dump_ascii_cell1(ecl_grid_type * grid , int global_index , FILE * stream , const double * offset) {
   ecl_cell_type * cell = ecl_grid_get_cell( grid , global_index );
+  point_type buffer[8];
   int i,j,k;
   ecl_grid_get_ijk1( grid , global_index , &i , &j , &k);
-  ecl_cell_dump_ascii(cell , i,j,k, stream , offset);
+  ecl_cell_dump_ascii(cell , ecl_grid_get_cell_corners( grid , global_index , buffer ) , i,j,k, stream , offset);
 }
 
 
 void ecl_grid_dump_ascii_cell3(ecl_grid_type * grid , int i , int j , int k , FILE * stream , const double * offset) {
   int global_index  = ecl_grid_get_global_index3(grid , i,j,k);
   ecl_cell_type * cell = ecl_grid_get_cell( grid , global_index );
-  ecl_cell_dump_ascii(cell , i,j,k, stream , offset);
+  point_type buffer[8];
+  ecl_cell_dump_ascii(cell , ecl_grid_get_cell_corners( grid , global_index , buffer ) , i,j,k, stream , offset);
 }
 
 /*****************************************************************/
@@ -5942,8 +7541,9 @@ static void ecl_grid_fwrite_GRID__( const ecl_grid_type * grid , int coords_size
         for (i=0; i < grid->nx; i++) {
           int global_index = ecl_grid_get_global_index__(grid , i , j , k );
           const ecl_cell_type * cell = ecl_grid_get_cell( grid ,  global_index );
+          point_type buffer[8];
 
-          ecl_cell_fwrite_GRID( grid , cell , false , coords_size , i,j,k,global_index,coords_kw , corners_kw , fortio );
+          ecl_cell_fwrite_GRID( grid , cell , ecl_grid_get_cell_corners( grid , global_index , buffer ) , false , coords_size , i,j,k,global_index,coords_kw , corners_kw , fortio );
         }
       }
     }
@@ -5954,8 +7554,9 @@ static void ecl_grid_fwrite_GRID__( const ecl_grid_type * grid , int coords_size
           for (i=0; i < grid->nx; i++) {
             int global_index = ecl_grid_get_global_index__(grid , i , j , k - grid->nz );
             const ecl_cell_type * cell = ecl_grid_get_cell( grid ,  global_index );
+            point_type buffer[8];
 
-            ecl_cell_fwrite_GRID( grid , cell , true , coords_size , i,j,k,global_index ,  coords_kw , corners_kw , fortio );
+            ecl_cell_fwrite_GRID( grid , cell , ecl_grid_get_cell_corners( grid , global_index , buffer ) , true , coords_size , i,j,k,global_index ,  coords_kw , corners_kw , fortio );
           }
         }
       }
@@ -6102,8 +7703,10 @@ static bool ecl_grid_init_coord_section__( const ecl_grid_type * grid , int i, i
     point_type top_point;
     point_type bottom_point;
 
-    const ecl_cell_type * bottom_cell = ecl_grid_get_cell( grid , bottom_index );
-    const ecl_cell_type * top_cell    = ecl_grid_get_cell( grid , top_index);
+    point_type bottom_buffer[8];
+    point_type top_buffer[8];
+    const point_type * bottom_corners = ecl_grid_get_cell_corners( grid , bottom_index , bottom_buffer );
+    const point_type * top_corners    = ecl_grid_get_cell_corners( grid , top_index , top_buffer );
 
     /*
       2---3
@@ -6113,8 +7716,8 @@ static bool ecl_grid_init_coord_section__( const ecl_grid_type * grid , int i, i
     int corner_index = j_corner*2 + i_corner;
     int coord_offset = 6 * ( (j + j_corner) * (grid->nx + 1) + (i + i_corner) );
     {
-      point_copy_values( &top_point    , &top_cell->corner_list[corner_index]);
-      point_copy_values( &bottom_point , &bottom_cell->corner_list[ corner_index + 4]);
+      point_copy_values( &top_point    , &top_corners[corner_index]);
+      point_copy_values( &bottom_point , &bottom_corners[ corner_index + 4]);
 
 
       if ((top_point.z == bottom_point.z) && (force_set == false)) {
@@ -6235,19 +7838,20 @@ static void ecl_grid_init_zcorn_data__( const ecl_grid_type * grid , float * zco
     for (i=0; i < nx; i++) {
       for (k=0; k < nz; k++) {
         const int cell_index   = ecl_grid_get_global_index3( grid , i,j,k);
-        const ecl_cell_type * cell = ecl_grid_get_cell( grid , cell_index );
+        point_type buffer[8];
+        const point_type * corner_list = ecl_grid_get_cell_corners( grid , cell_index , buffer );
         int l;
 
         for (l=0; l < 2; l++) {
-          point_type p0 = cell->corner_list[ 4*l];
-          point_type p1 = cell->corner_list[ 4*l + 1];
-          point_type p2 = cell->corner_list[ 4*l + 2];
-          point_type p3 = cell->corner_list[ 4*l + 3];
+          point_type p0 = corner_list[ 4*l];
+          point_type p1 = corner_list[ 4*l + 1];
+          point_type p2 = corner_list[ 4*l + 2];
+          point_type p3 = corner_list[ 4*l + 3];
 
-          int z1 = k*8*nx*ny + j*4*nx + 2*i            + l*4*nx*ny;
-          int z2 = k*8*nx*ny + j*4*nx + 2*i  +  1      + l*4*nx*ny;
-          int z3 = k*8*nx*ny + j*4*nx + 2*nx + 2*i     + l*4*nx*ny;
-          int z4 = k*8*nx*ny + j*4*nx + 2*nx + 2*i + 1 + l*4*nx*ny;
+          size_t z1 = (size_t) k*8*nx*ny + j*4*nx + 2*i            + (size_t) l*4*nx*ny;
+          size_t z2 = (size_t) k*8*nx*ny + j*4*nx + 2*i  +  1      + (size_t) l*4*nx*ny;
+          size_t z3 = (size_t) k*8*nx*ny + j*4*nx + 2*nx + 2*i     + (size_t) l*4*nx*ny;
+          size_t z4 = (size_t) k*8*nx*ny + j*4*nx + 2*nx + 2*i + 1 + (size_t) l*4*nx*ny;
 
           if (zcorn_float) {
             zcorn_float[z1] = p0.z;
@@ -6278,15 +7882,24 @@ void ecl_grid_init_zcorn_data_double( const ecl_grid_type * grid , double * zcor
 
 
 float * ecl_grid_alloc_zcorn_data( const ecl_grid_type * grid ) {
-  float * zcorn = util_calloc( 8 * grid->size , sizeof * zcorn );
+  float * zcorn = util_calloc( (size_t) 8 * grid->size , sizeof * zcorn );
   ecl_grid_init_zcorn_data( grid , zcorn );
   return zcorn;
 }
 
 
 
+/*
+  The size of the ZCORN keyword must fit in the int size of the keyword
+  header; i.e. this will fail for grids with more than INT_MAX / 8 cells.
+*/
+
 ecl_kw_type * ecl_grid_alloc_zcorn_kw( const ecl_grid_type * grid ) {
-  ecl_kw_type * zcorn_kw = ecl_kw_alloc( ZCORN_KW , 8 * grid->size , ECL_FLOAT);
+  ecl_kw_type * zcorn_kw;
+  if (grid->size > INT_MAX / 8)
+    util_abort("%s: grid with %d cells is too large for a ZCORN keyword \n",__func__ , grid->size);
+
+  zcorn_kw = ecl_kw_alloc( ZCORN_KW , 8 * grid->size , ECL_FLOAT);
   ecl_grid_init_zcorn_data( grid , ecl_kw_get_void_ptr( zcorn_kw ));
   return zcorn_kw;
 }
@@ -6453,6 +8066,7 @@ ecl_kw_type * ecl_grid_alloc_gridhead_kw( int nx, int ny , int nz , int grid_nr)
 void ecl_grid_reset_actnum( ecl_grid_type * grid , const int * actnum ) {
   const int global_size = ecl_grid_get_global_size( grid );
   int g;
+  ecl_grid_assert_not_frozen( grid , __func__ );
   for (g=0; g < global_size; g++) {
     ecl_cell_type * cell = ecl_grid_get_cell( grid , g );
     if (actnum)
@@ -6471,8 +8085,7 @@ static void  ecl_grid_fwrite_self_nnc( const ecl_grid_type * grid , fortio_type
   int g;
 
   for (g=0; g < ecl_grid_get_global_size(grid); g++) {
-    ecl_cell_type * cell = ecl_grid_get_cell( grid , g );
-    const nnc_info_type * nnc_info = cell->nnc_info;
+    const nnc_info_type * nnc_info = ecl_grid_get_cell_nnc_info__( grid , g );
     if (nnc_info) {
       const nnc_vector_type * nnc_vector = nnc_info_get_self_vector(nnc_info);
       int i;
@@ -6740,9 +8353,9 @@ void ecl_grid_fprintf_grdecl(ecl_grid_type * grid , FILE * stream ) {
 */
 
 void ecl_grid_cell_ri_export( const ecl_grid_type * ecl_grid , int global_index , double * ri_points) {
-  const ecl_cell_type * cell = ecl_grid_get_cell( ecl_grid , global_index );
+  point_type buffer[8];
   int offset = global_index * 8 * 3;
-  ecl_cell_ri_export( cell , &ri_points[ offset ] );
+  ecl_cell_ri_export( ecl_grid_get_cell_corners( ecl_grid , global_index , buffer ) , &ri_points[ offset ] );
 }
 
 
@@ -21,7 +21,9 @@
 #include <stdbool.h>
 #include <string.h>
 #include <math.h>
+#include <stdint.h>
 
+#include <ert/util/ert_api_config.h>
 #include <ert/util/util.h>
 #include <ert/util/buffer.h>
 #include <ert/util/int_vector.h>
@@ -31,10 +33,30 @@
 #include <ert/ecl/ecl_endian_flip.h>
 #include <ert/ecl/ecl_type.h>
 
+#ifdef ERT_HAVE_USELOCALE
+#include <locale.h>
+#ifdef __APPLE__
+#include <xlocale.h>
+#endif
+#endif
+
 
 #define ECL_KW_TYPE_ID  6111098
 
 
+/*
+  The number of elements is stored as a signed 32 bit integer in the
+  keyword header on disk, hence a keyword can have at most INT_MAX
+  elements and the size is an int also in memory. The data itself can
+  be larger than 2 GB - e.g. a DOUBLE keyword with 10^9 elements - and
+  all the byte offsets and sizes are therefore calculated with size_t /
+  offset_type. A keyword with more than INT_MAX elements, e.g. ZCORN
+  for a grid with more than ~268 million cells, can not be represented
+  in the file format and must be split by the calling scope; a header
+  with a negative size is treated as a read failure.
+*/
+
+
 
 
 
@@ -94,33 +116,23 @@ UTIL_IS_INSTANCE_FUNCTION(ecl_kw , ECL_KW_TYPE_ID )
 
 
 /*****************************************************************/
-/* Format string used when reading and writing formatted
-   files. Observe the following about these format strings:
+/* Format string used when writing formatted files. Observe the
+   following about these format strings:
 
-    1. The format string for reading double contains two '%'
-       identifiers, that is because doubles are read by parsing a
-       prefix and power separately.
-
-    2. For both double and float the write format contains two '%'
+    1. For both double and float the write format contains two '%'
        characters - that is because the values are split in a prefix
        and a power prior to writing - see the function
-       __fprintf_scientific().
+       __sprintf_scientific().
 
-    3. The logical type involves converting back and forth between 'T'
+    2. The logical type involves converting back and forth between 'T'
        and 'F' and internal logical representation. The format strings
-       are therefor for reading/writing a character.
+       are therefor for writing a character.
 
+   Formatted data is read with the hand written parser in the
+   ecl_kw_fmt_reader functions and not with fscanf(); the expected
+   input is the same as the output from these format strings.
 */
 
-#define READ_FMT_CHAR     "%8c"
-#define READ_FMT_C010     "%10c"
-#define READ_FMT_FLOAT    "%gE"
-#define READ_FMT_INT      "%d"
-#define READ_FMT_MESS     "%8c"
-#define READ_FMT_BOOL     "  %c"
-#define READ_FMT_DOUBLE   "%lgD%d"
-
-
 #define WRITE_FMT_CHAR    " '%-8s'"
 #define WRITE_FMT_C010    " '%-10s'"
 #define WRITE_FMT_INT     " %11d"
@@ -161,36 +173,6 @@ UTIL_IS_INSTANCE_FUNCTION(ecl_kw , ECL_KW_TYPE_ID )
 ecl_type_enum  ecl_kw_get_type(const ecl_kw_type *);
 void ecl_kw_set_data_type(ecl_kw_type * ecl_kw, ecl_data_type data_type);
 
-static const char * get_read_fmt(const ecl_data_type data_type ) {
-  switch(ecl_type_get_type(data_type)) {
-  case(ECL_CHAR_TYPE):
-    return READ_FMT_CHAR;
-    break;
-  case(ECL_C010_TYPE):
-    return READ_FMT_C010;
-    break;
-  case(ECL_INT_TYPE):
-    return READ_FMT_INT;
-    break;
-  case(ECL_FLOAT_TYPE):
-    return READ_FMT_FLOAT;
-    break;
-  case(ECL_DOUBLE_TYPE):
-    return READ_FMT_DOUBLE;
-    break;
-  case(ECL_BOOL_TYPE):
-    return READ_FMT_BOOL;
-    break;
-  case(ECL_MESS_TYPE):
-    return READ_FMT_MESS;
-    break;
-  default:
-    util_abort("%s: invalid ecl_type:%d \n",__func__ , ecl_type_get_type(data_type));
-    return NULL;
-  }
-}
-
-
 static const char * ecl_kw_get_write_fmt(const ecl_data_type data_type) {
   switch(ecl_type_get_type(data_type)) {
   case(ECL_CHAR_TYPE):
@@ -487,6 +469,9 @@ static void ecl_kw_set_shared_ref(ecl_kw_type * ecl_kw , void *data_ptr) {
 
 
 static void ecl_kw_initialize(ecl_kw_type * ecl_kw , const char *header ,  int size , ecl_data_type data_type) {
+  if (size < 0)
+    util_abort("%s: invalid size:%d for keyword:%s - at most INT_MAX elements are supported \n",__func__ , size , header);
+
   ecl_kw_set_data_type(ecl_kw, data_type);
   if (strlen(header) > ECL_STRING8_LENGTH)
     util_abort("%s: Fatal error: ecl_header_name:%s is longer than eight characters - aborting \n",__func__,header);
@@ -500,7 +485,7 @@ static size_t ecl_kw_fortio_data_size( const ecl_kw_type * ecl_kw) {
   const int num_blocks = ecl_kw->size / blocksize + (ecl_kw->size % blocksize == 0 ? 0 : 1);
 
   return num_blocks * (4 + 4) +                                           // Fortran fluff for each block
-    ecl_kw->size * ecl_type_get_sizeof_ctype_fortio( ecl_kw->data_type );  // Actual data
+    (size_t) ecl_kw->size * ecl_type_get_sizeof_ctype_fortio( ecl_kw->data_type );  // Actual data
 }
 
 
@@ -657,7 +642,7 @@ ecl_kw_type * ecl_kw_alloc_slice_copy( const ecl_kw_type * src, int index1, int
           int target_index = 0;
           const char * src_ptr = src->data;
           char * new_ptr = new_kw->data;
-          int sizeof_ctype = ecl_kw_get_sizeof_ctype(new_kw);
+          size_t sizeof_ctype = ecl_kw_get_sizeof_ctype(new_kw);
 
           while ( src_index < index2 ) {
             memcpy( &new_ptr[ target_index * sizeof_ctype ] , &src_ptr[ src_index * sizeof_ctype ] , sizeof_ctype );
@@ -1052,92 +1037,360 @@ static bool ecl_kw_fscanf_qstring(char *s , const char *fmt , int len, FILE *str
 
 
 
+/*****************************************************************/
 /*
-  This rather painful parsing is because formatted eclipse double
-  format : 0.ddddD+01 - difficult to parse the 'D';
+  The formatted files always use '.' as decimal separator, whereas
+  strtod(), strtof() and snprintf() use the LC_NUMERIC category of
+  the current locale. The formatted reader and writer therefor
+  install the "C" numeric locale for the calling thread while they
+  run; the global locale of the process is not touched. On platforms
+  without uselocale() the conversions follow the process locale.
 */
-/** Should be: NESTED */
-
-static double __fscanf_ECL_double( FILE * stream , const char * fmt) {
-  int    read_count , power;
-  double value , arg;
-  read_count = fscanf( stream , fmt , &arg , &power);
-  if (read_count == 2)
-    value = arg * pow(10 , power );
-  else {
-    util_abort("%s: read failed \n",__func__);
-    value = -1;
+
+#ifdef ERT_HAVE_USELOCALE
+
+typedef struct {
+  locale_t  c_locale;
+  locale_t  prev_locale;
+} ecl_kw_fmt_locale_type;
+
+
+static void ecl_kw_fmt_locale_enter( ecl_kw_fmt_locale_type * fmt_locale ) {
+  fmt_locale->c_locale = newlocale( LC_NUMERIC_MASK , "C" , (locale_t) 0 );
+  if (fmt_locale->c_locale != (locale_t) 0)
+    fmt_locale->prev_locale = uselocale( fmt_locale->c_locale );
+}
+
+
+static void ecl_kw_fmt_locale_exit( ecl_kw_fmt_locale_type * fmt_locale ) {
+  if (fmt_locale->c_locale != (locale_t) 0) {
+    uselocale( fmt_locale->prev_locale );
+    freelocale( fmt_locale->c_locale );
+  }
+}
+
+#else
+
+typedef int ecl_kw_fmt_locale_type;
+
+static void ecl_kw_fmt_locale_enter( ecl_kw_fmt_locale_type * fmt_locale ) {}
+static void ecl_kw_fmt_locale_exit( ecl_kw_fmt_locale_type * fmt_locale ) {}
+
+#endif
+
+
+/*
+  The formatted double values, and the float values on output, are
+  scaled with integer powers of ten; the pow() values are cached
+  while a keyword is read or written.
+*/
+
+#define FMT_POW10_RANGE  100
+
+typedef struct {
+  double   value[2 * FMT_POW10_RANGE + 1];     /* value[FMT_POW10_RANGE + p] = pow(10 , p); filled on demand. */
+  bool     is_set[2 * FMT_POW10_RANGE + 1];
+} ecl_kw_fmt_pow10_type;
+
+
+static void ecl_kw_fmt_pow10_init( ecl_kw_fmt_pow10_type * pow10 ) {
+  memset( pow10->is_set , 0 , sizeof pow10->is_set );
+}
+
+
+static double ecl_kw_fmt_pow10( ecl_kw_fmt_pow10_type * pow10 , int power) {
+  if ((power < -FMT_POW10_RANGE) || (power > FMT_POW10_RANGE))
+    return pow( 10.0 , power );
+  {
+    const int index = FMT_POW10_RANGE + power;
+    if (!pow10->is_set[index]) {
+      pow10->value[index] = pow( 10.0 , power );
+      pow10->is_set[index] = true;
+    }
+    return pow10->value[index];
+  }
+}
+
+
+/*****************************************************************/
+/*
+  Parsing of formatted keyword data. Instead of one fscanf() call per
+  element the data is read from the stream in large chunks into a
+  memory buffer, and the elements are parsed directly from the
+  buffer. The buffer is always kept '\0' terminated, and refilled
+  when less than FMT_MAX_TOKEN bytes remain, so a single element can
+  always be parsed from memory with strtol() / strtod().
+
+  When the keyword has been parsed the stream is repositioned to the
+  first byte which has not been consumed, i.e. the stream ends up in
+  the same position as it would have with the fscanf() based parsing.
+*/
+
+#define FMT_BUFFER_SIZE          65536
+#define FMT_MAX_TOKEN            128
+#define FMT_MAX_ELEMENT_WIDTH    32
+
+typedef struct {
+  FILE   * stream;
+  char   * buffer;
+  size_t   alloc_size;
+  size_t   size;        /* Number of valid bytes in the buffer. */
+  size_t   pos;         /* Position of the next byte to parse. */
+  bool     eof;
+  ecl_kw_fmt_pow10_type pow10;
+} ecl_kw_fmt_reader_type;
+
+
+static void ecl_kw_fmt_reader_init( ecl_kw_fmt_reader_type * reader , FILE * stream , int elements) {
+  size_t alloc_size = util_size_t_min( FMT_BUFFER_SIZE , (size_t) elements * FMT_MAX_ELEMENT_WIDTH + FMT_MAX_TOKEN );
+
+  reader->stream     = stream;
+  reader->alloc_size = alloc_size;
+  reader->buffer     = util_malloc( alloc_size + 1 );
+  reader->size       = 0;
+  reader->pos        = 0;
+  reader->eof        = false;
+  reader->buffer[0]  = '\0';
+  ecl_kw_fmt_pow10_init( &reader->pow10 );
+}
+
+
+/*
+  Returns the number of bytes which have been read from the stream,
+  but not consumed by the parser; the caller must seek back this
+  number of bytes.
+*/
+
+static size_t ecl_kw_fmt_reader_free( ecl_kw_fmt_reader_type * reader ) {
+  size_t unread = reader->size - reader->pos;
+  free( reader->buffer );
+  return unread;
+}
+
+
+static void ecl_kw_fmt_reader_fill( ecl_kw_fmt_reader_type * reader ) {
+  size_t remaining = reader->size - reader->pos;
+  if (reader->eof || remaining >= FMT_MAX_TOKEN)
+    return;
+
+  memmove( reader->buffer , &reader->buffer[reader->pos] , remaining );
+  reader->pos  = 0;
+  reader->size = remaining;
+  {
+    size_t request    = reader->alloc_size - reader->size;
+    size_t bytes_read = fread( &reader->buffer[reader->size] , 1 , request , reader->stream );
+    if (bytes_read < request)
+      reader->eof = true;
+
+    reader->size += bytes_read;
+    reader->buffer[reader->size] = '\0';
+  }
+}
+
+
+static bool ecl_kw_fmt_is_space( char c ) {
+  return (c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f');
+}
+
+
+/*
+  Will skip whitespace and return a pointer to the first character of
+  the next element - or NULL if the end of the stream is reached.
+*/
+
+static const char * ecl_kw_fmt_reader_next( ecl_kw_fmt_reader_type * reader ) {
+  while (true) {
+    ecl_kw_fmt_reader_fill( reader );
+    while (reader->pos < reader->size && ecl_kw_fmt_is_space( reader->buffer[reader->pos] ))
+      reader->pos++;
+
+    if (reader->pos < reader->size) {
+      ecl_kw_fmt_reader_fill( reader );
+      return &reader->buffer[reader->pos];
+    }
+
+    if (reader->eof)
+      return NULL;
   }
-  return value;
 }
 
+
+static void ecl_kw_fmt_reader_advance( ecl_kw_fmt_reader_type * reader , const char * end_ptr) {
+  reader->pos = end_ptr - reader->buffer;
+}
+
+
+static bool ecl_kw_fmt_reader_int( ecl_kw_fmt_reader_type * reader , int * value) {
+  const char * start_ptr = ecl_kw_fmt_reader_next( reader );
+  if (start_ptr) {
+    char * end_ptr;
+    long lvalue = strtol( start_ptr , &end_ptr , 10 );
+    if (end_ptr != start_ptr) {
+      *value = (int) lvalue;
+      ecl_kw_fmt_reader_advance( reader , end_ptr );
+      return true;
+    }
+  }
+  return false;
+}
+
+
+/*
+  Float values are formatted as 0.ddddddddE+03; the exponent is
+  consumed by strtof() directly.
+*/
+
+static bool ecl_kw_fmt_reader_float( ecl_kw_fmt_reader_type * reader , float * value) {
+  const char * start_ptr = ecl_kw_fmt_reader_next( reader );
+  if (start_ptr) {
+    char * end_ptr;
+    float fvalue = strtof( start_ptr , &end_ptr );
+    if (end_ptr != start_ptr) {
+      if (*end_ptr == 'E')
+        end_ptr++;
+
+      *value = fvalue;
+      ecl_kw_fmt_reader_advance( reader , end_ptr );
+      return true;
+    }
+  }
+  return false;
+}
+
+
+/*
+  Double values are formatted as 0.ddddddddddddddD+03, which strtod()
+  does not understand. The prefix and the power are therefor parsed
+  separately and combined as arg * 10^power.
+*/
+
+static bool ecl_kw_fmt_reader_double( ecl_kw_fmt_reader_type * reader , double * value) {
+  const char * start_ptr = ecl_kw_fmt_reader_next( reader );
+  if (start_ptr) {
+    char * end_ptr;
+    double arg = strtod( start_ptr , &end_ptr );
+    if ((end_ptr != start_ptr) && (*end_ptr == 'D')) {
+      int power;
+      ecl_kw_fmt_reader_advance( reader , end_ptr + 1 );
+      if (ecl_kw_fmt_reader_int( reader , &power )) {
+        *value = arg * ecl_kw_fmt_pow10( &reader->pow10 , power );
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+
+static bool ecl_kw_fmt_reader_bool( ecl_kw_fmt_reader_type * reader , char * bool_char) {
+  const char * start_ptr = ecl_kw_fmt_reader_next( reader );
+  if (start_ptr) {
+    *bool_char = start_ptr[0];
+    ecl_kw_fmt_reader_advance( reader , start_ptr + 1 );
+    return true;
+  }
+  return false;
+}
+
+
+/*
+  Reads a quoted string of exactly @len characters; like
+  ecl_kw_qskip() everything up to the opening quote is skipped, and
+  the character following the string (i.e. the closing quote) is
+  consumed without inspection.
+*/
+
+static bool ecl_kw_fmt_reader_qstring( ecl_kw_fmt_reader_type * reader , char * s , int len) {
+  while (true) {
+    ecl_kw_fmt_reader_fill( reader );
+    {
+      const char * quote = memchr( &reader->buffer[reader->pos] , '\'' , reader->size - reader->pos );
+      if (quote) {
+        ecl_kw_fmt_reader_advance( reader , quote + 1 );
+        break;
+      }
+    }
+    reader->pos = reader->size;
+    if (reader->eof)
+      return false;
+  }
+
+  ecl_kw_fmt_reader_fill( reader );
+  if ((reader->size - reader->pos) < (size_t) (len + 1))
+    util_abort("%s: reading \'xxxxxxxx\' formatted string failed \n",__func__);
+
+  memcpy( s , &reader->buffer[reader->pos] , len );
+  s[len] = '\0';
+  reader->pos += len + 1;
+  return true;
+}
+
+
+
+static void ecl_kw_fread_data_formatted( ecl_kw_type * ecl_kw , fortio_type * fortio ) {
+  ecl_kw_fmt_reader_type reader;
+  ecl_kw_fmt_locale_type fmt_locale;
+  size_t sizeof_ctype = ecl_kw_get_sizeof_ctype( ecl_kw );
+  int index;
+
+  ecl_kw_fmt_locale_enter( &fmt_locale );
+  ecl_kw_fmt_reader_init( &reader , fortio_get_FILE( fortio ) , ecl_kw->size );
+  for (index = 0; index < ecl_kw->size; index++) {
+    char * data_ptr = &ecl_kw->data[ (size_t) index * sizeof_ctype ];
+    switch(ecl_kw_get_type(ecl_kw)) {
+    case(ECL_CHAR_TYPE):
+      ecl_kw_fmt_reader_qstring( &reader , data_ptr , 8 );
+      break;
+    case(ECL_INT_TYPE):
+      if (!ecl_kw_fmt_reader_int( &reader , (int *) data_ptr ))
+        util_abort("%s: after reading %d values reading of keyword:%s from:%s failed - aborting \n",__func__ , index , ecl_kw->header8 , fortio_filename_ref(fortio));
+      break;
+    case(ECL_FLOAT_TYPE):
+      if (!ecl_kw_fmt_reader_float( &reader , (float *) data_ptr ))
+        util_abort("%s: after reading %d values reading of keyword:%s from:%s failed - aborting \n",__func__ , index , ecl_kw->header8 , fortio_filename_ref(fortio));
+      break;
+    case(ECL_DOUBLE_TYPE):
+      if (!ecl_kw_fmt_reader_double( &reader , (double *) data_ptr ))
+        util_abort("%s: read failed \n",__func__);
+      break;
+    case(ECL_BOOL_TYPE):
+      {
+        char bool_char;
+        if (ecl_kw_fmt_reader_bool( &reader , &bool_char )) {
+          if (bool_char == BOOL_TRUE_CHAR)
+            ecl_kw_iset_bool(ecl_kw , index , true);
+          else if (bool_char == BOOL_FALSE_CHAR)
+            ecl_kw_iset_bool(ecl_kw , index , false);
+          else
+            util_abort("%s: Logical value: [%c] not recogniced - aborting \n", __func__ , bool_char);
+        } else
+          util_abort("%s: read failed - premature file end? \n",__func__ );
+      }
+      break;
+    case(ECL_MESS_TYPE):
+      ecl_kw_fmt_reader_qstring( &reader , data_ptr , 8 );
+      break;
+    default:
+      util_abort("%s: Internal error: internal eclipse_type: %d not recognized - aborting \n",__func__ , ecl_kw_get_type(ecl_kw));
+    }
+  }
+
+  {
+    size_t unread = ecl_kw_fmt_reader_free( &reader );
+    if (unread > 0)
+      fortio_fseek( fortio , -((offset_type) unread) , SEEK_CUR );
+  }
+  ecl_kw_fmt_locale_exit( &fmt_locale );
+}
+
+
 bool ecl_kw_fread_data(ecl_kw_type *ecl_kw, fortio_type *fortio) {
   const char null_char         = '\0';
   bool fmt_file                = fortio_fmt_file( fortio );
   if (ecl_kw->size > 0) {
     const int blocksize = get_blocksize( ecl_kw->data_type );
     if (fmt_file) {
-      const int blocks      = ecl_kw->size / blocksize + (ecl_kw->size % blocksize == 0 ? 0 : 1);
-      const char * read_fmt = get_read_fmt( ecl_kw->data_type );
-      FILE * stream         = fortio_get_FILE(fortio);
-      int    offset         = 0;
-      int    index          = 0;
-      int    ib,ir;
-      for (ib = 0; ib < blocks; ib++) {
-        int read_elm = util_int_min((ib + 1) * blocksize , ecl_kw->size) - ib * blocksize;
-        for (ir = 0; ir < read_elm; ir++) {
-          switch(ecl_kw_get_type(ecl_kw)) {
-          case(ECL_CHAR_TYPE):
-            ecl_kw_fscanf_qstring(&ecl_kw->data[offset] , read_fmt , 8, stream);
-            break;
-          case(ECL_INT_TYPE):
-            {
-              int iread = fscanf(stream , read_fmt , (int *) &ecl_kw->data[offset]);
-              if (iread != 1)
-                util_abort("%s: after reading %d values reading of keyword:%s from:%s failed - aborting \n",__func__ , offset / ecl_kw_get_sizeof_ctype(ecl_kw) , ecl_kw->header8 , fortio_filename_ref(fortio));
-            }
-            break;
-          case(ECL_FLOAT_TYPE):
-            {
-              int iread = fscanf(stream , read_fmt , (float *) &ecl_kw->data[offset]);
-              if (iread != 1) {
-                util_abort("%s: after reading %d values reading of keyword:%s from:%s failed - aborting \n",__func__ ,
-                           offset / ecl_kw_get_sizeof_ctype(ecl_kw) ,
-                           ecl_kw->header8 ,
-                           fortio_filename_ref(fortio));
-              }
-            }
-            break;
-          case(ECL_DOUBLE_TYPE):
-            {
-              double value = __fscanf_ECL_double( stream , read_fmt );
-              ecl_kw_iset(ecl_kw , index , &value);
-            }
-            break;
-          case(ECL_BOOL_TYPE):
-            {
-              char bool_char;
-              if (fscanf(stream , read_fmt , &bool_char) == 1) {
-                if (bool_char == BOOL_TRUE_CHAR)
-                  ecl_kw_iset_bool(ecl_kw , index , true);
-                else if (bool_char == BOOL_FALSE_CHAR)
-                  ecl_kw_iset_bool(ecl_kw , index , false);
-                else
-                  util_abort("%s: Logical value: [%c] not recogniced - aborting \n", __func__ , bool_char);
-              } else
-                util_abort("%s: read failed - premature file end? \n",__func__ );
-            }
-            break;
-          case(ECL_MESS_TYPE):
-            ecl_kw_fscanf_qstring(&ecl_kw->data[offset] , read_fmt , 8 , stream);
-            break;
-          default:
-            util_abort("%s: Internal error: internal eclipse_type: %d not recognized - aborting \n",__func__ , ecl_kw_get_type(ecl_kw));
-          }
-          offset += ecl_kw_get_sizeof_ctype(ecl_kw);
-          index++;
-        }
-      }
+      ecl_kw_fread_data_formatted( ecl_kw , fortio );
 
       /* Skip the trailing newline */
       fortio_fseek( fortio , 1 , SEEK_CUR);
@@ -1177,9 +1430,11 @@ bool ecl_kw_fread_data(ecl_kw_type *ecl_kw, fortio_type *fortio) {
            This function handles the fuc***g blocks transparently at a
            low level.
         */
-        read_ok = fortio_fread_buffer(fortio , ecl_kw->data , ecl_kw->size * ecl_kw_get_sizeof_ctype(ecl_kw));
-        if (read_ok && ECL_ENDIAN_FLIP)
-          ecl_kw_endian_convert_data(ecl_kw);
+        const size_t byte_size = ecl_kw->size * ecl_kw_get_sizeof_ctype(ecl_kw);
+        if (ECL_ENDIAN_FLIP && (ecl_type_is_numeric(ecl_kw->data_type) || ecl_type_is_bool(ecl_kw->data_type)))
+          read_ok = fortio_fread_buffer_endian_flip(fortio , ecl_kw->data , byte_size , ecl_kw_get_sizeof_ctype(ecl_kw));
+        else
+          read_ok = fortio_fread_buffer(fortio , ecl_kw->data , byte_size);
       }
       return read_ok;
     }
@@ -1207,7 +1462,7 @@ void ecl_kw_fread_indexed_data(fortio_type * fortio, offset_type data_offset, ec
             util_abort("%s: Element index is out of range 0 <= %d < %d\n", __func__, element_index, element_count);
         }
         fortio_data_fseek(fortio, data_offset, element_index, element_size, element_count, block_size);
-        util_fread(&buffer[index * element_size], element_size, 1, stream, __func__);
+        util_fread(&buffer[(size_t) index * element_size], element_size, 1, stream, __func__);
     }
 
     if (ECL_ENDIAN_FLIP) {
@@ -1215,6 +1470,115 @@ void ecl_kw_fread_indexed_data(fortio_type * fortio, offset_type data_offset, ec
     }
 }
 
+/**
+   Will read the @num_elements consecutive elements starting at
+   @first_element; contrary to ecl_kw_fread_indexed_data() there is
+   only one seek for each Fortran record which is touched, and the
+   elements are read in one call for each record.
+*/
+
+void ecl_kw_fread_data_range(fortio_type * fortio, offset_type data_offset, ecl_data_type data_type, int element_count, int first_element, int num_elements, char* buffer) {
+    const int block_size = get_blocksize(data_type);
+    FILE *stream  = fortio_get_FILE( fortio );
+    int element_size = ecl_type_get_sizeof_ctype(data_type);
+    int read_elements = 0;
+
+    if(ecl_type_is_char(data_type) || ecl_type_is_mess(data_type)) {
+        element_size = ECL_STRING8_LENGTH;
+    }
+
+    if (first_element < 0 || num_elements < 0 || (first_element + num_elements) > element_count)
+        util_abort("%s: Element range [%d,%d) is out of range 0 <= index < %d\n", __func__, first_element, first_element + num_elements, element_count);
+
+    while (read_elements < num_elements) {
+        int element_index = first_element + read_elements;
+        int block_elements = util_int_min( block_size - (element_index % block_size) , num_elements - read_elements );
+
+        fortio_data_fseek(fortio, data_offset, element_index, element_size, element_count, block_size);
+        util_fread(&buffer[(size_t) read_elements * element_size], element_size, block_elements, stream, __func__);
+        read_elements += block_elements;
+    }
+
+    if (ECL_ENDIAN_FLIP) {
+        util_endian_flip_vector(buffer, element_size, num_elements);
+    }
+}
+
+/**
+   Alternative to ecl_kw_fread_data() for unformatted files which have
+   been memory mapped with fortio_mmap(); the @data_offset argument
+   should point to the first data record of the keyword, i.e. just
+   past the header.
+
+   Numeric keywords which fit in one Fortran record, i.e. have at most
+   one block of elements, will not get private storage; instead the
+   ecl_kw instance will borrow the storage from the mapping and the
+   endian conversion is done in place. Since the mapping is private
+   the conversion will only copy the memory pages which are actually
+   touched. All other keywords are copied record by record from the
+   mapping.
+
+   Observe that the in place conversion means that the data of a
+   keyword can only be read from the mapping once; this is ensured by
+   the ecl_file layer which is the only user of this function.
+*/
+
+bool ecl_kw_fread_mapped_data(ecl_kw_type * ecl_kw , const fortio_type * fortio , offset_type data_offset) {
+  const char null_char = '\0';
+  if (ecl_kw->size > 0) {
+    const int blocksize    = get_blocksize( ecl_kw->data_type );
+    const int blocks       = ecl_kw->size / blocksize + (ecl_kw->size % blocksize == 0 ? 0 : 1);
+    const size_t sizeof_ctype = ecl_kw_get_sizeof_ctype( ecl_kw );
+    const int sizeof_fortio_ctype = ecl_type_get_sizeof_ctype_fortio( ecl_kw->data_type );
+    const bool numeric     = ecl_type_is_numeric( ecl_kw->data_type ) || ecl_type_is_bool( ecl_kw->data_type );
+    offset_type offset     = data_offset;
+    int ib;
+
+    if (numeric && (blocks == 1) && !ecl_kw->data) {
+      int record_size;
+      char * record = fortio_mmap_record( fortio , offset , &record_size );
+      if (!record || ((size_t) record_size != ecl_kw->size * sizeof_ctype))
+        return false;
+
+      if (((size_t) record % sizeof_ctype) == 0) {
+        if (ECL_ENDIAN_FLIP)
+          util_endian_flip_vector( record , sizeof_ctype , ecl_kw->size );
+
+        ecl_kw_set_shared_ref( ecl_kw , record );
+        return true;
+      }
+    }
+
+    ecl_kw_alloc_data( ecl_kw );
+    for (ib = 0; ib < blocks; ib++) {
+      int read_elm = util_int_min((ib + 1) * blocksize , ecl_kw->size) - ib * blocksize;
+      int record_size;
+      char * record = fortio_mmap_record( fortio , offset , &record_size );
+
+      if (!record || (record_size != read_elm * sizeof_fortio_ctype))
+        return false;
+
+      if (numeric)
+        memcpy( &ecl_kw->data[ ib * blocksize * sizeof_ctype ] , record , record_size );
+      else {
+        /* String data is stored with a terminating \0 in memory. */
+        int ir;
+        for (ir = 0; ir < read_elm; ir++) {
+          char * target = &ecl_kw->data[ (ib * blocksize + ir) * sizeof_ctype ];
+          memcpy( target , &record[ ir * sizeof_fortio_ctype ] , sizeof_fortio_ctype );
+          target[ sizeof_fortio_ctype ] = null_char;
+        }
+      }
+      offset += record_size + 2 * sizeof record_size;
+    }
+
+    if (numeric && ECL_ENDIAN_FLIP)
+      ecl_kw_endian_convert_data( ecl_kw );
+  }
+  return true;
+}
+
+
 /**
    Allocates storage and reads data.
 */
@@ -1324,6 +1688,9 @@ ecl_read_status_enum ecl_kw_fread_header(ecl_kw_type *ecl_kw , fortio_type * for
       OK = false;
   }
 
+  if (OK && (size < 0))
+    OK = false;       /* More than INT_MAX elements; corrupt or written by some other tool. */
+
   if (OK) {
     ecl_data_type data_type = ecl_type_create_from_name( ecl_type_str );
     ecl_kw_initialize( ecl_kw , header , size , data_type);
@@ -1492,6 +1859,49 @@ void ecl_kw_fread(ecl_kw_type * ecl_kw , fortio_type * fortio) {
 }
 
 
+/**
+   Memory mapped variant of ecl_kw_fread_alloc(); the keyword header
+   is parsed from the mapping at @offset and the data is read with
+   ecl_kw_fread_mapped_data(). Returns NULL if the header or the data
+   records are invalid.
+*/
+
+ecl_kw_type * ecl_kw_fread_alloc_mapped( const fortio_type * fortio , offset_type offset ) {
+  int record_size;
+  const char * record = fortio_mmap_record( fortio , offset , &record_size );
+  if (!record || (record_size != ECL_KW_HEADER_DATA_SIZE))
+    return NULL;
+
+  {
+    char header[ECL_STRING8_LENGTH + 1];
+    char ecl_type_str[ECL_TYPE_LENGTH + 1];
+    int size;
+
+    memcpy( header , &record[0] , ECL_STRING8_LENGTH );
+    memcpy( &size , &record[ECL_STRING8_LENGTH] , sizeof size );
+    memcpy( ecl_type_str , &record[ECL_STRING8_LENGTH + sizeof size] , ECL_TYPE_LENGTH );
+    header[ECL_STRING8_LENGTH] = '\0';
+    ecl_type_str[ECL_TYPE_LENGTH] = '\0';
+
+    if (ECL_ENDIAN_FLIP)
+      util_endian_flip_vector( &size , sizeof size , 1 );
+
+    if (size < 0)
+      return NULL;
+
+    {
+      ecl_kw_type * ecl_kw = ecl_kw_alloc_empty();
+      ecl_kw_initialize( ecl_kw , header , size , ecl_type_create_from_name( ecl_type_str ));
+      if (!ecl_kw_fread_mapped_data( ecl_kw , fortio , offset + ECL_KW_HEADER_FORTIO_SIZE )) {
+        ecl_kw_free( ecl_kw );
+        ecl_kw = NULL;
+      }
+      return ecl_kw;
+    }
+  }
+}
+
+
 ecl_kw_type *ecl_kw_fread_alloc(fortio_type *fortio) {
   bool OK;
   ecl_kw_type *ecl_kw = ecl_kw_alloc_empty();
@@ -1567,38 +1977,228 @@ static void ecl_kw_fwrite_data_unformatted( ecl_kw_type * ecl_kw , fortio_type *
         2. To use 'D' as the exponent start for double values.
 
      If you are more proficient with C fprintf() format strings than I
-     am, the __fprintf_scientific() function should be removed, and
+     am, the __sprintf_scientific() function should be removed, and
      the WRITE_FMT_DOUBLE and WRITE_FMT_FLOAT format specifiers
      updated accordingly.
   */
 
-   static void __fprintf_scientific(FILE * stream, const char * fmt , double x) {
-    double pow_x = ceil(log10(fabs(x)));
-    double arg_x   = x / pow(10.0 , pow_x);
-    if (x != 0.0) {
-      if (fabs(arg_x) == 1.0) {
-        arg_x *= 0.10;
-        pow_x += 1;
+static int __sprintf_scientific(char * buffer , size_t buffer_size , const char * fmt , double x) {
+  double pow_x = ceil(log10(fabs(x)));
+  double arg_x   = x / pow(10.0 , pow_x);
+  if (x != 0.0) {
+    if (fabs(arg_x) == 1.0) {
+      arg_x *= 0.10;
+      pow_x += 1;
+    }
+  } else {
+    arg_x = 0.0;
+    pow_x = 0.0;
+  }
+  return snprintf(buffer , buffer_size , fmt , arg_x , (int) pow_x);
+}
+
+
+/*
+  The formatted output is assembled in a memory buffer which is
+  written to the stream with one fwrite() call when it is full. All
+  values are formatted by hand, the output is byte identical to the
+  WRITE_FMT_xxx format strings; see ecl_kw_fmt_writer_scientific()
+  for the float and double values.
+*/
+
+typedef struct {
+  FILE   * stream;
+  char   * buffer;
+  size_t   pos;
+  ecl_kw_fmt_pow10_type pow10;
+} ecl_kw_fmt_writer_type;
+
+
+static void ecl_kw_fmt_writer_flush( ecl_kw_fmt_writer_type * writer ) {
+  util_fwrite( writer->buffer , 1 , writer->pos , writer->stream , __func__ );
+  writer->pos = 0;
+}
+
+
+static char * ecl_kw_fmt_writer_reserve( ecl_kw_fmt_writer_type * writer ) {
+  if (writer->pos + FMT_MAX_TOKEN > FMT_BUFFER_SIZE)
+    ecl_kw_fmt_writer_flush( writer );
+  return &writer->buffer[writer->pos];
+}
+
+
+static void ecl_kw_fmt_writer_char( ecl_kw_fmt_writer_type * writer , char c) {
+  ecl_kw_fmt_writer_reserve( writer );
+  writer->buffer[writer->pos++] = c;
+}
+
+
+/* WRITE_FMT_INT: " %11d" */
+static void ecl_kw_fmt_writer_int( ecl_kw_fmt_writer_type * writer , int value) {
+  char digits[16];
+  int  num_digits = 0;
+  bool negative   = (value < 0);
+  unsigned int uvalue = negative ? 0U - (unsigned int) value : (unsigned int) value;
+  char * ptr = ecl_kw_fmt_writer_reserve( writer );
+
+  do {
+    digits[num_digits++] = '0' + (uvalue % 10);
+    uvalue /= 10;
+  } while (uvalue > 0);
+  if (negative)
+    digits[num_digits++] = '-';
+
+  *ptr++ = ' ';
+  {
+    int pad;
+    for (pad = num_digits; pad < 11; pad++)
+      *ptr++ = ' ';
+  }
+  while (num_digits > 0)
+    *ptr++ = digits[--num_digits];
+
+  writer->pos = ptr - writer->buffer;
+}
+
+
+/* WRITE_FMT_CHAR and WRITE_FMT_C010: " '%-8s'" and " '%-10s'" */
+static void ecl_kw_fmt_writer_qstring( ecl_kw_fmt_writer_type * writer , const char * s , int width) {
+  size_t len = strlen( s );
+  if (len + 4 + width > FMT_MAX_TOKEN) {
+    ecl_kw_fmt_writer_flush( writer );
+    fprintf(writer->stream , " '%-*s'" , width , s);
+  } else {
+    char * ptr = ecl_kw_fmt_writer_reserve( writer );
+    *ptr++ = ' ';
+    *ptr++ = '\'';
+    memcpy( ptr , s , len );
+    ptr += len;
+    while (len < (size_t) width) {
+      *ptr++ = ' ';
+      len++;
+    }
+    *ptr++ = '\'';
+    writer->pos = ptr - writer->buffer;
+  }
+}
+
+
+/*
+  Formats @x as WRITE_FMT_FLOAT (@digits == 8, @exp_char == 'E') or
+  WRITE_FMT_DOUBLE (@digits == 14, @exp_char == 'D') without going
+  through snprintf(); the output is byte identical to
+  __sprintf_scientific():
+
+    1. The power p = ceil(log10(|x|)) is found by comparing with the
+       same pow(10 , p) values which __sprintf_scientific() divides
+       with, and the argument x / pow(10 , p) is computed exactly as
+       there.
+
+    2. The argument, which is in (0.1 , 1), is a 53 bit integer
+       mantissa times a power of two; it is multiplied with 10^digits
+       and rounded to an integer in 128 bit integer arithmetic. That
+       is an exact rounding, with ties to even, i.e. the same digits
+       as printf() produces.
+
+  Zero, values which are within 1e-9 relative distance of a power of
+  ten - where log10() might round to the integer - values outside
+  10^-FMT_POW10_RANGE ... 10^FMT_POW10_RANGE, nan and inf are
+  formatted with __sprintf_scientific().
+*/
+
+static void ecl_kw_fmt_writer_scientific( ecl_kw_fmt_writer_type * writer , const char * fmt , int digits , char exp_char , double x) {
+  char * ptr = ecl_kw_fmt_writer_reserve( writer );
+#ifdef __SIZEOF_INT128__
+  const double ax = fabs( x );
+  if ((ax > 0) && (ax < 1e300)) {
+    uint64_t bits;
+    int power;
+
+    memcpy( &bits , &ax , sizeof bits );
+    power = ((((int) (bits >> 52)) - 1023) * 1233) / 4096;    /* ~ log10(2) * binary exponent */
+
+    if ((power > -FMT_POW10_RANGE + 2) && (power < FMT_POW10_RANGE - 2)) {
+      while (ax > ecl_kw_fmt_pow10( &writer->pow10 , power ))
+        power++;
+      while (ax <= ecl_kw_fmt_pow10( &writer->pow10 , power - 1 ))
+        power--;
+
+      if ((power > -FMT_POW10_RANGE) && (power < FMT_POW10_RANGE) &&
+          (ax > ecl_kw_fmt_pow10( &writer->pow10 , power - 1 ) * (1 + 1e-9)) &&
+          (ax < ecl_kw_fmt_pow10( &writer->pow10 , power ) * (1 - 1e-9))) {
+        const double arg = ax / ecl_kw_fmt_pow10( &writer->pow10 , power );
+        uint64_t scale = 1;
+        uint64_t rounded;
+        int i;
+
+        for (i = 0; i < digits; i++)
+          scale *= 10;
+
+        memcpy( &bits , &arg , sizeof bits );
+        {
+          const uint64_t mantissa = (bits & ((UINT64_C(1) << 52) - 1)) | (UINT64_C(1) << 52);
+          const int shift = 1075 - (int) (bits >> 52);   /* arg == mantissa * 2^-shift */
+          const unsigned __int128 product = (unsigned __int128) mantissa * scale;
+          const unsigned __int128 half = ((unsigned __int128) 1) << (shift - 1);
+          const unsigned __int128 rem  = product & ((half << 1) - 1);
+
+          rounded = (uint64_t) (product >> shift);
+          if ((rem > half) || ((rem == half) && (rounded & 1)))
+            rounded++;
+        }
+
+        *ptr++ = ' ';
+        *ptr++ = ' ';
+        *ptr++ = (x < 0) ? '-' : ' ';
+        if (rounded == scale) {
+          *ptr++ = '1';
+          rounded = 0;
+        } else
+          *ptr++ = '0';
+        *ptr++ = '.';
+        for (i = digits - 1; i >= 0; i--) {
+          ptr[i] = '0' + (char) (rounded % 10);
+          rounded /= 10;
+        }
+        ptr += digits;
+
+        *ptr++ = exp_char;
+        *ptr++ = (power < 0) ? '-' : '+';
+        {
+          int abs_power = abs( power );
+          if (abs_power >= 100)
+            *ptr++ = '0' + abs_power / 100;
+          *ptr++ = '0' + (abs_power / 10) % 10;
+          *ptr++ = '0' + abs_power % 10;
+        }
+        writer->pos = ptr - writer->buffer;
+        return;
       }
-    } else {
-      arg_x = 0.0;
-      pow_x = 0.0;
     }
-    fprintf(stream , fmt , arg_x , (int) pow_x);
   }
+#endif
+  writer->pos += __sprintf_scientific( ptr , FMT_MAX_TOKEN , fmt , x );
+}
 
 
 static void ecl_kw_fwrite_data_formatted( ecl_kw_type * ecl_kw , fortio_type * fortio ) {
 
   {
-
-    FILE * stream           = fortio_get_FILE( fortio );
+    ecl_kw_fmt_writer_type writer;
     const int blocksize     = get_blocksize( ecl_kw->data_type );
     const  int columns      = get_columns( ecl_kw->data_type );
     const  char * write_fmt = ecl_kw_get_write_fmt( ecl_kw->data_type );
     const int num_blocks    = ecl_kw->size / blocksize + (ecl_kw->size % blocksize == 0 ? 0 : 1);
     int block_nr;
 
+    ecl_kw_fmt_locale_type fmt_locale;
+
+    ecl_kw_fmt_locale_enter( &fmt_locale );
+    writer.stream = fortio_get_FILE( fortio );
+    writer.buffer = util_malloc( FMT_BUFFER_SIZE );
+    writer.pos    = 0;
+    ecl_kw_fmt_pow10_init( &writer.pow10 );
+
     for (block_nr = 0; block_nr < num_blocks; block_nr++) {
       int this_blocksize = util_int_min((block_nr + 1)*blocksize , ecl_kw->size) - block_nr*blocksize;
       int num_lines      = this_blocksize / columns + ( this_blocksize % columns == 0 ? 0 : 1);
@@ -1611,36 +2211,38 @@ static void ecl_kw_fwrite_data_formatted( ecl_kw_type * ecl_kw , fortio_type * f
           void * data_ptr = ecl_kw_iget_ptr_static( ecl_kw , data_index );
           switch (ecl_kw_get_type(ecl_kw)) {
           case(ECL_CHAR_TYPE):
-            fprintf(stream , write_fmt , data_ptr);
+            ecl_kw_fmt_writer_qstring( &writer , data_ptr , 8 );
             break;
           case(ECL_C010_TYPE):
-            fprintf(stream , write_fmt , data_ptr);
+            ecl_kw_fmt_writer_qstring( &writer , data_ptr , 10 );
             break;
           case(ECL_INT_TYPE):
             {
               int int_value = ((int *) data_ptr)[0];
-              fprintf(stream , write_fmt , int_value);
+              ecl_kw_fmt_writer_int( &writer , int_value );
             }
             break;
           case(ECL_BOOL_TYPE):
             {
               bool bool_value = ((bool *) data_ptr)[0];
+              ecl_kw_fmt_writer_char( &writer , ' ' );
+              ecl_kw_fmt_writer_char( &writer , ' ' );
               if (bool_value)
-                fprintf(stream , write_fmt , BOOL_TRUE_CHAR);
+                ecl_kw_fmt_writer_char( &writer , BOOL_TRUE_CHAR );
               else
-                fprintf(stream , write_fmt , BOOL_FALSE_CHAR);
+                ecl_kw_fmt_writer_char( &writer , BOOL_FALSE_CHAR );
             }
             break;
           case(ECL_FLOAT_TYPE):
             {
               float float_value = ((float *) data_ptr)[0];
-              __fprintf_scientific( stream , write_fmt , float_value );
+              ecl_kw_fmt_writer_scientific( &writer , write_fmt , 8 , 'E' , float_value );
             }
             break;
           case(ECL_DOUBLE_TYPE):
             {
               double double_value = ((double *) data_ptr)[0];
-              __fprintf_scientific( stream , write_fmt , double_value );
+              ecl_kw_fmt_writer_scientific( &writer , write_fmt , 14 , 'D' , double_value );
             }
             break;
           case(ECL_MESS_TYPE):
@@ -1648,9 +2250,13 @@ static void ecl_kw_fwrite_data_formatted( ecl_kw_type * ecl_kw , fortio_type * f
             break;
           }
         }
-        fprintf(stream , "\n");
+        ecl_kw_fmt_writer_char( &writer , '\n' );
       }
     }
+
+    ecl_kw_fmt_writer_flush( &writer );
+    free( writer.buffer );
+    ecl_kw_fmt_locale_exit( &fmt_locale );
   }
 }
 
@@ -1865,7 +2471,7 @@ ecl_kw_type * ecl_kw_alloc_scatter_copy( const ecl_kw_type * src_kw , int target
   }
 
   {
-    int sizeof_ctype = ecl_type_get_sizeof_ctype( src_kw->data_type );
+    size_t sizeof_ctype = ecl_type_get_sizeof_ctype( src_kw->data_type );
     int i;
         for( i =0; i < src_kw->size; i++) {
       int target_index = mapping[i];
@@ -1951,7 +2557,7 @@ void ecl_kw_scalar_set_float_or_double( ecl_kw_type * ecl_kw , double value ) {
   Untyped - low level alternative.
 */
 void ecl_kw_scalar_set__(ecl_kw_type * ecl_kw , const void * value) {
-  int sizeof_ctype = ecl_type_get_sizeof_ctype( ecl_kw->data_type );
+  size_t sizeof_ctype = ecl_type_get_sizeof_ctype( ecl_kw->data_type );
   int i;
   for (i=0;i < ecl_kw->size; i++)
     memcpy( &ecl_kw->data[ i * sizeof_ctype ] , value , sizeof_ctype);
@@ -2060,7 +2666,7 @@ void ecl_kw_copy_indexed( ecl_kw_type * target_kw , const int_vector_type * inde
   {
     char * target_data = ecl_kw_get_data_ref( target_kw );
     const char * src_data = ecl_kw_get_data_ref( src_kw );
-    int sizeof_ctype = ecl_type_get_sizeof_ctype(target_kw->data_type);
+    size_t sizeof_ctype = ecl_type_get_sizeof_ctype(target_kw->data_type);
     int set_size     = int_vector_size( index_set );
     const int * index_data = int_vector_get_const_ptr( index_set );
     int i;
@@ -19,12 +19,20 @@
 #include <string.h>
 #include <ctype.h>
 
+#include <ert/util/ert_api_config.h>
 #include <ert/util/util.h>
+#include <ert/util/stringlist.h>
+#include <ert/util/size_t_vector.h>
+#include <ert/util/type_macros.h>
 
 #include <ert/ecl/ecl_kw.h>
 #include <ert/ecl/ecl_type.h>
 #include <ert/ecl/ecl_util.h>
 
+#ifdef ERT_HAVE_MMAP
+#include <sys/mman.h>
+#endif
+
 
 /*
   This file is devoted to different routines for reading and writing
@@ -56,6 +64,180 @@
 */
 
 
+/*
+  The grdecl_reader is a small tokenizer used when scanning for
+  keywords and when loading the data of a keyword. It either reads
+  the FILE stream in large blocks, or works directly on a memory
+  mapped view of the file; the tokens are split exactly as with
+  fscanf("%32s"). When a reader on a stream is freed the stream is
+  positioned at the first character which has not been consumed.
+*/
+
+#define GRDECL_BUFFER_SIZE  65536
+#define GRDECL_MAX_TOKEN    32
+
+typedef struct {
+  FILE        * stream;
+  char        * buffer;
+  const char  * data;
+  size_t        size;
+  size_t        pos;
+  offset_type   data_offset;   /* The file offset of data[0]. */
+  bool          eof;
+} grdecl_reader_type;
+
+
+static void grdecl_reader_init_stream( grdecl_reader_type * reader , FILE * stream ) {
+  reader->stream      = stream;
+  reader->buffer      = util_malloc( GRDECL_BUFFER_SIZE );
+  reader->data        = reader->buffer;
+  reader->size        = 0;
+  reader->pos         = 0;
+  reader->data_offset = util_ftell( stream );
+  reader->eof         = false;
+}
+
+
+static void grdecl_reader_init_memory( grdecl_reader_type * reader , const char * data , size_t size , size_t offset) {
+  reader->stream      = NULL;
+  reader->buffer      = NULL;
+  reader->data        = data;
+  reader->size        = size;
+  reader->pos         = offset;
+  reader->data_offset = 0;
+  reader->eof         = true;
+}
+
+
+static offset_type grdecl_reader_tell( const grdecl_reader_type * reader ) {
+  return reader->data_offset + reader->pos;
+}
+
+
+static void grdecl_reader_free( grdecl_reader_type * reader ) {
+  if (reader->stream)
+    util_fseek( reader->stream , grdecl_reader_tell( reader ) , SEEK_SET );
+  free( reader->buffer );
+}
+
+
+/*
+  Refills the buffer when there are so few characters left that a
+  complete token might not be available.
+*/
+
+static void grdecl_reader_fill( grdecl_reader_type * reader ) {
+  size_t remaining = reader->size - reader->pos;
+  if (reader->eof || remaining > GRDECL_MAX_TOKEN)
+    return;
+
+  memmove( reader->buffer , &reader->buffer[reader->pos] , remaining );
+  reader->data_offset += reader->pos;
+  reader->pos = 0;
+  reader->size = remaining;
+  {
+    size_t request    = GRDECL_BUFFER_SIZE - reader->size;
+    size_t bytes_read = fread( &reader->buffer[reader->size] , 1 , request , reader->stream );
+    if (bytes_read < request)
+      reader->eof = true;
+    reader->size += bytes_read;
+  }
+}
+
+
+static bool grdecl_reader_skip_space( grdecl_reader_type * reader ) {
+  while (true) {
+    while ((reader->pos < reader->size) && isspace( (unsigned char) reader->data[reader->pos] ))
+      reader->pos++;
+
+    if (reader->pos < reader->size)
+      return true;
+
+    if (reader->eof)
+      return false;
+
+    grdecl_reader_fill( reader );
+  }
+}
+
+
+/*
+  Skips everything up to and including the next newline.
+*/
+
+static void grdecl_reader_skip_line( grdecl_reader_type * reader ) {
+  while (true) {
+    const char * newline = memchr( &reader->data[reader->pos] , '\n' , reader->size - reader->pos );
+    if (newline) {
+      reader->pos = (newline - reader->data) + 1;
+      return;
+    }
+
+    reader->pos = reader->size;
+    if (reader->eof)
+      return;
+
+    grdecl_reader_fill( reader );
+  }
+}
+
+
+/*
+  Reads the next whitespace delimited token, at most GRDECL_MAX_TOKEN
+  characters, into @token. Will return false at EOF.
+*/
+
+static bool grdecl_reader_next_token( grdecl_reader_type * reader , char * token ) {
+  if (grdecl_reader_skip_space( reader )) {
+    int len = 0;
+    grdecl_reader_fill( reader );
+    while ((len < GRDECL_MAX_TOKEN) && (reader->pos < reader->size) && !isspace( (unsigned char) reader->data[reader->pos] ))
+      token[len++] = reader->data[reader->pos++];
+
+    token[len] = '\0';
+    return true;
+  } else
+    return false;
+}
+
+
+static bool grdecl_reader_at_token_end( grdecl_reader_type * reader ) {
+  grdecl_reader_fill( reader );
+  if (reader->pos == reader->size)
+    return true;
+  return isspace( (unsigned char) reader->data[reader->pos] ) ? true : false;
+}
+
+
+/*
+  Will find the next keyword candidate, using the same rules as
+  ecl_kw_grdecl_fseek_next_kw(): the first string on a line which is
+  not a comment. The reader must be positioned at the start of a
+  line, or at the start of the first string on a line. On return the
+  reader is positioned at the start of the following line, and the
+  file offset of the candidate is returned in @offset.
+*/
+
+static bool grdecl_reader_next_kw( grdecl_reader_type * reader , char * kw , offset_type * offset ) {
+  while (grdecl_reader_skip_space( reader )) {
+    offset_type kw_offset = grdecl_reader_tell( reader );
+    bool complete , comment;
+
+    grdecl_reader_next_token( reader , kw );
+    complete = grdecl_reader_at_token_end( reader );
+    comment  = ((kw[0] == ECL_COMMENT_CHAR) && (kw[1] == ECL_COMMENT_CHAR));
+    grdecl_reader_skip_line( reader );
+
+    if (complete && !comment) {
+      *offset = kw_offset;
+      return true;
+    }
+  }
+  return false;
+}
+
+
+
 /*
   Will seek from the current position to the next keyword. If a valid
   next keyword is found the function will position the file reader at
@@ -168,21 +350,30 @@ char * ecl_kw_grdecl_alloc_next_header( FILE * stream ) {
 */
 
 static bool ecl_kw_grdecl_fseek_kw__(const char * kw , FILE * stream) {
-  long init_pos = util_ftell( stream );
-  while (true) {
-    if (ecl_kw_grdecl_fseek_next_kw( stream )) {
-      char next_kw[256];
-      fscanf( stream , "%s" , next_kw);
+  offset_type init_pos = util_ftell( stream );
+  if (ecl_kw_grdecl_fseek_next_kw( stream )) {
+    grdecl_reader_type reader;
+    char next_kw[GRDECL_MAX_TOKEN + 1];
+    offset_type kw_offset;
+    bool found = false;
+
+    grdecl_reader_init_stream( &reader , stream );
+    while (grdecl_reader_next_kw( &reader , next_kw , &kw_offset )) {
       if (strcmp( kw , next_kw ) == 0) {
-        offset_type offset = (offset_type) strlen(next_kw);
-        util_fseek( stream , -offset , SEEK_CUR);
-        return true;
+        found = true;
+        break;
       }
-    } else {
-      util_fseek( stream , init_pos , SEEK_SET);
-      return false;
+    }
+    grdecl_reader_free( &reader );
+
+    if (found) {
+      util_fseek( stream , kw_offset , SEEK_SET );
+      return true;
     }
   }
+
+  util_fseek( stream , init_pos , SEEK_SET);
+  return false;
 }
 
 
@@ -334,129 +525,139 @@ static void iset_range( char * data , int data_offset , int sizeof_ctype , void
    Observe that no-spaces-are-allowed-around-the-*
 */
 
-static char * fscanf_alloc_grdecl_data( const char * header , bool strict , ecl_data_type data_type , int * kw_size , FILE * stream ) {
-  char newline        = '\n';
-  bool atEOF          = false;
+static char * grdecl_reader_alloc_data( grdecl_reader_type * reader , const char * header , bool strict , ecl_data_type data_type , int * kw_size ) {
   int init_size       = 32;
-  int buffer_size     = 64;
   int data_index      = 0;
   int sizeof_ctype    = ecl_type_get_sizeof_ctype( data_type );
   int data_size       = init_size;
-  char * buffer       = util_calloc( (buffer_size + 1) , sizeof * buffer      );
+  char buffer[GRDECL_MAX_TOKEN + 1];
   char * data         = util_calloc( sizeof_ctype * data_size , sizeof * data );
 
-  while (true) {
-    if (fscanf(stream , "%32s" , buffer) == 1) {
-      if (strcmp(buffer , ECL_COMMENT_STRING) == 0) {
-        // We have read a comment marker - just read up to the end of line.
-        char c;
-        while (true) {
-          c = fgetc( stream );
-          if (c == newline)
-            break;
-          if (c == EOF) {
-            atEOF = true;
-            break;
-          }
-        }
-      } else if (strcmp(buffer , ECL_DATA_TERMINATION) == 0)
-        break;
-      else {
-        // We have read a valid input string; scan numerical input values from it.
-        // The multiplier algorithm will fail hard if there are spaces on either side
-        // of the '*'.
-
-        int multiplier;
-        void * value_ptr = NULL;
-        bool   char_input = false;
-
-        if (ecl_type_is_int(data_type)) {
-          int value;
-
-          if (sscanf(buffer , "%d*%d" , &multiplier , &value) == 2)
-            {}
-          else if (sscanf( buffer , "%d" , &value) == 1)
-            multiplier = 1;
-          else {
-            char_input = true;
-            if (strict)
-              util_abort("%s: Malformed content:\"%s\" when reading keyword:%s \n",__func__ , buffer , header);
-          }
-
-          value_ptr = &value;
-        } else if (ecl_type_is_float(data_type)) {
-          float value;
-
-          if (sscanf(buffer , "%d*%g" , &multiplier , &value) == 2)
-            {}
-          else if (sscanf( buffer , "%g" , &value) == 1)
-            multiplier = 1;
-          else {
-            char_input = true;
-            if (strict)
-              util_abort("%s: Malformed content:\"%s\" when reading keyword:%s \n",__func__ , buffer , header);
-          }
-
-          value_ptr = &value;
-        } else if (ecl_type_is_double(data_type)) {
-          double value;
-
-          if (sscanf(buffer , "%d*%lg" , &multiplier , &value) == 2)
-            {}
-          else if (sscanf( buffer , "%lg" , &value) == 1)
-            multiplier = 1;
-          else {
-            char_input = true;
-            if (strict)
-              util_abort("%s: Malformed content:\"%s\" when reading keyword:%s \n",__func__ , buffer , header);
-          }
+  while (grdecl_reader_next_token( reader , buffer )) {
+    if (strcmp(buffer , ECL_COMMENT_STRING) == 0)
+      // We have read a comment marker - just read up to the end of line.
+      grdecl_reader_skip_line( reader );
+    else if (strcmp(buffer , ECL_DATA_TERMINATION) == 0)
+      break;
+    else {
+      // We have read a valid input string; scan numerical input values from it.
+      // The multiplier algorithm will fail hard if there are spaces on either side
+      // of the '*'. The parsing is equivalent to sscanf() with the formats
+      // "%d*<value>" and "<value>".
+
+      int multiplier = 1;
+      void * value_ptr = NULL;
+      bool   char_input = false;
+      int    int_value;
+      float  float_value;
+      double double_value;
+      const char * value_string = buffer;
+      char * end_ptr;
 
-          value_ptr = &value;
-        } else
-          util_abort("%s: sorry type:%s not supported \n",__func__ , ecl_type_get_name(data_type));
+      {
+        long lmult = strtol( buffer , &end_ptr , 10 );
+        if ((end_ptr != buffer) && (*end_ptr == '*')) {
+          multiplier = (int) lmult;
+          value_string = end_ptr + 1;
+        }
+      }
 
-        /*
-          Removing this warning on user request:
-          if (char_input)
-          fprintf(stderr,"Warning: character string: \'%s\' ignored when reading keyword:%s \n",buffer , header);
-        */
-        if (!char_input) {
-          size_t min_size = data_index + multiplier;
-          if (min_size >= data_size) {
-            if (min_size <= ECL_KW_MAX_SIZE) {
-              size_t byte_size = sizeof_ctype * sizeof * data;
-
-              data_size  = util_size_t_min( ECL_KW_MAX_SIZE , 2*(data_index + multiplier));
-              byte_size *= data_size;
-
-              data = util_realloc( data , byte_size );
-            } else {
-              /*
-                We are asking for more elements than can possible be adressed in
-                an integer. Return NULL - and data size == 0; let calling scope
-                try to handle it.
-              */
-              data_index = 0;
-              break;
-            }
+      if (ecl_type_is_int(data_type)) {
+        int_value = (int) strtol( value_string , &end_ptr , 10 );
+        if (end_ptr == value_string) {
+          int_value = (int) strtol( buffer , &end_ptr , 10 );
+          multiplier = 1;
+          char_input = (end_ptr == buffer);
+        }
+        value_ptr = &int_value;
+      } else if (ecl_type_is_float(data_type)) {
+        float_value = strtof( value_string , &end_ptr );
+        if (end_ptr == value_string) {
+          float_value = strtof( buffer , &end_ptr );
+          multiplier = 1;
+          char_input = (end_ptr == buffer);
+        }
+        value_ptr = &float_value;
+      } else if (ecl_type_is_double(data_type)) {
+        double_value = strtod( value_string , &end_ptr );
+        if (end_ptr == value_string) {
+          double_value = strtod( buffer , &end_ptr );
+          multiplier = 1;
+          char_input = (end_ptr == buffer);
+        }
+        value_ptr = &double_value;
+      } else
+        util_abort("%s: sorry type:%s not supported \n",__func__ , ecl_type_get_name(data_type));
+
+      if (char_input && strict)
+        util_abort("%s: Malformed content:\"%s\" when reading keyword:%s \n",__func__ , buffer , header);
+
+      /*
+        Removing this warning on user request:
+        if (char_input)
+        fprintf(stderr,"Warning: character string: \'%s\' ignored when reading keyword:%s \n",buffer , header);
+      */
+      if (!char_input) {
+        size_t min_size = data_index + multiplier;
+        if (min_size >= data_size) {
+          if (min_size <= ECL_KW_MAX_SIZE) {
+            size_t byte_size = sizeof_ctype * sizeof * data;
+
+            data_size  = util_size_t_min( ECL_KW_MAX_SIZE , 2*(data_index + multiplier));
+            byte_size *= data_size;
+
+            data = util_realloc( data , byte_size );
+          } else {
+            /*
+              We are asking for more elements than can possible be adressed in
+              an integer. Return NULL - and data size == 0; let calling scope
+              try to handle it.
+            */
+            data_index = 0;
+            break;
           }
-
-          iset_range( data , data_index , sizeof_ctype , value_ptr , multiplier );
-          data_index += multiplier;
         }
 
+        iset_range( data , data_index , sizeof_ctype , value_ptr , multiplier );
+        data_index += multiplier;
       }
-      if (atEOF)
-        break;
-    } else
-      break;
+    }
   }
-  free( buffer );
   *kw_size = data_index;
   data = util_realloc( data , sizeof_ctype * data_index * sizeof * data );
   return data;
 }
 
+
+/*
+  Reads the header string and the data of one keyword from the
+  current position of the reader.
+*/
+
+static ecl_kw_type * grdecl_reader_alloc_kw( grdecl_reader_type * reader , bool strict , int size , ecl_data_type data_type) {
+  char file_header[GRDECL_MAX_TOKEN + 1];
+  if (grdecl_reader_next_token( reader , file_header )) {
+    int kw_size;
+    char * data = grdecl_reader_alloc_data( reader , file_header , strict , data_type , &kw_size );
+
+    // Verify size
+    if (size > 0)
+      if (size != kw_size) {
+        util_safe_free( data );
+        util_abort("%s: size mismatch when loading:%s. File:%d elements. Requested:%d elements \n",
+                   __func__ , file_header , kw_size , size);
+      }
+
+    {
+      ecl_kw_type * ecl_kw = ecl_kw_alloc_new( file_header , kw_size , data_type , NULL );
+      ecl_kw_set_data_ptr( ecl_kw , data );
+      return ecl_kw;
+    }
+  } else
+    /** No header read - probably at EOF */
+    return NULL;
+}
+
 /*
    This function will load a keyword from a grdecl file, and return
    it. If input argument @kw is NULL it will just try loading from the
@@ -468,8 +669,8 @@ static char * fscanf_alloc_grdecl_data( const char * header , bool strict , ecl_
    ways; if the loading fails the function returns NULL.
 
    The main loop is extremely simple - it is just repeated calls to
-   fscanf() to read one-number-at-atime; when that reading fails that
-   is interpreted as the end of the keyword.
+   read one-number-at-atime; when that reading fails that is
+   interpreted as the end of the keyword.
 
    Currently ONLY integer and float types are supported in ecl_type -
    any other types will lead to a hard failure.
@@ -494,7 +695,7 @@ static char * fscanf_alloc_grdecl_data( const char * header , bool strict , ecl_
       @header argument.
 
     strict: see the documentation of the strict flag in the
-      fscanf_alloc_grdecl_data() function. Most of the exported
+      grdecl_reader_alloc_data() function. Most of the exported
       functions have hardwired strict = true.
 
 
@@ -525,28 +726,13 @@ static ecl_kw_type * __ecl_kw_fscanf_alloc_grdecl__(FILE * stream , const char *
       return NULL;  /* Could not find it. */
 
   {
-    char file_header[9];
-    if (fscanf(stream , "%s" , file_header) == 1) {
-      int kw_size;
-      char * data = fscanf_alloc_grdecl_data( file_header , strict , data_type , &kw_size , stream );
-
-      // Verify size
-      if (size > 0)
-        if (size != kw_size) {
-          util_safe_free( data );
-          util_abort("%s: size mismatch when loading:%s. File:%d elements. Requested:%d elements \n",
-                     __func__ , file_header , kw_size , size);
-        }
+    grdecl_reader_type reader;
+    ecl_kw_type * ecl_kw;
 
-      {
-        ecl_kw_type * ecl_kw = ecl_kw_alloc_new( file_header , kw_size , data_type , NULL );
-        ecl_kw_set_data_ptr( ecl_kw , data );
-        return ecl_kw;
-      }
-
-    } else
-      /** No header read - probably at EOF */
-      return NULL;
+    grdecl_reader_init_stream( &reader , stream );
+    ecl_kw = grdecl_reader_alloc_kw( &reader , strict , size , data_type );
+    grdecl_reader_free( &reader );
+    return ecl_kw;
   }
 }
 /*****************************************************************/
@@ -676,3 +862,195 @@ void ecl_kw_fprintf_grdecl__(const ecl_kw_type * ecl_kw , const char * special_h
 void ecl_kw_fprintf_grdecl(const ecl_kw_type * ecl_kw , FILE * stream) {
   ecl_kw_fprintf_grdecl__(ecl_kw , NULL , stream );
 }
+
+
+/*****************************************************************/
+/*
+  The ecl_kw_grdecl_index scans a complete GRDECL file once, and
+  records the position of all the keywords found. This makes it
+  possible to load several keywords from a large include file without
+  rescanning the file for every keyword. Only strings starting with
+  a letter are considered keywords; apart from that the rules are the
+  same as for ecl_kw_grdecl_fseek_next_kw().
+
+  If @use_mmap is true the file is memory mapped, and keywords loaded
+  with ecl_kw_grdecl_index_alloc_kw() are parsed directly from the
+  mapping; if the mapping fails (or mmap is not available) the index
+  silently falls back to reading from the stream.
+*/
+
+#define ECL_KW_GRDECL_INDEX_TYPE_ID 71503128
+
+struct ecl_kw_grdecl_index_struct {
+  UTIL_TYPE_ID_DECLARATION;
+  FILE              * stream;
+  stringlist_type   * kw_list;
+  size_t_vector_type * offset_list;
+  char              * mmap_data;
+  size_t              mmap_size;
+};
+
+
+UTIL_IS_INSTANCE_FUNCTION( ecl_kw_grdecl_index , ECL_KW_GRDECL_INDEX_TYPE_ID )
+
+
+static void ecl_kw_grdecl_index_mmap( ecl_kw_grdecl_index_type * index ) {
+#ifdef ERT_HAVE_MMAP
+  size_t file_size = util_fd_size( fileno( index->stream ));
+  if (file_size > 0) {
+    void * data = mmap( NULL , file_size , PROT_READ , MAP_PRIVATE , fileno( index->stream ) , 0 );
+    if (data != MAP_FAILED) {
+      index->mmap_data = data;
+      index->mmap_size = file_size;
+    }
+  }
+#endif
+}
+
+
+static void ecl_kw_grdecl_index_init_reader( const ecl_kw_grdecl_index_type * index , grdecl_reader_type * reader , offset_type offset) {
+  if (index->mmap_data)
+    grdecl_reader_init_memory( reader , index->mmap_data , index->mmap_size , offset );
+  else {
+    util_fseek( index->stream , offset , SEEK_SET );
+    grdecl_reader_init_stream( reader , index->stream );
+  }
+}
+
+
+ecl_kw_grdecl_index_type * ecl_kw_grdecl_index_alloc( FILE * stream , bool use_mmap ) {
+  ecl_kw_grdecl_index_type * index = util_malloc( sizeof * index );
+  UTIL_TYPE_ID_INIT( index , ECL_KW_GRDECL_INDEX_TYPE_ID );
+  index->stream      = stream;
+  index->kw_list     = stringlist_alloc_new( );
+  index->offset_list = size_t_vector_alloc( 0 , 0 );
+  index->mmap_data   = NULL;
+  index->mmap_size   = 0;
+
+  if (use_mmap)
+    ecl_kw_grdecl_index_mmap( index );
+
+  {
+    offset_type init_pos = util_ftell( stream );
+    grdecl_reader_type reader;
+    char kw[GRDECL_MAX_TOKEN + 1];
+    offset_type kw_offset;
+
+    ecl_kw_grdecl_index_init_reader( index , &reader , 0 );
+    while (grdecl_reader_next_kw( &reader , kw , &kw_offset )) {
+      if (isalpha( (unsigned char) kw[0] )) {
+        stringlist_append_copy( index->kw_list , kw );
+        size_t_vector_append( index->offset_list , kw_offset );
+      }
+    }
+    grdecl_reader_free( &reader );
+    util_fseek( stream , init_pos , SEEK_SET );
+  }
+  return index;
+}
+
+
+void ecl_kw_grdecl_index_free( ecl_kw_grdecl_index_type * index ) {
+#ifdef ERT_HAVE_MMAP
+  if (index->mmap_data)
+    munmap( index->mmap_data , index->mmap_size );
+#endif
+  stringlist_free( index->kw_list );
+  size_t_vector_free( index->offset_list );
+  free( index );
+}
+
+
+bool ecl_kw_grdecl_index_is_mapped( const ecl_kw_grdecl_index_type * index ) {
+  return (index->mmap_data != NULL);
+}
+
+
+int ecl_kw_grdecl_index_get_size( const ecl_kw_grdecl_index_type * index ) {
+  return stringlist_get_size( index->kw_list );
+}
+
+
+const char * ecl_kw_grdecl_index_iget_kw( const ecl_kw_grdecl_index_type * index , int kw_nr) {
+  return stringlist_iget( index->kw_list , kw_nr );
+}
+
+
+offset_type ecl_kw_grdecl_index_iget_offset( const ecl_kw_grdecl_index_type * index , int kw_nr) {
+  return size_t_vector_iget( index->offset_list , kw_nr );
+}
+
+
+bool ecl_kw_grdecl_index_has_kw( const ecl_kw_grdecl_index_type * index , const char * kw) {
+  return stringlist_contains( index->kw_list , kw );
+}
+
+
+/*
+  Returns the index of the first occurence of @kw at or after
+  @offset, or -1 if there is no such occurence.
+*/
+
+static int ecl_kw_grdecl_index_find( const ecl_kw_grdecl_index_type * index , const char * kw , offset_type offset) {
+  int kw_nr;
+  for (kw_nr = 0; kw_nr < stringlist_get_size( index->kw_list ); kw_nr++) {
+    if (ecl_kw_grdecl_index_iget_offset( index , kw_nr ) >= offset)
+      if (strcmp( kw , stringlist_iget( index->kw_list , kw_nr )) == 0)
+        return kw_nr;
+  }
+  return -1;
+}
+
+
+/*
+  Equivalent to ecl_kw_grdecl_fseek_kw(), but the position of @kw is
+  found in the index instead of scanning the file.
+*/
+
+bool ecl_kw_grdecl_index_fseek_kw( const ecl_kw_grdecl_index_type * index , const char * kw , bool rewind , FILE * stream) {
+  int kw_nr = ecl_kw_grdecl_index_find( index , kw , util_ftell( stream ));
+  if ((kw_nr < 0) && rewind)
+    kw_nr = ecl_kw_grdecl_index_find( index , kw , 0 );
+
+  if (kw_nr < 0)
+    return false;
+
+  util_fseek( stream , ecl_kw_grdecl_index_iget_offset( index , kw_nr ) , SEEK_SET );
+  return true;
+}
+
+
+/*
+  Will load the first occurence of @kw in the file; the @strict and
+  @size arguments are as for ecl_kw_fscanf_alloc_grdecl__(). Returns
+  NULL if the keyword is not in the index. The position of the
+  stream is not changed.
+*/
+
+ecl_kw_type * ecl_kw_grdecl_index_alloc_kw__( const ecl_kw_grdecl_index_type * index , const char * kw , bool strict , int size , ecl_data_type data_type) {
+  if (!ecl_type_is_numeric(data_type))
+    util_abort("%s: sorry only types FLOAT, INT and DOUBLE supported\n",__func__);
+  {
+    int kw_nr = ecl_kw_grdecl_index_find( index , kw , 0 );
+    if (kw_nr < 0)
+      return NULL;
+
+    {
+      offset_type init_pos = util_ftell( index->stream );
+      grdecl_reader_type reader;
+      ecl_kw_type * ecl_kw;
+
+      ecl_kw_grdecl_index_init_reader( index , &reader , ecl_kw_grdecl_index_iget_offset( index , kw_nr ));
+      ecl_kw = grdecl_reader_alloc_kw( &reader , strict , size , data_type );
+      grdecl_reader_free( &reader );
+      util_fseek( index->stream , init_pos , SEEK_SET );
+      return ecl_kw;
+    }
+  }
+}
+
+
+ecl_kw_type * ecl_kw_grdecl_index_alloc_kw( const ecl_kw_grdecl_index_type * index , const char * kw , int size , ecl_data_type data_type) {
+  bool strict = true;
+  return ecl_kw_grdecl_index_alloc_kw__( index , kw , strict , size , data_type );
+}
@@ -1074,6 +1074,41 @@ static bool ecl_smspec_check_header( ecl_file_type * header ) {
 }
 
 
+/*
+  The string vectors in the SMSPEC header are normally of type CHAR,
+  i.e. max eight characters. This will strip leading and trailing
+  blanks from @src into the caller supplied @buffer, to avoid a heap
+  allocation per string when loading large headers. The buffers are
+  allocated from the element size of the keyword, see
+  ecl_smspec_alloc_string_buffer(); should a string still be too long
+  it is truncated to fit the buffer.
+*/
+
+static const char * ecl_smspec_strip_string( char * buffer , size_t buffer_size , const char * src) {
+  int start_index = 0;
+  int end_index   = strlen( src ) - 1;
+
+  while (end_index >= 0 && src[end_index] == ' ')
+    end_index--;
+
+  while (start_index <= end_index && src[start_index] == ' ')
+    start_index++;
+
+  if (end_index - start_index + 1 >= (int) buffer_size)
+    end_index = start_index + buffer_size - 2;
+
+  memcpy( buffer , &src[start_index] , end_index - start_index + 1 );
+  buffer[end_index - start_index + 1] = '\0';
+  return buffer;
+}
+
+
+static char * ecl_smspec_alloc_string_buffer( const ecl_kw_type * ecl_kw , size_t * buffer_size) {
+  *buffer_size = ecl_kw_get_sizeof_ctype( ecl_kw ) + 1;
+  return util_malloc( *buffer_size );
+}
+
+
 static bool ecl_smspec_fread_header(ecl_smspec_type * ecl_smspec, const char * header_file , bool include_restart) {
   ecl_file_type * header = ecl_file_open( header_file , 0);
   if (header && ecl_smspec_check_header( header )) {
@@ -1115,16 +1150,23 @@ static bool ecl_smspec_fread_header(ecl_smspec_type * ecl_smspec, const char * h
     ecl_smspec->grid_dims[1] = ecl_kw_iget_int(dimens , DIMENS_SMSPEC_NY_INDEX );
     ecl_smspec->grid_dims[2] = ecl_kw_iget_int(dimens , DIMENS_SMSPEC_NZ_INDEX );
     ecl_smspec_set_params_size( ecl_smspec , ecl_kw_get_size(keywords));
+    /* Every node is installed with at least one general key - see ecl_smspec_install_gen_keys(). */
+    hash_reserve( ecl_smspec->gen_var_index , ecl_kw_get_size(keywords));
 
     ecl_util_get_file_type( header_file , &ecl_smspec->formatted , NULL );
 
     {
+      size_t well_size, kw_size, unit_size;
+      char * well_buffer = ecl_smspec_alloc_string_buffer( wells , &well_size );
+      char * kw_buffer   = ecl_smspec_alloc_string_buffer( keywords , &kw_size );
+      char * unit_buffer = ecl_smspec_alloc_string_buffer( units , &unit_size );
+
       for (params_index=0; params_index < ecl_kw_get_size(wells); params_index++) {
         float default_value          = PARAMS_GLOBAL_DEFAULT;
         int num                      = SMSPEC_NUMS_INVALID;
-        char * well                  = util_alloc_strip_copy(ecl_kw_iget_ptr(wells    , params_index));
-        char * kw                    = util_alloc_strip_copy(ecl_kw_iget_ptr(keywords , params_index));
-        char * unit                  = util_alloc_strip_copy(ecl_kw_iget_ptr(units    , params_index));
+        const char * well            = ecl_smspec_strip_string( well_buffer , well_size , ecl_kw_iget_ptr(wells    , params_index));
+        const char * kw              = ecl_smspec_strip_string( kw_buffer   , kw_size   , ecl_kw_iget_ptr(keywords , params_index));
+        const char * unit            = ecl_smspec_strip_string( unit_buffer , unit_size , ecl_kw_iget_ptr(units    , params_index));
         char * lgr_name              = NULL;
 
         smspec_node_type * smspec_node;
@@ -1145,11 +1187,12 @@ static bool ecl_smspec_fread_header(ecl_smspec_type * ecl_smspec, const char * h
           ecl_smspec_add_node( ecl_smspec , smspec_node );
         }
 
-        free( kw );
-        free( well );
-        free( unit );
         util_safe_free( lgr_name );
       }
+
+      free( well_buffer );
+      free( kw_buffer );
+      free( unit_buffer );
     }
 
     ecl_smspec->header_file = util_alloc_realpath( header_file );
@@ -1165,6 +1208,37 @@ static bool ecl_smspec_fread_header(ecl_smspec_type * ecl_smspec, const char * h
 
 
 
+/*
+  The indexes of a smspec instance loaded from file are not modified
+  after loading, and are frozen so that lookups from several threads
+  do not take the hash locks. The @depth argument is the number of
+  levels of nested hash tables below @index.
+*/
+
+static void ecl_smspec_freeze_index__( hash_type * index , int depth ) {
+  if (depth > 0) {
+    hash_iter_type * iter = hash_iter_alloc( index );
+    while (!hash_iter_is_complete( iter ))
+      ecl_smspec_freeze_index__( hash_iter_get_next_value( iter ) , depth - 1);
+    hash_iter_free( iter );
+  }
+  hash_freeze( index );
+}
+
+
+static void ecl_smspec_freeze_indexes( ecl_smspec_type * ecl_smspec ) {
+  ecl_smspec_freeze_index__( ecl_smspec->well_var_index , 1 );
+  ecl_smspec_freeze_index__( ecl_smspec->well_completion_var_index , 2 );
+  ecl_smspec_freeze_index__( ecl_smspec->group_var_index , 1 );
+  ecl_smspec_freeze_index__( ecl_smspec->field_var_index , 0 );
+  ecl_smspec_freeze_index__( ecl_smspec->region_var_index , 1 );
+  ecl_smspec_freeze_index__( ecl_smspec->misc_var_index , 0 );
+  ecl_smspec_freeze_index__( ecl_smspec->block_var_index , 1 );
+  ecl_smspec_freeze_index__( ecl_smspec->gen_var_index , 0 );
+}
+
+
+
 ecl_smspec_type * ecl_smspec_fread_alloc(const char *header_file, const char * key_join_string , bool include_restart) {
   ecl_smspec_type *ecl_smspec;
 
@@ -1206,6 +1280,7 @@ ecl_smspec_type * ecl_smspec_fread_alloc(const char *header_file, const char * k
       util_abort("%s: Sorry the SMSPEC file seems to lack all time information, need either TIME, or DAY/MONTH/YEAR information. Can not proceed.",__func__);
       return NULL;
     }
+    ecl_smspec_freeze_indexes( ecl_smspec );
     return ecl_smspec;
   } else {
     /** Failed to load from disk. */
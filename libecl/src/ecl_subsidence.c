@@ -136,16 +136,11 @@ static void ecl_subsidence_survey_free__( void * __subsidence_survey ) {
 
 /*****************************************************************/
 
-static double ecl_subsidence_survey_eval( const ecl_subsidence_survey_type * base_survey ,
-                                          const ecl_subsidence_survey_type * monitor_survey,
-                                          ecl_region_type * region ,
-                                          double utm_x , double utm_y , double depth,
-                                          double compressibility, double poisson_ratio) {
-
+static double * ecl_subsidence_survey_alloc_weight( const ecl_subsidence_survey_type * base_survey ,
+                                                    const ecl_subsidence_survey_type * monitor_survey) {
   const ecl_grid_cache_type * grid_cache = base_survey->grid_cache;
   const int size  = ecl_grid_cache_get_size( grid_cache );
   double * weight = util_calloc( size , sizeof * weight );
-  double deltaz;
   int index;
 
   if (monitor_survey != NULL) {
@@ -155,6 +150,39 @@ static double ecl_subsidence_survey_eval( const ecl_subsidence_survey_type * bas
     for (index = 0; index < size; index++)
       weight[index] = base_survey->porv[index] * base_survey->pressure[index];
   }
+  return weight;
+}
+
+
+static double * ecl_subsidence_survey_alloc_geertsma_weight( const ecl_subsidence_survey_type * base_survey ,
+                                                             const ecl_subsidence_survey_type * monitor_survey,
+                                                             double youngs_modulus, double poisson_ratio) {
+  const ecl_grid_cache_type * grid_cache = base_survey->grid_cache;
+  const double * cell_volume = ecl_grid_cache_get_volume( grid_cache );
+  const int size  = ecl_grid_cache_get_size( grid_cache );
+  double scale_factor = 1e4 *(1 + poisson_ratio) * ( 1 - 2*poisson_ratio) / ( 4*M_PI*( 1 - poisson_ratio)  * youngs_modulus );
+  double * weight = util_calloc( size , sizeof * weight );
+
+  for (int index = 0; index < size; index++) {
+    if (monitor_survey) {
+        weight[index] = scale_factor * cell_volume[index] * (base_survey->pressure[index] - monitor_survey->pressure[index]);
+    } else {
+        weight[index] = scale_factor * cell_volume[index] * (base_survey->pressure[index] );
+    }
+  }
+  return weight;
+}
+
+
+static double ecl_subsidence_survey_eval( const ecl_subsidence_survey_type * base_survey ,
+                                          const ecl_subsidence_survey_type * monitor_survey,
+                                          ecl_region_type * region ,
+                                          double utm_x , double utm_y , double depth,
+                                          double compressibility, double poisson_ratio) {
+
+  const ecl_grid_cache_type * grid_cache = base_survey->grid_cache;
+  double * weight = ecl_subsidence_survey_alloc_weight( base_survey , monitor_survey );
+  double deltaz;
 
   deltaz = compressibility * 31.83099*(1-poisson_ratio) *
     ecl_grav_common_eval_biot_savart( grid_cache , region , base_survey->aquifer_cell , weight , utm_x , utm_y , depth );
@@ -171,20 +199,9 @@ static double ecl_subsidence_survey_eval_geertsma( const ecl_subsidence_survey_t
                                                    double youngs_modulus, double poisson_ratio, double seabed) {
 
   const ecl_grid_cache_type * grid_cache = base_survey->grid_cache;
-  const double * cell_volume = ecl_grid_cache_get_volume( grid_cache );
-  const int size  = ecl_grid_cache_get_size( grid_cache );
-  double scale_factor = 1e4 *(1 + poisson_ratio) * ( 1 - 2*poisson_ratio) / ( 4*M_PI*( 1 - poisson_ratio)  * youngs_modulus );
-  double * weight = util_calloc( size , sizeof * weight );
+  double * weight = ecl_subsidence_survey_alloc_geertsma_weight( base_survey , monitor_survey , youngs_modulus , poisson_ratio );
   double deltaz;
 
-  for (int index = 0; index < size; index++) {
-    if (monitor_survey) {
-        weight[index] = scale_factor * cell_volume[index] * (base_survey->pressure[index] - monitor_survey->pressure[index]);
-    } else {
-        weight[index] = scale_factor * cell_volume[index] * (base_survey->pressure[index] );
-    }
-  }
-
   deltaz = ecl_grav_common_eval_geertsma( grid_cache , region , base_survey->aquifer_cell , weight , utm_x , utm_y , depth , poisson_ratio, seabed);
 
   free( weight );
@@ -192,6 +209,47 @@ static double ecl_subsidence_survey_eval_geertsma( const ecl_subsidence_survey_t
 }
 
 
+static void ecl_subsidence_survey_eval_stations( const ecl_subsidence_survey_type * base_survey ,
+                                                 const ecl_subsidence_survey_type * monitor_survey,
+                                                 ecl_region_type * region ,
+                                                 int num_stations ,
+                                                 const double * utm_x , const double * utm_y , const double * depth,
+                                                 double compressibility, double poisson_ratio,
+                                                 int num_threads , double * deltaz) {
+
+  const ecl_grid_cache_type * grid_cache = base_survey->grid_cache;
+  double * weight = ecl_subsidence_survey_alloc_weight( base_survey , monitor_survey );
+  int_vector_type * index_list = ecl_grav_common_alloc_index_list( grid_cache , region , base_survey->aquifer_cell );
+  int station;
+
+  ecl_grav_common_eval_biot_savart_stations( grid_cache , index_list , weight , num_stations , utm_x , utm_y , depth , num_threads , deltaz );
+  for (station = 0; station < num_stations; station++)
+    deltaz[station] *= compressibility * 31.83099*(1-poisson_ratio);
+
+  int_vector_free( index_list );
+  free( weight );
+}
+
+
+static void ecl_subsidence_survey_eval_geertsma_stations( const ecl_subsidence_survey_type * base_survey ,
+                                                          const ecl_subsidence_survey_type * monitor_survey,
+                                                          ecl_region_type * region ,
+                                                          int num_stations ,
+                                                          const double * utm_x , const double * utm_y , const double * depth,
+                                                          double youngs_modulus, double poisson_ratio, double seabed,
+                                                          int num_threads , double * deltaz) {
+
+  const ecl_grid_cache_type * grid_cache = base_survey->grid_cache;
+  double * weight = ecl_subsidence_survey_alloc_geertsma_weight( base_survey , monitor_survey , youngs_modulus , poisson_ratio );
+  int_vector_type * index_list = ecl_grav_common_alloc_index_list( grid_cache , region , base_survey->aquifer_cell );
+
+  ecl_grav_common_eval_geertsma_stations( grid_cache , index_list , weight , num_stations , utm_x , utm_y , depth , poisson_ratio , seabed , num_threads , deltaz );
+
+  int_vector_free( index_list );
+  free( weight );
+}
+
+
 
 /*****************************************************************/
 /**
@@ -253,6 +311,34 @@ double ecl_subsidence_eval_geertsma( const ecl_subsidence_type * subsidence , co
   return ecl_subsidence_survey_eval_geertsma( base_survey , monitor_survey , region , utm_x , utm_y , depth , youngs_modulus, poisson_ratio, seabed);
 }
 
+
+/**
+   Batched versions of ecl_subsidence_eval() and
+   ecl_subsidence_eval_geertsma(); the subsidence at station i is
+   stored in deltaz[i]. The stations can be evaluated in parallel
+   with @num_threads threads.
+*/
+
+void ecl_subsidence_eval_stations( const ecl_subsidence_type * subsidence , const char * base, const char * monitor , ecl_region_type * region ,
+                                   int num_stations , const double * utm_x, const double * utm_y , const double * depth,
+                                   double compressibility, double poisson_ratio,
+                                   int num_threads , double * deltaz) {
+  ecl_subsidence_survey_type * base_survey    = ecl_subsidence_get_survey( subsidence , base );
+  ecl_subsidence_survey_type * monitor_survey = ecl_subsidence_get_survey( subsidence , monitor );
+  ecl_subsidence_survey_eval_stations( base_survey , monitor_survey , region , num_stations , utm_x , utm_y , depth , compressibility , poisson_ratio , num_threads , deltaz);
+}
+
+
+void ecl_subsidence_eval_geertsma_stations( const ecl_subsidence_type * subsidence , const char * base, const char * monitor , ecl_region_type * region ,
+                                            int num_stations , const double * utm_x, const double * utm_y , const double * depth,
+                                            double youngs_modulus, double poisson_ratio, double seabed,
+                                            int num_threads , double * deltaz) {
+  ecl_subsidence_survey_type * base_survey    = ecl_subsidence_get_survey( subsidence , base );
+  ecl_subsidence_survey_type * monitor_survey = ecl_subsidence_get_survey( subsidence , monitor );
+  ecl_subsidence_survey_eval_geertsma_stations( base_survey , monitor_survey , region , num_stations , utm_x , utm_y , depth ,
+                                                youngs_modulus , poisson_ratio , seabed , num_threads , deltaz);
+}
+
 void ecl_subsidence_free( ecl_subsidence_type * ecl_subsidence ) {
   ecl_grid_cache_free( ecl_subsidence->grid_cache );
   free( ecl_subsidence->aquifer_cell );
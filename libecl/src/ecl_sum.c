@@ -20,7 +20,9 @@
 #include <stdbool.h>
 #include <math.h>
 #include <time.h>
+#include <stdint.h>
 #include <locale.h>
+#include <ctype.h>
 
 #include <ert/util/hash.h>
 #include <ert/util/util.h>
@@ -32,11 +34,13 @@
 #include <ert/util/time_t_vector.h>
 #include <ert/util/stringlist.h>
 #include <ert/util/time_interval.h>
+#include <ert/util/buffer.h>
 
 #include <ert/ecl/ecl_util.h>
 #include <ert/ecl/ecl_sum.h>
 #include <ert/ecl/ecl_smspec.h>
 #include <ert/ecl/ecl_sum_data.h>
+#include <ert/ecl/ecl_sum_vector.h>
 #include <ert/ecl/smspec_node.h>
 
 
@@ -105,6 +109,7 @@ struct ecl_sum_struct {
   char              * base;       /* Only the basename. */
   char              * ecl_case;   /* This is the current case, with optional path component. == path + base*/
   char              * ext;        /* Only to support selective loading of formatted|unformatted and unified|multiple. (can be NULL) */
+  int                 load_threads; /* Number of threads used to load non unified summary files. */
 };
 
 
@@ -162,6 +167,7 @@ static ecl_sum_type * ecl_sum_alloc__( const char * input_arg , const char * key
 
   ecl_sum->smspec = NULL;
   ecl_sum->data   = NULL;
+  ecl_sum->load_threads = 1;
 
   return ecl_sum;
 }
@@ -172,6 +178,7 @@ static bool ecl_sum_fread_data( ecl_sum_type * ecl_sum , const stringlist_type *
     ecl_sum_free_data( ecl_sum );
 
   ecl_sum->data = ecl_sum_data_alloc( ecl_sum->smspec );
+  ecl_sum_data_set_load_threads( ecl_sum->data , ecl_sum->load_threads );
   if (ecl_sum_data_fread( ecl_sum->data , data_files )) {
     if (include_restart) {
 
@@ -183,7 +190,7 @@ static bool ecl_sum_fread_data( ecl_sum_type * ecl_sum , const stringlist_type *
 
 
 static void ecl_sum_fread_history( ecl_sum_type * ecl_sum ) {
-  ecl_sum_type * history = ecl_sum_fread_alloc_case__( ecl_smspec_get_restart_case( ecl_sum->smspec ) , ":" , true);
+  ecl_sum_type * history = ecl_sum_fread_alloc_case_parallel( ecl_smspec_get_restart_case( ecl_sum->smspec ) , ":" , true , ecl_sum->load_threads);
   if (history) {
     ecl_sum_data_add_case(ecl_sum->data , history->data );
     ecl_sum_free( history );
@@ -390,7 +397,20 @@ void ecl_sum_free__(void * __ecl_sum) {
 
 
 ecl_sum_type * ecl_sum_fread_alloc_case__(const char * input_file , const char * key_join_string , bool include_restart){
+  return ecl_sum_fread_alloc_case_parallel( input_file , key_join_string , include_restart , 1 );
+}
+
+
+/**
+   As ecl_sum_fread_alloc_case__(), but a case stored as a list of non
+   unified summary files (BASE.S0001, BASE.S0002, ...) is loaded with
+   @load_threads threads; cases this case has been restarted from are
+   loaded the same way.
+*/
+
+ecl_sum_type * ecl_sum_fread_alloc_case_parallel(const char * input_file , const char * key_join_string , bool include_restart , int load_threads){
   ecl_sum_type * ecl_sum     = ecl_sum_alloc__(input_file , key_join_string);
+  ecl_sum->load_threads = util_int_max( 1 , load_threads );
   if (ecl_sum_fread_case( ecl_sum , include_restart))
     return ecl_sum;
   else {
@@ -411,6 +431,43 @@ ecl_sum_type * ecl_sum_fread_alloc_case(const char * input_file , const char * k
 }
 
 
+/**
+   Will load the ministeps which have been written to the summary
+   files since the case was loaded, or since the previous call to
+   ecl_sum_fread_refresh(); this is intended for monitoring running
+   simulations. Only the new part of the summary files is read, see
+   ecl_sum_data_fread_tail() for details. Returns the number of new
+   ministeps.
+
+   Only implemented for unformatted cases; the formatted reader can
+   not handle a keyword which is only partly written. For a formatted
+   case the function returns -1 and the data is left unchanged.
+*/
+
+int ecl_sum_fread_refresh( ecl_sum_type * ecl_sum ) {
+  stringlist_type * data_files;
+  int new_ministeps = 0;
+
+  if (ecl_sum->fmt_case)
+    return -1;
+
+  data_files = stringlist_alloc_new();
+
+  if (ecl_sum->unified) {
+    char * unified_file = ecl_util_alloc_exfilename( ecl_sum->path , ecl_sum->base , ECL_UNIFIED_SUMMARY_FILE , false , -1 );
+    if (unified_file != NULL)
+      stringlist_append_owned_ref( data_files , unified_file );
+  } else
+    ecl_util_select_filelist( ecl_sum->path , ecl_sum->base , ECL_SUMMARY_FILE , false , data_files );
+
+  if (stringlist_get_size( data_files ) > 0)
+    new_ministeps = ecl_sum_data_fread_tail( ecl_sum->data , data_files );
+
+  stringlist_free( data_files );
+  return new_ministeps;
+}
+
+
 bool ecl_sum_case_exists( const char * input_file ) {
   char * smspec_file = NULL;
   stringlist_type * data_files = stringlist_alloc_new();
@@ -668,6 +725,18 @@ void ecl_sum_fwrite_interp_csv_line(const ecl_sum_type * ecl_sum, time_t sim_tim
 }
 
 
+/**
+   Will fill @matrix with the values of all the keys in @keylist,
+   evaluated at the (sorted) times in @sim_time, or at all the
+   ministeps if @sim_time == NULL. See ecl_sum_data_init_data_matrix()
+   for the layout of @matrix.
+*/
+
+void ecl_sum_init_data_matrix( const ecl_sum_type * ecl_sum , const ecl_sum_vector_type * keylist , const time_t_vector_type * sim_time , double * matrix) {
+  ecl_sum_data_init_data_matrix( ecl_sum->data , keylist , sim_time , matrix );
+}
+
+
 
 double ecl_sum_get_general_var_from_sim_time( const ecl_sum_type * ecl_sum , time_t sim_time , const char * var) {
   const smspec_node_type * node = ecl_sum_get_general_var_node( ecl_sum , var );
@@ -793,6 +862,42 @@ double_vector_type * ecl_sum_alloc_data_vector( const ecl_sum_type * ecl_sum  ,
 }
 
 
+/**
+   Bulk access to the full time series of one variable; the returned
+   pointer is to float storage owned by the ecl_sum instance, with one
+   element per internal index, and *length is set to the number of
+   elements. The first call builds a column major copy of the summary
+   data, see the documentation of ecl_sum_data_get_column().
+*/
+
+const float * ecl_sum_iget_column( ecl_sum_type * ecl_sum , int params_index , int * length) {
+  return ecl_sum_data_get_column( ecl_sum->data , params_index , length );
+}
+
+
+const float * ecl_sum_get_column( ecl_sum_type * ecl_sum , const char * gen_key , int * length) {
+  int params_index = ecl_sum_get_general_var_params_index( ecl_sum , gen_key );
+  return ecl_sum_data_get_column( ecl_sum->data , params_index , length );
+}
+
+
+/**
+   Will compress the summary data held in memory, this is intended
+   for keeping many cases in memory at the same time. All the query
+   functions work as before, but the values are decoded on demand;
+   see the documentation of ecl_sum_data_compress().
+*/
+
+void ecl_sum_compress( ecl_sum_type * ecl_sum ) {
+  ecl_sum_data_compress( ecl_sum->data );
+}
+
+
+bool ecl_sum_is_compressed( const ecl_sum_type * ecl_sum ) {
+  return ecl_sum_data_is_compressed( ecl_sum->data );
+}
+
+
 
 void ecl_sum_summarize( const ecl_sum_type * ecl_sum , FILE * stream ) {
   ecl_sum_data_summarize( ecl_sum->data , stream );
@@ -916,29 +1021,155 @@ void ecl_sum_fmt_init_summary_x( const ecl_sum_type * ecl_sum , ecl_sum_fmt_type
 #define DATE_HEADER         "-- Days   dd/mm/yyyy   "
 #define DATE_STRING_LENGTH 128
 
-static void __ecl_sum_fprintf_line( const ecl_sum_type * ecl_sum , FILE * stream , int internal_index , const bool_vector_type * has_var , const int_vector_type * var_index , char * date_string , const ecl_sum_fmt_type * fmt) {
-  fprintf(stream , fmt->days_fmt , ecl_sum_iget_sim_days(ecl_sum , internal_index));
-  fprintf(stream , "%s", fmt->sep );
+#define OUTPUT_BLOCK_SIZE  (1024 * 1024)
+#define OUTPUT_MAX_WIDTH    128   /* Wider value formats go through snprintf(). */
+#define OUTPUT_VALUE_SIZE   256
+
+/*
+  The lines are assembled in a memory buffer which is written to the
+  stream in large blocks. When the value format is a plain '%g' with
+  an optional width of at most OUTPUT_MAX_WIDTH, e.g. "%g" for csv and
+  " %15.6g " for summary.x, and the decimal point is '.', the values
+  are formatted with util_sprintf_g() instead of going through the
+  printf() machinery.
+*/
+
+typedef struct {
+  const ecl_sum_fmt_type * fmt;
+  buffer_type            * buffer;
+  bool                     fast_value;
+  int                      prefix_length;   /* The literal text before the '%' in value_fmt. */
+  int                      width;
+  const char             * suffix;          /* The literal text after the 'g' in value_fmt. */
+  char                   * date_string;
+} ecl_sum_output_type;
+
+
+static bool ecl_sum_output_parse_value_fmt( ecl_sum_output_type * output , const char * value_fmt ) {
+  const char * p = strchr( value_fmt , '%' );
+  if (p == NULL)
+    return false;
+
+  output->prefix_length = p - value_fmt;
+  p++;
+
+  if (*p == '0')  /* Zero padding flag */
+    return false;
+
+  output->width = 0;
+  while (isdigit( *p )) {
+    output->width = output->width * 10 + (*p - '0');
+    if (output->width > OUTPUT_MAX_WIDTH)
+      return false;
+    p++;
+  }
+
+  if (*p == '.') {
+    p++;
+    if ((p[0] != '6') || isdigit( p[1] ))
+      return false;
+    p++;
+  }
+
+  if (*p != 'g')
+    return false;
+  p++;
+
+  if (strchr( p , '%' ) != NULL)
+    return false;
+
+  output->suffix = p;
+  return true;
+}
+
+
+static void ecl_sum_output_init( ecl_sum_output_type * output , const ecl_sum_fmt_type * fmt) {
+  output->fmt = fmt;
+  output->buffer = buffer_alloc( OUTPUT_BLOCK_SIZE );
+  output->date_string = util_malloc( DATE_STRING_LENGTH * sizeof * output->date_string );
+  output->fast_value = false;
+  if (strcmp( localeconv()->decimal_point , ".") == 0)
+    output->fast_value = ecl_sum_output_parse_value_fmt( output , fmt->value_fmt );
+}
+
+
+static void ecl_sum_output_flush( ecl_sum_output_type * output , FILE * stream) {
+  size_t size = buffer_get_size( output->buffer );
+  if (size > 0)
+    util_fwrite( buffer_get_data( output->buffer ) , 1 , size , stream , __func__ );
+  buffer_clear( output->buffer );
+}
+
+
+static void ecl_sum_output_free( ecl_sum_output_type * output , FILE * stream) {
+  ecl_sum_output_flush( output , stream );
+  buffer_free( output->buffer );
+  free( output->date_string );
+}
+
+
+static void ecl_sum_output_string( ecl_sum_output_type * output , const char * string) {
+  buffer_fwrite( output->buffer , string , 1 , strlen( string ));
+}
+
+
+static void ecl_sum_output_value( ecl_sum_output_type * output , double value) {
+  char value_string[OUTPUT_VALUE_SIZE];
+  int length;
+
+  if (output->fast_value) {
+    char g_string[32];
+    int  g_length = util_sprintf_g( g_string , value );
+    int  pad = util_int_max( 0 , output->width - g_length );
+
+    buffer_fwrite( output->buffer , output->fmt->value_fmt , 1 , output->prefix_length );
+    length = 0;
+    while (length < pad)
+      value_string[length++] = ' ';
+    memcpy( &value_string[length] , g_string , g_length );
+    buffer_fwrite( output->buffer , value_string , 1 , length + g_length );
+    ecl_sum_output_string( output , output->suffix );
+  } else {
+    length = snprintf( value_string , sizeof value_string , output->fmt->value_fmt , value );
+    if (length < sizeof value_string)
+      buffer_fwrite( output->buffer , value_string , 1 , length );
+    else {
+      char * long_string = util_alloc_sprintf( output->fmt->value_fmt , value );
+      ecl_sum_output_string( output , long_string );
+      free( long_string );
+    }
+  }
+}
+
+
+static void __ecl_sum_fprintf_line( const ecl_sum_type * ecl_sum , ecl_sum_output_type * output , int internal_index , const bool_vector_type * has_var , const int_vector_type * var_index) {
+  const ecl_sum_fmt_type * fmt = output->fmt;
+  {
+    char days_string[128];
+    snprintf( days_string , sizeof days_string , fmt->days_fmt , ecl_sum_iget_sim_days(ecl_sum , internal_index));
+    ecl_sum_output_string( output , days_string );
+    ecl_sum_output_string( output , fmt->sep );
+  }
 
   {
     struct tm ts;
     time_t sim_time = ecl_sum_iget_sim_time(ecl_sum , internal_index );
     util_time_utc( &sim_time , &ts);
-    strftime( date_string , DATE_STRING_LENGTH - 1 , fmt->date_fmt , &ts);
-    fprintf(stream , "%s", date_string );
+    strftime( output->date_string , DATE_STRING_LENGTH - 1 , fmt->date_fmt , &ts);
+    ecl_sum_output_string( output , output->date_string );
   }
 
   {
     int ivar;
     for (ivar = 0; ivar < int_vector_size( var_index ); ivar++) {
       if (bool_vector_iget( has_var , ivar )) {
-        fprintf(stream , "%s", fmt->sep);
-        fprintf(stream , fmt->value_fmt , ecl_sum_iget(ecl_sum , internal_index, int_vector_iget( var_index , ivar )));
+        ecl_sum_output_string( output , fmt->sep );
+        ecl_sum_output_value( output , ecl_sum_iget(ecl_sum , internal_index, int_vector_iget( var_index , ivar )));
       }
     }
   }
 
-  fprintf(stream , "%s", fmt->newline);
+  ecl_sum_output_string( output , fmt->newline );
 }
 
 
@@ -972,11 +1203,12 @@ static void ecl_sum_fprintf_header( const ecl_sum_type * ecl_sum , const stringl
 void ecl_sum_fprintf(const ecl_sum_type * ecl_sum , FILE * stream , const stringlist_type * var_list , bool report_only , const ecl_sum_fmt_type * fmt) {
   bool_vector_type  * has_var   = bool_vector_alloc( stringlist_get_size( var_list ), false );
   int_vector_type   * var_index = int_vector_alloc( stringlist_get_size( var_list ), -1 );
-  char * date_string            = util_malloc( DATE_STRING_LENGTH * sizeof * date_string);
+  ecl_sum_output_type output;
 
   char * current_locale = NULL;
   if (fmt->locale != NULL)
     current_locale = setlocale(LC_NUMERIC , fmt->locale);
+  ecl_sum_output_init( &output , fmt );
 
   {
     int ivar;
@@ -1003,22 +1235,28 @@ void ecl_sum_fprintf(const ecl_sum_type * ecl_sum , FILE * stream , const string
       if (ecl_sum_data_has_report_step(ecl_sum->data , report)) {
         int time_index;
         time_index = ecl_sum_data_iget_report_end( ecl_sum->data , report );
-        __ecl_sum_fprintf_line( ecl_sum , stream , time_index , has_var , var_index , date_string , fmt);
+        __ecl_sum_fprintf_line( ecl_sum , &output , time_index , has_var , var_index );
       }
+      if (buffer_get_size( output.buffer ) > OUTPUT_BLOCK_SIZE)
+        ecl_sum_output_flush( &output , stream );
     }
   } else {
     int time_index;
-    for (time_index = 0; time_index < ecl_sum_get_data_length( ecl_sum ); time_index++)
-      __ecl_sum_fprintf_line( ecl_sum , stream , time_index , has_var , var_index , date_string , fmt);
+    for (time_index = 0; time_index < ecl_sum_get_data_length( ecl_sum ); time_index++) {
+      __ecl_sum_fprintf_line( ecl_sum , &output , time_index , has_var , var_index );
+      if (buffer_get_size( output.buffer ) > OUTPUT_BLOCK_SIZE)
+        ecl_sum_output_flush( &output , stream );
+    }
   }
+  ecl_sum_output_free( &output , stream );
 
   int_vector_free( var_index );
   bool_vector_free( has_var );
   if (current_locale != NULL)
     setlocale( LC_NUMERIC , current_locale);
-  free( date_string );
 }
 #undef DATE_STRING_LENGTH
+#undef OUTPUT_BLOCK_SIZE
 
 
 
@@ -1050,6 +1288,101 @@ void ecl_sum_export_csv(const ecl_sum_type * ecl_sum , const char * filename  ,
 }
 
 
+#define EXPORT_COLUMNS_MAGIC    0x45434c43    /* "ECLC" */
+#define EXPORT_COLUMNS_VERSION  1
+#define EXPORT_COLUMNS_BLOCK    64
+
+/*
+  Will export the vectors in @var_list to a binary column file, which
+  can be memory mapped or read directly by numerical tools without any
+  parsing. All numbers are written in the native byte order:
+
+     int32      magic  (EXPORT_COLUMNS_MAGIC)
+     int32      version
+     int32      num_columns
+     int32      num_rows
+     int64      start time (seconds since the epoch)
+     num_columns x (key , unit)   - written with util_fwrite_string()
+     float64    days[num_rows]
+     float32    data[num_columns][num_rows]
+
+  Keys in @var_list which are not present in the summary case are
+  skipped with a warning, as in ecl_sum_fprintf(). The data is
+  extracted with ecl_sum_init_data_matrix() in blocks of
+  EXPORT_COLUMNS_BLOCK keys.
+*/
+
+void ecl_sum_export_columns(const ecl_sum_type * ecl_sum , const char * filename , const stringlist_type * var_list) {
+  const int num_rows = ecl_sum_get_data_length( ecl_sum );
+  stringlist_type * keys = stringlist_alloc_new();
+  FILE * stream;
+
+  for (int ivar = 0; ivar < stringlist_get_size( var_list ); ivar++) {
+    const char * key = stringlist_iget( var_list , ivar );
+    if (ecl_sum_has_general_var( ecl_sum , key ))
+      stringlist_append_copy( keys , key );
+    else
+      fprintf(stderr,"** Warning: could not find variable: \'%s\' in summary file \n", key);
+  }
+
+  stream = util_mkdir_fopen( filename , "w");
+  util_fwrite_int( EXPORT_COLUMNS_MAGIC , stream );
+  util_fwrite_int( EXPORT_COLUMNS_VERSION , stream );
+  util_fwrite_int( stringlist_get_size( keys ) , stream );
+  util_fwrite_int( num_rows , stream );
+  {
+    int64_t start_time = ecl_sum_get_start_time( ecl_sum );
+    util_fwrite( &start_time , sizeof start_time , 1 , stream , __func__ );
+  }
+
+  for (int ikey = 0; ikey < stringlist_get_size( keys ); ikey++) {
+    const char * key = stringlist_iget( keys , ikey );
+    util_fwrite_string( key , stream );
+    util_fwrite_string( ecl_sum_get_unit( ecl_sum , key ) , stream );
+  }
+
+  {
+    double * days = util_calloc( num_rows , sizeof * days );
+    for (int time_index = 0; time_index < num_rows; time_index++)
+      days[time_index] = ecl_sum_iget_sim_days( ecl_sum , time_index );
+    util_fwrite( days , sizeof * days , num_rows , stream , __func__ );
+    free( days );
+  }
+
+  if (num_rows > 0) {
+    double * matrix = util_calloc( EXPORT_COLUMNS_BLOCK * num_rows , sizeof * matrix );
+    float  * column = util_calloc( num_rows , sizeof * column );
+
+    for (int block_start = 0; block_start < stringlist_get_size( keys ); block_start += EXPORT_COLUMNS_BLOCK) {
+      int block_end = util_int_min( block_start + EXPORT_COLUMNS_BLOCK , stringlist_get_size( keys ));
+      ecl_sum_vector_type * keylist = ecl_sum_vector_alloc( ecl_sum );
+
+      for (int ikey = block_start; ikey < block_end; ikey++)
+        ecl_sum_vector_add_key( keylist , stringlist_iget( keys , ikey ));
+
+      ecl_sum_init_data_matrix( ecl_sum , keylist , NULL , matrix );
+      for (int ikey = 0; ikey < block_end - block_start; ikey++) {
+        const double * key_data = &matrix[ ikey * num_rows ];
+        for (int time_index = 0; time_index < num_rows; time_index++)
+          column[time_index] = key_data[time_index];
+        util_fwrite( column , sizeof * column , num_rows , stream , __func__ );
+      }
+      ecl_sum_vector_free( keylist );
+    }
+
+    free( column );
+    free( matrix );
+  }
+
+  fclose( stream );
+  stringlist_free( keys );
+}
+
+#undef EXPORT_COLUMNS_MAGIC
+#undef EXPORT_COLUMNS_VERSION
+#undef EXPORT_COLUMNS_BLOCK
+
+
 
 const char * ecl_sum_get_case(const ecl_sum_type * ecl_sum) {
   return ecl_sum->ecl_case;
@@ -1136,10 +1469,27 @@ stringlist_type * ecl_sum_alloc_well_var_list( const ecl_sum_type * ecl_sum ) {
 
 void ecl_sum_resample_from_sim_time( const ecl_sum_type * ecl_sum , const time_t_vector_type * sim_time , double_vector_type * value , const char * gen_key) {
   const smspec_node_type * node = ecl_smspec_get_general_var_node( ecl_sum->smspec , gen_key);
+  const int size = time_t_vector_size( sim_time );
   double_vector_reset( value );
-  {
+
+  /*
+    A sorted time axis which is fully inside the simulation is handled
+    with one merge pass in ecl_sum_init_data_matrix(); otherwise we
+    fall back to one lookup per time point - which will fail hard for
+    time points outside the simulation.
+  */
+  if ((size > 0) &&
+      time_t_vector_is_sorted( sim_time , false ) &&
+      ecl_sum_data_check_sim_time( ecl_sum->data , time_t_vector_get_first( sim_time )) &&
+      ecl_sum_data_check_sim_time( ecl_sum->data , time_t_vector_get_last( sim_time ))) {
+    ecl_sum_vector_type * keylist = ecl_sum_vector_alloc( ecl_sum );
+    ecl_sum_vector_add_key( keylist , gen_key );
+    double_vector_iset( value , size - 1 , 0 );
+    ecl_sum_init_data_matrix( ecl_sum , keylist , sim_time , double_vector_get_ptr( value ));
+    ecl_sum_vector_free( keylist );
+  } else {
     int i;
-    for (i=0; i < time_t_vector_size( sim_time ); i++)
+    for (i=0; i < size; i++)
       double_vector_iset( value , i , ecl_sum_data_get_from_sim_time( ecl_sum->data , time_t_vector_iget( sim_time , i ) , node));
   }
 }
@@ -0,0 +1,398 @@
+/*
+   Copyright (C) 2017  Statoil ASA, Norway.
+
+   The file 'ecl_sum_compressed.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include <ert/util/util.h>
+#include <ert/util/type_macros.h>
+
+#include <ert/ecl/ecl_sum_compressed.h>
+
+
+/*
+  The ecl_sum_compressed structure holds a matrix of float values
+  which is built by appending one row at a time; for the summary data
+  one row is the PARAMS vector of one ministep, and the columns are
+  the time series of the individual summary vectors.
+
+  Most summary vectors are constant (shut wells, rates which are zero,
+  static properties) or vary smoothly over many ministeps, so the data
+  is compressed column wise in blocks of BLOCK_SIZE rows. For each
+  (block,column) the bit pattern of every value is XOR'ed with the
+  bit pattern of the first value in the block, the base. The bits
+  which are zero in all the XOR values, at the top and at the bottom
+  of the word, are removed and the remaining 'width' bits of every
+  value are packed in a bit stream:
+
+      value[i] = base ^ (packed[i] << shift)
+
+  A block where all values are equal has width == 0 and only takes
+  the space of the block header. Since all the values in a block
+  have the same width the value in row i can be extracted directly,
+  without decoding the rest of the block - i.e. the random access of
+  ecl_sum_compressed_iget() is O(1). The compression is lossless;
+  the bit patterns are restored exactly.
+
+  The rows which do not fill a complete block are kept uncompressed
+  in the pending buffer. When ecl_sum_compressed_shrink() is called
+  the pending rows are compressed as a partial block, and the storage
+  is trimmed to the size in use; a partial block is unpacked to the
+  pending buffer again if more rows are appended.
+*/
+
+
+#define ECL_SUM_COMPRESSED_TYPE_ID 66310773
+#define BLOCK_SIZE                 64
+
+typedef struct {
+  uint32_t base;         /* Bit pattern of the first value in the block. */
+  uint8_t  shift;
+  uint8_t  width;        /* Number of bits per value in the packed stream; 0 for constant blocks. */
+  size_t   offset;       /* Offset of the packed stream in the words array. */
+} block_type;
+
+
+struct ecl_sum_compressed_struct {
+  UTIL_TYPE_ID_DECLARATION;
+  int          row_size;
+  int          compressed_rows;     /* Number of rows in the blocks. */
+  block_type * blocks;              /* blocks[ block_nr * row_size + column ]. */
+  int          alloc_block_rows;
+  uint64_t   * words;               /* The packed bit streams of all the blocks. */
+  size_t       num_words;
+  size_t       alloc_words;
+  float      * pending;             /* BLOCK_SIZE rows, row major; NULL when there are no pending rows. */
+  int          pending_rows;
+};
+
+
+UTIL_IS_INSTANCE_FUNCTION( ecl_sum_compressed , ECL_SUM_COMPRESSED_TYPE_ID )
+
+
+ecl_sum_compressed_type * ecl_sum_compressed_alloc( int row_size ) {
+  ecl_sum_compressed_type * compressed = util_malloc( sizeof * compressed );
+  UTIL_TYPE_ID_INIT( compressed , ECL_SUM_COMPRESSED_TYPE_ID );
+  compressed->row_size         = row_size;
+  compressed->compressed_rows  = 0;
+  compressed->blocks           = NULL;
+  compressed->alloc_block_rows = 0;
+  compressed->words            = NULL;
+  compressed->num_words        = 0;
+  compressed->alloc_words      = 0;
+  compressed->pending          = NULL;
+  compressed->pending_rows     = 0;
+  return compressed;
+}
+
+
+void ecl_sum_compressed_free( ecl_sum_compressed_type * compressed ) {
+  util_safe_free( compressed->pending );
+  util_safe_free( compressed->words );
+  util_safe_free( compressed->blocks );
+  free( compressed );
+}
+
+
+static uint32_t ecl_sum_compressed_float_bits( float value ) {
+  uint32_t bits;
+  memcpy( &bits , &value , sizeof bits );
+  return bits;
+}
+
+
+static float ecl_sum_compressed_bits_float( uint32_t bits ) {
+  float value;
+  memcpy( &value , &bits , sizeof value );
+  return value;
+}
+
+
+static uint32_t ecl_sum_compressed_block_iget( const ecl_sum_compressed_type * compressed , const block_type * block , int index ) {
+  if (block->width == 0)
+    return block->base;
+  else {
+    const uint64_t * src = &compressed->words[ block->offset ];
+    const size_t bit = (size_t) index * block->width;
+    const size_t word = bit >> 6;
+    const int shift = bit & 63;
+    uint64_t packed = src[word] >> shift;
+
+    if (shift + block->width > 64)
+      packed |= src[word + 1] << (64 - shift);
+    packed &= (UINT64_C(1) << block->width) - 1;
+
+    return block->base ^ ((uint32_t) packed << block->shift);
+  }
+}
+
+
+static void ecl_sum_compressed_decode_block( const ecl_sum_compressed_type * compressed , const block_type * block , int count , float * target ) {
+  int i;
+  if (block->width == 0) {
+    float value = ecl_sum_compressed_bits_float( block->base );
+    for (i = 0; i < count; i++)
+      target[i] = value;
+  } else {
+    const uint64_t * src = &compressed->words[ block->offset ];
+    const uint64_t mask = (UINT64_C(1) << block->width) - 1;
+    size_t bit = 0;
+
+    for (i = 0; i < count; i++) {
+      const size_t word = bit >> 6;
+      const int shift = bit & 63;
+      uint64_t packed = src[word] >> shift;
+
+      if (shift + block->width > 64)
+        packed |= src[word + 1] << (64 - shift);
+
+      target[i] = ecl_sum_compressed_bits_float( block->base ^ ((uint32_t) (packed & mask) << block->shift));
+      bit += block->width;
+    }
+  }
+}
+
+
+static void ecl_sum_compressed_encode_block( ecl_sum_compressed_type * compressed , block_type * block , const uint32_t * bits , int count) {
+  uint32_t diff = 0;
+  int i;
+
+  block->base = bits[0];
+  block->shift = 0;
+  block->width = 0;
+  block->offset = compressed->num_words;
+  for (i = 1; i < count; i++)
+    diff |= bits[i] ^ block->base;
+
+  if (diff != 0) {
+    uint64_t * target = &compressed->words[ compressed->num_words ];
+    size_t bit = 0;
+    int num_words;
+
+    while ((diff & 1) == 0) {
+      diff >>= 1;
+      block->shift++;
+    }
+    while (diff != 0) {
+      diff >>= 1;
+      block->width++;
+    }
+
+    num_words = (count * block->width + 63) / 64;
+    memset( target , 0 , num_words * sizeof * target );
+    for (i = 0; i < count; i++) {
+      const uint64_t packed = (bits[i] ^ block->base) >> block->shift;
+      const size_t word = bit >> 6;
+      const int shift = bit & 63;
+
+      target[word] |= packed << shift;
+      if (shift + block->width > 64)
+        target[word + 1] |= packed >> (64 - shift);
+      bit += block->width;
+    }
+    compressed->num_words += num_words;
+  }
+}
+
+
+/*
+  Compresses the pending rows to a new row of blocks.
+*/
+
+static void ecl_sum_compressed_flush( ecl_sum_compressed_type * compressed ) {
+  const int row_size = compressed->row_size;
+  const int block_row = compressed->compressed_rows / BLOCK_SIZE;
+
+  if (block_row >= compressed->alloc_block_rows) {
+    compressed->alloc_block_rows = util_int_max( 4 , 2 * compressed->alloc_block_rows );
+    compressed->blocks = util_realloc( compressed->blocks , (size_t) compressed->alloc_block_rows * row_size * sizeof * compressed->blocks );
+  }
+
+  {
+    size_t max_words = compressed->num_words + (size_t) row_size * (BLOCK_SIZE / 2);
+    if (max_words > compressed->alloc_words) {
+      compressed->alloc_words = util_size_t_max( max_words , 2 * compressed->alloc_words );
+      compressed->words = util_realloc( compressed->words , compressed->alloc_words * sizeof * compressed->words );
+    }
+  }
+
+  {
+    uint32_t bits[BLOCK_SIZE];
+    int column;
+    for (column = 0; column < row_size; column++) {
+      int i;
+      for (i = 0; i < compressed->pending_rows; i++)
+        bits[i] = ecl_sum_compressed_float_bits( compressed->pending[ (size_t) i * row_size + column ] );
+
+      ecl_sum_compressed_encode_block( compressed , &compressed->blocks[ (size_t) block_row * row_size + column ] , bits , compressed->pending_rows );
+    }
+  }
+
+  compressed->compressed_rows += compressed->pending_rows;
+  compressed->pending_rows = 0;
+}
+
+
+/*
+  Moves the rows of the last, partial, block back to the pending
+  buffer.
+*/
+
+static void ecl_sum_compressed_reopen( ecl_sum_compressed_type * compressed ) {
+  const int row_size = compressed->row_size;
+  const int block_row = compressed->compressed_rows / BLOCK_SIZE;
+  const int count = compressed->compressed_rows % BLOCK_SIZE;
+  const block_type * blocks = &compressed->blocks[ (size_t) block_row * row_size ];
+  float values[BLOCK_SIZE];
+  int column;
+
+  if (compressed->pending == NULL)
+    compressed->pending = util_malloc( (size_t) BLOCK_SIZE * row_size * sizeof * compressed->pending );
+
+  for (column = 0; column < row_size; column++) {
+    int i;
+    ecl_sum_compressed_decode_block( compressed , &blocks[column] , count , values );
+    for (i = 0; i < count; i++)
+      compressed->pending[ (size_t) i * row_size + column ] = values[i];
+  }
+
+  compressed->num_words = blocks[0].offset;
+  compressed->compressed_rows -= count;
+  compressed->pending_rows = count;
+}
+
+
+void ecl_sum_compressed_append_row( ecl_sum_compressed_type * compressed , const float * row ) {
+  const int row_size = compressed->row_size;
+
+  if ((compressed->compressed_rows % BLOCK_SIZE) != 0)
+    ecl_sum_compressed_reopen( compressed );
+
+  if (compressed->pending == NULL)
+    compressed->pending = util_malloc( (size_t) BLOCK_SIZE * row_size * sizeof * compressed->pending );
+
+  memcpy( &compressed->pending[ (size_t) compressed->pending_rows * row_size ] , row , row_size * sizeof * row );
+  compressed->pending_rows++;
+  if (compressed->pending_rows == BLOCK_SIZE)
+    ecl_sum_compressed_flush( compressed );
+}
+
+
+/*
+  Compresses the pending rows and releases the unused storage; should
+  be called when a batch of rows has been appended.
+*/
+
+void ecl_sum_compressed_shrink( ecl_sum_compressed_type * compressed ) {
+  if (compressed->pending_rows > 0)
+    ecl_sum_compressed_flush( compressed );
+
+  util_safe_free( compressed->pending );
+  compressed->pending = NULL;
+
+  if (compressed->num_words < compressed->alloc_words) {
+    compressed->alloc_words = util_size_t_max( 1 , compressed->num_words );
+    compressed->words = util_realloc( compressed->words , compressed->alloc_words * sizeof * compressed->words );
+  }
+
+  {
+    int block_rows = (compressed->compressed_rows + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    if (block_rows < compressed->alloc_block_rows) {
+      compressed->alloc_block_rows = util_int_max( 1 , block_rows );
+      compressed->blocks = util_realloc( compressed->blocks , (size_t) compressed->alloc_block_rows * compressed->row_size * sizeof * compressed->blocks );
+    }
+  }
+}
+
+
+int ecl_sum_compressed_get_num_rows( const ecl_sum_compressed_type * compressed ) {
+  return compressed->compressed_rows + compressed->pending_rows;
+}
+
+
+int ecl_sum_compressed_get_row_size( const ecl_sum_compressed_type * compressed ) {
+  return compressed->row_size;
+}
+
+
+float ecl_sum_compressed_iget( const ecl_sum_compressed_type * compressed , int row , int column ) {
+  if ((row < 0) || (row >= ecl_sum_compressed_get_num_rows( compressed )))
+    util_abort("%s: row:%d invalid. Valid range: [0,%d) \n",__func__ , row , ecl_sum_compressed_get_num_rows( compressed ));
+
+  if ((column < 0) || (column >= compressed->row_size))
+    util_abort("%s: column:%d invalid. Valid range: [0,%d) \n",__func__ , column , compressed->row_size);
+
+  if (row < compressed->compressed_rows) {
+    const block_type * block = &compressed->blocks[ (size_t) (row / BLOCK_SIZE) * compressed->row_size + column ];
+    return ecl_sum_compressed_bits_float( ecl_sum_compressed_block_iget( compressed , block , row % BLOCK_SIZE ));
+  } else
+    return compressed->pending[ (size_t) (row - compressed->compressed_rows) * compressed->row_size + column ];
+}
+
+
+void ecl_sum_compressed_get_row( const ecl_sum_compressed_type * compressed , int row , float * target ) {
+  int column;
+  for (column = 0; column < compressed->row_size; column++)
+    target[column] = ecl_sum_compressed_iget( compressed , row , column );
+}
+
+
+/*
+  Decodes the full column @column to @target, which must have room
+  for ecl_sum_compressed_get_num_rows() elements.
+*/
+
+void ecl_sum_compressed_get_column( const ecl_sum_compressed_type * compressed , int column , float * target ) {
+  if ((column < 0) || (column >= compressed->row_size))
+    util_abort("%s: column:%d invalid. Valid range: [0,%d) \n",__func__ , column , compressed->row_size);
+
+  {
+    int row = 0;
+    while (row < compressed->compressed_rows) {
+      const block_type * block = &compressed->blocks[ (size_t) (row / BLOCK_SIZE) * compressed->row_size + column ];
+      int count = util_int_min( BLOCK_SIZE , compressed->compressed_rows - row );
+
+      ecl_sum_compressed_decode_block( compressed , block , count , &target[row] );
+      row += count;
+    }
+  }
+
+  {
+    int i;
+    for (i = 0; i < compressed->pending_rows; i++)
+      target[ compressed->compressed_rows + i ] = compressed->pending[ (size_t) i * compressed->row_size + column ];
+  }
+}
+
+
+/*
+  The number of bytes allocated by the instance, including the
+  storage which is allocated but not yet used.
+*/
+
+size_t ecl_sum_compressed_get_byte_size( const ecl_sum_compressed_type * compressed ) {
+  size_t byte_size = sizeof * compressed;
+
+  byte_size += (size_t) compressed->alloc_block_rows * compressed->row_size * sizeof * compressed->blocks;
+  byte_size += compressed->alloc_words * sizeof * compressed->words;
+  if (compressed->pending)
+    byte_size += (size_t) BLOCK_SIZE * compressed->row_size * sizeof * compressed->pending;
+
+  return byte_size;
+}
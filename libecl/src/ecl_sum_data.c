@@ -17,21 +17,28 @@
 */
 
 #include <string.h>
+#include <math.h>
 
+#include <ert/util/ert_api_config.h>
 #include <ert/util/util.h>
 #include <ert/util/vector.h>
 #include <ert/util/time_t_vector.h>
 #include <ert/util/int_vector.h>
 #include <ert/util/stringlist.h>
 #include <ert/util/time_interval.h>
+#ifdef ERT_HAVE_THREAD_POOL
+#include <ert/util/thread_pool.h>
+#endif
 
 #include <ert/ecl/ecl_util.h>
 #include <ert/ecl/ecl_smspec.h>
 #include <ert/ecl/ecl_sum_data.h>
 #include <ert/ecl/ecl_sum_tstep.h>
+#include <ert/ecl/ecl_sum_compressed.h>
 #include <ert/ecl/smspec_node.h>
 #include <ert/ecl/ecl_kw.h>
 #include <ert/ecl/ecl_file.h>
+#include <ert/ecl/fortio.h>
 #include <ert/ecl/ecl_endian_flip.h>
 #include <ert/ecl/ecl_kw_magic.h>
 #include <ert/ecl/ecl_sum_vector.h>
@@ -225,6 +232,14 @@ struct ecl_sum_data_struct {
   time_interval_type     * sim_time;               /* The time interval sim_time goes from the first time value where we have
                                                       data to the end of the simulation. In the case of restarts the start
                                                       value might disagree with the simulation start reported by the smspec file. */
+  float                  * columns;                /* Optional column major copy of the data; see ecl_sum_data_build_columns(). */
+  int                      columns_length;         /* Number of tsteps in each column. */
+  int                      columns_count;          /* Number of columns, i.e. the params_size when the columns were built. */
+  ecl_sum_compressed_type * compressed;            /* The PARAMS data when the data is compressed; the tsteps are then without data. */
+  int                      load_threads;           /* Number of threads used when loading non unified summary files. */
+  char                   * tail_file;              /* The file, and the offset in that file, where ecl_sum_data_fread_tail() */
+  offset_type              tail_offset;            /* will continue reading. tail_file == NULL before the first call. */
+  int                      tail_report_step;       /* The report step of the last SEQHDR block read from a unified file. */
 };
 
 
@@ -234,6 +249,10 @@ struct ecl_sum_data_struct {
 /*****************************************************************/
 
  void ecl_sum_data_free( ecl_sum_data_type * data ) {
+  free( data->columns );
+  if (data->compressed)
+    ecl_sum_compressed_free( data->compressed );
+  util_safe_free( data->tail_file );
   vector_free( data->data );
   int_vector_free( data->report_first_index );
   int_vector_free( data->report_last_index  );
@@ -268,6 +287,14 @@ ecl_sum_data_type * ecl_sum_data_alloc(ecl_smspec_type * smspec) {
   data->data        = vector_alloc_new();
   data->smspec      = smspec;
   data->__min_time  = 0;
+  data->columns     = NULL;
+  data->columns_length = 0;
+  data->columns_count  = 0;
+  data->compressed     = NULL;
+  data->load_threads   = 1;
+  data->tail_file      = NULL;
+  data->tail_offset    = 0;
+  data->tail_report_step = 0;
 
   data->report_first_index    = int_vector_alloc( 0 , INVALID_MINISTEP_NR );
   data->report_last_index     = int_vector_alloc( 0 , INVALID_MINISTEP_NR );
@@ -305,6 +332,26 @@ static ecl_sum_tstep_type * ecl_sum_data_iget_ministep( const ecl_sum_data_type
 }
 
 
+/*
+  Returns a copy of the tstep at @internal_index which carries the
+  data, also when the data is compressed.
+*/
+
+static ecl_sum_tstep_type * ecl_sum_data_alloc_tstep_copy( const ecl_sum_data_type * data , int internal_index ) {
+  ecl_sum_tstep_type * copy = ecl_sum_tstep_alloc_copy( ecl_sum_data_iget_ministep( data , internal_index ));
+
+  if (data->compressed) {
+    const int params_size = ecl_sum_compressed_get_row_size( data->compressed );
+    float * row = util_calloc( util_int_max( 1 , params_size ) , sizeof * row );
+
+    ecl_sum_compressed_get_row( data->compressed , internal_index , row );
+    ecl_sum_tstep_set_data( copy , row , params_size );
+    free( row );
+  }
+  return copy;
+}
+
+
 
 void ecl_sum_data_report2internal_range(const ecl_sum_data_type * data , int report_step , int * index1 , int * index2 ){
   if (index1 != NULL)
@@ -335,8 +382,14 @@ static void ecl_sum_data_fwrite_report__( const ecl_sum_data_type * data , int r
 
     ecl_sum_data_report2internal_range( data , report_step , &index1 , &index2);
     for (index = index1; index <= index2; index++) {
-      const ecl_sum_tstep_type * tstep = ecl_sum_data_iget_ministep( data , index );
-      ecl_sum_tstep_fwrite( tstep , ecl_smspec_get_index_map( data->smspec ) , fortio );
+      if (data->compressed) {
+        ecl_sum_tstep_type * tstep = ecl_sum_data_alloc_tstep_copy( data , index );
+        ecl_sum_tstep_fwrite( tstep , ecl_smspec_get_index_map( data->smspec ) , fortio );
+        ecl_sum_tstep_free( tstep );
+      } else {
+        const ecl_sum_tstep_type * tstep = ecl_sum_data_iget_ministep( data , index );
+        ecl_sum_tstep_fwrite( tstep , ecl_smspec_get_index_map( data->smspec ) , fortio );
+      }
     }
   }
 }
@@ -671,7 +724,7 @@ double_vector_type * ecl_sum_data_alloc_seconds_solution( const ecl_sum_data_typ
     int index = 0;
     const ecl_sum_tstep_type * ministep = ecl_sum_data_iget_ministep( data , index );
     const ecl_sum_tstep_type * prev_ministep;
-    double value = ecl_sum_tstep_iget( ministep , param_index );
+    double value = ecl_sum_data_iget( data , index , param_index );
     double prev_value;
 
     while (true) {
@@ -683,7 +736,7 @@ double_vector_type * ecl_sum_data_alloc_seconds_solution( const ecl_sum_data_typ
       prev_value = value;
 
       ministep = ecl_sum_data_iget_ministep( data , index );
-      value = ecl_sum_tstep_iget( ministep , param_index );
+      value = ecl_sum_data_iget( data , index , param_index );
 
       if ((value == cmp_value) ||
           (((value - cmp_value) * (cmp_value - prev_value)) > 0)) {
@@ -712,6 +765,209 @@ double_vector_type * ecl_sum_data_alloc_seconds_solution( const ecl_sum_data_typ
 
 
 
+/*****************************************************************/
+/*
+  Column major storage
+  --------------------
+
+  The primary storage is a vector of ecl_sum_tstep instances, i.e. one
+  float PARAMS row per ministep. Extracting the full time series of
+  one variable from this layout means visiting every tstep allocation,
+  which is slow when there are many variables and many ministeps.
+
+  As an alternative the data can be transposed into one contiguous
+  block with one column of length ecl_sum_data_get_length() per
+  params_index; the column for params_index is then available as a
+  plain float pointer through ecl_sum_data_get_column(). The column
+  block is built on demand and thrown away whenever the tstep data is
+  modified through the ecl_sum_data functions. Observe that the
+  columns duplicate the full data set; and that values set directly
+  on a tstep with ecl_sum_tstep_iset() after the columns have been
+  built will not be reflected in the columns.
+*/
+
+#define COLUMN_BLOCK_SIZE 64
+
+static void ecl_sum_data_drop_columns( ecl_sum_data_type * data ) {
+  free( data->columns );
+  data->columns = NULL;
+  data->columns_length = 0;
+  data->columns_count = 0;
+}
+
+
+bool ecl_sum_data_has_columns( const ecl_sum_data_type * data ) {
+  return (data->columns != NULL);
+}
+
+
+void ecl_sum_data_build_columns( ecl_sum_data_type * data ) {
+  const int length = vector_get_size( data->data );
+  const int params_size = ecl_smspec_get_params_size( data->smspec );
+
+  ecl_sum_data_drop_columns( data );
+  if ((length == 0) || (params_size == 0))
+    return;
+
+  if (data->compressed) {
+    float * columns = util_malloc( (size_t) length * params_size * sizeof * columns );
+    int p;
+    for (p = 0; p < params_size; p++)
+      ecl_sum_compressed_get_column( data->compressed , p , &columns[ (size_t) p * length ] );
+
+    data->columns = columns;
+    data->columns_length = length;
+    data->columns_count = params_size;
+    return;
+  }
+
+  {
+    float * columns = util_malloc( (size_t) length * params_size * sizeof * columns );
+    int t0;
+
+    /*
+      The transpose is done in blocks of COLUMN_BLOCK_SIZE tsteps, so
+      that the writes to each column stay within a few cache lines
+      while the rows are traversed.
+    */
+    for (t0 = 0; t0 < length; t0 += COLUMN_BLOCK_SIZE) {
+      const int t1 = util_int_min( t0 + COLUMN_BLOCK_SIZE , length );
+      int p0;
+      for (p0 = 0; p0 < params_size; p0 += COLUMN_BLOCK_SIZE) {
+        const int p1 = util_int_min( p0 + COLUMN_BLOCK_SIZE , params_size );
+        int t;
+        for (t = t0; t < t1; t++) {
+          const ecl_sum_tstep_type * tstep = ecl_sum_data_iget_ministep( data , t );
+          const float * row = ecl_sum_tstep_get_data( tstep );
+          int p;
+
+          if (ecl_sum_tstep_get_data_size( tstep ) != params_size)
+            util_abort("%s: tstep:%d has %d elements - expected %d \n",__func__ , t , ecl_sum_tstep_get_data_size( tstep ) , params_size);
+
+          for (p = p0; p < p1; p++)
+            columns[ (size_t) p * length + t ] = row[p];
+        }
+      }
+    }
+
+    data->columns = columns;
+    data->columns_length = length;
+    data->columns_count = params_size;
+  }
+}
+
+
+/**
+   Will return a pointer to the full time series of the variable
+   @params_index, ordered by internal index, and set *length to the
+   number of elements. The column block is built if it is not already
+   present; the returned pointer is owned by the ecl_sum_data instance
+   and is only valid until the data is modified.
+*/
+
+const float * ecl_sum_data_get_column( ecl_sum_data_type * data , int params_index , int * length) {
+  if (!ecl_sum_data_has_columns( data ))
+    ecl_sum_data_build_columns( data );
+
+  if (data->columns == NULL) {
+    *length = 0;
+    return NULL;
+  }
+
+  if ((params_index < 0) || (params_index >= data->columns_count))
+    util_abort("%s: param index:%d invalid: Valid range: [0,%d) \n",__func__ , params_index , data->columns_count);
+
+  *length = data->columns_length;
+  return &data->columns[ (size_t) params_index * data->columns_length ];
+}
+
+#undef COLUMN_BLOCK_SIZE
+
+
+/*
+  Compressed storage
+  ------------------
+
+  When a large number of cases should be kept in memory, e.g. all the
+  realizations of an ensemble, the data can be compressed with
+  ecl_sum_data_compress(). The PARAMS rows are then moved from the
+  tsteps to an ecl_sum_compressed instance, see ecl_sum_compressed.c
+  for the encoding, and the tsteps only carry the time information.
+  Row i of the compressed data belongs to tstep i in the data vector.
+
+  Reading the data works as before; ecl_sum_data_iget() extracts
+  single values and the bulk functions decode full columns. Ministeps
+  which are loaded later, e.g. with ecl_sum_data_fread_tail(), are
+  compressed as they are added. Operations which modify the data, or
+  reorder the tsteps, uncompress the data and compress it again
+  afterwards; ecl_sum_data_add_new_tstep() will uncompress the data
+  permanently, since the calling scope will set the values directly
+  on the new tstep.
+*/
+
+static void ecl_sum_data_compress_tstep( ecl_sum_data_type * data , ecl_sum_tstep_type * tstep ) {
+  if (ecl_sum_tstep_get_data_size( tstep ) != ecl_sum_compressed_get_row_size( data->compressed ))
+    util_abort("%s: tstep has %d elements - expected %d \n",__func__ , ecl_sum_tstep_get_data_size( tstep ) , ecl_sum_compressed_get_row_size( data->compressed ));
+
+  ecl_sum_compressed_append_row( data->compressed , ecl_sum_tstep_get_data( tstep ));
+  ecl_sum_tstep_drop_data( tstep );
+}
+
+
+void ecl_sum_data_compress( ecl_sum_data_type * data ) {
+  if (data->compressed == NULL) {
+    int internal_index;
+
+    data->compressed = ecl_sum_compressed_alloc( ecl_smspec_get_params_size( data->smspec ));
+    for (internal_index = 0; internal_index < vector_get_size( data->data ); internal_index++)
+      ecl_sum_data_compress_tstep( data , ecl_sum_data_iget_ministep( data , internal_index ));
+
+    ecl_sum_compressed_shrink( data->compressed );
+    ecl_sum_data_drop_columns( data );
+  }
+}
+
+
+bool ecl_sum_data_is_compressed( const ecl_sum_data_type * data ) {
+  return (data->compressed != NULL);
+}
+
+
+static void ecl_sum_data_uncompress( ecl_sum_data_type * data ) {
+  if (data->compressed) {
+    const int params_size = ecl_sum_compressed_get_row_size( data->compressed );
+    float * row = util_calloc( util_int_max( 1 , params_size ) , sizeof * row );
+    int internal_index;
+
+    for (internal_index = 0; internal_index < vector_get_size( data->data ); internal_index++) {
+      ecl_sum_compressed_get_row( data->compressed , internal_index , row );
+      ecl_sum_tstep_set_data( ecl_sum_data_iget_ministep( data , internal_index ) , row , params_size );
+    }
+
+    free( row );
+    ecl_sum_compressed_free( data->compressed );
+    data->compressed = NULL;
+  }
+}
+
+
+/*
+  Returns the full column @params_index in a newly allocated buffer
+  when the data is compressed, otherwise NULL.
+*/
+
+static float * ecl_sum_data_alloc_compressed_column( const ecl_sum_data_type * data , int params_index ) {
+  if (data->compressed) {
+    float * column = util_calloc( util_int_max( 1 , vector_get_size( data->data )) , sizeof * column );
+    ecl_sum_compressed_get_column( data->compressed , params_index , column );
+    return column;
+  } else
+    return NULL;
+}
+
+/*****************************************************************/
+
+
 static void ecl_sum_data_append_tstep__( ecl_sum_data_type * data , ecl_sum_tstep_type * tstep) {
   /*
      Here the tstep is just appended naively, the vector will be
@@ -749,7 +1005,10 @@ static void ecl_sum_data_append_tstep__( ecl_sum_data_type * data , ecl_sum_tste
   }
 
   vector_append_owned_ref( data->data , tstep , ecl_sum_tstep_free__);
+  if (data->compressed)
+    ecl_sum_data_compress_tstep( data , tstep );
   data->index_valid = false;
+  ecl_sum_data_drop_columns( data );
 }
 
 
@@ -778,8 +1037,16 @@ static int cmp_ministep( const void * arg1 , const void * arg2) {
 
 
 static void ecl_sum_data_build_index( ecl_sum_data_type * sum_data ) {
+  /*
+    The compressed rows follow the order of the tsteps; the data must
+    be restored in the tsteps before they are sorted.
+  */
+  const bool compressed = ecl_sum_data_is_compressed( sum_data );
+  ecl_sum_data_uncompress( sum_data );
+
   /* Clear the existing index (if any): */
   ecl_sum_data_clear_index( sum_data );
+  ecl_sum_data_drop_columns( sum_data );
 
   /*
     Sort the internal storage vector after sim_time.
@@ -835,6 +1102,9 @@ static void ecl_sum_data_build_index( ecl_sum_data_type * sum_data ) {
     }
   }
   sum_data->index_valid = true;
+
+  if (compressed)
+    ecl_sum_data_compress( sum_data );
 }
 
 
@@ -851,6 +1121,8 @@ ecl_sum_tstep_type * ecl_sum_data_add_new_tstep( ecl_sum_data_type * data , int
   ecl_sum_tstep_type * tstep = ecl_sum_tstep_alloc_new( report_step , ministep_nr , sim_seconds , data->smspec );
   ecl_sum_tstep_type * prev_tstep = NULL;
 
+  ecl_sum_data_uncompress( data );
+
   if (vector_get_size( data->data ) > 0)
     prev_tstep = vector_get_last( data->data );
 
@@ -912,11 +1184,11 @@ ecl_sum_tstep_type * ecl_sum_data_add_new_tstep( ecl_sum_data_type * data , int
    calling routine will read the unified summary file partly.
 */
 
-static void ecl_sum_data_add_ecl_file(ecl_sum_data_type * data         ,
-                                      time_t load_end ,
-                                      int   report_step                ,
-                                      const ecl_file_view_type * summary_view,
-                                      const ecl_smspec_type * smspec) {
+static void ecl_sum_data_load_ecl_file(vector_type * tstep_list         ,
+                                       time_t load_end ,
+                                       int   report_step                ,
+                                       const ecl_file_view_type * summary_view,
+                                       const ecl_smspec_type * smspec) {
 
 
   int num_ministep  = ecl_file_view_get_num_named_kw( summary_view , PARAMS_KW);
@@ -938,7 +1210,7 @@ static void ecl_sum_data_add_ecl_file(ecl_sum_data_type * data         ,
 
         if (tstep != NULL) {
           if (load_end == 0 || (ecl_sum_tstep_get_sim_time( tstep ) < load_end))
-            ecl_sum_data_append_tstep__( data , tstep );
+            vector_append_ref( tstep_list , tstep );
           else
             /* This tstep is in a time-period overlapping with data we
                already have; discard this. */
@@ -950,6 +1222,30 @@ static void ecl_sum_data_add_ecl_file(ecl_sum_data_type * data         ,
 }
 
 
+/*
+  The tsteps in @tstep_list are appended to the data instance, which
+  takes ownership of them.
+*/
+
+static void ecl_sum_data_append_tstep_list( ecl_sum_data_type * data , const vector_type * tstep_list ) {
+  int i;
+  for (i = 0; i < vector_get_size( tstep_list ); i++)
+    ecl_sum_data_append_tstep__( data , vector_iget( tstep_list , i ));
+}
+
+
+static void ecl_sum_data_add_ecl_file(ecl_sum_data_type * data         ,
+                                      time_t load_end ,
+                                      int   report_step                ,
+                                      const ecl_file_view_type * summary_view,
+                                      const ecl_smspec_type * smspec) {
+  vector_type * tstep_list = vector_alloc_new();
+  ecl_sum_data_load_ecl_file( tstep_list , load_end , report_step , summary_view , smspec );
+  ecl_sum_data_append_tstep_list( data , tstep_list );
+  vector_free( tstep_list );
+}
+
+
 void ecl_sum_data_add_case(ecl_sum_data_type * self, const ecl_sum_data_type * other) {
   int * param_mapping = NULL;
   bool  header_equal = ecl_smspec_equal( self->smspec , other->smspec);
@@ -969,12 +1265,13 @@ void ecl_sum_data_add_case(ecl_sum_data_type * self, const ecl_sum_data_type * o
     */
 
     if (!time_interval_contains( self->sim_time , ecl_sum_tstep_get_sim_time( other_tstep ))) {
-      ecl_sum_tstep_type * new_tstep;
+      ecl_sum_tstep_type * new_tstep = ecl_sum_data_alloc_tstep_copy( other , tstep_nr );
 
-      if (header_equal)
-        new_tstep = ecl_sum_tstep_alloc_copy( other_tstep );
-      else
-        new_tstep = ecl_sum_tstep_alloc_remap_copy( other_tstep , self->smspec , default_value , param_mapping );
+      if (!header_equal) {
+        ecl_sum_tstep_type * remap_tstep = ecl_sum_tstep_alloc_remap_copy( new_tstep , self->smspec , default_value , param_mapping );
+        ecl_sum_tstep_free( new_tstep );
+        new_tstep = remap_tstep;
+      }
 
       ecl_sum_data_append_tstep__( self , new_tstep );
 
@@ -995,21 +1292,143 @@ static bool ecl_sum_data_check_file( ecl_file_type * ecl_file ) {
 }
 
 
+/*
+  Loads all the tsteps from one non unified summary file into
+  @tstep_list. The function only reads the (shared) smspec and does not
+  touch the ecl_sum_data instance, so it can be called concurrently
+  for different files.
+*/
+
+static void ecl_sum_data_load_summary_file( vector_type * tstep_list , time_t load_end , const char * data_file , const ecl_smspec_type * smspec) {
+  ecl_file_enum file_type;
+  int report_step;
+  file_type = ecl_util_get_file_type( data_file , NULL , &report_step);
+  if (file_type != ECL_SUMMARY_FILE)
+    util_abort("%s: file:%s has wrong type \n",__func__ , data_file);
+  {
+    ecl_file_type * ecl_file = ecl_file_open( data_file , 0);
+    if (ecl_file) {
+      if (ecl_sum_data_check_file( ecl_file ))
+        ecl_sum_data_load_ecl_file( tstep_list , load_end , report_step , ecl_file_get_global_view( ecl_file ) , smspec);
+      ecl_file_close( ecl_file );
+    }
+  }
+}
+
+
+/**
+   Sets the number of threads used when loading a list of non unified
+   summary files, i.e. BASE.S0001, BASE.S0002, ...; with more than one
+   thread the files are opened and decoded concurrently and the
+   ministeps merged in file order afterwards. The unified summary file
+   is always loaded sequentially. The default is one thread.
+*/
+
+void ecl_sum_data_set_load_threads( ecl_sum_data_type * data , int load_threads) {
+  data->load_threads = util_int_max( 1 , load_threads );
+}
+
+
+int ecl_sum_data_get_load_threads( const ecl_sum_data_type * data ) {
+  return data->load_threads;
+}
+
+
+#ifdef ERT_HAVE_THREAD_POOL
+
+typedef struct {
+  const ecl_smspec_type * smspec;
+  const char            * data_file;
+  time_t                  load_end;
+  vector_type           * tstep_list;
+} load_job_type;
+
+
+static void * ecl_sum_data_load_summary_file__( void * arg ) {
+  load_job_type * job = arg;
+  ecl_sum_data_load_summary_file( job->tstep_list , job->load_end , job->data_file , job->smspec );
+  return NULL;
+}
+
+
+static void ecl_sum_data_fread_parallel( ecl_sum_data_type * data , time_t load_end , const stringlist_type * filelist) {
+  const int num_files = stringlist_get_size( filelist );
+  load_job_type * jobs = util_calloc( num_files , sizeof * jobs );
+  thread_pool_type * tp = thread_pool_alloc( util_int_min( data->load_threads , num_files ) , true );
+  int filenr;
+
+  for (filenr = 0; filenr < num_files; filenr++) {
+    load_job_type * job = &jobs[filenr];
+    job->smspec = data->smspec;
+    job->data_file = stringlist_iget( filelist , filenr );
+    job->load_end = load_end;
+    job->tstep_list = vector_alloc_new();
+    thread_pool_add_job( tp , ecl_sum_data_load_summary_file__ , job );
+  }
+  thread_pool_join( tp );
+  thread_pool_free( tp );
+
+  /*
+    The merge is done in file order, so the end result is identical to
+    the sequential load.
+  */
+  for (filenr = 0; filenr < num_files; filenr++) {
+    ecl_sum_data_append_tstep_list( data , jobs[filenr].tstep_list );
+    vector_free( jobs[filenr].tstep_list );
+  }
+  free( jobs );
+}
+
+#endif
+
+
+/*
+  Will record the position of the last MINISTEP / PARAMS pair in the
+  unified summary file @data_file as the starting point for
+  ecl_sum_data_fread_tail(); the first refresh of a case will then
+  not have to scan the file from the start. The pair itself is read
+  again, and skipped, by ecl_sum_data_fread_tail().
+*/
+
+static void ecl_sum_data_init_tail( ecl_sum_data_type * data , const char * data_file , const ecl_file_view_type * file_view) {
+  const int size = ecl_file_view_get_size( file_view );
+  int seqhdr_count = 0;
+  int index;
+
+  for (index = 0; index < size; index++) {
+    const char * header = ecl_file_view_iget_header( file_view , index );
+
+    if (strcmp( header , SEQHDR_KW ) == 0)
+      seqhdr_count++;
+    else if ((strcmp( header , MINISTEP_KW ) == 0) &&
+             (index + 1 < size) &&
+             (strcmp( ecl_file_view_iget_header( file_view , index + 1 ) , PARAMS_KW ) == 0)) {
+      data->tail_file = util_realloc_string_copy( data->tail_file , data_file );
+      data->tail_offset = ecl_file_kw_get_offset( ecl_file_view_iget_file_kw( file_view , index ));
+      data->tail_report_step = seqhdr_count;
+    }
+  }
+}
+
+
 /*
   Observe that this can be called several times (but not with the same
-  data - that will die).
+  data - that will die). If @init_tail is true, and the file is an
+  unformatted unified file, the end of the loaded data is recorded
+  for ecl_sum_data_fread_tail().
 
   Warning: The index information of the ecl_sum_data instance has
   __NOT__ been updated when leaving this function. That is done with a
   call to ecl_sum_data_build_index().
 */
 
-static bool ecl_sum_data_fread__( ecl_sum_data_type * data , time_t load_end , const stringlist_type * filelist) {
+static bool ecl_sum_data_fread__( ecl_sum_data_type * data , time_t load_end , const stringlist_type * filelist , bool init_tail) {
   if (stringlist_get_size( filelist ) == 0)
     return false;
 
   {
-    ecl_file_enum file_type = ecl_util_get_file_type( stringlist_iget( filelist , 0 ) , NULL , NULL);
+    bool fmt_file;
+    ecl_file_enum file_type = ecl_util_get_file_type( stringlist_iget( filelist , 0 ) , &fmt_file , NULL);
     if ((stringlist_get_size( filelist ) > 1) && (file_type != ECL_SUMMARY_FILE))
       util_abort("%s: internal error - when calling with more than one file - you can not supply a unified file - come on?! \n",__func__);
 
@@ -1018,20 +1437,19 @@ static bool ecl_sum_data_fread__( ecl_sum_data_type * data , time_t load_end , c
       if (file_type == ECL_SUMMARY_FILE) {
 
         /* Not unified. */
-        for (filenr = 0; filenr < stringlist_get_size( filelist ); filenr++) {
-          const char * data_file = stringlist_iget( filelist , filenr);
-          ecl_file_enum file_type;
-          int report_step;
-          file_type = ecl_util_get_file_type( data_file , NULL , &report_step);
-          if (file_type != ECL_SUMMARY_FILE)
-            util_abort("%s: file:%s has wrong type \n",__func__ , data_file);
-          {
-            ecl_file_type * ecl_file = ecl_file_open( data_file , 0);
-            if (ecl_file && ecl_sum_data_check_file( ecl_file )) {
-              ecl_sum_data_add_ecl_file( data , load_end , report_step , ecl_file_get_global_view( ecl_file ) , data->smspec);
-              ecl_file_close( ecl_file );
-            }
+#ifdef ERT_HAVE_THREAD_POOL
+        if ((data->load_threads > 1) && (stringlist_get_size( filelist ) > 1))
+          ecl_sum_data_fread_parallel( data , load_end , filelist );
+        else
+#endif
+        {
+          vector_type * tstep_list = vector_alloc_new();
+          for (filenr = 0; filenr < stringlist_get_size( filelist ); filenr++) {
+            ecl_sum_data_load_summary_file( tstep_list , load_end , stringlist_iget( filelist , filenr ) , data->smspec );
+            ecl_sum_data_append_tstep_list( data , tstep_list );
+            vector_clear( tstep_list );
           }
+          vector_free( tstep_list );
         }
       } else if (file_type == ECL_UNIFIED_SUMMARY_FILE) {
         ecl_file_type * ecl_file = ecl_file_open( stringlist_iget(filelist ,0 ) , 0);
@@ -1051,6 +1469,8 @@ static bool ecl_sum_data_fread__( ecl_sum_data_type * data , time_t load_end , c
               report_step++;
             } else break;
           }
+          if (init_tail && !fmt_file)
+            ecl_sum_data_init_tail( data , stringlist_iget( filelist , 0 ) , ecl_file_get_global_view( ecl_file ));
           ecl_file_close( ecl_file );
         }
       } else
@@ -1067,7 +1487,7 @@ static bool ecl_sum_data_fread__( ecl_sum_data_type * data , time_t load_end , c
 }
 
 bool ecl_sum_data_fread( ecl_sum_data_type * data , const stringlist_type * filelist) {
-  return ecl_sum_data_fread__( data , 0 , filelist );
+  return ecl_sum_data_fread__( data , 0 , filelist , true );
 }
 
 
@@ -1080,7 +1500,7 @@ static time_t ecl_sum_data_get_load_end( const ecl_sum_data_type * data ) {
 
 void ecl_sum_data_fread_restart( ecl_sum_data_type * data , const stringlist_type * filelist) {
   time_t load_end = ecl_sum_data_get_load_end( data );
-  ecl_sum_data_fread__( data , load_end , filelist );
+  ecl_sum_data_fread__( data , load_end , filelist , false );
 }
 
 
@@ -1097,7 +1517,7 @@ void ecl_sum_data_fread_restart( ecl_sum_data_type * data , const stringlist_typ
 
 ecl_sum_data_type * ecl_sum_data_fread_alloc( ecl_smspec_type * smspec , const stringlist_type * filelist , bool include_restart) {
   ecl_sum_data_type * data = ecl_sum_data_alloc( smspec );
-  ecl_sum_data_fread__( data , 0 , filelist );
+  ecl_sum_data_fread__( data , 0 , filelist , true );
 
   /*****************************************************************/
   /* OK - now we have loaded all the data. Must sort the internal
@@ -1109,6 +1529,267 @@ ecl_sum_data_type * ecl_sum_data_fread_alloc( ecl_smspec_type * smspec , const s
 }
 
 
+/*****************************************************************/
+/*
+  Incremental loading of the summary files from a running simulation.
+
+  The ordinary load functions above open the complete summary files
+  with ecl_file_open() and rebuild the full index. To monitor a
+  running simulation the ecl_sum_data_fread_tail() function will
+  instead read the summary files sequentially with fortio, starting
+  from the file and offset where the previous call stopped, and only
+  append the new ministeps:
+
+    1. A keyword is only consumed if it has been completely written to
+       the file, i.e. the header, and all the data blocks implied by
+       the header, fit within the current file size. A MINISTEP
+       keyword is only consumed together with the PARAMS keyword
+       following it. If the simulator is in the middle of writing a
+       keyword the reading stops at the start of that keyword (or
+       MINISTEP / PARAMS pair) and continues from there on the next
+       call.
+
+    2. For non unified files the reading moves on to the next
+       BASE.Snnnn file when the current file has been exhausted and a
+       newer file is present in the file list.
+
+    3. Ministeps with a ministep number less than or equal to the last
+       ministep already loaded are skipped without reading the PARAMS
+       data. That makes it possible to call ecl_sum_data_fread_tail()
+       on a data instance which has been loaded with the ordinary
+       functions. For an unformatted unified file the ordinary load
+       records the position of the last ministep; for non unified
+       files the first call will scan the last of the BASE.Snnnn
+       files to establish the offset.
+
+  When the new ministeps follow the ones already loaded in time the
+  report step index is extended in place; otherwise the full index is
+  rebuilt with ecl_sum_data_build_index(). Only unformatted files are
+  supported.
+*/
+
+
+/*
+  Will read the header of the keyword starting at the current position
+  of @fortio, and check that the keyword is complete. If the keyword is
+  complete the header is returned and @fortio is positioned at the
+  start of the data section; otherwise NULL is returned.
+*/
+
+static ecl_kw_type * ecl_sum_data_fread_tail_header( fortio_type * fortio , offset_type file_size) {
+  ecl_kw_type * ecl_kw = ecl_kw_alloc_empty();
+  if (ecl_kw_fread_header( ecl_kw , fortio ) != ECL_KW_READ_FAIL) {
+    offset_type data_start = fortio_ftell( fortio );
+    if (ecl_kw_fskip_data( ecl_kw , fortio ) && (fortio_ftell( fortio ) <= file_size)) {
+      fortio_fseek( fortio , data_start , SEEK_SET );
+      return ecl_kw;
+    }
+  }
+
+  ecl_kw_free( ecl_kw );
+  return NULL;
+}
+
+
+static ecl_kw_type * ecl_sum_data_fread_tail_kw( fortio_type * fortio , offset_type file_size , const char * kw) {
+  ecl_kw_type * ecl_kw = ecl_sum_data_fread_tail_header( fortio , file_size );
+  if (ecl_kw != NULL) {
+    if (ecl_kw_name_equal( ecl_kw , kw ) && ecl_kw_fread_realloc_data( ecl_kw , fortio ))
+      return ecl_kw;
+
+    ecl_kw_free( ecl_kw );
+  }
+  return NULL;
+}
+
+
+/*
+  Reads the complete keywords from data->tail_offset to the end of
+  @data_file, appending new tsteps to @tstep_list and updating the
+  tail_offset and tail_report_step fields.
+*/
+
+static void ecl_sum_data_fread_tail_file( ecl_sum_data_type * data , const char * data_file , vector_type * tstep_list) {
+  int report_step;
+  ecl_file_enum file_type = ecl_util_get_file_type( data_file , NULL , &report_step );
+  fortio_type * fortio;
+
+  if ((file_type != ECL_SUMMARY_FILE) && (file_type != ECL_UNIFIED_SUMMARY_FILE))
+    util_abort("%s: file:%s has wrong type \n",__func__ , data_file);
+
+  if (!util_file_exists( data_file ))
+    return;
+
+  fortio = fortio_open_reader( data_file , false , ECL_ENDIAN_FLIP );
+  if (fortio == NULL)
+    return;
+
+  {
+    const offset_type file_size = util_file_size( data_file );
+    fortio_fseek( fortio , data->tail_offset , SEEK_SET );
+
+    while (true) {
+      ecl_kw_type * ecl_kw = ecl_sum_data_fread_tail_header( fortio , file_size );
+      if (ecl_kw == NULL)
+        break;
+
+      if (ecl_kw_name_equal( ecl_kw , MINISTEP_KW )) {
+        bool complete = false;
+
+        if (ecl_kw_fread_realloc_data( ecl_kw , fortio )) {
+          int ministep_nr = ecl_kw_iget_int( ecl_kw , 0 );
+          int current_report = (file_type == ECL_UNIFIED_SUMMARY_FILE) ? data->tail_report_step : report_step;
+
+          if ((data->last_ministep != INVALID_MINISTEP_NR) && (ministep_nr <= data->last_ministep)) {
+            ecl_kw_type * params_kw = ecl_sum_data_fread_tail_header( fortio , file_size );
+            if (params_kw != NULL) {
+              complete = ecl_kw_fskip_data( params_kw , fortio );
+              ecl_kw_free( params_kw );
+            }
+          } else {
+            ecl_kw_type * params_kw = ecl_sum_data_fread_tail_kw( fortio , file_size , PARAMS_KW );
+            if (params_kw != NULL) {
+              ecl_sum_tstep_type * tstep = ecl_sum_tstep_alloc_from_file( current_report ,
+                                                                          ministep_nr ,
+                                                                          params_kw ,
+                                                                          data_file ,
+                                                                          data->smspec );
+              if (tstep != NULL)
+                vector_append_ref( tstep_list , tstep );
+
+              complete = true;
+              ecl_kw_free( params_kw );
+            }
+          }
+        }
+
+        ecl_kw_free( ecl_kw );
+        if (!complete)
+          break;
+      } else {
+        if (ecl_kw_name_equal( ecl_kw , SEQHDR_KW ) && (file_type == ECL_UNIFIED_SUMMARY_FILE))
+          data->tail_report_step++;
+
+        ecl_kw_fskip_data( ecl_kw , fortio );
+        ecl_kw_free( ecl_kw );
+      }
+      data->tail_offset = fortio_ftell( fortio );
+    }
+  }
+  fortio_fclose( fortio );
+}
+
+
+/*
+  Appends the tsteps in @tstep_list, which are sorted in time, and
+  updates the index. If all the new tsteps come after the currently
+  last tstep the report step index is extended in place.
+*/
+
+static void ecl_sum_data_append_tail( ecl_sum_data_type * data , const vector_type * tstep_list) {
+  bool extend_index = data->index_valid && (vector_get_size( data->data ) > 0);
+
+  if (vector_get_size( tstep_list ) == 0)
+    return;
+
+  if (extend_index) {
+    time_t prev_time = ecl_sum_tstep_get_sim_time( vector_get_last_const( data->data ));
+    int i;
+    for (i = 0; i < vector_get_size( tstep_list ); i++) {
+      time_t sim_time = ecl_sum_tstep_get_sim_time( vector_iget_const( tstep_list , i ));
+      if (sim_time <= prev_time) {
+        extend_index = false;
+        break;
+      }
+      prev_time = sim_time;
+    }
+  }
+
+  ecl_sum_data_append_tstep_list( data , tstep_list );
+  if (data->compressed)
+    ecl_sum_compressed_shrink( data->compressed );
+
+  if (extend_index) {
+    int internal_index;
+    for (internal_index = vector_get_size( data->data ) - vector_get_size( tstep_list ); internal_index < vector_get_size( data->data ); internal_index++) {
+      const ecl_sum_tstep_type * ministep = ecl_sum_data_iget_ministep( data , internal_index );
+      int report_step = ecl_sum_tstep_get_report( ministep );
+
+      if (int_vector_safe_iget( data->report_first_index , report_step ) < 0)
+        int_vector_iset( data->report_first_index , report_step , internal_index );
+      int_vector_iset( data->report_last_index , report_step , internal_index );
+
+      data->first_report_step = util_int_min( data->first_report_step , report_step );
+      data->last_report_step  = util_int_max( data->last_report_step  , report_step );
+    }
+    ecl_sum_data_update_end_info( data );
+    data->index_valid = true;
+  } else
+    ecl_sum_data_build_index( data );
+}
+
+
+/**
+   Will load the ministeps which have been added to the summary files
+   in @filelist since the previous call, see the documentation
+   above. The @filelist should be either one unified file, or the full
+   (sorted) list of BASE.Snnnn files - it is OK if new files have been
+   added to the list since the previous call. Returns the number of
+   new ministeps.
+*/
+
+int ecl_sum_data_fread_tail( ecl_sum_data_type * data , const stringlist_type * filelist) {
+  int file_index = 0;
+  int length = ecl_sum_data_get_length( data );
+
+  if (stringlist_get_size( filelist ) == 0)
+    return 0;
+
+  if (data->tail_file != NULL) {
+    file_index = stringlist_find_first( filelist , data->tail_file );
+    if (file_index < 0)
+      util_abort("%s: the file:%s has disappeared from the list of summary files \n",__func__ , data->tail_file);
+  } else {
+    /*
+      First call: For non unified files we can start with the file
+      containing the last report step we already have.
+    */
+    if ((ecl_sum_data_get_length( data ) > 0) && (stringlist_get_size( filelist ) > 1)) {
+      int filenr;
+      for (filenr = 0; filenr < stringlist_get_size( filelist ); filenr++) {
+        int report_step;
+        ecl_util_get_file_type( stringlist_iget( filelist , filenr ) , NULL , &report_step );
+        if (report_step <= data->last_report_step)
+          file_index = filenr;
+      }
+    }
+    data->tail_file = util_alloc_string_copy( stringlist_iget( filelist , file_index ));
+    data->tail_offset = 0;
+    data->tail_report_step = 0;
+  }
+
+  {
+    vector_type * tstep_list = vector_alloc_new();
+    while (true) {
+      ecl_sum_data_fread_tail_file( data , data->tail_file , tstep_list );
+
+      if (file_index + 1 < stringlist_get_size( filelist )) {
+        /* The simulator has moved on to the next file; i.e. the current file is complete. */
+        file_index++;
+        data->tail_file = util_realloc_string_copy( data->tail_file , stringlist_iget( filelist , file_index ));
+        data->tail_offset = 0;
+      } else
+        break;
+    }
+
+    ecl_sum_data_append_tail( data , tstep_list );
+    vector_free( tstep_list );
+  }
+
+  return ecl_sum_data_get_length( data ) - length;
+}
+
+
 void ecl_sum_data_summarize(const ecl_sum_data_type * data , FILE * stream) {
   fprintf(stream , "REPORT         INDEX              DATE                 DAYS\n");
   fprintf(stream , "---------------------------------------------------------------\n");
@@ -1191,8 +1872,12 @@ int ecl_sum_data_iget_mini_step(const ecl_sum_data_type * data , int internal_in
 
 
 double ecl_sum_data_iget( const ecl_sum_data_type * data , int time_index , int params_index ) {
-  const ecl_sum_tstep_type * ministep_data = ecl_sum_data_iget_ministep( data , time_index  );
-  return ecl_sum_tstep_iget( ministep_data , params_index);
+  if (data->compressed)
+    return ecl_sum_compressed_iget( data->compressed , time_index , params_index );
+  else {
+    const ecl_sum_tstep_type * ministep_data = ecl_sum_data_iget_ministep( data , time_index  );
+    return ecl_sum_tstep_iget( ministep_data , params_index);
+  }
 }
 
 
@@ -1209,10 +1894,7 @@ double ecl_sum_data_iget( const ecl_sum_data_type * data , int time_index , int
 */
 
 double ecl_sum_data_interp_get(const ecl_sum_data_type * data , int time_index1 , int time_index2 , double weight1 , double weight2 , int params_index) {
-  const ecl_sum_tstep_type * ministep_data1 = ecl_sum_data_iget_ministep( data , time_index1 );
-  const ecl_sum_tstep_type * ministep_data2 = ecl_sum_data_iget_ministep( data , time_index2 );
-
-  return ecl_sum_tstep_iget( ministep_data1 , params_index ) * weight1 + ecl_sum_tstep_iget( ministep_data2 , params_index ) * weight2;
+  return ecl_sum_data_iget( data , time_index1 , params_index ) * weight1 + ecl_sum_data_iget( data , time_index2 , params_index ) * weight2;
 }
 
 
@@ -1220,21 +1902,21 @@ void ecl_sum_data_fwrite_interp_csv_line(const ecl_sum_data_type * data , time_t
     int num_keywords = ecl_sum_vector_get_size(keylist);
     double weight1 , weight2;
     int    time_index1 , time_index2;
+    int    rate_index;
     double value = 0.0;
     int i;
 
     ecl_sum_data_init_interp_from_sim_time( data , sim_time , &time_index1 , &time_index2 , &weight1 , &weight2);
+    if (sim_time == time_interval_get_start( data->sim_time ))
+        rate_index = 0;
+    else
+        rate_index = ecl_sum_data_get_index_from_sim_time( data , sim_time );
+
     for(i = 0; i< num_keywords; i++  ){
         bool is_rate = ecl_sum_vector_iget_is_rate(keylist, i);
         int params_index = ecl_sum_vector_iget_param_index(keylist , i);
         if(is_rate){
-            int time_index;
-            if (sim_time == time_interval_get_start( data->sim_time ))
-                time_index = 0;
-            else
-                time_index = ecl_sum_data_get_index_from_sim_time( data , sim_time );
-
-           value = ecl_sum_data_iget( data , time_index , params_index);
+           value = ecl_sum_data_iget( data , rate_index , params_index);
         } else {
            value = ecl_sum_data_interp_get( data , time_index1 , time_index2 , weight1 , weight2 , params_index);
 
@@ -1285,6 +1967,119 @@ double ecl_sum_data_get_from_sim_time( const ecl_sum_data_type * data , time_t s
 }
 
 
+/**
+   Bulk extraction of many summary vectors on a common time axis. The
+   @matrix must have room for num_keys * num_times elements, and is
+   filled in key major order:
+
+       matrix[ key_index * num_times + time_index ]
+
+   where key_index refers to the keys in @keylist. If @sim_time is NULL
+   the values are extracted at all the ministeps, i.e. num_times ==
+   ecl_sum_data_get_length(), otherwise @sim_time must be sorted in
+   increasing order and the values are evaluated with the same rules
+   as ecl_sum_data_get_from_sim_time(): rates are taken from the
+   ministep covering the time, and state variables are interpolated
+   linearly between the two bracketing ministeps. Time points outside
+   the simulated interval are set to NAN.
+
+   The ministeps bracketing each time point are located in one merge
+   pass over the sorted time axis, instead of one binary search for
+   each (key,time) pair. If the column block has been built with
+   ecl_sum_data_build_columns() the values are read from the columns,
+   and compressed data is decoded one full column at a time.
+*/
+
+void ecl_sum_data_init_data_matrix( const ecl_sum_data_type * data , const ecl_sum_vector_type * keylist , const time_t_vector_type * sim_time , double * matrix) {
+  const int num_keys   = ecl_sum_vector_get_size( keylist );
+  const int length     = vector_get_size( data->data );
+  const int num_times  = (sim_time == NULL) ? length : time_t_vector_size( sim_time );
+  const bool use_columns = (data->columns != NULL) && (data->columns_length == length);
+  int    * index1  = util_calloc( util_int_max( 1 , num_times ) , sizeof * index1 );
+  int    * index2  = util_calloc( util_int_max( 1 , num_times ) , sizeof * index2 );
+  double * weight1 = util_calloc( util_int_max( 1 , num_times ) , sizeof * weight1 );
+  int time_index;
+
+  if ((sim_time != NULL) && !time_t_vector_is_sorted( sim_time , false ))
+    util_abort("%s: the sim_time vector must be sorted in increasing order\n",__func__);
+
+  /*
+    1: Locate the ministeps for each time point. index2 is the first
+       ministep with sim_time >= the requested time, index1 is the
+       ministep before that and weight1 is the interpolation weight
+       of index1. A negative index2 flags a time point outside the
+       simulated interval.
+  */
+  {
+    int ministep = 0;
+    for (time_index = 0; time_index < num_times; time_index++) {
+      if (sim_time == NULL) {
+        index1[time_index]  = time_index;
+        index2[time_index]  = time_index;
+        weight1[time_index] = 0;
+      } else {
+        time_t t = time_t_vector_iget( sim_time , time_index );
+
+        if ((length == 0) || !ecl_sum_data_check_sim_time( data , t ))
+          index2[time_index] = -1;
+        else {
+          while (ecl_sum_tstep_get_sim_time( ecl_sum_data_iget_ministep( data , ministep )) < t)
+            ministep++;
+
+          index2[time_index] = ministep;
+          if (ministep == 0) {
+            index1[time_index]  = 0;
+            weight1[time_index] = 0;
+          } else {
+            time_t t1 = ecl_sum_tstep_get_sim_time( ecl_sum_data_iget_ministep( data , ministep - 1 ));
+            time_t t2 = ecl_sum_tstep_get_sim_time( ecl_sum_data_iget_ministep( data , ministep ));
+
+            index1[time_index]  = ministep - 1;
+            weight1[time_index] = 1.0 * (t2 - t) / (t2 - t1);
+          }
+        }
+      }
+    }
+  }
+
+  /* 2: Fill in the values, one key at a time. */
+  {
+    int key_index;
+    for (key_index = 0; key_index < num_keys; key_index++) {
+      const int params_index = ecl_sum_vector_iget_param_index( keylist , key_index );
+      const bool is_rate = ecl_sum_vector_iget_is_rate( keylist , key_index );
+      float * compressed_column = use_columns ? NULL : ecl_sum_data_alloc_compressed_column( data , params_index );
+      const float * column = use_columns ? &data->columns[ (size_t) params_index * length ] : compressed_column;
+      double * key_data = &matrix[ (size_t) key_index * num_times ];
+
+      for (time_index = 0; time_index < num_times; time_index++) {
+        const int i2 = index2[time_index];
+        if (i2 < 0)
+          key_data[time_index] = NAN;
+        else {
+          double value2 = column ? column[i2] : ecl_sum_data_iget( data , i2 , params_index );
+
+          if (is_rate || (weight1[time_index] == 0))
+            key_data[time_index] = value2;
+          else {
+            const int i1 = index1[time_index];
+            double value1 = column ? column[i1] : ecl_sum_data_iget( data , i1 , params_index );
+            double w1 = weight1[time_index];
+
+            key_data[time_index] = value1 * w1 + value2 * (1 - w1);
+          }
+        }
+      }
+      free( compressed_column );
+    }
+  }
+
+  free( weight1 );
+  free( index2 );
+  free( index1 );
+}
+
+
 int ecl_sum_data_get_report_step_from_days(const ecl_sum_data_type * data , double sim_days) {
   if ((sim_days < data->days_start) || (sim_days > data->sim_length))
     return -1;
@@ -1457,22 +2252,41 @@ time_t_vector_type *  ecl_sum_data_alloc_time_vector( const ecl_sum_data_type *
 
 
 void ecl_sum_data_init_data_vector( const ecl_sum_data_type * data , double_vector_type * data_vector , int data_index , bool report_only) {
+  const float * column = NULL;
+  float * compressed_column = NULL;
+  if ((data->columns != NULL) && (data_index >= 0) && (data_index < data->columns_count))
+    column = &data->columns[ (size_t) data_index * data->columns_length ];
+  else {
+    compressed_column = ecl_sum_data_alloc_compressed_column( data , data_index );
+    column = compressed_column;
+  }
+
   double_vector_reset( data_vector );
   double_vector_append( data_vector , ecl_smspec_get_start_time( data->smspec ));
   if (report_only) {
     int report_step;
     for (report_step = data->first_report_step; report_step <= data->last_report_step; report_step++) {
       int last_index = int_vector_iget(data->report_last_index , report_step);
-      const ecl_sum_tstep_type * ministep = ecl_sum_data_iget_ministep( data , last_index );
-      double_vector_append( data_vector , ecl_sum_tstep_iget( ministep , data_index ));
+      if (column)
+        double_vector_append( data_vector , column[ last_index ]);
+      else {
+        const ecl_sum_tstep_type * ministep = ecl_sum_data_iget_ministep( data , last_index );
+        double_vector_append( data_vector , ecl_sum_tstep_iget( ministep , data_index ));
+      }
     }
   } else {
     int i;
-    for (i = 0; i < vector_get_size(data->data); i++) {
-      const ecl_sum_tstep_type * ministep = ecl_sum_data_iget_ministep( data , i  );
-      double_vector_append( data_vector , ecl_sum_tstep_iget( ministep , data_index ));
+    if (column) {
+      for (i = 0; i < vector_get_size(data->data); i++)
+        double_vector_append( data_vector , column[i] );
+    } else {
+      for (i = 0; i < vector_get_size(data->data); i++) {
+        const ecl_sum_tstep_type * ministep = ecl_sum_data_iget_ministep( data , i  );
+        double_vector_append( data_vector , ecl_sum_tstep_iget( ministep , data_index ));
+      }
     }
   }
+  free( compressed_column );
 }
 
 
@@ -1495,19 +2309,29 @@ int ecl_sum_data_get_length( const ecl_sum_data_type * data ) {
 }
 
 void ecl_sum_data_scale_vector(ecl_sum_data_type * data, int index, double scalar) {
+  const bool compressed = ecl_sum_data_is_compressed( data );
   int len = vector_get_size(data->data);
+  ecl_sum_data_uncompress( data );
   for (int i = 0; i < len; i++) {
     ecl_sum_tstep_type * ministep = ecl_sum_data_iget_ministep(data,i);
     ecl_sum_tstep_iscale(ministep, index, scalar);
   }
+  ecl_sum_data_drop_columns( data );
+  if (compressed)
+    ecl_sum_data_compress( data );
 }
 
 void ecl_sum_data_shift_vector(ecl_sum_data_type * data, int index, double addend) {
+  const bool compressed = ecl_sum_data_is_compressed( data );
   int len = vector_get_size(data->data);
+  ecl_sum_data_uncompress( data );
   for (int i = 0; i < len; i++) {
     ecl_sum_tstep_type * ministep = ecl_sum_data_iget_ministep(data,i);
     ecl_sum_tstep_ishift(ministep, index, addend);
   }
+  ecl_sum_data_drop_columns( data );
+  if (compressed)
+    ecl_sum_data_compress( data );
 }
 
 bool ecl_sum_data_report_step_equal( const ecl_sum_data_type * data1 , const ecl_sum_data_type * data2) {
@@ -0,0 +1,640 @@
+/*
+   Copyright (C) 2017  Statoil ASA, Norway.
+
+   The file 'ecl_sum_ensemble.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include <ert/util/ert_api_config.h>
+#include <ert/util/util.h>
+#include <ert/util/vector.h>
+#include <ert/util/hash.h>
+#include <ert/util/stringlist.h>
+#include <ert/util/int_vector.h>
+#include <ert/util/double_vector.h>
+#include <ert/util/time_t_vector.h>
+#include <ert/util/statistics.h>
+#include <ert/util/type_macros.h>
+#ifdef ERT_HAVE_THREAD_POOL
+#include <ert/util/thread_pool.h>
+#endif
+
+#include <ert/ecl/ecl_sum.h>
+#include <ert/ecl/ecl_sum_vector.h>
+#include <ert/ecl/ecl_sum_ensemble.h>
+
+
+/*
+  The ecl_sum_ensemble structure is used to calculate statistics,
+  i.e. quantiles, of summary vectors over an ensemble of simulations
+  of the same model.
+
+  All the summary vectors are first resampled on a common time axis,
+  the interp_time vector; the resampling is done for all the keys in
+  one pass over each case. The resampled values are stored per case:
+
+      resampled[iens][key_index * num_interp + time_index]
+
+  When the time axis extends beyond the simulated time of a case, or
+  the case does not have the key at all, the resampled value is NAN,
+  and the case is not included in the statistics for that key and
+  time.
+
+  The quantiles are calculated for all the (key,time) columns in
+  parallel, with a selection algorithm which calculates all the
+  quantiles of one column in one pass, see
+  statistics_empirical_quantiles__(). The loading of cases, the
+  resampling and the quantile calculation are all distributed over
+  num_threads threads.
+
+  With ecl_sum_ensemble_set_compress() the cases are compressed when
+  they are added to the ensemble, see ecl_sum_compress(); for large
+  ensembles this reduces the memory usage substantially.
+*/
+
+#define ECL_SUM_ENSEMBLE_TYPE_ID 66107281
+
+
+struct ecl_sum_ensemble_struct {
+  UTIL_TYPE_ID_DECLARATION;
+  int                   num_threads;
+  bool                  compress;       /* Compress the cases when they are added. */
+  vector_type         * cases;          /* Owned ecl_sum instances. */
+  time_t                start_time;
+  time_t                end_time;
+  time_t_vector_type  * interp_time;
+  stringlist_type     * keys;
+  hash_type           * key_index;      /* key -> index in keys. */
+  double             ** resampled;      /* resampled[iens] - NULL before ecl_sum_ensemble_resample() is called. */
+  int                   resampled_cases;
+  double_vector_type  * quantiles;      /* The quantiles added with ecl_sum_ensemble_add_quantile(). */
+  double              * quantile_values;  /* NULL before ecl_sum_ensemble_calculate() is called. */
+};
+
+
+UTIL_IS_INSTANCE_FUNCTION( ecl_sum_ensemble , ECL_SUM_ENSEMBLE_TYPE_ID )
+
+
+ecl_sum_ensemble_type * ecl_sum_ensemble_alloc( int num_threads ) {
+  ecl_sum_ensemble_type * ensemble = util_malloc( sizeof * ensemble );
+  UTIL_TYPE_ID_INIT( ensemble , ECL_SUM_ENSEMBLE_TYPE_ID );
+  ensemble->num_threads     = util_int_max( 1 , num_threads );
+  ensemble->compress        = false;
+  ensemble->cases           = vector_alloc_new();
+  ensemble->start_time      = -1;
+  ensemble->end_time        = -1;
+  ensemble->interp_time     = time_t_vector_alloc( 0 , -1 );
+  ensemble->keys            = stringlist_alloc_new();
+  ensemble->key_index       = hash_alloc();
+  ensemble->resampled       = NULL;
+  ensemble->resampled_cases = 0;
+  ensemble->quantiles       = double_vector_alloc( 0 , 0 );
+  ensemble->quantile_values = NULL;
+  return ensemble;
+}
+
+
+static void ecl_sum_ensemble_free_resampled( ecl_sum_ensemble_type * ensemble ) {
+  if (ensemble->quantile_values) {
+    free( ensemble->quantile_values );
+    ensemble->quantile_values = NULL;
+  }
+
+  if (ensemble->resampled) {
+    int iens;
+    for (iens = 0; iens < ensemble->resampled_cases; iens++)
+      free( ensemble->resampled[iens] );
+    free( ensemble->resampled );
+    ensemble->resampled = NULL;
+    ensemble->resampled_cases = 0;
+  }
+}
+
+
+void ecl_sum_ensemble_free( ecl_sum_ensemble_type * ensemble ) {
+  ecl_sum_ensemble_free_resampled( ensemble );
+  vector_free( ensemble->cases );
+  time_t_vector_free( ensemble->interp_time );
+  stringlist_free( ensemble->keys );
+  hash_free( ensemble->key_index );
+  double_vector_free( ensemble->quantiles );
+  free( ensemble );
+}
+
+
+/*
+  Will run func(arg , index1 , index2) for num_jobs consecutive
+  ranges covering [0,size) on a thread pool.
+*/
+
+typedef void (ecl_sum_ensemble_range_ftype) (void * arg , int job_nr , int index1 , int index2);
+
+typedef struct {
+  ecl_sum_ensemble_range_ftype * func;
+  void                         * arg;
+  int                            job_nr;
+  int                            index1;
+  int                            index2;
+} range_job_type;
+
+
+#ifdef ERT_HAVE_THREAD_POOL
+static void * ecl_sum_ensemble_range_job__( void * arg ) {
+  range_job_type * job = arg;
+  job->func( job->arg , job->job_nr , job->index1 , job->index2 );
+  return NULL;
+}
+#endif
+
+
+static void ecl_sum_ensemble_run_ranges( const ecl_sum_ensemble_type * ensemble , int size , int num_jobs , ecl_sum_ensemble_range_ftype * func , void * arg) {
+  num_jobs = util_int_max( 1 , util_int_min( num_jobs , size ));
+#ifdef ERT_HAVE_THREAD_POOL
+  if ((num_jobs > 1) && (ensemble->num_threads > 1)) {
+    range_job_type * jobs = util_calloc( num_jobs , sizeof * jobs );
+    thread_pool_type * tp = thread_pool_alloc( util_int_min( ensemble->num_threads , num_jobs ) , true );
+    int job_nr;
+
+    for (job_nr = 0; job_nr < num_jobs; job_nr++) {
+      range_job_type * job = &jobs[job_nr];
+      job->func   = func;
+      job->arg    = arg;
+      job->job_nr = job_nr;
+      job->index1 = (int) (((int64_t) job_nr * size) / num_jobs);
+      job->index2 = (int) (((int64_t) (job_nr + 1) * size) / num_jobs);
+      thread_pool_add_job( tp , ecl_sum_ensemble_range_job__ , job );
+    }
+    thread_pool_join( tp );
+    thread_pool_free( tp );
+    free( jobs );
+    return;
+  }
+#endif
+  func( arg , 0 , 0 , size );
+}
+
+
+/*****************************************************************/
+/* Loading cases */
+
+static void ecl_sum_ensemble_update_time( ecl_sum_ensemble_type * ensemble , const ecl_sum_type * ecl_sum) {
+  time_t start_time = ecl_sum_get_start_time( ecl_sum );
+  time_t end_time   = ecl_sum_get_end_time( ecl_sum );
+
+  if (vector_get_size( ensemble->cases ) == 0) {
+    ensemble->start_time = start_time;
+    ensemble->end_time   = end_time;
+  } else {
+    ensemble->start_time = util_time_t_min( ensemble->start_time , start_time );
+    ensemble->end_time   = util_time_t_max( ensemble->end_time , end_time );
+  }
+}
+
+
+void ecl_sum_ensemble_set_compress( ecl_sum_ensemble_type * ensemble , bool compress ) {
+  ensemble->compress = compress;
+}
+
+
+/*
+  The ensemble takes ownership of the ecl_sum instance.
+*/
+
+void ecl_sum_ensemble_add_case( ecl_sum_ensemble_type * ensemble , ecl_sum_type * ecl_sum ) {
+  if (ensemble->compress)
+    ecl_sum_compress( ecl_sum );
+  ecl_sum_ensemble_update_time( ensemble , ecl_sum );
+  vector_append_owned_ref( ensemble->cases , ecl_sum , ecl_sum_free__ );
+  ecl_sum_ensemble_free_resampled( ensemble );
+}
+
+
+typedef struct {
+  const stringlist_type * case_list;
+  const char            * key_join_string;
+  bool                    compress;
+  ecl_sum_type         ** ecl_sum_list;
+} load_arg_type;
+
+
+static void ecl_sum_ensemble_load_range( void * arg , int job_nr , int index1 , int index2) {
+  load_arg_type * load_arg = arg;
+  int icase;
+  for (icase = index1; icase < index2; icase++) {
+    ecl_sum_type * ecl_sum = ecl_sum_fread_alloc_case( stringlist_iget( load_arg->case_list , icase ) , load_arg->key_join_string );
+    if (ecl_sum && load_arg->compress)
+      ecl_sum_compress( ecl_sum );
+    load_arg->ecl_sum_list[icase] = ecl_sum;
+  }
+}
+
+
+/*
+  Will load all the cases in @case_list concurrently. The cases are
+  added to the ensemble in the order of @case_list, irrespective of
+  the order the loading completes. Cases which can not be loaded are
+  skipped; the function returns the number of cases loaded.
+*/
+
+int ecl_sum_ensemble_load_cases( ecl_sum_ensemble_type * ensemble , const stringlist_type * case_list , const char * key_join_string ) {
+  const int num_cases = stringlist_get_size( case_list );
+  load_arg_type load_arg;
+  int num_loaded = 0;
+  int icase;
+
+  load_arg.case_list       = case_list;
+  load_arg.key_join_string = key_join_string;
+  load_arg.compress        = ensemble->compress;
+  load_arg.ecl_sum_list    = util_calloc( num_cases , sizeof * load_arg.ecl_sum_list );
+
+  /* One job per case, the thread pool distributes them over the threads. */
+  ecl_sum_ensemble_run_ranges( ensemble , num_cases , num_cases , ecl_sum_ensemble_load_range , &load_arg );
+
+  for (icase = 0; icase < num_cases; icase++) {
+    if (load_arg.ecl_sum_list[icase]) {
+      ecl_sum_ensemble_add_case( ensemble , load_arg.ecl_sum_list[icase] );
+      num_loaded++;
+    }
+  }
+  free( load_arg.ecl_sum_list );
+  return num_loaded;
+}
+
+
+int ecl_sum_ensemble_get_size( const ecl_sum_ensemble_type * ensemble ) {
+  return vector_get_size( ensemble->cases );
+}
+
+
+const ecl_sum_type * ecl_sum_ensemble_iget_case( const ecl_sum_ensemble_type * ensemble , int iens ) {
+  return vector_iget_const( ensemble->cases , iens );
+}
+
+
+time_t ecl_sum_ensemble_get_start_time( const ecl_sum_ensemble_type * ensemble ) {
+  return ensemble->start_time;
+}
+
+
+time_t ecl_sum_ensemble_get_end_time( const ecl_sum_ensemble_type * ensemble ) {
+  return ensemble->end_time;
+}
+
+
+/*****************************************************************/
+/* Time axis and keys */
+
+/*
+  Will initialize a time axis with @num_interp points uniformly
+  distributed between the first start time and the last end time of
+  the cases in the ensemble.
+*/
+
+void ecl_sum_ensemble_init_time_interp( ecl_sum_ensemble_type * ensemble , int num_interp ) {
+  int i;
+  if (num_interp < 2)
+    util_abort("%s: need at least two interpolation points\n",__func__);
+
+  time_t_vector_reset( ensemble->interp_time );
+  for (i = 0; i < num_interp; i++)
+    time_t_vector_append( ensemble->interp_time , ensemble->start_time + i * (ensemble->end_time - ensemble->start_time) / (num_interp - 1));
+  ecl_sum_ensemble_free_resampled( ensemble );
+}
+
+
+void ecl_sum_ensemble_set_time_interp( ecl_sum_ensemble_type * ensemble , const time_t_vector_type * interp_time ) {
+  time_t_vector_memcpy( ensemble->interp_time , interp_time );
+  ecl_sum_ensemble_free_resampled( ensemble );
+}
+
+
+const time_t_vector_type * ecl_sum_ensemble_get_time_interp( const ecl_sum_ensemble_type * ensemble ) {
+  return ensemble->interp_time;
+}
+
+
+/*
+  Will add the key to the list of keys which are resampled, and return
+  the index of the key. Adding the same key several times is allowed,
+  the key is only stored once.
+*/
+
+int ecl_sum_ensemble_add_key( ecl_sum_ensemble_type * ensemble , const char * key ) {
+  int key_index = ecl_sum_ensemble_get_key_index( ensemble , key );
+  if (key_index < 0) {
+    key_index = stringlist_get_size( ensemble->keys );
+    stringlist_append_copy( ensemble->keys , key );
+    hash_insert_int( ensemble->key_index , key , key_index );
+    ecl_sum_ensemble_free_resampled( ensemble );
+  }
+  return key_index;
+}
+
+
+int ecl_sum_ensemble_get_key_index( const ecl_sum_ensemble_type * ensemble , const char * key ) {
+  if (hash_has_key( ensemble->key_index , key ))
+    return hash_get_int( ensemble->key_index , key );
+  else
+    return -1;
+}
+
+
+int ecl_sum_ensemble_get_num_keys( const ecl_sum_ensemble_type * ensemble ) {
+  return stringlist_get_size( ensemble->keys );
+}
+
+
+/*
+  Will check that all the cases in the ensemble have the key; the
+  cases which do not have the key are not included in the statistics.
+  If @missing_cases is != NULL the names of the cases which do not
+  have the key are appended to it.
+*/
+
+bool ecl_sum_ensemble_has_key( const ecl_sum_ensemble_type * ensemble , const char * key , stringlist_type * missing_cases ) {
+  bool has_key = true;
+  int iens;
+  for (iens = 0; iens < vector_get_size( ensemble->cases ); iens++) {
+    const ecl_sum_type * ecl_sum = vector_iget_const( ensemble->cases , iens );
+    if (!ecl_sum_has_general_var( ecl_sum , key )) {
+      has_key = false;
+      if (missing_cases)
+        stringlist_append_copy( missing_cases , ecl_sum_get_case( ecl_sum ));
+    }
+  }
+  return has_key;
+}
+
+
+/*****************************************************************/
+/* Resampling */
+
+/*
+  The keys which are present in the case are extracted in one pass
+  with ecl_sum_init_data_matrix(), which also takes care of setting
+  time points outside the simulation (the different simulations are
+  allowed to have differing length) to NAN.
+*/
+
+static void ecl_sum_ensemble_resample_sorted( const ecl_sum_ensemble_type * ensemble , const ecl_sum_type * ecl_sum , double * resampled) {
+  const int num_interp = time_t_vector_size( ensemble->interp_time );
+  const int num_keys = stringlist_get_size( ensemble->keys );
+  ecl_sum_vector_type * keylist = ecl_sum_vector_alloc( ecl_sum );
+  int_vector_type * key_map = int_vector_alloc( 0 , 0 );
+  int key_index;
+
+  for (key_index = 0; key_index < num_keys; key_index++) {
+    if (ecl_sum_vector_add_key( keylist , stringlist_iget( ensemble->keys , key_index )))
+      int_vector_append( key_map , key_index );
+    else {
+      int time_index;
+      for (time_index = 0; time_index < num_interp; time_index++)
+        resampled[ (size_t) key_index * num_interp + time_index ] = NAN;
+    }
+  }
+
+  {
+    double * matrix = util_calloc( util_size_t_max( 1 , (size_t) int_vector_size( key_map ) * num_interp ) , sizeof * matrix );
+    int i;
+
+    ecl_sum_init_data_matrix( ecl_sum , keylist , ensemble->interp_time , matrix );
+    for (i = 0; i < int_vector_size( key_map ); i++)
+      memcpy( &resampled[ (size_t) int_vector_iget( key_map , i ) * num_interp ] , &matrix[ (size_t) i * num_interp ] , num_interp * sizeof * matrix );
+
+    free( matrix );
+  }
+
+  int_vector_free( key_map );
+  ecl_sum_vector_free( keylist );
+}
+
+
+static void ecl_sum_ensemble_resample_unsorted( const ecl_sum_ensemble_type * ensemble , const ecl_sum_type * ecl_sum , double * resampled) {
+  const int num_interp = time_t_vector_size( ensemble->interp_time );
+  const int num_keys = stringlist_get_size( ensemble->keys );
+  const time_t start_time = ecl_sum_get_start_time( ecl_sum );
+  const time_t end_time = ecl_sum_get_end_time( ecl_sum );
+  int key_index;
+
+  for (key_index = 0; key_index < num_keys; key_index++) {
+    const char * key = stringlist_iget( ensemble->keys , key_index );
+    double * key_data = &resampled[ (size_t) key_index * num_interp ];
+    int time_index;
+
+    if (ecl_sum_has_general_var( ecl_sum , key )) {
+      const smspec_node_type * node = ecl_sum_get_general_var_node( ecl_sum , key );
+      for (time_index = 0; time_index < num_interp; time_index++) {
+        time_t sim_time = time_t_vector_iget( ensemble->interp_time , time_index );
+
+        if ((sim_time >= start_time) && (sim_time <= end_time))
+          key_data[time_index] = ecl_sum_get_from_sim_time( ecl_sum , sim_time , node );
+        else
+          key_data[time_index] = NAN;
+      }
+    } else {
+      for (time_index = 0; time_index < num_interp; time_index++)
+        key_data[time_index] = NAN;
+    }
+  }
+}
+
+
+static void ecl_sum_ensemble_resample_range( void * arg , int job_nr , int index1 , int index2) {
+  ecl_sum_ensemble_type * ensemble = arg;
+  const int num_interp = time_t_vector_size( ensemble->interp_time );
+  const int num_keys = stringlist_get_size( ensemble->keys );
+  int iens;
+
+  for (iens = index1; iens < index2; iens++) {
+    const ecl_sum_type * ecl_sum = vector_iget_const( ensemble->cases , iens );
+    double * resampled = util_calloc( (size_t) num_keys * num_interp , sizeof * resampled );
+
+    if (time_t_vector_is_sorted( ensemble->interp_time , false ))
+      ecl_sum_ensemble_resample_sorted( ensemble , ecl_sum , resampled );
+    else
+      ecl_sum_ensemble_resample_unsorted( ensemble , ecl_sum , resampled );
+
+    ensemble->resampled[iens] = resampled;
+  }
+}
+
+
+/*
+  Will resample all the keys for all the cases on the interpolation
+  time axis; each case is handled by one thread.
+*/
+
+void ecl_sum_ensemble_resample( ecl_sum_ensemble_type * ensemble ) {
+  const int ens_size = vector_get_size( ensemble->cases );
+  ecl_sum_ensemble_free_resampled( ensemble );
+
+  ensemble->resampled = util_calloc( util_int_max( 1 , ens_size ) , sizeof * ensemble->resampled );
+  ensemble->resampled_cases = ens_size;
+  ecl_sum_ensemble_run_ranges( ensemble , ens_size , ens_size , ecl_sum_ensemble_resample_range , ensemble );
+}
+
+
+static void ecl_sum_ensemble_assert_resampled( const ecl_sum_ensemble_type * ensemble , const char * caller) {
+  if (ensemble->resampled == NULL)
+    util_abort("%s: must call ecl_sum_ensemble_resample() first\n", caller );
+}
+
+
+double ecl_sum_ensemble_iget_resampled( const ecl_sum_ensemble_type * ensemble , int iens , int key_index , int time_index ) {
+  ecl_sum_ensemble_assert_resampled( ensemble , __func__ );
+  return ensemble->resampled[iens][ (size_t) key_index * time_t_vector_size( ensemble->interp_time ) + time_index ];
+}
+
+
+/*****************************************************************/
+/* Quantiles */
+
+typedef struct {
+  const ecl_sum_ensemble_type * ensemble;
+  int                           num_quantiles;
+  const double                * quantiles;
+  double                      * values;
+} quantile_arg_type;
+
+
+static void ecl_sum_ensemble_quantile_range( void * arg , int job_nr , int index1 , int index2) {
+  quantile_arg_type * quantile_arg = arg;
+  const ecl_sum_ensemble_type * ensemble = quantile_arg->ensemble;
+  const int ens_size = ensemble->resampled_cases;
+  const int num_quantiles = quantile_arg->num_quantiles;
+  double * column = util_calloc( util_int_max( 1 , ens_size ) , sizeof * column );
+  int column_nr;
+
+  for (column_nr = index1; column_nr < index2; column_nr++) {
+    double * values = &quantile_arg->values[ (size_t) column_nr * num_quantiles ];
+    int size = 0;
+    int iens;
+
+    for (iens = 0; iens < ens_size; iens++) {
+      double value = ensemble->resampled[iens][column_nr];
+      if (!isnan( value ))
+        column[size++] = value;
+    }
+
+    if (size > 0)
+      statistics_empirical_quantiles__( column , size , num_quantiles , quantile_arg->quantiles , values );
+    else {
+      int iq;
+      for (iq = 0; iq < num_quantiles; iq++)
+        values[iq] = NAN;
+    }
+  }
+  free( column );
+}
+
+
+/*
+  Will calculate the quantiles for all keys and all interpolation
+  times; the returned array should be freed by the calling scope and
+  has the layout:
+
+     values[(key_index * num_interp + time_index) * num_quantiles + iq]
+
+  When no case has a value for a key at a time the quantiles are NAN.
+*/
+
+double * ecl_sum_ensemble_alloc_quantiles( const ecl_sum_ensemble_type * ensemble , int num_quantiles , const double * quantiles ) {
+  const int num_columns = stringlist_get_size( ensemble->keys ) * time_t_vector_size( ensemble->interp_time );
+  quantile_arg_type quantile_arg;
+
+  ecl_sum_ensemble_assert_resampled( ensemble , __func__ );
+  quantile_arg.ensemble      = ensemble;
+  quantile_arg.num_quantiles = num_quantiles;
+  quantile_arg.quantiles     = quantiles;
+  quantile_arg.values        = util_calloc( util_int_max( 1 , num_columns * num_quantiles ) , sizeof * quantile_arg.values );
+
+  ecl_sum_ensemble_run_ranges( ensemble , num_columns , 4 * ensemble->num_threads , ecl_sum_ensemble_quantile_range , &quantile_arg );
+  return quantile_arg.values;
+}
+
+
+/*
+  The quantiles which should be calculated by ecl_sum_ensemble_calculate()
+  are added with ecl_sum_ensemble_add_quantile(); as for the keys the
+  same quantile is only stored once, and the index of the quantile is
+  returned.
+*/
+
+int ecl_sum_ensemble_add_quantile( ecl_sum_ensemble_type * ensemble , double quantile ) {
+  int quantile_index = ecl_sum_ensemble_get_quantile_index( ensemble , quantile );
+  if (quantile_index < 0) {
+    if ((quantile < 0) || (quantile > 1))
+      util_abort("%s: invalid quantile:%g - must be in [0,1]\n",__func__ , quantile);
+
+    quantile_index = double_vector_size( ensemble->quantiles );
+    double_vector_append( ensemble->quantiles , quantile );
+    if (ensemble->quantile_values) {
+      free( ensemble->quantile_values );
+      ensemble->quantile_values = NULL;
+    }
+  }
+  return quantile_index;
+}
+
+
+int ecl_sum_ensemble_get_quantile_index( const ecl_sum_ensemble_type * ensemble , double quantile ) {
+  int iq;
+  for (iq = 0; iq < double_vector_size( ensemble->quantiles ); iq++)
+    if (double_vector_iget( ensemble->quantiles , iq ) == quantile)
+      return iq;
+  return -1;
+}
+
+
+int ecl_sum_ensemble_get_num_quantiles( const ecl_sum_ensemble_type * ensemble ) {
+  return double_vector_size( ensemble->quantiles );
+}
+
+
+/*
+  Will resample the ensemble - unless that has already been done -
+  and calculate all the added quantiles for all the keys and
+  interpolation times; the results are available with
+  ecl_sum_ensemble_iget_quantile().
+*/
+
+void ecl_sum_ensemble_calculate( ecl_sum_ensemble_type * ensemble ) {
+  if (ensemble->resampled == NULL)
+    ecl_sum_ensemble_resample( ensemble );
+
+  if (ensemble->quantile_values == NULL)
+    ensemble->quantile_values = ecl_sum_ensemble_alloc_quantiles( ensemble ,
+                                                                  double_vector_size( ensemble->quantiles ) ,
+                                                                  double_vector_get_const_ptr( ensemble->quantiles ));
+}
+
+
+double ecl_sum_ensemble_iget_quantile( const ecl_sum_ensemble_type * ensemble , int key_index , int time_index , int quantile_index ) {
+  const int num_interp    = time_t_vector_size( ensemble->interp_time );
+  const int num_quantiles = double_vector_size( ensemble->quantiles );
+
+  if (ensemble->quantile_values == NULL)
+    util_abort("%s: must call ecl_sum_ensemble_calculate() first\n",__func__);
+
+  if ((key_index < 0) || (key_index >= stringlist_get_size( ensemble->keys )) ||
+      (time_index < 0) || (time_index >= num_interp) ||
+      (quantile_index < 0) || (quantile_index >= num_quantiles))
+    util_abort("%s: invalid index key:%d time:%d quantile:%d\n",__func__ , key_index , time_index , quantile_index);
+
+  return ensemble->quantile_values[ ((size_t) key_index * num_interp + time_index) * num_quantiles + quantile_index ];
+}
@@ -234,6 +234,42 @@ ecl_sum_tstep_type * ecl_sum_tstep_alloc_new( int report_step , int ministep , f
 
 
 
+/*
+  Direct access to the PARAMS row of this tstep; the row has
+  ecl_sum_tstep_get_data_size() elements.
+*/
+
+const float * ecl_sum_tstep_get_data(const ecl_sum_tstep_type * ministep) {
+  return ministep->data;
+}
+
+
+int ecl_sum_tstep_get_data_size(const ecl_sum_tstep_type * ministep) {
+  return ministep->data_size;
+}
+
+
+/*
+  The data of a tstep can be held elsewhere, see ecl_sum_data_compress();
+  after ecl_sum_tstep_drop_data() the tstep only carries the time
+  information, until the data is installed again with
+  ecl_sum_tstep_set_data().
+*/
+
+void ecl_sum_tstep_drop_data( ecl_sum_tstep_type * ministep ) {
+  free( ministep->data );
+  ministep->data = NULL;
+  ministep->data_size = 0;
+}
+
+
+void ecl_sum_tstep_set_data( ecl_sum_tstep_type * ministep , const float * data , int data_size) {
+  free( ministep->data );
+  ministep->data = util_alloc_copy( data , data_size * sizeof * data );
+  ministep->data_size = data_size;
+}
+
+
 double ecl_sum_tstep_iget(const ecl_sum_tstep_type * ministep , int index) {
   if ((index >= 0) && (index < ministep->data_size))
     return ministep->data[index];
@@ -98,25 +98,46 @@ const char * ecl_type_get_name(const ecl_data_type ecl_type) {
   }
 }
 
-ecl_data_type ecl_type_create_from_name( const char * type_name ) {
+static bool ecl_type_lookup_name__( const char * type_name , ecl_type_enum * type ) {
   if (strncmp( type_name , ECL_TYPE_NAME_FLOAT , ECL_TYPE_LENGTH) == 0)
-    return ECL_FLOAT;
+    *type = ECL_FLOAT_TYPE;
   else if (strncmp( type_name , ECL_TYPE_NAME_INT , ECL_TYPE_LENGTH) == 0)
-    return ECL_INT;
+    *type = ECL_INT_TYPE;
   else if (strncmp( type_name , ECL_TYPE_NAME_DOUBLE , ECL_TYPE_LENGTH) == 0)
-    return ECL_DOUBLE;
+    *type = ECL_DOUBLE_TYPE;
   else if (strncmp( type_name , ECL_TYPE_NAME_CHAR , ECL_TYPE_LENGTH) == 0)
-    return ECL_CHAR;
+    *type = ECL_CHAR_TYPE;
   else if (strncmp( type_name , ECL_TYPE_NAME_C010 , ECL_TYPE_LENGTH) == 0)
-    return ECL_C010;
+    *type = ECL_C010_TYPE;
   else if (strncmp( type_name , ECL_TYPE_NAME_MESSAGE , ECL_TYPE_LENGTH) == 0)
-    return ECL_MESS;
+    *type = ECL_MESS_TYPE;
   else if (strncmp( type_name , ECL_TYPE_NAME_BOOL , ECL_TYPE_LENGTH) == 0)
-    return ECL_BOOL;
-  else {
+    *type = ECL_BOOL_TYPE;
+  else
+    return false;
+
+  return true;
+}
+
+
+/*
+  Can be used to check a type name read from an untrusted source
+  before calling ecl_type_create_from_name(), which will abort on an
+  unrecognized name.
+*/
+
+bool ecl_type_is_valid_name( const char * type_name ) {
+  ecl_type_enum type;
+  return ecl_type_lookup_name__( type_name , &type );
+}
+
+
+ecl_data_type ecl_type_create_from_name( const char * type_name ) {
+  ecl_type_enum type = ECL_INT_TYPE;
+  if (!ecl_type_lookup_name__( type_name , &type ))
     util_abort("%s: unrecognized type name:%s \n",__func__ , type_name);
-    return ECL_INT; /* Dummy */
-  }
+
+  return ecl_type_create_from_type( type );
 }
 
 
@@ -22,10 +22,15 @@
 #include <string.h>
 #include <errno.h>
 
+#include <ert/util/ert_api_config.h>
 #include <ert/util/util.h>
 #include <ert/util/type_macros.h>
 #include <ert/ecl/fortio.h>
 
+#ifdef ERT_HAVE_MMAP
+#include <sys/mman.h>
+#endif
+
 
 #define FORTIO_ID  345116
 
@@ -90,6 +95,12 @@ struct fortio_struct {
   */
   bool               readable;
   offset_type        read_size;
+
+  /*
+    Optional read-only view of the complete file, see fortio_mmap().
+  */
+  char             * mmap_data;
+  size_t             mmap_size;
 };
 
 
@@ -105,6 +116,8 @@ static fortio_type * fortio_alloc__(const char *filename , bool fmt_file , bool
   fortio->stream_owner       = stream_owner;
   fortio->read_size          = 0;
   fortio->readable           = readable;
+  fortio->mmap_data          = NULL;
+  fortio->mmap_size          = 0;
   return fortio;
 }
 
@@ -392,10 +405,109 @@ bool fortio_assert_stream_open( fortio_type * fortio ) {
 }
 
 
+/*****************************************************************/
+
+/**
+   Will memory map the complete file wrapped by the fortio
+   instance. This is only supported for unformatted files which are
+   open for reading; the function will return false if the file can
+   not be mapped, and the fortio instance will then continue to work
+   through the FILE * stream only.
+
+   The mapping is private and writable; i.e. the content can be
+   modified in place, e.g. endian converted, without affecting the
+   file on disk. The operating system will only copy the pages which
+   are actually modified. The mapping is retained until
+   fortio_munmap() or fortio_fclose() is called - also when the
+   stream is closed with fortio_fclose_stream().
+*/
+
+bool fortio_mmap( fortio_type * fortio ) {
+  if (fortio->mmap_data)
+    return true;
+
+  if (fortio->fmt_file || !fortio->readable || !fortio->stream)
+    return false;
+
+  if (fortio->read_size <= 0)
+    return false;
+
+#ifdef ERT_HAVE_MMAP
+  {
+    void * data = mmap( NULL , fortio->read_size , PROT_READ | PROT_WRITE , MAP_PRIVATE , fortio_fileno( fortio ) , 0);
+    if (data == MAP_FAILED)
+      return false;
+
+    fortio->mmap_data = data;
+    fortio->mmap_size = fortio->read_size;
+    return true;
+  }
+#else
+  return false;
+#endif
+}
+
+
+void fortio_munmap( fortio_type * fortio ) {
+#ifdef ERT_HAVE_MMAP
+  if (fortio->mmap_data)
+    munmap( fortio->mmap_data , fortio->mmap_size );
+#endif
+  fortio->mmap_data = NULL;
+  fortio->mmap_size = 0;
+}
+
+
+bool fortio_is_mapped( const fortio_type * fortio ) {
+  if (fortio->mmap_data)
+    return true;
+  else
+    return false;
+}
+
+
+/**
+   Will return a pointer to the payload of the record starting at
+   file offset @offset in the memory mapped file, and the size of the
+   record in *@record_size. If the record is not completely contained
+   in the mapping, or the header and tail of the record do not agree,
+   the function will return NULL.
+*/
+
+char * fortio_mmap_record( const fortio_type * fortio , offset_type offset , int * record_size) {
+  if (!fortio->mmap_data)
+    util_abort("%s: the file:%s has not been memory mapped \n",__func__ , fortio->filename);
+
+  if (offset < 0 || (offset + 2 * sizeof * record_size) > fortio->mmap_size)
+    return NULL;
+
+  {
+    int header , tail;
+    memcpy( &header , &fortio->mmap_data[offset] , sizeof header );
+    if (fortio->endian_flip_header)
+      util_endian_flip_vector(&header , sizeof header , 1);
+
+    if (header < 0 || (offset + 2 * sizeof header + header) > fortio->mmap_size)
+      return NULL;
+
+    memcpy( &tail , &fortio->mmap_data[offset + sizeof header + header] , sizeof tail );
+    if (fortio->endian_flip_header)
+      util_endian_flip_vector(&tail , sizeof tail , 1);
+
+    if (tail != header)
+      return NULL;
+
+    *record_size = header;
+    return &fortio->mmap_data[offset + sizeof header];
+  }
+}
+
+
 /*****************************************************************/
 
 
 static void fortio_free__(fortio_type * fortio) {
+  fortio_munmap( fortio );
   util_safe_free(fortio->filename);
   free(fortio);
 }
@@ -466,9 +578,9 @@ int fortio_init_read(fortio_type *fortio) {
 
 
 bool fortio_data_fskip(fortio_type* fortio, const int element_size, const int element_count, const int block_count) {
-  int headers = block_count * 4;
-  int trailers = block_count * 4;
-  int bytes_to_skip = headers + trailers + (element_size * element_count);
+  offset_type headers = (offset_type) block_count * 4;
+  offset_type trailers = (offset_type) block_count * 4;
+  offset_type bytes_to_skip = headers + trailers + ((offset_type) element_size * element_count);
 
   return fortio_fseek(fortio, bytes_to_skip, SEEK_CUR);
 }
@@ -476,12 +588,12 @@ bool fortio_data_fskip(fortio_type* fortio, const int element_size, const int el
 
 void fortio_data_fseek(fortio_type* fortio, offset_type data_offset, size_t data_element, const int element_size, const int element_count, const int block_size) {
     if(data_element < 0 || data_element >= element_count) {
-        util_abort("%s: Element index is out of range: 0 <= %d < %d \n", __func__, data_element, element_count);
+        util_abort("%s: Element index is out of range: 0 <= %zu < %d \n", __func__, data_element, element_count);
     }
     {
-      int block_index = data_element / block_size;
-      int headers = (block_index + 1) * 4;
-      int trailers = block_index * 4;
+      offset_type block_index = data_element / block_size;
+      offset_type headers = (block_index + 1) * 4;
+      offset_type trailers = block_index * 4;
       offset_type bytes_to_skip = data_offset + headers + trailers + (data_element * element_size);
 
       fortio_fseek(fortio, bytes_to_skip, SEEK_SET);
@@ -535,8 +647,8 @@ static int fortio_fread_record(fortio_type *fortio , char *buffer) {
    transparent, low-level way.
 */
 
-bool fortio_fread_buffer(fortio_type * fortio, char * buffer , int buffer_size) {
-  int total_bytes_read = 0;
+static bool fortio_fread_buffer__(fortio_type * fortio, char * buffer , size_t buffer_size , int flip_size) {
+  size_t total_bytes_read = 0;
 
   while (true) {
     char * buffer_ptr = &buffer[total_bytes_read];
@@ -545,6 +657,9 @@ bool fortio_fread_buffer(fortio_type * fortio, char * buffer , int buffer_size)
     if (bytes_read < 0)
       break;
     else {
+      if (flip_size > 1)
+        util_endian_flip_vector( buffer_ptr , flip_size , bytes_read / flip_size );
+
       total_bytes_read += bytes_read;
       if (total_bytes_read >= buffer_size)
         break;
@@ -557,11 +672,27 @@ bool fortio_fread_buffer(fortio_type * fortio, char * buffer , int buffer_size)
   if (total_bytes_read < buffer_size)
     return false;
 
-  util_abort("%s: internal inconsistency: buffer_size:%d  read %d bytes \n",__func__ , buffer_size , total_bytes_read);
+  util_abort("%s: internal inconsistency: buffer_size:%zu  read %zu bytes \n",__func__ , buffer_size , total_bytes_read);
   return false;
 }
 
 
+bool fortio_fread_buffer(fortio_type * fortio, char * buffer , size_t buffer_size) {
+  return fortio_fread_buffer__( fortio , buffer , buffer_size , 0 );
+}
+
+
+/**
+   Like fortio_fread_buffer(), but every record is endian flipped as
+   elements of size @element_size immediately after it has been read,
+   i.e. while the data is still in the cache.
+*/
+
+bool fortio_fread_buffer_endian_flip(fortio_type * fortio, char * buffer , size_t buffer_size , int element_size) {
+  return fortio_fread_buffer__( fortio , buffer , buffer_size , element_size );
+}
+
+
 int fortio_fskip_record(fortio_type *fortio) {
   int record_size = fortio_init_read(fortio);
   fortio_fseek(fortio , (offset_type) record_size , SEEK_CUR);
@@ -569,12 +700,16 @@ int fortio_fskip_record(fortio_type *fortio) {
   return record_size;
 }
 
-void fortio_fskip_buffer(fortio_type * fortio, int buffer_size) {
-  int bytes_skipped = 0;
-  while (bytes_skipped < buffer_size)
-    bytes_skipped += fortio_fskip_record(fortio);
+void fortio_fskip_buffer(fortio_type * fortio, size_t buffer_size) {
+  size_t bytes_skipped = 0;
+  while (bytes_skipped < buffer_size) {
+    int record_size = fortio_fskip_record(fortio);
+    if (record_size < 0)
+      break;
+    bytes_skipped += record_size;
+  }
 
-  if (bytes_skipped > buffer_size)
+  if (bytes_skipped != buffer_size)
     util_abort("%s: hmmmm - something is broken. The individual records in %s did not sum up to the expected buffer size \n",__func__ , fortio->filename);
 }
 
@@ -628,6 +763,13 @@ void fortio_complete_write(fortio_type *fortio , int record_size) {
 }
 
 
+/**
+   The size of a Fortran record is stored as a 32 bit integer in the
+   file, hence the int @record_size; larger amounts of data must be
+   written as several records, like ecl_kw_fwrite() does with blocks
+   of 1000 elements.
+*/
+
 void fortio_fwrite_record(fortio_type *fortio, const char *buffer , int record_size) {
   fortio_init_write(fortio , record_size);
   util_fwrite( buffer , 1 , record_size , fortio->stream , __func__);
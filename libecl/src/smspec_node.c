@@ -49,6 +49,18 @@
 
 #define SMSPEC_TYPE_ID 61550451
 
+/*
+  The ECLIPSE standard limits the keyword, unit and well/group names
+  to eight characters, everything beyond that is silently dropped. These
+  strings, and the ijk triplets, are therefore stored inline in the
+  smspec_node struct, and the pointer members point into the inline
+  storage or are NULL. Loading a large SMSPEC file then only requires
+  heap allocations for the node itself and the composite gen_key
+  strings.
+*/
+
+#define SMSPEC_STRING_LENGTH 8
+
 
 struct smspec_node_struct {
   UTIL_TYPE_ID_DECLARATION;
@@ -70,9 +82,35 @@ struct smspec_node_struct {
   bool                   historical;         /* Does the name end with 'H'? */
   int                    params_index;       /* The index of this variable (applies to all the vectors - in particular the PARAMS vectors of the summary files *.Snnnn / *.UNSMRY ). */
   float                  default_value;      /* Default value for this variable. */
+
+  /*------------------------------------------- Inline storage for the wgname, keyword, unit, ijk and lgr_ijk pointers above. */
+
+  char                   wgname_buffer[SMSPEC_STRING_LENGTH + 1];
+  char                   keyword_buffer[SMSPEC_STRING_LENGTH + 1];
+  char                   unit_buffer[SMSPEC_STRING_LENGTH + 1];
+  int                    ijk_buffer[3];
+  int                    lgr_ijk_buffer[3];
 };
 
 
+/*
+  Copies at most SMSPEC_STRING_LENGTH characters of @src into
+  @buffer. Returns @buffer, or NULL if @src is NULL.
+*/
+
+static char * smspec_node_copy_string( char * buffer , const char * src) {
+  if (src == NULL)
+    return NULL;
+
+  if (src != buffer) {
+    strncpy( buffer , src , SMSPEC_STRING_LENGTH );
+    buffer[SMSPEC_STRING_LENGTH] = '\0';
+  }
+  return buffer;
+}
+
+
+
 static bool string_equal(const char * s1 , const char * s2)
 {
   if ((s1 == NULL) && (s2 == NULL))
@@ -112,90 +150,120 @@ bool smspec_node_equal( const smspec_node_type * node1,  const smspec_node_type
   ecl_sum combined key like 'WWCT:OPX' as input.
 */
 
-#define ECL_SUM_KEYFMT_AQUIFER                "%s%s%d"
-#define ECL_SUM_KEYFMT_BLOCK_IJK              "%s%s%d,%d,%d"
-#define ECL_SUM_KEYFMT_BLOCK_NUM              "%s%s%d"
-#define ECL_SUM_KEYFMT_LOCAL_BLOCK            "%s%s%s%s%d,%d,%d"
-#define ECL_SUM_KEYFMT_COMPLETION_IJK         "%s%s%s%s%d,%d,%d"
-#define ECL_SUM_KEYFMT_COMPLETION_NUM         "%s%s%s%s%d"
-#define ECL_SUM_KEYFMT_LOCAL_COMPLETION       "%s%s%s%s%s%s%d,%d,%d"
-#define ECL_SUM_KEYFMT_GROUP                  "%s%s%s"
-#define ECL_SUM_KEYFMT_WELL                   "%s%s%s"
-#define ECL_SUM_KEYFMT_REGION                 "%s%s%d"
-#define ECL_SUM_KEYFMT_REGION_2_REGION_R1R2   "%s%s%d-%d"
-#define ECL_SUM_KEYFMT_REGION_2_REGION_NUM    "%s%s%d"
-#define ECL_SUM_KEYFMT_SEGMENT                "%s%s%s%s%d"
-#define ECL_SUM_KEYFMT_LOCAL_WELL             "%s%s%s%s%s"
-
 UTIL_SAFE_CAST_FUNCTION( smspec_node , SMSPEC_TYPE_ID )
 
 
+/*
+  The composite keys are assembled by hand instead of with
+  util_alloc_sprintf(); when loading a large SMSPEC file the printf()
+  machinery was the dominating cost. The key consists of the
+  @num_strings strings joined with @join_string, and then - if
+  @num_ints > 0 - the integers separated with @int_sep as the last
+  component, i.e. the same as the old format strings:
+
+     "%s%s%d"             ->  keyword , num
+     "%s%s%s%s%d,%d,%d"   ->  keyword , wgname , i,j,k
+     "%s%s%d-%d"          ->  keyword , r1,r2
+
+  A NULL string is written as "(null)" - as printf() would do.
+*/
+
+static int smspec_key_append_string( char * key , int offset , const char * s) {
+  int length = strlen( s );
+  memcpy( &key[offset] , s , length );
+  return offset + length;
+}
+
+
+static int smspec_key_append_int( char * key , int offset , int value) {
+  char digits[16];
+  int num_digits = 0;
+  unsigned int uvalue = (value < 0) ? -(unsigned int) value : (unsigned int) value;
+
+  do {
+    digits[num_digits++] = '0' + uvalue % 10;
+    uvalue /= 10;
+  } while (uvalue > 0);
+
+  if (value < 0)
+    key[offset++] = '-';
+
+  while (num_digits > 0)
+    key[offset++] = digits[--num_digits];
+
+  return offset;
+}
+
+
+static char * smspec_alloc_key( const char * join_string , int num_strings , const char ** strings , int num_ints , const int * ints , char int_sep) {
+  const int join_length = strlen( join_string );
+  int length = 0;
+  char * key;
+
+  for (int i = 0; i < num_strings; i++)
+    length += join_length + ((strings[i] == NULL) ? 6 : strlen( strings[i] ));
+  length += join_length + num_ints * 12;
+
+  key = util_malloc( length + 1 );
+  {
+    int offset = 0;
+    for (int i = 0; i < num_strings; i++) {
+      if (i > 0)
+        offset = smspec_key_append_string( key , offset , join_string );
+      offset = smspec_key_append_string( key , offset , (strings[i] == NULL) ? "(null)" : strings[i] );
+    }
+
+    if (num_ints > 0) {
+      offset = smspec_key_append_string( key , offset , join_string );
+      for (int i = 0; i < num_ints; i++) {
+        if (i > 0)
+          key[offset++] = int_sep;
+        offset = smspec_key_append_int( key , offset , ints[i] );
+      }
+    }
+    key[offset] = '\0';
+  }
+  return key;
+}
+
+
 char * smspec_alloc_block_num_key( const char * join_string , const char * keyword , int num) {
-  return util_alloc_sprintf(ECL_SUM_KEYFMT_BLOCK_NUM,
-                            keyword ,
-                            join_string ,
-                            num );
+  return smspec_alloc_key( join_string , 1 , (const char *[]) { keyword } , 1 , &num , ',');
 }
 
 char * smspec_alloc_aquifer_key( const char * join_string , const char * keyword , int num) {
-  return util_alloc_sprintf(ECL_SUM_KEYFMT_AQUIFER,
-                            keyword ,
-                            join_string ,
-                            num );
+  return smspec_alloc_key( join_string , 1 , (const char *[]) { keyword } , 1 , &num , ',');
 }
 
 
 char * smspec_alloc_local_block_key( const char * join_string , const char * keyword , const char * lgr_name , int i , int j , int k) {
-  return util_alloc_sprintf(ECL_SUM_KEYFMT_LOCAL_BLOCK ,
-                            keyword ,
-                            join_string ,
-                            lgr_name ,
-                            join_string ,
-                            i,j,k);
+  return smspec_alloc_key( join_string , 2 , (const char *[]) { keyword , lgr_name } , 3 , (const int []) { i , j , k } , ',');
 }
 
 
 char * smspec_alloc_region_key( const char * join_string , const char * keyword , int num) {
-  return util_alloc_sprintf(ECL_SUM_KEYFMT_REGION ,
-                            keyword ,
-                            join_string ,
-                            num );
+  return smspec_alloc_key( join_string , 1 , (const char *[]) { keyword } , 1 , &num , ',');
 }
 
 char * smspec_alloc_region_2_region_r1r2_key( const char * join_string , const char * keyword , int r1, int r2) {
-  return util_alloc_sprintf(ECL_SUM_KEYFMT_REGION_2_REGION_R1R2,
-                            keyword,
-                            join_string,
-                            r1,
-                            r2);
+  return smspec_alloc_key( join_string , 1 , (const char *[]) { keyword } , 2 , (const int []) { r1 , r2 } , '-');
 }
 
 char * smspec_alloc_region_2_region_num_key( const char * join_string , const char * keyword , int num) {
-  return util_alloc_sprintf(ECL_SUM_KEYFMT_REGION_2_REGION_NUM,
-                            keyword ,
-                            join_string ,
-                            num);
+  return smspec_alloc_key( join_string , 1 , (const char *[]) { keyword } , 1 , &num , ',');
 }
 
 
 
 char * smspec_alloc_block_ijk_key( const char * join_string , const char * keyword , int i , int j , int k) {
-  return util_alloc_sprintf(ECL_SUM_KEYFMT_BLOCK_IJK ,
-                            keyword,
-                            join_string ,
-                            i,j,k);
+  return smspec_alloc_key( join_string , 1 , (const char *[]) { keyword } , 3 , (const int []) { i , j , k } , ',');
 }
 
 
 
 char * smspec_alloc_completion_ijk_key( const char * join_string , const char * keyword, const char * wgname , int i , int j , int k) {
   if (wgname != NULL)
-    return util_alloc_sprintf( ECL_SUM_KEYFMT_COMPLETION_IJK ,
-                               keyword ,
-                               join_string ,
-                               wgname ,
-                               join_string ,
-                               i , j , k );
+    return smspec_alloc_key( join_string , 2 , (const char *[]) { keyword , wgname } , 3 , (const int []) { i , j , k } , ',');
   else
     return NULL;
 }
@@ -204,12 +272,7 @@ char * smspec_alloc_completion_ijk_key( const char * join_string , const char *
 
 char * smspec_alloc_completion_num_key( const char * join_string , const char * keyword, const char * wgname , int num) {
   if (wgname != NULL)
-    return util_alloc_sprintf(ECL_SUM_KEYFMT_COMPLETION_NUM,
-                              keyword ,
-                              join_string ,
-                              wgname ,
-                              join_string ,
-                              num );
+    return smspec_alloc_key( join_string , 2 , (const char *[]) { keyword , wgname } , 1 , &num , ',');
   else
     return NULL;
 }
@@ -223,10 +286,7 @@ char * smspec_alloc_completion_num_key( const char * join_string , const char *
 
 static char * smspec_alloc_wgname_key( const char * join_string , const char * keyword , const char * wgname) {
   if (wgname != NULL)
-    return util_alloc_sprintf(ECL_SUM_KEYFMT_WELL,
-                              keyword ,
-                              join_string ,
-                              wgname );
+    return smspec_alloc_key( join_string , 2 , (const char *[]) { keyword , wgname } , 0 , NULL , ',');
   else
     return NULL;
 }
@@ -241,12 +301,7 @@ char * smspec_alloc_well_key( const char * join_string , const char * keyword ,
 
 char * smspec_alloc_segment_key( const char * join_string , const char * keyword , const char * wgname , int num) {
   if (wgname != NULL)
-    return util_alloc_sprintf(ECL_SUM_KEYFMT_SEGMENT ,
-                              keyword ,
-                              join_string ,
-                              wgname ,
-                              join_string ,
-                              num );
+    return smspec_alloc_key( join_string , 2 , (const char *[]) { keyword , wgname } , 1 , &num , ',');
   else
     return NULL;
 }
@@ -254,26 +309,14 @@ char * smspec_alloc_segment_key( const char * join_string , const char * keyword
 
 char * smspec_alloc_local_well_key( const char * join_string , const char * keyword , const char * lgr_name , const char * wgname) {
   if (wgname != NULL)
-    return util_alloc_sprintf( ECL_SUM_KEYFMT_LOCAL_WELL ,
-                               keyword ,
-                               join_string ,
-                               lgr_name ,
-                               join_string ,
-                               wgname);
+    return smspec_alloc_key( join_string , 3 , (const char *[]) { keyword , lgr_name , wgname } , 0 , NULL , ',');
   else
     return NULL;
 }
 
 char * smspec_alloc_local_completion_key( const char * join_string, const char * keyword , const char * lgr_name , const char * wgname , int i , int j , int k) {
   if (wgname != NULL)
-    return util_alloc_sprintf(ECL_SUM_KEYFMT_LOCAL_COMPLETION ,
-                              keyword  ,
-                              join_string ,
-                              lgr_name ,
-                              join_string ,
-                              wgname ,
-                              join_string ,
-                              i,j,k);
+    return smspec_alloc_key( join_string , 3 , (const char *[]) { keyword , lgr_name , wgname } , 3 , (const int []) { i , j , k } , ',');
   else
     return NULL;
 }
@@ -285,7 +328,7 @@ static void smspec_node_set_keyword( smspec_node_type * smspec_node , const char
   // This function can __ONLY__ be called on time; run-time chaning of keyword is not
   // allowed.
   if (smspec_node->keyword == NULL)
-    smspec_node->keyword = util_alloc_substring_copy( keyword , 0 , 8);
+    smspec_node->keyword = smspec_node_copy_string( smspec_node->keyword_buffer , keyword );
   else
     util_abort("%s: fatal error - attempt to change keyword runtime detected - aborting\n",__func__);
 }
@@ -413,15 +456,7 @@ smspec_node_type * smspec_node_alloc_new(int params_index, float default_value)
 */
 
 static void smspec_node_set_wgname( smspec_node_type * index , const char * wgname ) {
-  if (wgname == NULL) {
-    util_safe_free( index->wgname );
-    index->wgname = NULL;
-  } else {
-    if (strlen(wgname) > 8)
-      index->wgname = util_realloc_substring_copy(index->wgname , wgname , 8);
-    else
-      index->wgname = util_realloc_string_copy(index->wgname , wgname );
-  }
+  index->wgname = smspec_node_copy_string( index->wgname_buffer , wgname );
 }
 
 
@@ -432,8 +467,7 @@ static void smspec_node_set_lgr_name( smspec_node_type * index , const char * lg
 
 
 static void smspec_node_set_lgr_ijk( smspec_node_type * index , int lgr_i , int lgr_j , int lgr_k) {
-  if (index->lgr_ijk == NULL)
-    index->lgr_ijk = util_calloc( 3 , sizeof * index->lgr_ijk );
+  index->lgr_ijk = index->lgr_ijk_buffer;
 
   index->lgr_ijk[0] = lgr_i;
   index->lgr_ijk[1] = lgr_j;
@@ -448,7 +482,7 @@ static void smspec_node_set_num( smspec_node_type * index , const int grid_dims[
   index->num = num;
   if ((index->var_type == ECL_SMSPEC_COMPLETION_VAR) || (index->var_type == ECL_SMSPEC_BLOCK_VAR)) {
     int global_index = num - 1;
-    index->ijk = util_calloc( 3 , sizeof * index->ijk );
+    index->ijk = index->ijk_buffer;
 
     index->ijk[2] = global_index / ( grid_dims[0] * grid_dims[1] );   global_index -= index->ijk[2] * (grid_dims[0] * grid_dims[1]);
     index->ijk[1] = global_index /  grid_dims[0] ;                    global_index -= index->ijk[1] * grid_dims[0];
@@ -806,46 +840,35 @@ smspec_node_type* smspec_node_alloc_copy( const smspec_node_type* node ) {
 
   {
     smspec_node_type* copy = util_malloc( sizeof * copy );
-    UTIL_TYPE_ID_INIT( copy, SMSPEC_TYPE_ID );
+    memcpy( copy , node , sizeof * copy );
+
     copy->gen_key1 = util_alloc_string_copy( node->gen_key1 );
     copy->gen_key2 = util_alloc_string_copy( node->gen_key2 );
-    copy->var_type = node->var_type;
-    copy->wgname = util_alloc_string_copy( node->wgname );
-    copy->keyword = util_alloc_string_copy( node->keyword );
-    copy->unit = util_alloc_string_copy( node->unit );
-    copy->num = node->num;
-
-    copy->ijk = NULL;
-    if( node->ijk ) {
-        copy->ijk = util_calloc( 3 , sizeof * node->ijk );
-        memcpy( copy->ijk, node->ijk, 3 * sizeof( * node->ijk ) );
-    }
-
     copy->lgr_name = util_alloc_string_copy( node->lgr_name );
-    copy->lgr_ijk = NULL;
-    if( node->lgr_ijk ) {
-        copy->lgr_ijk = util_calloc( 3 , sizeof * node->lgr_ijk );
-        memcpy( copy->lgr_ijk, node->lgr_ijk, 3 * sizeof( * node->lgr_ijk ) );
-    }
 
-    copy->rate_variable = node->rate_variable;
-    copy->total_variable = node->total_variable;
-    copy->historical = node->historical;
-    copy->params_index = node->params_index;
-    copy->default_value = node->default_value;
+    if (node->wgname)
+      copy->wgname = copy->wgname_buffer;
+
+    if (node->keyword)
+      copy->keyword = copy->keyword_buffer;
+
+    if (node->unit)
+      copy->unit = copy->unit_buffer;
+
+    if (node->ijk)
+      copy->ijk = copy->ijk_buffer;
+
+    if (node->lgr_ijk)
+      copy->lgr_ijk = copy->lgr_ijk_buffer;
+
     return copy;
   }
 }
 
 void smspec_node_free( smspec_node_type * index ) {
-  util_safe_free( index->unit );
-  util_safe_free( index->keyword );
-  util_safe_free( index->ijk );
   util_safe_free( index->gen_key1 );
   util_safe_free( index->gen_key2 );
-  util_safe_free( index->wgname );
   util_safe_free( index->lgr_name );
-  util_safe_free( index->lgr_ijk );
   free( index );
 }
 
@@ -915,8 +938,7 @@ const char  * smspec_node_get_unit( const smspec_node_type * smspec_node) {
 
 void smspec_node_set_unit( smspec_node_type * smspec_node , const char * unit ) {
   // ECLIPSE Standard: Max eight characters - everything beyond is silently dropped
-  util_safe_free( smspec_node->unit );
-  smspec_node->unit = util_alloc_substring_copy( unit , 0 , 8);
+  smspec_node->unit = smspec_node_copy_string( smspec_node->unit_buffer , unit );
 }
 
 
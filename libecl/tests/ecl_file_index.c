@@ -0,0 +1,231 @@
+/*
+   Copyright (C) 2017  Statoil ASA, Norway.
+
+   The file 'ecl_file_index.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include <ert/util/test_util.h>
+#include <ert/util/util.h>
+#include <ert/util/test_work_area.h>
+
+#include <ert/ecl/ecl_kw.h>
+#include <ert/ecl/ecl_file.h>
+#include <ert/ecl/ecl_endian_flip.h>
+
+
+void write_step(fortio_type * fortio , int step) {
+  ecl_kw_type * seqnum_kw = ecl_kw_alloc( "SEQNUM" , 1 , ECL_INT );
+  ecl_kw_type * data_kw = ecl_kw_alloc( "PRESSURE" , 1500 , ECL_FLOAT );
+  ecl_kw_type * name_kw = ecl_kw_alloc( "NAMES" , 3 , ECL_CHAR );
+
+  ecl_kw_iset_int( seqnum_kw , 0 , step );
+  ecl_kw_scalar_set_float( data_kw , step * 1.0 );
+  ecl_kw_iset_char_ptr( name_kw , 0 , "OP_1" );
+  ecl_kw_iset_char_ptr( name_kw , 1 , "OP_2" );
+  ecl_kw_iset_char_ptr( name_kw , 2 , "WI_1" );
+
+  ecl_kw_fwrite( seqnum_kw , fortio );
+  ecl_kw_fwrite( data_kw , fortio );
+  ecl_kw_fwrite( name_kw , fortio );
+
+  ecl_kw_free( seqnum_kw );
+  ecl_kw_free( data_kw );
+  ecl_kw_free( name_kw );
+}
+
+
+void write_file( const char * filename , int steps , bool append) {
+  fortio_type * fortio;
+  int step;
+  int first_step = 0;
+
+  if (append) {
+    ecl_file_type * ecl_file = ecl_file_open( filename , 0 );
+    first_step = ecl_file_get_num_named_kw( ecl_file , "SEQNUM" );
+    ecl_file_close( ecl_file );
+    fortio = fortio_open_append( filename , false , ECL_ENDIAN_FLIP );
+  } else
+    fortio = fortio_open_writer( filename , false , ECL_ENDIAN_FLIP );
+
+  for (step = first_step; step < first_step + steps; step++)
+    write_step( fortio , step );
+
+  fortio_fclose( fortio );
+}
+
+
+void assert_equal_index( const ecl_file_type * file1 , const ecl_file_type * file2 ) {
+  int i;
+  test_assert_int_equal( ecl_file_get_size( file1 ) , ecl_file_get_size( file2 ));
+  for (i=0; i < ecl_file_get_size( file1 ); i++) {
+    ecl_file_kw_type * file_kw1 = ecl_file_iget_file_kw( file1 , i );
+    ecl_file_kw_type * file_kw2 = ecl_file_iget_file_kw( file2 , i );
+
+    test_assert_string_equal( ecl_file_kw_get_header( file_kw1 ) , ecl_file_kw_get_header( file_kw2 ));
+    test_assert_int_equal( ecl_file_kw_get_size( file_kw1 ) , ecl_file_kw_get_size( file_kw2 ));
+    test_assert_true( ecl_file_kw_get_offset( file_kw1 ) == ecl_file_kw_get_offset( file_kw2 ));
+    test_assert_true( ecl_kw_equal( ecl_file_iget_kw( file1 , i ) , ecl_file_iget_kw( file2 , i )));
+  }
+}
+
+
+void test_write_read() {
+  write_file( "CASE.UNRST" , 5 , false );
+  {
+    ecl_file_type * ecl_file = ecl_file_open( "CASE.UNRST" , 0 );
+    test_assert_false( ecl_file_index_valid( "CASE.UNRST" , "CASE.index" ));
+    test_assert_true( ecl_file_write_index( ecl_file , "CASE.index" ));
+    test_assert_true( ecl_file_index_valid( "CASE.UNRST" , "CASE.index" ));
+    {
+      ecl_file_type * fast_file = ecl_file_fast_open( "CASE.UNRST" , "CASE.index" , 0 );
+      assert_equal_index( ecl_file , fast_file );
+      ecl_file_close( fast_file );
+    }
+    ecl_file_close( ecl_file );
+  }
+}
+
+
+void test_append() {
+  write_file( "CASE.UNRST" , 3 , true );
+  test_assert_false( ecl_file_index_valid( "CASE.UNRST" , "CASE.index" ));
+  {
+    ecl_file_type * ecl_file = ecl_file_open( "CASE.UNRST" , 0 );
+    ecl_file_type * fast_file = ecl_file_fast_open( "CASE.UNRST" , "CASE.index" , 0 );
+    test_assert_int_equal( ecl_file_get_num_named_kw( fast_file , "SEQNUM" ) , 8 );
+    assert_equal_index( ecl_file , fast_file );
+    ecl_file_close( fast_file );
+    ecl_file_close( ecl_file );
+  }
+}
+
+
+void test_invalid() {
+  {
+    FILE * stream = util_fopen( "CASE.index" , "w");
+    fprintf(stream , "Not an index file\n");
+    fclose( stream );
+  }
+  test_assert_false( ecl_file_index_valid( "CASE.UNRST" , "CASE.index" ));
+  {
+    ecl_file_type * ecl_file = ecl_file_open( "CASE.UNRST" , 0 );
+    ecl_file_type * fast_file = ecl_file_fast_open( "CASE.UNRST" , "CASE.index" , 0 );
+    assert_equal_index( ecl_file , fast_file );
+    ecl_file_close( fast_file );
+    ecl_file_close( ecl_file );
+  }
+
+  /* Index from a different and larger file. */
+  write_file( "LARGE.UNRST" , 20 , false );
+  {
+    ecl_file_type * ecl_file = ecl_file_open( "LARGE.UNRST" , 0 );
+    ecl_file_write_index( ecl_file , "CASE.index" );
+    ecl_file_close( ecl_file );
+  }
+  {
+    ecl_file_type * ecl_file = ecl_file_open( "CASE.UNRST" , 0 );
+    ecl_file_type * fast_file = ecl_file_fast_open( "CASE.UNRST" , "CASE.index" , 0 );
+    assert_equal_index( ecl_file , fast_file );
+    ecl_file_close( fast_file );
+    ecl_file_close( ecl_file );
+  }
+}
+
+
+/*
+  An index entry with an unknown type name, and an index which does
+  not match the start of a file which has grown, should both lead to a
+  full scan of the file.
+*/
+
+void test_corrupt() {
+  write_file( "CORRUPT.UNRST" , 3 , false );
+  {
+    ecl_file_type * ecl_file = ecl_file_open( "CORRUPT.UNRST" , 0 );
+    test_assert_true( ecl_file_write_index( ecl_file , "CORRUPT.index" ));
+    ecl_file_close( ecl_file );
+  }
+  {
+    long type_offset = strlen("ECLINDEX") + sizeof(int) + sizeof(offset_type) + sizeof(time_t) + sizeof(int) + 8 + sizeof(int);
+    FILE * stream = util_fopen( "CORRUPT.index" , "r+");
+    fseek( stream , type_offset , SEEK_SET );
+    fwrite( "XXXX" , 1 , 4 , stream );
+    fclose( stream );
+  }
+  {
+    ecl_file_type * ecl_file = ecl_file_open( "CORRUPT.UNRST" , 0 );
+    ecl_file_type * fast_file = ecl_file_fast_open( "CORRUPT.UNRST" , "CORRUPT.index" , 0 );
+    assert_equal_index( ecl_file , fast_file );
+    ecl_file_close( fast_file );
+    ecl_file_close( ecl_file );
+  }
+
+  write_file( "CORRUPT.UNRST" , 3 , false );
+  {
+    ecl_file_type * ecl_file = ecl_file_open( "CORRUPT.UNRST" , 0 );
+    test_assert_true( ecl_file_write_index( ecl_file , "CORRUPT.index" ));
+    ecl_file_close( ecl_file );
+  }
+  {
+    fortio_type * fortio = fortio_open_writer( "CORRUPT.UNRST" , false , ECL_ENDIAN_FLIP );
+    ecl_kw_type * extra_kw = ecl_kw_alloc( "EXTRA" , 10 , ECL_INT );
+    int step;
+    ecl_kw_scalar_set_int( extra_kw , 0 );
+    ecl_kw_fwrite( extra_kw , fortio );
+    for (step = 0; step < 4; step++)
+      write_step( fortio , step );
+    ecl_kw_free( extra_kw );
+    fortio_fclose( fortio );
+  }
+  {
+    ecl_file_type * ecl_file = ecl_file_open( "CORRUPT.UNRST" , 0 );
+    ecl_file_type * fast_file = ecl_file_fast_open( "CORRUPT.UNRST" , "CORRUPT.index" , 0 );
+    test_assert_int_equal( ecl_file_get_num_named_kw( fast_file , "EXTRA" ) , 1 );
+    assert_equal_index( ecl_file , fast_file );
+    ecl_file_close( fast_file );
+    ecl_file_close( ecl_file );
+  }
+}
+
+
+void test_flag() {
+  char * index_file = ecl_file_alloc_index_filename( "CASE.UNRST" );
+  ecl_file_type * ecl_file = ecl_file_open( "CASE.UNRST" , ECL_FILE_INDEX );
+  test_assert_true( ecl_file_index_valid( "CASE.UNRST" , index_file ));
+  {
+    ecl_file_type * ecl_file2 = ecl_file_open( "CASE.UNRST" , ECL_FILE_INDEX );
+    assert_equal_index( ecl_file , ecl_file2 );
+    ecl_file_close( ecl_file2 );
+  }
+  ecl_file_close( ecl_file );
+  free( index_file );
+}
+
+
+int main(int argc , char ** argv) {
+  test_work_area_type * work_area = test_work_area_alloc("ecl_file_index");
+
+  test_write_read();
+  test_append();
+  test_invalid();
+  test_corrupt();
+  test_flag();
+
+  test_work_area_free( work_area );
+  exit(0);
+}
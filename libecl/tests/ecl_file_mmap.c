@@ -0,0 +1,175 @@
+/*
+   Copyright (C) 2017  Statoil ASA, Norway.
+
+   The file 'ecl_file_mmap.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+#include <stdlib.h>
+#include <stdbool.h>
+#include <unistd.h>
+
+#include <ert/util/test_util.h>
+#include <ert/util/util.h>
+#include <ert/util/test_work_area.h>
+
+#include <ert/ecl/ecl_kw.h>
+#include <ert/ecl/ecl_file.h>
+#include <ert/ecl/ecl_endian_flip.h>
+
+
+void create_file(const char * filename) {
+  fortio_type * fortio = fortio_open_writer( filename , false , ECL_ENDIAN_FLIP );
+  {
+    ecl_kw_type * int_kw = ecl_kw_alloc( "INT" , 100 , ECL_INT );
+    ecl_kw_type * float_kw = ecl_kw_alloc( "FLOAT" , 2500 , ECL_FLOAT );
+    ecl_kw_type * double_kw = ecl_kw_alloc( "DOUBLE" , 7 , ECL_DOUBLE );
+    ecl_kw_type * bool_kw = ecl_kw_alloc( "BOOL" , 11 , ECL_BOOL );
+    ecl_kw_type * char_kw = ecl_kw_alloc( "CHAR" , 250 , ECL_CHAR );
+    ecl_kw_type * empty_kw = ecl_kw_alloc( "EMPTY" , 0 , ECL_INT );
+    int i;
+
+    for (i=0; i < ecl_kw_get_size( int_kw ); i++)
+      ecl_kw_iset_int( int_kw , i , i );
+
+    for (i=0; i < ecl_kw_get_size( float_kw ); i++)
+      ecl_kw_iset_float( float_kw , i , i * 0.25 );
+
+    for (i=0; i < ecl_kw_get_size( double_kw ); i++)
+      ecl_kw_iset_double( double_kw , i , i * 1.5 );
+
+    for (i=0; i < ecl_kw_get_size( bool_kw ); i++)
+      ecl_kw_iset_bool( bool_kw , i , (i % 2) == 0 );
+
+    for (i=0; i < ecl_kw_get_size( char_kw ); i++) {
+      char * s = util_alloc_sprintf("S%d" , i);
+      ecl_kw_iset_char_ptr( char_kw , i , s );
+      free( s );
+    }
+
+    ecl_kw_fwrite( int_kw , fortio );
+    ecl_kw_fwrite( float_kw , fortio );
+    ecl_kw_fwrite( double_kw , fortio );
+    ecl_kw_fwrite( bool_kw , fortio );
+    ecl_kw_fwrite( char_kw , fortio );
+    ecl_kw_fwrite( empty_kw , fortio );
+    ecl_kw_fwrite( int_kw , fortio );
+
+    ecl_kw_free( int_kw );
+    ecl_kw_free( float_kw );
+    ecl_kw_free( double_kw );
+    ecl_kw_free( bool_kw );
+    ecl_kw_free( char_kw );
+    ecl_kw_free( empty_kw );
+  }
+  fortio_fclose( fortio );
+}
+
+
+void test_equal(const char * filename , int flags) {
+  ecl_file_type * ecl_file = ecl_file_open( filename , 0 );
+  ecl_file_type * mmap_file = ecl_file_open( filename , flags );
+  int i;
+
+  test_assert_int_equal( ecl_file_get_size( ecl_file ) , ecl_file_get_size( mmap_file ));
+  for (i=0; i < ecl_file_get_size( ecl_file ); i++) {
+    ecl_kw_type * kw1 = ecl_file_iget_kw( ecl_file , i );
+    ecl_kw_type * kw2 = ecl_file_iget_kw( mmap_file , i );
+
+    test_assert_true( ecl_kw_equal( kw1 , kw2 ));
+    /* Loading a second time should return the same instance. */
+    test_assert_ptr_equal( kw2 , ecl_file_iget_kw( mmap_file , i ));
+  }
+
+  ecl_file_close( ecl_file );
+  ecl_file_close( mmap_file );
+}
+
+
+void test_detach(const char * filename) {
+  ecl_file_type * mmap_file = ecl_file_open( filename , ECL_FILE_MMAP );
+  ecl_kw_type * int_kw = ecl_file_iget_named_kw( mmap_file , "INT" , 0 );
+  ecl_kw_type * float_kw = ecl_file_iget_named_kw( mmap_file , "FLOAT" , 0 );
+
+  ecl_file_fortio_detach( mmap_file );
+  test_assert_int_equal( ecl_kw_iget_int( int_kw , 99 ) , 99 );
+  test_assert_float_equal( ecl_kw_iget_float( float_kw , 2499 ) , 2499 * 0.25 );
+
+  ecl_kw_iset_int( int_kw , 0 , 77 );
+  ecl_file_close( mmap_file );
+
+  {
+    ecl_file_type * ecl_file = ecl_file_open( filename , 0 );
+    test_assert_int_equal( ecl_kw_iget_int( ecl_file_iget_named_kw( ecl_file , "INT" , 0 ) , 0) , 0 );
+    ecl_file_close( ecl_file );
+  }
+}
+
+
+void test_unlink(const char * filename) {
+  util_copy_file( filename , "COPY.INIT" );
+  {
+    ecl_file_type * mmap_file = ecl_file_open( "COPY.INIT" , ECL_FILE_MMAP | ECL_FILE_CLOSE_STREAM );
+    unlink( "COPY.INIT" );
+    test_assert_true( ecl_file_load_all( mmap_file ));
+    test_assert_int_equal( ecl_kw_iget_int( ecl_file_iget_named_kw( mmap_file , "INT" , 1 ) , 50) , 50 );
+    ecl_file_close( mmap_file );
+  }
+}
+
+
+/*
+  The keyword header is parsed from the mapping, i.e. an offset which
+  does not point to a keyword header is rejected instead of silently
+  loading data with the wrong name, type or size.
+*/
+
+void test_fread_alloc_mapped(const char * filename) {
+  fortio_type * fortio = fortio_open_reader( filename , false , ECL_ENDIAN_FLIP );
+  ecl_file_type * ecl_file = ecl_file_open( filename , 0 );
+  const ecl_kw_type * int_kw = ecl_file_iget_named_kw( ecl_file , "INT" , 0 );
+  const ecl_kw_type * float_kw = ecl_file_iget_named_kw( ecl_file , "FLOAT" , 0 );
+
+  test_assert_true( fortio_mmap( fortio ));
+  {
+    ecl_kw_type * kw = ecl_kw_fread_alloc_mapped( fortio , 0 );
+    test_assert_true( ecl_kw_equal( kw , int_kw ));
+    ecl_kw_free( kw );
+  }
+  {
+    ecl_kw_type * kw = ecl_kw_fread_alloc_mapped( fortio , ecl_kw_fortio_size( int_kw ));
+    test_assert_true( ecl_kw_equal( kw , float_kw ));
+    ecl_kw_free( kw );
+  }
+  test_assert_NULL( ecl_kw_fread_alloc_mapped( fortio , ECL_KW_HEADER_FORTIO_SIZE ));
+  test_assert_NULL( ecl_kw_fread_alloc_mapped( fortio , 4 ));
+  test_assert_NULL( ecl_kw_fread_alloc_mapped( fortio , util_file_size( filename ) + 100 ));
+
+  ecl_file_close( ecl_file );
+  fortio_fclose( fortio );
+}
+
+
+int main(int argc , char ** argv) {
+  test_work_area_type * work_area = test_work_area_alloc("ecl_file_mmap");
+  create_file( "ECLIPSE.INIT" );
+
+  test_equal( "ECLIPSE.INIT" , ECL_FILE_MMAP );
+  test_equal( "ECLIPSE.INIT" , ECL_FILE_MMAP | ECL_FILE_CLOSE_STREAM );
+  test_detach( "ECLIPSE.INIT" );
+  test_unlink( "ECLIPSE.INIT" );
+  test_fread_alloc_mapped( "ECLIPSE.INIT" );
+
+  test_work_area_free( work_area );
+  exit(0);
+}
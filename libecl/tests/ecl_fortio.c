@@ -275,6 +275,34 @@ void test_fseek() {
 }
 
 
+void test_fskip_buffer() {
+  test_work_area_type * work_area = test_work_area_alloc("fortio_fskip_buffer" );
+  {
+    fortio_type * fortio = fortio_open_writer("PRESSURE" , false , true);
+    void * buffer = util_malloc( 100 );
+
+    fortio_fwrite_record( fortio , buffer , 100);
+    fortio_fwrite_record( fortio , buffer , 100);
+    fortio_fwrite_record( fortio , buffer , 50);
+    fortio_fwrite_record( fortio , buffer , 10);
+    free( buffer );
+
+    fortio_fclose( fortio );
+  }
+  {
+    fortio_type * fortio = fortio_open_reader("PRESSURE" , false , true);
+
+    fortio_fskip_buffer( fortio , (size_t) 250 );
+    test_assert_int_equal( fortio_ftell( fortio ) , 3 * 8 + 250 );
+    test_assert_int_equal( fortio_fskip_record( fortio ) , 10 );
+    test_assert_true( fortio_read_at_eof( fortio ));
+
+    fortio_fclose( fortio );
+  }
+
+  test_work_area_free( work_area );
+}
+
 
 
 int main( int argc , char ** argv) {
@@ -295,6 +323,7 @@ int main( int argc , char ** argv) {
     test_fread_invalid_tail();
     test_fseek();
     test_at_eof();
+    test_fskip_buffer();
 
     test_write( "/tmp/path/does/not/exist" , false );
     {
@@ -0,0 +1,109 @@
+/*
+   Copyright (C) 2017  Statoil ASA, Norway.
+
+   The file 'ecl_grav_common_stations.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include <ert/util/test_util.h>
+#include <ert/util/util.h>
+#include <ert/util/int_vector.h>
+
+#include <ert/ecl/ecl_grid.h>
+#include <ert/ecl/ecl_region.h>
+#include <ert/ecl/ecl_grid_cache.h>
+#include <ert/ecl/ecl_grav_common.h>
+
+
+#define NUM_STATIONS 37
+
+void test_stations( const ecl_grid_cache_type * grid_cache , ecl_region_type * region , const bool * aquifer , const double * weight , int num_threads) {
+  double utm_x[NUM_STATIONS];
+  double utm_y[NUM_STATIONS];
+  double depth[NUM_STATIONS];
+  double biot_savart[NUM_STATIONS];
+  double geertsma[NUM_STATIONS];
+  int_vector_type * index_list = ecl_grav_common_alloc_index_list( grid_cache , region , aquifer );
+  int station;
+
+  for (station = 0; station < NUM_STATIONS; station++) {
+    utm_x[station] = -5 + 1.7 * station;
+    utm_y[station] = 40 - 1.3 * station;
+    depth[station] = (station % 3) * 0.5;
+  }
+
+  ecl_grav_common_eval_biot_savart_stations( grid_cache , index_list , weight , NUM_STATIONS , utm_x , utm_y , depth , num_threads , biot_savart );
+  ecl_grav_common_eval_geertsma_stations( grid_cache , index_list , weight , NUM_STATIONS , utm_x , utm_y , depth , 0.25 , 0.5 , num_threads , geertsma );
+
+  for (station = 0; station < NUM_STATIONS; station++) {
+    test_assert_double_equal( ecl_grav_common_eval_biot_savart( grid_cache , region , aquifer , weight , utm_x[station] , utm_y[station] , depth[station] ),
+                              biot_savart[station] );
+    test_assert_double_equal( ecl_grav_common_eval_geertsma( grid_cache , region , aquifer , weight , utm_x[station] , utm_y[station] , depth[station] , 0.25 , 0.5 ),
+                              geertsma[station] );
+  }
+
+  int_vector_free( index_list );
+}
+
+
+void test_index_list( const ecl_grid_cache_type * grid_cache , ecl_region_type * region , const bool * aquifer) {
+  int_vector_type * index_list = ecl_grav_common_alloc_index_list( grid_cache , NULL , aquifer );
+  int index;
+  int count = 0;
+
+  for (index = 0; index < ecl_grid_cache_get_size( grid_cache ); index++) {
+    if (!aquifer[index]) {
+      test_assert_int_equal( index , int_vector_iget( index_list , count ));
+      count++;
+    }
+  }
+  test_assert_int_equal( count , int_vector_size( index_list ));
+  int_vector_free( index_list );
+
+  index_list = ecl_grav_common_alloc_index_list( grid_cache , region , aquifer );
+  test_assert_true( int_vector_size( index_list ) < count );
+  int_vector_free( index_list );
+}
+
+
+int main( int argc , char ** argv) {
+  ecl_grid_type * grid = ecl_grid_alloc_rectangular( 20 , 15 , 10 , 1 , 2 , 1 , NULL );
+  ecl_grid_cache_type * grid_cache = ecl_grid_cache_alloc( grid );
+  ecl_region_type * region = ecl_region_alloc( grid , false );
+  const int size = ecl_grid_cache_get_size( grid_cache );
+  bool * aquifer = util_malloc( size * sizeof * aquifer );
+  double * weight = util_malloc( size * sizeof * weight );
+  int index;
+
+  for (index = 0; index < size; index++) {
+    aquifer[index] = ((index % 11) == 0);
+    weight[index] = 1 + (index % 7) - 0.25 * (index % 5);
+  }
+  ecl_region_select_k1k2( region , 2 , 6 );
+
+  test_index_list( grid_cache , region , aquifer );
+  test_stations( grid_cache , NULL , aquifer , weight , 1 );
+  test_stations( grid_cache , region , aquifer , weight , 1 );
+  test_stations( grid_cache , NULL , aquifer , weight , 4 );
+  test_stations( grid_cache , region , aquifer , weight , 4 );
+
+  free( weight );
+  free( aquifer );
+  ecl_region_free( region );
+  ecl_grid_cache_free( grid_cache );
+  ecl_grid_free( grid );
+  exit(0);
+}
@@ -0,0 +1,252 @@
+/*
+   Copyright (C) 2017  Statoil ASA, Norway.
+
+   The file 'ecl_grid_cache.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include <ert/util/test_util.h>
+#include <ert/util/test_work_area.h>
+#include <ert/util/util.h>
+#include <ert/util/stringlist.h>
+
+#include <ert/ecl/ecl_grid.h>
+#include <ert/ecl/nnc_info.h>
+
+
+void test_equal_grid( const ecl_grid_type * grid , const ecl_grid_type * cached_grid ) {
+  int lgr_index;
+  int g;
+
+  test_assert_true( ecl_grid_compare( grid , cached_grid , true , true , true ));
+  test_assert_int_equal( ecl_grid_get_num_lgr( grid ) , ecl_grid_get_num_lgr( cached_grid ));
+  test_assert_int_equal( ecl_grid_get_num_nnc( grid ) , ecl_grid_get_num_nnc( cached_grid ));
+
+  for (g = 0; g < ecl_grid_get_global_size( grid ); g++) {
+    test_assert_double_equal( ecl_grid_get_cell_volume1( grid , g ) , ecl_grid_get_cell_volume1( cached_grid , g ));
+    test_assert_int_equal( ecl_grid_get_active_index1( grid , g ) , ecl_grid_get_active_index1( cached_grid , g ));
+    {
+      const ecl_grid_type * cell_lgr = ecl_grid_get_cell_lgr1( grid , g );
+      const ecl_grid_type * cached_cell_lgr = ecl_grid_get_cell_lgr1( cached_grid , g );
+      if (cell_lgr)
+        test_assert_int_equal( ecl_grid_get_lgr_nr( cell_lgr ) , ecl_grid_get_lgr_nr( cached_cell_lgr ));
+      else
+        test_assert_NULL( cached_cell_lgr );
+    }
+  }
+
+  for (lgr_index = 0; lgr_index < ecl_grid_get_num_lgr( grid ); lgr_index++) {
+    const ecl_grid_type * lgr = ecl_grid_iget_lgr( grid , lgr_index );
+    const ecl_grid_type * cached_lgr = ecl_grid_iget_lgr( cached_grid , lgr_index );
+
+    test_assert_string_equal( ecl_grid_get_name( lgr ) , ecl_grid_get_name( cached_lgr ));
+    test_assert_int_equal( ecl_grid_get_lgr_nr( lgr ) , ecl_grid_get_lgr_nr( cached_lgr ));
+    test_assert_int_equal( ecl_grid_get_parent_cell1( lgr , 0 ) , ecl_grid_get_parent_cell1( cached_lgr , 0 ));
+  }
+}
+
+
+/*
+  The cached grids are always compact; when the cache is created from
+  a compact grid the corners are identical.
+*/
+
+void test_equal_corners( const ecl_grid_type * grid , const ecl_grid_type * cached_grid ) {
+  int g,c;
+  for (g = 0; g < ecl_grid_get_global_size( grid ); g++) {
+    for (c = 0; c < 8; c++) {
+      double x1,y1,z1;
+      double x2,y2,z2;
+      ecl_grid_get_cell_corner_xyz1( grid , g , c , &x1 , &y1 , &z1 );
+      ecl_grid_get_cell_corner_xyz1( cached_grid , g , c , &x2 , &y2 , &z2 );
+      test_assert_true( (x1 == x2) && (y1 == y2) && (z1 == z2) );
+    }
+  }
+}
+
+
+void test_case( const char * grid_file , const char * cache_file ) {
+  ecl_grid_type * grid = ecl_grid_load_case( grid_file );
+  ecl_grid_type * cached_grid;
+
+  test_assert_NULL( ecl_grid_fread_cache( cache_file , grid_file , false ));
+  test_assert_true( ecl_grid_fwrite_cache( grid , cache_file , grid_file ));
+
+  cached_grid = ecl_grid_fread_cache( cache_file , grid_file , false );
+  test_assert_not_NULL( cached_grid );
+  test_assert_true( ecl_grid_is_compact( cached_grid ));
+  test_equal_grid( grid , cached_grid );
+  ecl_grid_free( cached_grid );
+
+  cached_grid = ecl_grid_fread_cache( cache_file , grid_file , true );
+  test_assert_not_NULL( cached_grid );
+  ecl_grid_free( cached_grid );
+
+  {
+    ecl_grid_type * compact_grid = ecl_grid_alloc_compact( grid_file );
+    test_assert_true( ecl_grid_fwrite_cache( compact_grid , cache_file , grid_file ));
+    cached_grid = ecl_grid_load_case_cached( grid_file , cache_file );
+    test_equal_grid( grid , cached_grid );
+    test_equal_corners( compact_grid , cached_grid );
+
+    /* The copy does not share the cache data. */
+    {
+      ecl_grid_type * copy = ecl_grid_alloc_copy( cached_grid );
+      ecl_grid_free( cached_grid );
+      test_equal_corners( compact_grid , copy );
+      ecl_grid_free( copy );
+    }
+    ecl_grid_free( compact_grid );
+  }
+
+  ecl_grid_free( grid );
+}
+
+
+void test_truncated( const char * grid_file , const char * cache_file ) {
+  size_t size = util_file_size( cache_file );
+  char * buffer = util_malloc( size );
+  FILE * stream = util_fopen( cache_file , "r");
+
+  util_fread( buffer , 1 , size , stream , __func__ );
+  fclose( stream );
+
+  stream = util_fopen( cache_file , "w");
+  util_fwrite( buffer , 1 , size / 2 , stream , __func__ );
+  fclose( stream );
+
+  test_assert_NULL( ecl_grid_fread_cache( cache_file , grid_file , false ));
+  free( buffer );
+}
+
+
+void test_synthetic( ) {
+  test_work_area_type * work_area = test_work_area_alloc("ecl_grid_cache");
+  {
+    const int nx = 6;
+    const int ny = 5;
+    const int nz = 4;
+    double dxv[6] = {10 , 12 , 14 , 10 , 12 , 14};
+    double dyv[5] = {20 , 22 , 24 , 20 , 22};
+    double dzv[4] = {1.5 , 2.5 , 3.5 , 4.5};
+    int * actnum = util_malloc( nx*ny*nz * sizeof * actnum );
+    int g;
+    for (g = 0; g < nx*ny*nz; g++)
+      actnum[g] = (g % 7) ? 1 : 0;
+
+    {
+      ecl_grid_type * grid = ecl_grid_alloc_dxv_dyv_dzv( nx , ny , nz , dxv , dyv , dzv , actnum );
+      ecl_grid_add_self_nnc( grid , 0 , nx*ny*nz - 1 , 0 );
+      ecl_grid_add_self_nnc( grid , 5 , 17 , 1 );
+      ecl_grid_fwrite_EGRID2( grid , "CASE.EGRID" , ECL_METRIC_UNITS );
+      ecl_grid_free( grid );
+    }
+
+    test_case( "CASE.EGRID" , "CASE.EGRID.cache" );
+
+    /* The default cache file is created next to the grid file. */
+    {
+      ecl_grid_type * grid = ecl_grid_load_case_cached( "CASE" , NULL );
+      test_assert_true( util_file_exists( "CASE.EGRID.cache" ));
+      ecl_grid_free( grid );
+    }
+
+    /* When the grid file changes the cache is ignored, and rewritten. */
+    for (g = 0; g < nx*ny*nz; g++)
+      actnum[g] = (g % 5) ? 1 : 0;
+    {
+      ecl_grid_type * grid = ecl_grid_alloc_dxv_dyv_dzv( nx , ny , nz , dxv , dyv , dzv , actnum );
+      ecl_grid_fwrite_EGRID2( grid , "CASE.EGRID" , ECL_METRIC_UNITS );
+      test_assert_NULL( ecl_grid_fread_cache( "CASE.EGRID.cache" , "CASE.EGRID" , false ));
+      {
+        ecl_grid_type * cached_grid = ecl_grid_load_case_cached( "CASE.EGRID" , NULL );
+        test_assert_int_equal( ecl_grid_get_active_size( grid ) , ecl_grid_get_active_size( cached_grid ));
+        ecl_grid_free( cached_grid );
+      }
+      {
+        ecl_grid_type * cached_grid = ecl_grid_fread_cache( "CASE.EGRID.cache" , "CASE.EGRID" , true );
+        test_assert_not_NULL( cached_grid );
+        ecl_grid_free( cached_grid );
+      }
+      ecl_grid_free( grid );
+    }
+
+    /*
+      A change which does not alter the file size can happen within
+      the resolution of the modification time; that is only detected
+      by the checksum.
+    */
+    for (g = 0; g < nx*ny*nz; g++)
+      actnum[g] = (g % 3) ? 1 : 0;
+    {
+      ecl_grid_type * grid = ecl_grid_alloc_dxv_dyv_dzv( nx , ny , nz , dxv , dyv , dzv , actnum );
+      ecl_grid_fwrite_EGRID2( grid , "CASE.EGRID" , ECL_METRIC_UNITS );
+      test_assert_NULL( ecl_grid_fread_cache( "CASE.EGRID.cache" , "CASE.EGRID" , true ));
+      {
+        ecl_grid_type * cached_grid = ecl_grid_load_case_cached( "CASE.EGRID" , NULL );
+        test_assert_int_equal( ecl_grid_get_active_size( grid ) , ecl_grid_get_active_size( cached_grid ));
+        ecl_grid_free( cached_grid );
+      }
+      ecl_grid_free( grid );
+    }
+
+    /* The temporary file used while writing the cache is not left behind. */
+    {
+      ecl_grid_type * grid = ecl_grid_alloc_compact( "CASE.EGRID" );
+      stringlist_type * tmp_files = stringlist_alloc_new();
+      test_assert_true( ecl_grid_fwrite_cache( grid , "CASE.EGRID.cache" , "CASE.EGRID" ));
+      test_assert_true( ecl_grid_fwrite_cache( grid , "CASE.EGRID.cache" , "CASE.EGRID" ));
+      stringlist_select_matching_files( tmp_files , NULL , "*.tmp" );
+      test_assert_int_equal( 0 , stringlist_get_size( tmp_files ));
+      stringlist_free( tmp_files );
+      ecl_grid_free( grid );
+    }
+
+    /* Failure to write the cache is not an error, and leaves no files behind. */
+    {
+      ecl_grid_type * grid = ecl_grid_alloc_compact( "CASE.EGRID" );
+      test_assert_false( ecl_grid_fwrite_cache( grid , "DOES_NOT_EXIST/CASE.EGRID.cache" , "CASE.EGRID" ));
+      test_assert_false( ecl_grid_fwrite_cache( grid , "CASE.EGRID.cache" , "DOES_NOT_EXIST.EGRID" ));
+      test_assert_false( util_entry_exists( "DOES_NOT_EXIST" ));
+      test_assert_true( ecl_grid_fwrite_cache( grid , "CASE.EGRID.cache" , "CASE.EGRID" ));
+      ecl_grid_free( grid );
+    }
+
+    test_truncated( "CASE.EGRID" , "CASE.EGRID.cache" );
+    test_assert_NULL( ecl_grid_fread_cache( "DOES_NOT_EXIST.cache" , "CASE.EGRID" , false ));
+    free( actnum );
+  }
+  test_work_area_free( work_area );
+}
+
+
+void test_file( const char * grid_file ) {
+  char * abs_grid_file = util_alloc_abs_path( grid_file );
+  test_work_area_type * work_area = test_work_area_alloc("ecl_grid_cache_file");
+  test_case( abs_grid_file , "GRID.cache" );
+  test_work_area_free( work_area );
+  free( abs_grid_file );
+}
+
+
+int main( int argc , char ** argv) {
+  if (argc > 1)
+    test_file( argv[1] );
+  else
+    test_synthetic( );
+  exit(0);
+}
@@ -0,0 +1,194 @@
+/*
+   Copyright (C) 2017  Statoil ASA, Norway.
+
+   The file 'ecl_grid_compact.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+#include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
+
+#include <ert/util/test_util.h>
+#include <ert/util/test_work_area.h>
+#include <ert/util/util.h>
+
+#include <ert/ecl/ecl_grid.h>
+#include <ert/ecl/nnc_info.h>
+
+
+void test_equal_geometry( const ecl_grid_type * grid , const ecl_grid_type * compact_grid ) {
+  int g;
+  test_assert_int_equal( ecl_grid_get_global_size( grid ) , ecl_grid_get_global_size( compact_grid ));
+  test_assert_int_equal( ecl_grid_get_active_size( grid ) , ecl_grid_get_active_size( compact_grid ));
+
+  for (g = 0; g < ecl_grid_get_global_size( grid ); g++) {
+    double x1,y1,z1;
+    double x2,y2,z2;
+    int c;
+
+    ecl_grid_get_xyz1( grid , g , &x1 , &y1 , &z1 );
+    ecl_grid_get_xyz1( compact_grid , g , &x2 , &y2 , &z2 );
+    test_assert_double_equal( x1 , x2 );
+    test_assert_double_equal( y1 , y2 );
+    test_assert_double_equal( z1 , z2 );
+
+    for (c = 0; c < 8; c++) {
+      ecl_grid_get_cell_corner_xyz1( grid , g , c , &x1 , &y1 , &z1 );
+      ecl_grid_get_cell_corner_xyz1( compact_grid , g , c , &x2 , &y2 , &z2 );
+      test_assert_double_equal( x1 , x2 );
+      test_assert_double_equal( y1 , y2 );
+      test_assert_double_equal( z1 , z2 );
+    }
+
+    test_assert_double_equal( ecl_grid_get_cell_volume1( grid , g ) , ecl_grid_get_cell_volume1( compact_grid , g ));
+    test_assert_int_equal( ecl_grid_get_active_index1( grid , g ) , ecl_grid_get_active_index1( compact_grid , g ));
+  }
+}
+
+
+void test_compact( ) {
+  test_work_area_type * work_area = test_work_area_alloc("ecl_grid_compact");
+  {
+    const int nx = 6;
+    const int ny = 5;
+    const int nz = 4;
+    double dxv[6] = {10 , 12 , 14 , 10 , 12 , 14};
+    double dyv[5] = {20 , 22 , 24 , 20 , 22};
+    double dzv[4] = {1.5 , 2.5 , 3.5 , 4.5};
+    int * actnum = util_malloc( nx*ny*nz * sizeof * actnum );
+    int g;
+    for (g = 0; g < nx*ny*nz; g++)
+      actnum[g] = (g % 7) ? 1 : 0;
+
+    {
+      ecl_grid_type * grid = ecl_grid_alloc_dxv_dyv_dzv( nx , ny , nz , dxv , dyv , dzv , actnum );
+      ecl_grid_add_self_nnc( grid , 0 , nx*ny*nz - 1 , 0 );
+      ecl_grid_add_self_nnc( grid , 5 , 17 , 1 );
+      test_assert_false( ecl_grid_is_compact( grid ));
+      ecl_grid_fwrite_EGRID2( grid , "CASE.EGRID" , ECL_METRIC_UNITS );
+      ecl_grid_fwrite_GRID2( grid , "CASE.GRID" , ECL_METRIC_UNITS );
+      ecl_grid_free( grid );
+    }
+
+    {
+      ecl_grid_type * grid = ecl_grid_alloc( "CASE.EGRID" );
+      ecl_grid_type * compact_grid = ecl_grid_alloc_compact( "CASE.EGRID" );
+      test_assert_true( ecl_grid_is_compact( compact_grid ));
+      test_equal_geometry( grid , compact_grid );
+
+      test_assert_int_equal( ecl_grid_get_num_nnc( grid ) , ecl_grid_get_num_nnc( compact_grid ));
+      test_assert_NULL( ecl_grid_get_cell_nnc_info1( compact_grid , 1 ));
+      test_assert_true( nnc_info_equal( ecl_grid_get_cell_nnc_info1( grid , 0 ) , ecl_grid_get_cell_nnc_info1( compact_grid , 0 )));
+
+      {
+        ecl_grid_type * copy = ecl_grid_alloc_copy( compact_grid );
+        test_assert_true( ecl_grid_is_compact( copy ));
+        test_assert_true( ecl_grid_compare( compact_grid , copy , true , true , true ));
+        ecl_grid_free( copy );
+      }
+
+      ecl_grid_free( compact_grid );
+      ecl_grid_free( grid );
+    }
+
+    {
+      ecl_grid_type * grid = ecl_grid_alloc( "CASE.GRID" );
+      ecl_grid_type * compact_grid = ecl_grid_alloc_compact( "CASE.GRID" );
+      test_assert_true( ecl_grid_is_compact( compact_grid ));
+      test_equal_geometry( grid , compact_grid );
+      ecl_grid_free( compact_grid );
+      ecl_grid_free( grid );
+    }
+
+    free( actnum );
+  }
+  test_work_area_free( work_area );
+}
+
+
+/*
+  With mapaxes the corners end up at UTM coordinates, where the float
+  resolution is ~0.5 m; the compact corners are stored relative to the
+  grid origin and must be accurate to well below a millimetre.
+*/
+
+void test_compact_utm( ) {
+  test_work_area_type * work_area = test_work_area_alloc("ecl_grid_compact_utm");
+  {
+    const int nx = 10;
+    const int ny = 8;
+    const int nz = 3;
+    const float mapaxes[6] = {456789.25 , 6712345.50 , 456789.25 , 6712344.50 , 456790.25 , 6712344.50};
+    float * coord = util_malloc( 6 * (nx + 1) * (ny + 1) * sizeof * coord );
+    float * zcorn = util_malloc( 8 * nx * ny * nz * sizeof * zcorn );
+    int i,j,k,c;
+
+    for (j = 0; j <= ny; j++) {
+      for (i = 0; i <= nx; i++) {
+        float * pillar = &coord[6 * (j * (nx + 1) + i)];
+        pillar[0] = 101.37 * i + 0.71 * j;
+        pillar[1] = 99.13 * j + 0.29 * i;
+        pillar[2] = 2000;
+        pillar[3] = pillar[0] + 1.7;
+        pillar[4] = pillar[1] - 0.9;
+        pillar[5] = 2100;
+      }
+    }
+    for (k = 0; k < nz; k++)
+      for (c = 0; c < 2; c++)
+        for (j = 0; j < 2*ny; j++)
+          for (i = 0; i < 2*nx; i++)
+            zcorn[ ((2*k + c) * 2*ny + j) * 2*nx + i ] = 2013.123 + 7.77 * (k + c) + 0.011 * i + 0.007 * j;
+
+    {
+      ecl_grid_type * grid = ecl_grid_alloc_GRDECL_data( nx , ny , nz , zcorn , coord , NULL , true , mapaxes );
+      ecl_grid_fwrite_EGRID2( grid , "UTM.EGRID" , ECL_METRIC_UNITS );
+      ecl_grid_free( grid );
+    }
+
+    {
+      ecl_grid_type * grid = ecl_grid_alloc( "UTM.EGRID" );
+      ecl_grid_type * compact_grid = ecl_grid_alloc_compact( "UTM.EGRID" );
+      double max_diff = 0;
+      int g;
+
+      for (g = 0; g < ecl_grid_get_global_size( grid ); g++) {
+        for (c = 0; c < 8; c++) {
+          double x1,y1,z1;
+          double x2,y2,z2;
+          ecl_grid_get_cell_corner_xyz1( grid , g , c , &x1 , &y1 , &z1 );
+          ecl_grid_get_cell_corner_xyz1( compact_grid , g , c , &x2 , &y2 , &z2 );
+          test_assert_true( y1 > 6.7e6 );
+          max_diff = util_double_max( max_diff , fabs( x1 - x2 ));
+          max_diff = util_double_max( max_diff , fabs( y1 - y2 ));
+          max_diff = util_double_max( max_diff , fabs( z1 - z2 ));
+        }
+      }
+      test_assert_true( max_diff < 1e-3 );
+
+      ecl_grid_free( compact_grid );
+      ecl_grid_free( grid );
+    }
+    free( coord );
+    free( zcorn );
+  }
+  test_work_area_free( work_area );
+}
+
+
+int main( int argc , char ** argv) {
+  test_compact( );
+  test_compact_utm( );
+  exit(0);
+}
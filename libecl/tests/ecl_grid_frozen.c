@@ -0,0 +1,179 @@
+/*
+   Copyright (C) 2017  Statoil ASA, Norway.
+
+   The file 'ecl_grid_frozen.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include <ert/util/ert_api_config.h>
+#include <ert/util/test_util.h>
+#include <ert/util/util.h>
+#ifdef ERT_HAVE_THREAD_POOL
+#include <ert/util/thread_pool.h>
+#endif
+
+#include <ert/ecl/ecl_grid.h>
+
+#define NUM_JOBS   32
+#define NUM_ROUNDS 4
+
+
+typedef struct {
+  const ecl_grid_type * grid;
+  const double        * volume;
+  const double        * x;
+  const double        * y;
+  const double        * z;
+  const int           * xyz_index;
+  int                   seed;
+  int                   errors;
+} query_job_type;
+
+
+/*
+  Will query the grid for all cells, in an order which depends on the
+  seed, and compare the results with the results calculated up front
+  in the main thread.
+*/
+
+void * query_grid( void * arg ) {
+  query_job_type * job = arg;
+  ecl_grid_type * grid = (ecl_grid_type *) job->grid;
+  const int size = ecl_grid_get_global_size( grid );
+  const int stride = 7919;
+  int round;
+
+  for (round = 0; round < NUM_ROUNDS; round++) {
+    int n;
+    for (n = 0; n < size; n++) {
+      int g = (int) (((long) n * stride + job->seed + round) % size);
+      double x,y,z;
+
+      if (ecl_grid_get_cell_volume1( grid , g ) != job->volume[g])
+        job->errors++;
+
+      ecl_grid_get_xyz1( grid , g , &x , &y , &z );
+      if ((x != job->x[g]) || (y != job->y[g]) || (z != job->z[g]))
+        job->errors++;
+
+      if (ecl_grid_get_global_index_from_xyz( grid , x , y , z , -1 ) != job->xyz_index[g])
+        job->errors++;
+
+      if (!ecl_grid_cell_contains_xyz1( grid , g , x , y , z ))
+        job->errors++;
+    }
+  }
+  return NULL;
+}
+
+
+void test_frozen_queries( ) {
+  const int nx = 30;
+  const int ny = 20;
+  const int nz = 10;
+  const int size = nx*ny*nz;
+  double dxv[30], dyv[20], dzv[10];
+  double * volume = util_malloc( size * sizeof * volume );
+  double * x = util_malloc( size * sizeof * x );
+  double * y = util_malloc( size * sizeof * y );
+  double * z = util_malloc( size * sizeof * z );
+  int * xyz_index = util_malloc( size * sizeof * xyz_index );
+  int i,g;
+
+  for (i = 0; i < nx; i++) dxv[i] = 10 + (i % 4);
+  for (i = 0; i < ny; i++) dyv[i] = 20 + (i % 3);
+  for (i = 0; i < nz; i++) dzv[i] = 1.5 + 0.5 * (i % 2);
+
+  {
+    ecl_grid_type * grid = ecl_grid_alloc_dxv_dyv_dzv( nx , ny , nz , dxv , dyv , dzv , NULL );
+    for (g = 0; g < size; g++) {
+      volume[g] = ecl_grid_get_cell_volume1( grid , g );
+      ecl_grid_get_xyz1( grid , g , &x[g] , &y[g] , &z[g] );
+      xyz_index[g] = ecl_grid_get_global_index_from_xyz( grid , x[g] , y[g] , z[g] , -1 );
+    }
+    ecl_grid_free( grid );
+  }
+
+  {
+    ecl_grid_type * grid = ecl_grid_alloc_dxv_dyv_dzv( nx , ny , nz , dxv , dyv , dzv , NULL );
+    query_job_type jobs[NUM_JOBS];
+    int ijob;
+
+    test_assert_false( ecl_grid_is_frozen( grid ));
+    ecl_grid_freeze( grid );
+    test_assert_true( ecl_grid_is_frozen( grid ));
+
+    for (ijob = 0; ijob < NUM_JOBS; ijob++) {
+      jobs[ijob].grid      = grid;
+      jobs[ijob].volume    = volume;
+      jobs[ijob].x         = x;
+      jobs[ijob].y         = y;
+      jobs[ijob].z         = z;
+      jobs[ijob].xyz_index = xyz_index;
+      jobs[ijob].seed      = ijob * 131;
+      jobs[ijob].errors    = 0;
+    }
+
+#ifdef ERT_HAVE_THREAD_POOL
+    {
+      thread_pool_type * tp = thread_pool_alloc( 8 , true );
+      for (ijob = 0; ijob < NUM_JOBS; ijob++)
+        thread_pool_add_job( tp , query_grid , &jobs[ijob] );
+      thread_pool_join( tp );
+      thread_pool_free( tp );
+    }
+#else
+    for (ijob = 0; ijob < NUM_JOBS; ijob++)
+      query_grid( &jobs[ijob] );
+#endif
+
+    for (ijob = 0; ijob < NUM_JOBS; ijob++)
+      test_assert_int_equal( jobs[ijob].errors , 0 );
+
+    ecl_grid_free( grid );
+  }
+
+  free( xyz_index );
+  free( z );
+  free( y );
+  free( x );
+  free( volume );
+}
+
+
+void test_frozen_copy( ) {
+  ecl_grid_type * grid = ecl_grid_alloc_rectangular( 10 , 10 , 10 , 1 , 1 , 1 , NULL );
+  ecl_grid_freeze( grid );
+  {
+    ecl_grid_type * copy = ecl_grid_alloc_copy( grid );
+    test_assert_false( ecl_grid_is_frozen( copy ));
+    test_assert_true( ecl_grid_compare( grid , copy , true , true , true ));
+
+    ecl_grid_alloc_blocking_variables( copy , 3 );
+    ecl_grid_init_blocking( copy );
+    test_assert_true( ecl_grid_block_value_3d( copy , 0.5 , 0.5 , 0.5 , 1.0 ));
+    test_assert_int_equal( ecl_grid_get_block_count3d( copy , 0 , 0 , 0 ) , 1 );
+    ecl_grid_free( copy );
+  }
+  ecl_grid_free( grid );
+}
+
+
+int main( int argc , char ** argv) {
+  test_frozen_queries( );
+  test_frozen_copy( );
+  exit(0);
+}
@@ -0,0 +1,114 @@
+/*
+   Copyright (C) 2017  Statoil ASA, Norway.
+
+   The file 'ecl_grid_init_threads.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include <ert/util/test_util.h>
+#include <ert/util/test_work_area.h>
+#include <ert/util/util.h>
+
+#include <ert/ecl/ecl_grid.h>
+
+
+void test_equal_grid( const ecl_grid_type * grid1 , const ecl_grid_type * grid2 ) {
+  int g;
+  test_assert_true( ecl_grid_compare( grid1 , grid2 , true , true , true ));
+  test_assert_int_equal( ecl_grid_get_active_size( grid1 ) , ecl_grid_get_active_size( grid2 ));
+
+  for (g = 0; g < ecl_grid_get_global_size( grid1 ); g++) {
+    double x1,y1,z1;
+    double x2,y2,z2;
+
+    ecl_grid_get_xyz1( grid1 , g , &x1 , &y1 , &z1 );
+    ecl_grid_get_xyz1( grid2 , g , &x2 , &y2 , &z2 );
+    test_assert_double_equal( x1 , x2 );
+    test_assert_double_equal( y1 , y2 );
+    test_assert_double_equal( z1 , z2 );
+
+    test_assert_double_equal( ecl_grid_get_cell_volume1( grid1 , g ) , ecl_grid_get_cell_volume1( grid2 , g ));
+    test_assert_int_equal( ecl_grid_get_active_index1( grid1 , g ) , ecl_grid_get_active_index1( grid2 , g ));
+  }
+
+  for (g = 0; g < ecl_grid_get_active_size( grid1 ); g++)
+    test_assert_int_equal( ecl_grid_get_global_index1A( grid1 , g ) , ecl_grid_get_global_index1A( grid2 , g ));
+}
+
+
+void test_init_threads() {
+  test_work_area_type * work_area = test_work_area_alloc("ecl_grid_init_threads");
+  {
+    const int nx = 60;
+    const int ny = 50;
+    const int nz = 20;
+    double * dxv = util_malloc( nx * sizeof * dxv );
+    double * dyv = util_malloc( ny * sizeof * dyv );
+    double * dzv = util_malloc( nz * sizeof * dzv );
+    int * actnum = util_malloc( nx*ny*nz * sizeof * actnum );
+    int i,g;
+
+    for (i = 0; i < nx; i++)
+      dxv[i] = 10 + (i % 3);
+
+    for (i = 0; i < ny; i++)
+      dyv[i] = 20 + (i % 5);
+
+    for (i = 0; i < nz; i++)
+      dzv[i] = 1.5 + 0.25 * i;
+
+    for (g = 0; g < nx*ny*nz; g++)
+      actnum[g] = (g % 7) ? 1 : 0;
+
+    test_assert_int_equal( ecl_grid_get_init_threads( ) , 1 );
+    {
+      ecl_grid_type * grid = ecl_grid_alloc_dxv_dyv_dzv( nx , ny , nz , dxv , dyv , dzv , actnum );
+      ecl_grid_fwrite_EGRID2( grid , "CASE.EGRID" , ECL_METRIC_UNITS );
+      ecl_grid_free( grid );
+    }
+
+    {
+      ecl_grid_type * serial_grid = ecl_grid_alloc( "CASE.EGRID" );
+      int num_threads;
+
+      for (num_threads = 2; num_threads <= 8; num_threads *= 2) {
+        ecl_grid_set_init_threads( num_threads );
+        test_assert_int_equal( ecl_grid_get_init_threads( ) , num_threads );
+        {
+          ecl_grid_type * grid = ecl_grid_alloc( "CASE.EGRID" );
+          test_equal_grid( serial_grid , grid );
+          ecl_grid_free( grid );
+        }
+      }
+
+      ecl_grid_set_init_threads( 0 );
+      test_assert_int_equal( ecl_grid_get_init_threads( ) , 1 );
+      ecl_grid_free( serial_grid );
+    }
+
+    free( actnum );
+    free( dxv );
+    free( dyv );
+    free( dzv );
+  }
+  test_work_area_free( work_area );
+}
+
+
+int main( int argc , char ** argv) {
+  test_init_threads( );
+  exit(0);
+}
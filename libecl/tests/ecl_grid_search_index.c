@@ -0,0 +1,125 @@
+/*
+   Copyright (C) 2017  Statoil ASA, Norway.
+
+   The file 'ecl_grid_search_index.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include <ert/util/test_util.h>
+#include <ert/util/util.h>
+
+#include <ert/ecl/ecl_grid.h>
+
+
+static int linear_search( const ecl_grid_type * grid , double x , double y , double z) {
+  int g;
+  for (g = 0; g < ecl_grid_get_global_size( grid ); g++)
+    if (ecl_grid_cell_contains_xyz1( grid , g , x , y , z ))
+      return g;
+  return -1;
+}
+
+
+static double next_uniform( unsigned int * seed ) {
+  *seed = *seed * 1103515245 + 12345;
+  return ((*seed >> 8) & 0xFFFF) / 65536.0;
+}
+
+
+void test_search( ecl_grid_type * grid , double xmax , double ymax , double zmin , double zmax) {
+  const int num_points = 2000;
+  double * x = util_malloc( num_points * sizeof * x );
+  double * y = util_malloc( num_points * sizeof * y );
+  double * z = util_malloc( num_points * sizeof * z );
+  int * global_index = util_malloc( num_points * sizeof * global_index );
+  unsigned int seed = 1;
+  int hits = 0;
+  int ip;
+
+  for (ip = 0; ip < num_points; ip++) {
+    x[ip] = -1 + (xmax + 2) * next_uniform( &seed );
+    y[ip] = -1 + (ymax + 2) * next_uniform( &seed );
+    z[ip] = zmin - 1 + (zmax - zmin + 2) * next_uniform( &seed );
+  }
+
+  ecl_grid_get_global_index_from_xyz_list( grid , num_points , x , y , z , global_index );
+  for (ip = 0; ip < num_points; ip++) {
+    int expected = linear_search( grid , x[ip] , y[ip] , z[ip] );
+    test_assert_int_equal( expected , ecl_grid_get_global_index_from_xyz( grid , x[ip] , y[ip] , z[ip] , -1 ));
+    test_assert_int_equal( expected , global_index[ip] );
+    if (expected >= 0)
+      hits++;
+  }
+  test_assert_true( hits > num_points / 2 );
+
+  free( global_index );
+  free( x );
+  free( y );
+  free( z );
+}
+
+
+void test_dxv_grid() {
+  const int nx = 7;
+  const int ny = 5;
+  const int nz = 19;
+  double dxv[7] = {1 , 2 , 3 , 1 , 2 , 3 , 1};
+  double dyv[5] = {2 , 1 , 2 , 1 , 2};
+  double dzv[19];
+  double depthz[8*6];
+  int i;
+
+  for (i = 0; i < nz; i++)
+    dzv[i] = 0.5 + 0.1 * i;
+
+  for (i = 0; i < 8*6; i++)
+    depthz[i] = 0.25 * (i % 5);
+
+  {
+    ecl_grid_type * grid = ecl_grid_alloc_dxv_dyv_dzv( nx , ny , nz , dxv , dyv , dzv , NULL );
+    ecl_grid_init_search_index( grid );
+    test_search( grid , 13 , 8 , 0 , 26.6 );
+    ecl_grid_free( grid );
+  }
+
+  {
+    ecl_grid_type * grid = ecl_grid_alloc_dxv_dyv_dzv_depthz( nx , ny , nz , dxv , dyv , dzv , depthz , NULL );
+    test_search( grid , 13 , 8 , 0 , 27.6 );
+    ecl_grid_free( grid );
+  }
+}
+
+
+void test_outside() {
+  ecl_grid_type * grid = ecl_grid_alloc_rectangular( 4 , 4 , 4 , 1 , 1 , 1 , NULL );
+  double x[3] = {0.5 , 10 , 3.5};
+  double y[3] = {0.5 , 0.5 , 3.5};
+  double z[3] = {0.5 , 0.5 , 3.5};
+  int global_index[3];
+
+  ecl_grid_get_global_index_from_xyz_list( grid , 3 , x , y , z , global_index );
+  test_assert_int_equal( 0 , global_index[0] );
+  test_assert_int_equal( -1 , global_index[1] );
+  test_assert_int_equal( 63 , global_index[2] );
+  ecl_grid_free( grid );
+}
+
+
+int main( int argc , char ** argv) {
+  test_dxv_grid();
+  test_outside();
+  exit(0);
+}
@@ -17,6 +17,10 @@
 */
 #include <stdlib.h>
 #include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <locale.h>
 
 #include <ert/util/test_util.h>
 #include <ert/util/util.h>
@@ -24,6 +28,7 @@
 
 #include <ert/ecl/ecl_kw.h>
 #include <ert/ecl/fortio.h>
+#include <ert/ecl/ecl_endian_flip.h>
 
 
 void test_truncated(const char * filename , offset_type truncate_size) {
@@ -75,8 +80,409 @@ void test_fread_alloc() {
 }
 
 
+/*
+  The size in the keyword header is a signed 32 bit integer; a header
+  claiming more than INT_MAX elements - here 8 * 300 million, i.e. the
+  ZCORN keyword of a 300M cell grid - shows up as a negative size and
+  must be rejected as a read failure.
+*/
+
+void test_negative_size() {
+  test_work_area_type * work_area = test_work_area_alloc("ecl_kw_fread_negative" );
+  {
+    char header[16];
+    int size = (int) (uint32_t) 2400000000u;
+    float data[4] = {0};
+
+    memcpy( &header[0] , "ZCORN   " , 8 );
+    if (ECL_ENDIAN_FLIP)
+      util_endian_flip_vector( &size , sizeof size , 1 );
+    memcpy( &header[8] , &size , 4 );
+    memcpy( &header[12] , "REAL" , 4 );
+    {
+      fortio_type * fortio = fortio_open_writer("ZCORN" , false , true );
+      fortio_fwrite_record( fortio , header , sizeof header );
+      fortio_fwrite_record( fortio , (const char *) data , sizeof data );
+      fortio_fclose( fortio );
+    }
+    {
+      fortio_type * fortio = fortio_open_reader("ZCORN" , false , true );
+      test_assert_NULL( ecl_kw_fread_alloc( fortio ));
+      fortio_fclose( fortio );
+    }
+  }
+  test_work_area_free( work_area );
+}
+
+
+/*
+  Reference implementation of the formatted writer, i.e. one fprintf()
+  call per element with the scaling of the old __fprintf_scientific();
+  the output from ecl_kw_fwrite() must be byte identical to this.
+*/
+
+void ref_fprintf_scientific( FILE * stream , const char * fmt , double x) {
+  double pow_x = ceil(log10(fabs(x)));
+  double arg_x = x / pow(10.0 , pow_x);
+  if (x != 0.0) {
+    if (fabs(arg_x) == 1.0) {
+      arg_x *= 0.10;
+      pow_x += 1;
+    }
+  } else {
+    arg_x = 0.0;
+    pow_x = 0.0;
+  }
+  fprintf(stream , fmt , arg_x , (int) pow_x);
+}
+
+
+void ref_fwrite( const ecl_kw_type * ecl_kw , FILE * stream ) {
+  const ecl_data_type data_type = ecl_kw_get_data_type( ecl_kw );
+  const int size = ecl_kw_get_size( ecl_kw );
+  int blocksize = 1000;
+  int columns;
+  int index;
+
+  switch (ecl_type_get_type( data_type )) {
+  case(ECL_CHAR_TYPE):
+    blocksize = 105;
+    columns = 7;
+    break;
+  case(ECL_INT_TYPE):
+    columns = 6;
+    break;
+  case(ECL_FLOAT_TYPE):
+    columns = 4;
+    break;
+  case(ECL_DOUBLE_TYPE):
+    columns = 3;
+    break;
+  case(ECL_BOOL_TYPE):
+    columns = 25;
+    break;
+  default:
+    util_abort("%s: type not supported \n",__func__);
+    columns = 1;
+  }
+
+  fprintf(stream , " '%-8s' %11d '%-4s'\n" , ecl_kw_get_header8( ecl_kw ) , size , ecl_type_get_name( data_type ));
+
+  for (index = 0; index < size; index++) {
+    switch (ecl_type_get_type( data_type )) {
+    case(ECL_CHAR_TYPE):
+      fprintf(stream , " '%-8s'" , ecl_kw_iget_char_ptr( ecl_kw , index ));
+      break;
+    case(ECL_INT_TYPE):
+      fprintf(stream , " %11d" , ecl_kw_iget_int( ecl_kw , index ));
+      break;
+    case(ECL_FLOAT_TYPE):
+      ref_fprintf_scientific( stream , "  %11.8fE%+03d" , ecl_kw_iget_float( ecl_kw , index ));
+      break;
+    case(ECL_DOUBLE_TYPE):
+      ref_fprintf_scientific( stream , "  %17.14fD%+03d" , ecl_kw_iget_double( ecl_kw , index ));
+      break;
+    case(ECL_BOOL_TYPE):
+      fprintf(stream , "  %c" , ecl_kw_iget_bool( ecl_kw , index ) ? 'T' : 'F');
+      break;
+    default:
+      break;
+    }
+
+    {
+      int block_index = index % blocksize;
+      if ((((block_index + 1) % columns) == 0) || ((block_index + 1) == blocksize) || ((index + 1) == size))
+        fprintf(stream , "\n");
+    }
+  }
+}
+
+
+void assert_file_equal( const char * file1 , const char * file2 ) {
+  int size1, size2;
+  char * content1 = util_fread_alloc_file_content( file1 , &size1 );
+  char * content2 = util_fread_alloc_file_content( file2 , &size2 );
+
+  test_assert_int_equal( size1 , size2 );
+  test_assert_true( memcmp( content1 , content2 , size1 ) == 0 );
+
+  free( content1 );
+  free( content2 );
+}
+
+
+/*
+  Writes all the keywords to a formatted file and verifies that the
+  content is identical to the reference writer, and that the keywords
+  are recovered when the file is read.
+*/
+
+void test_formatted_keywords( ecl_kw_type ** kw_list , int num_kw ) {
+  int ikw;
+  {
+    fortio_type * fortio = fortio_open_writer("FMT" , true , true );
+    for (ikw = 0; ikw < num_kw; ikw++)
+      ecl_kw_fwrite( kw_list[ikw] , fortio );
+    fortio_fclose( fortio );
+  }
+  {
+    FILE * stream = util_fopen("REF" , "w");
+    for (ikw = 0; ikw < num_kw; ikw++)
+      ref_fwrite( kw_list[ikw] , stream );
+    fclose( stream );
+  }
+  assert_file_equal( "FMT" , "REF" );
+
+  {
+    fortio_type * fortio = fortio_open_reader("FMT" , true , true );
+    for (ikw = 0; ikw < num_kw; ikw++) {
+      ecl_kw_type * kw = ecl_kw_fread_alloc( fortio );
+      test_assert_not_NULL( kw );
+      if (ecl_type_is_double( ecl_kw_get_data_type( kw )))
+        /* Doubles are read back as prefix * 10^power, which is not exact. */
+        test_assert_true( ecl_kw_numeric_equal( kw , kw_list[ikw] , 1e-12 , 1e-14 ));
+      else if (ecl_type_is_float( ecl_kw_get_data_type( kw )))
+        /* Eight digits do not always recover a float exactly. */
+        test_assert_true( ecl_kw_numeric_equal( kw , kw_list[ikw] , 0 , 1e-7 ));
+      else
+        test_assert_true( ecl_kw_equal( kw , kw_list[ikw] ));
+      ecl_kw_free( kw );
+    }
+    test_assert_NULL( ecl_kw_fread_alloc( fortio ));
+    fortio_fclose( fortio );
+  }
+}
+
+
+ecl_kw_type ** alloc_formatted_keywords( int size ) {
+  ecl_kw_type ** kw_list = util_calloc( 5 , sizeof * kw_list );
+  ecl_kw_type * int_kw    = ecl_kw_alloc( "INT" , size , ECL_INT );
+  ecl_kw_type * float_kw  = ecl_kw_alloc( "FLOAT" , size , ECL_FLOAT );
+  ecl_kw_type * double_kw = ecl_kw_alloc( "DOUBLE" , size , ECL_DOUBLE );
+  ecl_kw_type * bool_kw   = ecl_kw_alloc( "BOOL" , size , ECL_BOOL );
+  ecl_kw_type * char_kw   = ecl_kw_alloc( "CHAR" , 250 , ECL_CHAR );
+  int i;
+  for (i=0; i < size; i++) {
+    ecl_kw_iset_int( int_kw , i , (i - size/2) * 1013 );
+    ecl_kw_iset_float( float_kw , i , (i - size/2) * 0.25 );
+    ecl_kw_iset_double( double_kw , i , (i - size/2) * 0.125 );
+    ecl_kw_iset_bool( bool_kw , i , (i % 3) == 0 );
+  }
+  for (i=0; i < 250; i++) {
+    char * s = util_alloc_sprintf("S%d" , i);
+    ecl_kw_iset_string8( char_kw , i , s );
+    free( s );
+  }
+  kw_list[0] = int_kw;
+  kw_list[1] = float_kw;
+  kw_list[2] = double_kw;
+  kw_list[3] = bool_kw;
+  kw_list[4] = char_kw;
+  return kw_list;
+}
+
+
+void free_keywords( ecl_kw_type ** kw_list , int num_kw ) {
+  int ikw;
+  for (ikw = 0; ikw < num_kw; ikw++)
+    ecl_kw_free( kw_list[ikw] );
+  free( kw_list );
+}
+
+
+void test_fread_alloc_formatted() {
+  test_work_area_type * work_area = test_work_area_alloc("ecl_kw_fread_formatted" );
+  {
+    ecl_kw_type ** kw_list = alloc_formatted_keywords( 2500 );
+    test_formatted_keywords( kw_list , 5 );
+    free_keywords( kw_list , 5 );
+  }
+  test_work_area_free( work_area );
+}
+
+
+/* The expected output has been created with the original fprintf() based writer. */
+
+void test_formatted_golden() {
+  test_work_area_type * work_area = test_work_area_alloc("ecl_kw_formatted_golden" );
+  {
+    const float  float_values[]  = {0.0f, 1.0f, -1.0f, 0.1f, 123.456f, -2.5e-7f, 1e10f, 3.4e38f, 1e-40f, 99999.995f, 1.5f, -0.00123f, 7.0f, 0.3f};
+    const double double_values[] = {0.0, 1.0, -10.0, 0.1, 123.456, -2.5e-7, 1e300, 5e-324, 1234567.891234567, -3.0, 0.5, 2.0/3};
+    const char * expected =
+      " 'GOLDF   '          14 'REAL'\n"
+      "   0.00000000E+00   0.10000000E+01  -0.10000000E+01   0.10000000E+00\n"
+      "   0.12345600E+03  -0.25000000E-06   0.10000000E+11   0.34000000E+39\n"
+      "   0.99999461E-40   0.99999992E+05   0.15000000E+01  -0.12300001E-02\n"
+      "   0.70000000E+01   0.30000001E+00\n"
+      " 'GOLDD   '          12 'DOUB'\n"
+      "   0.00000000000000D+00   0.10000000000000D+01  -0.10000000000000D+02\n"
+      "   0.10000000000000D+00   0.12345600000000D+03  -0.25000000000000D-06\n"
+      "   0.10000000000000D+301   0.50000000000000D-323   0.12345678912346D+07\n"
+      "  -0.30000000000000D+01   0.50000000000000D+00   0.66666666666667D+00\n";
+    const int num_float  = sizeof float_values / sizeof float_values[0];
+    const int num_double = sizeof double_values / sizeof double_values[0];
+    ecl_kw_type * float_kw  = ecl_kw_alloc( "GOLDF" , num_float , ECL_FLOAT );
+    ecl_kw_type * double_kw = ecl_kw_alloc( "GOLDD" , num_double , ECL_DOUBLE );
+    int i;
+
+    for (i = 0; i < num_float; i++)
+      ecl_kw_iset_float( float_kw , i , float_values[i] );
+    for (i = 0; i < num_double; i++)
+      ecl_kw_iset_double( double_kw , i , double_values[i] );
+
+    {
+      fortio_type * fortio = fortio_open_writer("GOLD" , true , true );
+      ecl_kw_fwrite( float_kw , fortio );
+      ecl_kw_fwrite( double_kw , fortio );
+      fortio_fclose( fortio );
+    }
+    {
+      int size;
+      char * content = util_fread_alloc_file_content( "GOLD" , &size );
+      test_assert_int_equal( strlen( expected ) , size );
+      test_assert_string_equal( expected , content );
+      free( content );
+    }
+
+    ecl_kw_free( float_kw );
+    ecl_kw_free( double_kw );
+  }
+  test_work_area_free( work_area );
+}
+
+
+/*
+  Random bit patterns cover all exponents, including denormals and the
+  values close to a power of ten; in addition there are decimal
+  fractions which are often close to a rounding tie.
+*/
+
+void test_formatted_random() {
+  test_work_area_type * work_area = test_work_area_alloc("ecl_kw_formatted_random" );
+  {
+    const int size = 50000;
+    ecl_kw_type ** kw_list = util_calloc( 2 , sizeof * kw_list );
+    ecl_kw_type * float_kw  = ecl_kw_alloc( "FLOAT" , size , ECL_FLOAT );
+    ecl_kw_type * double_kw = ecl_kw_alloc( "DOUBLE" , size , ECL_DOUBLE );
+    unsigned int seed = 1;
+    int i;
+
+    srand( seed );
+    for (i = 0; i < size; i++) {
+      if (i % 2) {
+        uint32_t float_bits = ((uint32_t) rand() << 16) ^ (uint32_t) rand();
+        uint64_t double_bits = ((uint64_t) rand() << 48) ^ ((uint64_t) rand() << 24) ^ (uint64_t) rand();
+        float  float_value;
+        double double_value;
+
+        memcpy( &float_value , &float_bits , sizeof float_value );
+        memcpy( &double_value , &double_bits , sizeof double_value );
+        if (!isfinite( float_value ))
+          float_value = i;
+        if (!isfinite( double_value ))
+          double_value = i;
+
+        ecl_kw_iset_float( float_kw , i , float_value );
+        ecl_kw_iset_double( double_kw , i , double_value );
+      } else {
+        ecl_kw_iset_float( float_kw , i , (i - size / 2) * 0.001 );
+        ecl_kw_iset_double( double_kw , i , (i - size / 2) / 3.0e7 );
+      }
+    }
+    kw_list[0] = float_kw;
+    kw_list[1] = double_kw;
+
+    {
+      fortio_type * fortio = fortio_open_writer("FMT" , true , true );
+      ecl_kw_fwrite( float_kw , fortio );
+      ecl_kw_fwrite( double_kw , fortio );
+      fortio_fclose( fortio );
+    }
+    {
+      FILE * stream = util_fopen("REF" , "w");
+      ref_fwrite( float_kw , stream );
+      ref_fwrite( double_kw , stream );
+      fclose( stream );
+    }
+    assert_file_equal( "FMT" , "REF" );
+    free_keywords( kw_list , 2 );
+  }
+  test_work_area_free( work_area );
+}
+
+
+/*
+  The formatted files must be written and read with '.' as decimal
+  separator also when the LC_NUMERIC category of the process locale
+  uses ','. The test is skipped if no such locale is installed.
+*/
+
+void test_formatted_locale() {
+  const char * locale_list[] = {"de_DE.UTF-8", "de_DE.utf8", "nb_NO.UTF-8", "nb_NO.utf8", "fr_FR.UTF-8", "fr_FR.utf8", "de_DE", NULL};
+  const char * locale = NULL;
+  int i;
+
+  for (i = 0; locale_list[i]; i++) {
+    if (setlocale( LC_NUMERIC , locale_list[i] ) && (strcmp( localeconv()->decimal_point , "," ) == 0)) {
+      locale = locale_list[i];
+      break;
+    }
+  }
+  setlocale( LC_NUMERIC , "C" );
+
+  if (locale == NULL) {
+    printf("No locale with decimal comma available - locale test skipped\n");
+    return;
+  }
+
+  {
+    test_work_area_type * work_area = test_work_area_alloc("ecl_kw_formatted_locale" );
+    ecl_kw_type ** kw_list = alloc_formatted_keywords( 2500 );
+
+    {
+      FILE * stream = util_fopen("REF" , "w");
+      for (i = 0; i < 5; i++)
+        ref_fwrite( kw_list[i] , stream );
+      fclose( stream );
+    }
+
+    setlocale( LC_NUMERIC , locale );
+    {
+      fortio_type * fortio = fortio_open_writer("FMT" , true , true );
+      for (i = 0; i < 5; i++)
+        ecl_kw_fwrite( kw_list[i] , fortio );
+      fortio_fclose( fortio );
+    }
+    assert_file_equal( "FMT" , "REF" );
+
+    {
+      fortio_type * fortio = fortio_open_reader("REF" , true , true );
+      for (i = 0; i < 5; i++) {
+        ecl_kw_type * kw = ecl_kw_fread_alloc( fortio );
+        if (ecl_type_is_double( ecl_kw_get_data_type( kw )))
+          test_assert_true( ecl_kw_numeric_equal( kw , kw_list[i] , 1e-12 , 1e-14 ));
+        else
+          test_assert_true( ecl_kw_equal( kw , kw_list[i] ));
+        ecl_kw_free( kw );
+      }
+      fortio_fclose( fortio );
+    }
+    test_assert_string_equal( "," , localeconv()->decimal_point );
+    setlocale( LC_NUMERIC , "C" );
+
+    free_keywords( kw_list , 5 );
+    test_work_area_free( work_area );
+  }
+}
+
+
 int main(int argc , char ** argv) {
   test_fread_alloc();
+  test_negative_size();
+  test_fread_alloc_formatted();
+  test_formatted_golden();
+  test_formatted_random();
+  test_formatted_locale();
   exit(0);
 }
 
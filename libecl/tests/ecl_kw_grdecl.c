@@ -24,6 +24,61 @@
 
 #include <ert/ecl/ecl_kw.h>
 
+void test_index( bool use_mmap ) {
+  test_work_area_type * work_area = test_work_area_alloc("ecl_kw_grdecl_index");
+  {
+    FILE * stream = util_fopen( "INDEX.grdecl" , "w");
+    fprintf(stream , "-- PERMX is not here\n");
+    fprintf(stream , "PORO\n  0.25 2*0.50 -- comment 1 2 3\n  3*0.75\n/\n\n");
+    fprintf(stream , "ACTNUM\n  4*1 -- ACTNUM\n-- ACTNUM\n  2*0 /\n");
+    fprintf(stream , "PORO\n  1.0 /\n");
+    fclose( stream );
+  }
+  {
+    FILE * stream = util_fopen( "INDEX.grdecl" , "r");
+    ecl_kw_grdecl_index_type * index = ecl_kw_grdecl_index_alloc( stream , use_mmap );
+
+    test_assert_true( ecl_kw_grdecl_index_is_instance( index ));
+    test_assert_int_equal( 3 , ecl_kw_grdecl_index_get_size( index ));
+    test_assert_string_equal( "PORO" , ecl_kw_grdecl_index_iget_kw( index , 0 ));
+    test_assert_string_equal( "ACTNUM" , ecl_kw_grdecl_index_iget_kw( index , 1 ));
+    test_assert_string_equal( "PORO" , ecl_kw_grdecl_index_iget_kw( index , 2 ));
+    test_assert_true( ecl_kw_grdecl_index_has_kw( index , "ACTNUM" ));
+    test_assert_false( ecl_kw_grdecl_index_has_kw( index , "PERMX" ));
+    test_assert_int_equal( 0 , util_ftell( stream ));
+
+    {
+      ecl_kw_type * poro = ecl_kw_grdecl_index_alloc_kw( index , "PORO" , 6 , ECL_FLOAT );
+      ecl_kw_type * actnum = ecl_kw_grdecl_index_alloc_kw( index , "ACTNUM" , 6 , ECL_INT );
+
+      test_assert_float_equal( 0.25 , ecl_kw_iget_float( poro , 0 ));
+      test_assert_float_equal( 0.50 , ecl_kw_iget_float( poro , 2 ));
+      test_assert_float_equal( 0.75 , ecl_kw_iget_float( poro , 5 ));
+      test_assert_int_equal( 1 , ecl_kw_iget_int( actnum , 3 ));
+      test_assert_int_equal( 0 , ecl_kw_iget_int( actnum , 4 ));
+      test_assert_NULL( ecl_kw_grdecl_index_alloc_kw( index , "PERMX" , 0 , ECL_FLOAT ));
+
+      test_assert_true( ecl_kw_grdecl_index_fseek_kw( index , "ACTNUM" , false , stream ));
+      {
+        ecl_kw_type * actnum2 = ecl_kw_fscanf_alloc_current_grdecl( stream , ECL_INT );
+        test_assert_true( ecl_kw_equal( actnum , actnum2 ));
+        ecl_kw_free( actnum2 );
+      }
+      test_assert_true( ecl_kw_grdecl_index_fseek_kw( index , "PORO" , false , stream ));
+      test_assert_int_equal( ecl_kw_grdecl_index_iget_offset( index , 2 ) , util_ftell( stream ));
+      test_assert_false( ecl_kw_grdecl_index_fseek_kw( index , "ACTNUM" , false , stream ));
+      test_assert_true( ecl_kw_grdecl_index_fseek_kw( index , "ACTNUM" , true , stream ));
+
+      ecl_kw_free( poro );
+      ecl_kw_free( actnum );
+    }
+    ecl_kw_grdecl_index_free( index );
+    fclose( stream );
+  }
+  test_work_area_free( work_area );
+}
+
+
 int main(int argc , char ** argv) {  
   int i;
   ecl_kw_type * ecl_kw = ecl_kw_alloc("HEAD" , 10  , ECL_INT);
@@ -68,6 +123,8 @@ int main(int argc , char ** argv) {
     test_work_area_free( work_area );
   }
   ecl_kw_free( ecl_kw );
-  
+
+  test_index( false );
+  test_index( true );
   exit(0);
 }
@@ -26,12 +26,47 @@
 #include <ert/ecl/ecl_kw_magic.h>
 
 
+/*
+  The lgrs of a compact grid are stored relative to the origin of the
+  main grid; the geometry should be equal to the ordinary grid.
+*/
+
+void test_compact_lgr( const ecl_grid_type * ecl_grid , const char * grid_file ) {
+  ecl_grid_type * compact_grid = ecl_grid_alloc_compact( grid_file );
+  int lgr_index;
+
+  test_assert_int_equal( ecl_grid_get_num_lgr( ecl_grid ) , ecl_grid_get_num_lgr( compact_grid ));
+  for (lgr_index = 0; lgr_index < ecl_grid_get_num_lgr( ecl_grid ); lgr_index++) {
+    const ecl_grid_type * lgr = ecl_grid_iget_lgr( ecl_grid , lgr_index );
+    const ecl_grid_type * compact_lgr = ecl_grid_iget_lgr( compact_grid , lgr_index );
+    int g;
+
+    test_assert_int_equal( ecl_grid_get_global_size( lgr ) , ecl_grid_get_global_size( compact_lgr ));
+    for (g = 0; g < ecl_grid_get_global_size( lgr ); g++) {
+      int c;
+      for (c = 0; c < 8; c++) {
+        double x1,y1,z1;
+        double x2,y2,z2;
+
+        ecl_grid_get_cell_corner_xyz1( lgr , g , c , &x1 , &y1 , &z1 );
+        ecl_grid_get_cell_corner_xyz1( compact_lgr , g , c , &x2 , &y2 , &z2 );
+        test_assert_double_equal( x1 , x2 );
+        test_assert_double_equal( y1 , y2 );
+        test_assert_double_equal( z1 , z2 );
+      }
+    }
+  }
+  ecl_grid_free( compact_grid );
+}
+
+
 int main(int argc , char ** argv) {
   const char * grid_file = argv[1];
   ecl_grid_type * ecl_grid = ecl_grid_alloc( grid_file );
   ecl_file_type * ecl_file = ecl_file_open( grid_file , 0);
   
   ecl_grid_test_lgr_consistency( ecl_grid );
+  test_compact_lgr( ecl_grid , grid_file );
 
   if (ecl_file_get_num_named_kw( ecl_file , COORD_KW ))
     test_assert_int_equal( ecl_file_get_num_named_kw( ecl_file , COORD_KW ) - 1, ecl_grid_get_num_lgr( ecl_grid ));
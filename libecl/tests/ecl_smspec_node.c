@@ -0,0 +1,152 @@
+/*
+   Copyright (C) 2017  Statoil ASA, Norway.
+
+   The file 'ecl_smspec_node.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+#include <stdlib.h>
+#include <stdbool.h>
+#include <limits.h>
+
+#include <ert/util/test_util.h>
+#include <ert/util/util.h>
+
+#include <ert/ecl/ecl_smspec.h>
+#include <ert/ecl/smspec_node.h>
+
+
+void test_key( char * key , const char * expected ) {
+  test_assert_string_equal( key , expected );
+  free( key );
+}
+
+
+void test_keys( const char * join ) {
+  const int nums[] = {0 , 1 , 9 , 10 , 12345 , -1 , -987 , INT_MAX , INT_MIN};
+  const int num_nums = sizeof nums / sizeof nums[0];
+
+  for (int n = 0; n < num_nums; n++) {
+    int num = nums[n];
+    int i = num;
+    int j = nums[(n + 1) % num_nums];
+    int k = nums[(n + 2) % num_nums];
+    char * expected;
+
+    expected = util_alloc_sprintf("%s%s%d" , "BPR" , join , num);
+    test_key( smspec_alloc_block_num_key( join , "BPR" , num ) , expected );
+    test_key( smspec_alloc_region_key( join , "BPR" , num ) , expected );
+    test_key( smspec_alloc_region_2_region_num_key( join , "BPR" , num ) , expected );
+    free( expected );
+
+    expected = util_alloc_sprintf("%s%s%d,%d,%d" , "BPR" , join , i,j,k);
+    test_key( smspec_alloc_block_ijk_key( join , "BPR" , i,j,k ) , expected );
+    free( expected );
+
+    expected = util_alloc_sprintf("%s%s%d-%d" , "RGFT" , join , i,j);
+    test_key( smspec_alloc_region_2_region_r1r2_key( join , "RGFT" , i,j ) , expected );
+    free( expected );
+
+    expected = util_alloc_sprintf("%s%s%s%s%d,%d,%d" , "COPR" , join , "OP_1" , join , i,j,k);
+    test_key( smspec_alloc_completion_ijk_key( join , "COPR" , "OP_1" , i,j,k ) , expected );
+    free( expected );
+
+    expected = util_alloc_sprintf("%s%s%s%s%d" , "COPR" , join , "OP_1" , join , num);
+    test_key( smspec_alloc_completion_num_key( join , "COPR" , "OP_1" , num ) , expected );
+    test_key( smspec_alloc_segment_key( join , "COPR" , "OP_1" , num ) , expected );
+    free( expected );
+
+    expected = util_alloc_sprintf("%s%s%s%s%d,%d,%d" , "LBPR" , join , "LGR1" , join , i,j,k);
+    test_key( smspec_alloc_local_block_key( join , "LBPR" , "LGR1" , i,j,k ) , expected );
+    free( expected );
+
+    expected = util_alloc_sprintf("%s%s%s%s%s%s%d,%d,%d" , "LCOPR" , join , "LGR1" , join , "OP_1" , join , i,j,k);
+    test_key( smspec_alloc_local_completion_key( join , "LCOPR" , "LGR1" , "OP_1" , i,j,k ) , expected );
+    free( expected );
+  }
+
+  {
+    char * expected = util_alloc_sprintf("%s%s%s" , "WOPR" , join , "OP_1");
+    test_key( smspec_alloc_well_key( join , "WOPR" , "OP_1" ) , expected );
+    test_key( smspec_alloc_group_key( join , "WOPR" , "OP_1" ) , expected );
+    free( expected );
+
+    expected = util_alloc_sprintf("%s%s%s%s%s" , "LWOPR" , join , "LGR1" , join , "OP_1");
+    test_key( smspec_alloc_local_well_key( join , "LWOPR" , "LGR1" , "OP_1" ) , expected );
+    free( expected );
+  }
+
+  test_assert_NULL( smspec_alloc_well_key( join , "WOPR" , NULL ));
+  test_assert_NULL( smspec_alloc_completion_num_key( join , "COPR" , NULL , 10 ));
+}
+
+
+void test_node( ) {
+  const int grid_dims[3] = {10 , 10 , 10};
+  smspec_node_type * node = smspec_node_alloc( ECL_SMSPEC_COMPLETION_VAR , "LONG_WELL_NAME" , "COPRXXXXXX" , "SM3/DAY_XXX" , ":" , grid_dims , 123 , 7 , 0 );
+
+  test_assert_string_equal( "LONG_WEL" , smspec_node_get_wgname( node ));
+  test_assert_string_equal( "COPRXXXX" , smspec_node_get_keyword( node ));
+  test_assert_string_equal( "SM3/DAY_" , smspec_node_get_unit( node ));
+  test_assert_string_equal( "COPRXXXX:LONG_WEL:3,3,2" , smspec_node_get_gen_key1( node ));
+  test_assert_string_equal( "COPRXXXX:LONG_WEL:123" , smspec_node_get_gen_key2( node ));
+  test_assert_int_equal( 3 , smspec_node_get_ijk( node )[0] );
+  test_assert_int_equal( 3 , smspec_node_get_ijk( node )[1] );
+  test_assert_int_equal( 2 , smspec_node_get_ijk( node )[2] );
+  test_assert_NULL( smspec_node_get_lgr_ijk( node ));
+
+  {
+    smspec_node_type * copy = smspec_node_alloc_copy( node );
+    test_assert_true( smspec_node_equal( node , copy ));
+
+    smspec_node_update_wgname( node , "OP_2" , ":");
+    smspec_node_set_unit( node , "BARS" );
+    test_assert_string_equal( "OP_2" , smspec_node_get_wgname( node ));
+    test_assert_string_equal( "COPRXXXX:OP_2:3,3,2" , smspec_node_get_gen_key1( node ));
+    test_assert_false( smspec_node_equal( node , copy ));
+
+    smspec_node_free( node );
+    test_assert_string_equal( "LONG_WEL" , smspec_node_get_wgname( copy ));
+    test_assert_string_equal( "SM3/DAY_" , smspec_node_get_unit( copy ));
+    test_assert_int_equal( 2 , smspec_node_get_ijk( copy )[2] );
+    smspec_node_free( copy );
+  }
+
+  node = smspec_node_alloc( ECL_SMSPEC_WELL_VAR , NULL , "WOPR" , "SM3" , ":" , grid_dims , 0 , 0 , 0 );
+  test_assert_NULL( smspec_node_get_wgname( node ));
+  test_assert_NULL( smspec_node_get_gen_key1( node ));
+  smspec_node_update_wgname( node , "OP_1" , ":");
+  test_assert_string_equal( "WOPR:OP_1" , smspec_node_get_gen_key1( node ));
+  smspec_node_free( node );
+
+  node = smspec_node_alloc_lgr( ECL_SMSPEC_LOCAL_COMPLETION_VAR , "OP_1" , "LCOPR" , "SM3" , "LGR1" , ":" , 1 , 2 , 3 , 0 , 0 );
+  test_assert_string_equal( "LGR1" , smspec_node_get_lgr_name( node ));
+  test_assert_int_equal( 3 , smspec_node_get_lgr_ijk( node )[2] );
+  test_assert_string_equal( "LCOPR:LGR1:OP_1:1,2,3" , smspec_node_get_gen_key1( node ));
+  {
+    smspec_node_type * copy = smspec_node_alloc_copy( node );
+    smspec_node_free( node );
+    test_assert_string_equal( "LGR1" , smspec_node_get_lgr_name( copy ));
+    test_assert_int_equal( 2 , smspec_node_get_lgr_ijk( copy )[1] );
+    smspec_node_free( copy );
+  }
+}
+
+
+int main( int argc , char ** argv) {
+  test_keys( ":" );
+  test_keys( "" );
+  test_keys( "::" );
+  test_node( );
+  exit(0);
+}
@@ -0,0 +1,118 @@
+/*
+   Copyright (C) 2017  Statoil ASA, Norway.
+
+   The file 'ecl_sum_columns.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include <ert/util/test_util.h>
+#include <ert/util/double_vector.h>
+#include <ert/util/util.h>
+#include <ert/util/test_work_area.h>
+
+#include <ert/ecl/ecl_sum.h>
+
+#define NUM_BLOCKS 150
+
+void write_summary( const char * name , time_t start_time , int num_dates, int num_ministep, double ministep_length) {
+  ecl_sum_type * ecl_sum = ecl_sum_alloc_writer( name , false , true , ":" , start_time , true , 10 , 10 , 10 );
+  smspec_node_type * fopt = ecl_sum_add_var( ecl_sum , "FOPT" , NULL , 0 , "Barrels" , 99.0 );
+  smspec_node_type * bpr[NUM_BLOCKS];
+  double sim_seconds = 0;
+
+  for (int i = 0; i < NUM_BLOCKS; i++)
+    bpr[i] = ecl_sum_add_var( ecl_sum , "BPR" , NULL , i + 1 , "BARS" , 0.0 );
+
+  for (int report_step = 0; report_step < num_dates; report_step++) {
+    for (int step = 0; step < num_ministep; step++) {
+      ecl_sum_tstep_type * tstep = ecl_sum_add_tstep( ecl_sum , report_step + 1 , sim_seconds );
+      ecl_sum_tstep_set_from_node( tstep , fopt , sim_seconds );
+      for (int i = 0; i < NUM_BLOCKS; i++)
+        ecl_sum_tstep_set_from_node( tstep , bpr[i] , i * 1000 + report_step * num_ministep + step );
+
+      sim_seconds += ministep_length;
+    }
+  }
+  ecl_sum_fwrite( ecl_sum );
+  ecl_sum_free( ecl_sum );
+}
+
+
+void test_columns( ecl_sum_type * ecl_sum ) {
+  int params_size = ecl_smspec_get_params_size( ecl_sum_get_smspec( ecl_sum ));
+  for (int params_index = 0; params_index < params_size; params_index++) {
+    int length;
+    const float * column = ecl_sum_iget_column( ecl_sum , params_index , &length );
+    test_assert_int_equal( length , ecl_sum_get_data_length( ecl_sum ));
+    for (int t = 0; t < length; t++)
+      test_assert_double_equal( column[t] , ecl_sum_iget( ecl_sum , t , params_index ));
+  }
+}
+
+
+void test_data_vector( ecl_sum_type * ecl_sum , const char * key ) {
+  int params_index = ecl_sum_get_general_var_params_index( ecl_sum , key );
+  double_vector_type * row_vector = ecl_sum_alloc_data_vector( ecl_sum , params_index , false );
+  double_vector_type * row_report = ecl_sum_alloc_data_vector( ecl_sum , params_index , true );
+  int length;
+
+  ecl_sum_get_column( ecl_sum , key , &length );
+  {
+    double_vector_type * col_vector = ecl_sum_alloc_data_vector( ecl_sum , params_index , false );
+    double_vector_type * col_report = ecl_sum_alloc_data_vector( ecl_sum , params_index , true );
+
+    test_assert_true( double_vector_equal( row_vector , col_vector ));
+    test_assert_true( double_vector_equal( row_report , col_report ));
+
+    double_vector_free( col_vector );
+    double_vector_free( col_report );
+  }
+  double_vector_free( row_vector );
+  double_vector_free( row_report );
+}
+
+
+void test_scale( ecl_sum_type * ecl_sum ) {
+  int length;
+  int params_index = ecl_sum_get_general_var_params_index( ecl_sum , "BPR:100" );
+  const float * column = ecl_sum_iget_column( ecl_sum , params_index , &length );
+  double value = column[ length - 1 ];
+
+  ecl_sum_scale_vector( ecl_sum , params_index , 2.0 );
+  column = ecl_sum_iget_column( ecl_sum , params_index , &length );
+  test_assert_double_equal( column[ length - 1 ] , 2 * value );
+}
+
+
+int main( int argc , char ** argv) {
+  test_work_area_type * work_area = test_work_area_alloc("sum/columns");
+  time_t start_time = util_make_date_utc( 1,1,2010 );
+  write_summary( "CASE" , start_time , 10 , 13 , 36000 );
+  {
+    ecl_sum_type * ecl_sum = ecl_sum_fread_alloc_case( "CASE" , ":" );
+    test_assert_true( ecl_sum_is_instance( ecl_sum ));
+    test_assert_int_equal( ecl_sum_get_data_length( ecl_sum ) , 130 );
+
+    test_columns( ecl_sum );
+    test_data_vector( ecl_sum , "FOPT" );
+    test_data_vector( ecl_sum , "BPR:77" );
+    test_scale( ecl_sum );
+
+    ecl_sum_free( ecl_sum );
+  }
+  test_work_area_free( work_area );
+  exit(0);
+}
@@ -0,0 +1,335 @@
+/*
+   Copyright (C) 2017  Statoil ASA, Norway.
+
+   The file 'ecl_sum_compressed.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+
+#include <ert/util/test_util.h>
+#include <ert/util/util.h>
+#include <ert/util/double_vector.h>
+#include <ert/util/stringlist.h>
+#include <ert/util/time_t_vector.h>
+#include <ert/util/test_work_area.h>
+
+#include <ert/ecl/ecl_sum.h>
+#include <ert/ecl/ecl_sum_vector.h>
+#include <ert/ecl/ecl_sum_compressed.h>
+
+#define ROW_SIZE   9
+#define NUM_BLOCKS 30
+
+
+static float test_value( int row , int column ) {
+  switch (column) {
+  case 0:
+    return 0;
+  case 1:
+    return -0.0f;
+  case 2:
+    return (row < 100) ? 1 : 2;
+  case 3:
+    return row * 1000.0f;
+  case 4:
+    return sin( row * 0.01 ) * 1e6;
+  case 5:
+    return (row % 7 == 0) ? NAN : row / 3.0f;
+  case 6:
+    return (row % 2) ? FLT_MIN / 4 : -FLT_MAX;
+  case 7:
+    return (row % 64 == 63) ? 1 : 0;
+  default:
+    return row * 3.0f;
+  }
+}
+
+
+static bool bits_equal( float value1 , float value2 ) {
+  return (memcmp( &value1 , &value2 , sizeof value1 ) == 0);
+}
+
+
+static void assert_compressed( const ecl_sum_compressed_type * compressed , int num_rows) {
+  float * target = util_calloc( num_rows , sizeof * target );
+  float row[ROW_SIZE];
+
+  test_assert_int_equal( num_rows , ecl_sum_compressed_get_num_rows( compressed ));
+  for (int r = 0; r < num_rows; r++) {
+    ecl_sum_compressed_get_row( compressed , r , row );
+    for (int c = 0; c < ROW_SIZE; c++) {
+      test_assert_true( bits_equal( test_value( r , c ) , ecl_sum_compressed_iget( compressed , r , c )));
+      test_assert_true( bits_equal( test_value( r , c ) , row[c] ));
+    }
+  }
+
+  for (int c = 0; c < ROW_SIZE; c++) {
+    ecl_sum_compressed_get_column( compressed , c , target );
+    for (int r = 0; r < num_rows; r++)
+      test_assert_true( bits_equal( test_value( r , c ) , target[r] ));
+  }
+  free( target );
+}
+
+
+/*
+  The rows are appended in batches of varying size, with a shrink
+  between the batches; the partial blocks are then reopened when the
+  next batch is appended.
+*/
+
+void test_compressed( ) {
+  ecl_sum_compressed_type * compressed = ecl_sum_compressed_alloc( ROW_SIZE );
+  const int batch_size[] = {1 , 63 , 1 , 64 , 100 , 5 , 0 , 300};
+  int num_rows = 0;
+
+  test_assert_true( ecl_sum_compressed_is_instance( compressed ));
+  for (int b = 0; b < sizeof batch_size / sizeof batch_size[0]; b++) {
+    for (int i = 0; i < batch_size[b]; i++) {
+      float row[ROW_SIZE];
+      for (int c = 0; c < ROW_SIZE; c++)
+        row[c] = test_value( num_rows , c );
+      ecl_sum_compressed_append_row( compressed , row );
+      num_rows++;
+    }
+    assert_compressed( compressed , num_rows );
+    ecl_sum_compressed_shrink( compressed );
+    assert_compressed( compressed , num_rows );
+  }
+  ecl_sum_compressed_free( compressed );
+}
+
+
+void test_constant_size( ) {
+  const int row_size = 1000;
+  const int num_rows = 2000;
+  ecl_sum_compressed_type * compressed = ecl_sum_compressed_alloc( row_size );
+  float * row = util_calloc( row_size , sizeof * row );
+
+  for (int c = 0; c < row_size; c++)
+    row[c] = c;
+
+  for (int r = 0; r < num_rows; r++)
+    ecl_sum_compressed_append_row( compressed , row );
+  ecl_sum_compressed_shrink( compressed );
+
+  test_assert_true( ecl_sum_compressed_get_byte_size( compressed ) * 10 < (size_t) row_size * num_rows * sizeof * row );
+  test_assert_double_equal( 999 , ecl_sum_compressed_iget( compressed , num_rows - 1 , 999 ));
+
+  free( row );
+  ecl_sum_compressed_free( compressed );
+}
+
+/*****************************************************************/
+
+void write_summary( const char * name , int num_reports , int num_ministep ) {
+  ecl_sum_type * ecl_sum = ecl_sum_alloc_writer( name , false , true , ":" , util_make_date_utc( 1,1,2010 ) , true , 10 , 10 , 10 );
+  smspec_node_type * fopt = ecl_sum_add_var( ecl_sum , "FOPT" , NULL , 0 , "Barrels" , 99.0 );
+  smspec_node_type * fopr = ecl_sum_add_var( ecl_sum , "FOPR" , NULL , 0 , "Barrels/day" , 99.0 );
+  smspec_node_type * bpr[NUM_BLOCKS];
+  double sim_seconds = 0;
+
+  for (int i = 0; i < NUM_BLOCKS; i++)
+    bpr[i] = ecl_sum_add_var( ecl_sum , "BPR" , NULL , i + 1 , "BARS" , 0.0 );
+
+  for (int report_step = 0; report_step < num_reports; report_step++) {
+    for (int step = 0; step < num_ministep; step++) {
+      ecl_sum_tstep_type * tstep = ecl_sum_add_tstep( ecl_sum , report_step + 1 , sim_seconds );
+      int total_step = report_step * num_ministep + step;
+
+      ecl_sum_tstep_set_from_node( tstep , fopt , sim_seconds / 17 );
+      ecl_sum_tstep_set_from_node( tstep , fopr , (total_step / 50) % 3 );
+      for (int i = 0; i < NUM_BLOCKS; i++)
+        ecl_sum_tstep_set_from_node( tstep , bpr[i] , (i % 3 == 0) ? 250 : 300 - i - total_step * 0.01 );
+      sim_seconds += 7200;
+    }
+  }
+  ecl_sum_fwrite( ecl_sum );
+  ecl_sum_free( ecl_sum );
+}
+
+
+void assert_sum_equal( const ecl_sum_type * sum1 , const ecl_sum_type * sum2 ) {
+  const int length = ecl_sum_get_data_length( sum1 );
+  const int params_size = ecl_smspec_get_params_size( ecl_sum_get_smspec( sum1 ));
+
+  test_assert_int_equal( length , ecl_sum_get_data_length( sum2 ));
+  test_assert_true( ecl_sum_report_step_equal( sum1 , sum2 ));
+  for (int t = 0; t < length; t++) {
+    test_assert_true( ecl_sum_iget_sim_time( sum1 , t ) == ecl_sum_iget_sim_time( sum2 , t ));
+    for (int p = 0; p < params_size; p++)
+      test_assert_double_equal( ecl_sum_iget( sum1 , t , p ) , ecl_sum_iget( sum2 , t , p ));
+  }
+
+  for (int p = 0; p < params_size; p++) {
+    double_vector_type * data1 = ecl_sum_alloc_data_vector( sum1 , p , false );
+    double_vector_type * data2 = ecl_sum_alloc_data_vector( sum2 , p , false );
+    test_assert_true( double_vector_equal( data1 , data2 ));
+    double_vector_free( data2 );
+    double_vector_free( data1 );
+
+    data1 = ecl_sum_alloc_data_vector( sum1 , p , true );
+    data2 = ecl_sum_alloc_data_vector( sum2 , p , true );
+    test_assert_true( double_vector_equal( data1 , data2 ));
+    double_vector_free( data2 );
+    double_vector_free( data1 );
+  }
+}
+
+
+void assert_matrix_equal( const ecl_sum_type * sum1 , const ecl_sum_type * sum2 ) {
+  const time_t start_time = ecl_sum_get_data_start( sum1 );
+  const time_t end_time = ecl_sum_get_end_time( sum1 );
+  ecl_sum_vector_type * keylist1 = ecl_sum_vector_alloc( sum1 );
+  ecl_sum_vector_type * keylist2 = ecl_sum_vector_alloc( sum2 );
+  time_t_vector_type * sim_time = time_t_vector_alloc( 0 , 0 );
+  stringlist_type * keys = stringlist_alloc_new();
+
+  for (time_t t = start_time; t <= end_time; t += 5000)
+    time_t_vector_append( sim_time , t );
+
+  stringlist_append_copy( keys , "FOPT" );
+  stringlist_append_copy( keys , "FOPR" );
+  for (int i = 0; i < NUM_BLOCKS; i++)
+    stringlist_append_owned_ref( keys , util_alloc_sprintf("BPR:%d" , i + 1));
+
+  for (int i = 0; i < stringlist_get_size( keys ); i++) {
+    test_assert_true( ecl_sum_vector_add_key( keylist1 , stringlist_iget( keys , i )));
+    test_assert_true( ecl_sum_vector_add_key( keylist2 , stringlist_iget( keys , i )));
+  }
+
+  {
+    const int num_keys = ecl_sum_vector_get_size( keylist1 );
+    const int num_times = time_t_vector_size( sim_time );
+    double * matrix1 = util_calloc( num_keys * num_times , sizeof * matrix1 );
+    double * matrix2 = util_calloc( num_keys * num_times , sizeof * matrix2 );
+
+    ecl_sum_init_data_matrix( sum1 , keylist1 , sim_time , matrix1 );
+    ecl_sum_init_data_matrix( sum2 , keylist2 , sim_time , matrix2 );
+    for (int i = 0; i < num_keys * num_times; i++)
+      test_assert_double_equal( matrix1[i] , matrix2[i] );
+
+    for (int key_index = 0; key_index < num_keys; key_index++) {
+      const char * key = stringlist_iget( keys , key_index );
+      const smspec_node_type * node = ecl_sum_get_general_var_node( sum2 , key );
+      for (int time_index = 0; time_index < num_times; time_index++)
+        test_assert_double_equal( matrix1[ key_index * num_times + time_index ] , ecl_sum_get_from_sim_time( sum2 , time_t_vector_iget( sim_time , time_index ) , node ));
+    }
+
+    free( matrix2 );
+    free( matrix1 );
+  }
+
+  stringlist_free( keys );
+  time_t_vector_free( sim_time );
+  ecl_sum_vector_free( keylist2 );
+  ecl_sum_vector_free( keylist1 );
+}
+
+
+void test_sum( ) {
+  test_work_area_type * work_area = test_work_area_alloc("sum/compressed");
+  write_summary( "CASE" , 10 , 37 );
+  {
+    ecl_sum_type * ecl_sum = ecl_sum_fread_alloc_case( "CASE" , ":" );
+    ecl_sum_type * compressed = ecl_sum_fread_alloc_case( "CASE" , ":" );
+
+    test_assert_false( ecl_sum_is_compressed( compressed ));
+    ecl_sum_compress( compressed );
+    test_assert_true( ecl_sum_is_compressed( compressed ));
+    assert_sum_equal( ecl_sum , compressed );
+    assert_matrix_equal( ecl_sum , compressed );
+
+    {
+      int length1 , length2;
+      const float * column1 = ecl_sum_get_column( ecl_sum , "BPR:5" , &length1 );
+      const float * column2 = ecl_sum_get_column( compressed , "BPR:5" , &length2 );
+      test_assert_int_equal( length1 , length2 );
+      test_assert_int_equal( 0 , memcmp( column1 , column2 , length1 * sizeof * column1 ));
+    }
+
+    {
+      int params_index = ecl_sum_get_general_var_params_index( ecl_sum , "FOPT" );
+      ecl_sum_scale_vector( ecl_sum , params_index , 0.5 );
+      ecl_sum_scale_vector( compressed , params_index , 0.5 );
+      ecl_sum_shift_vector( ecl_sum , params_index , 100 );
+      ecl_sum_shift_vector( compressed , params_index , 100 );
+      test_assert_true( ecl_sum_is_compressed( compressed ));
+      assert_sum_equal( ecl_sum , compressed );
+    }
+
+    ecl_sum_set_case( compressed , "COPY" );
+    ecl_sum_fwrite( compressed );
+    {
+      ecl_sum_type * copy = ecl_sum_fread_alloc_case( "COPY" , ":" );
+      assert_sum_equal( ecl_sum , copy );
+      ecl_sum_free( copy );
+    }
+
+    ecl_sum_free( compressed );
+    ecl_sum_free( ecl_sum );
+  }
+  test_work_area_free( work_area );
+}
+
+
+/* New ministeps loaded with ecl_sum_fread_refresh() are compressed as they are added. */
+void test_refresh( ) {
+  test_work_area_type * work_area = test_work_area_alloc("sum/compressed_refresh");
+  write_summary( "FULL" , 10 , 37 );
+  write_summary( "LIVE" , 3 , 37 );
+  {
+    ecl_sum_type * full = ecl_sum_fread_alloc_case( "FULL" , ":" );
+    ecl_sum_type * live = ecl_sum_fread_alloc_case( "LIVE" , ":" );
+    const long full_size = util_file_size( "FULL.UNSMRY" );
+    long offset = util_file_size( "LIVE.UNSMRY" );
+
+    ecl_sum_compress( live );
+    while (offset < full_size) {
+      long next_offset = util_int_min( offset + 2000 , full_size );
+      FILE * src = util_fopen( "FULL.UNSMRY" , "r");
+      FILE * target = util_fopen( "LIVE.UNSMRY" , "a");
+      char * buffer = util_malloc( next_offset - offset );
+
+      util_fseek( src , offset , SEEK_SET );
+      util_fread( buffer , 1 , next_offset - offset , src , __func__ );
+      util_fwrite( buffer , 1 , next_offset - offset , target , __func__ );
+      free( buffer );
+      fclose( target );
+      fclose( src );
+      offset = next_offset;
+
+      ecl_sum_fread_refresh( live );
+      test_assert_true( ecl_sum_is_compressed( live ));
+    }
+    assert_sum_equal( full , live );
+
+    ecl_sum_free( live );
+    ecl_sum_free( full );
+  }
+  test_work_area_free( work_area );
+}
+
+
+int main( int argc , char ** argv) {
+  test_compressed( );
+  test_constant_size( );
+  test_sum( );
+  test_refresh( );
+  exit(0);
+}
@@ -0,0 +1,166 @@
+/*
+   Copyright (C) 2017  Statoil ASA, Norway.
+
+   The file 'ecl_sum_data_matrix.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+#include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
+
+#include <ert/util/test_util.h>
+#include <ert/util/double_vector.h>
+#include <ert/util/time_t_vector.h>
+#include <ert/util/util.h>
+#include <ert/util/test_work_area.h>
+
+#include <ert/ecl/ecl_sum.h>
+#include <ert/ecl/ecl_sum_vector.h>
+
+#define NUM_BLOCKS 20
+
+void write_summary( const char * name , time_t start_time , int num_dates, int num_ministep, double ministep_length) {
+  ecl_sum_type * ecl_sum = ecl_sum_alloc_writer( name , false , true , ":" , start_time , true , 10 , 10 , 10 );
+  smspec_node_type * fopt = ecl_sum_add_var( ecl_sum , "FOPT" , NULL , 0 , "Barrels" , 99.0 );
+  smspec_node_type * fopr = ecl_sum_add_var( ecl_sum , "FOPR" , NULL , 0 , "Barrels/day" , 99.0 );
+  smspec_node_type * bpr[NUM_BLOCKS];
+  double sim_seconds = 0;
+
+  for (int i = 0; i < NUM_BLOCKS; i++)
+    bpr[i] = ecl_sum_add_var( ecl_sum , "BPR" , NULL , i + 1 , "BARS" , 0.0 );
+
+  for (int report_step = 0; report_step < num_dates; report_step++) {
+    for (int step = 0; step < num_ministep; step++) {
+      ecl_sum_tstep_type * tstep = ecl_sum_add_tstep( ecl_sum , report_step + 1 , sim_seconds );
+      ecl_sum_tstep_set_from_node( tstep , fopt , sim_seconds );
+      ecl_sum_tstep_set_from_node( tstep , fopr , (report_step * num_ministep + step) % 7 );
+      for (int i = 0; i < NUM_BLOCKS; i++)
+        ecl_sum_tstep_set_from_node( tstep , bpr[i] , i * 1000 + (report_step * num_ministep + step) * (report_step * num_ministep + step) );
+
+      sim_seconds += ministep_length;
+    }
+  }
+  ecl_sum_fwrite( ecl_sum );
+  ecl_sum_free( ecl_sum );
+}
+
+
+/* All the ministeps; i.e. no interpolation. */
+void test_ministeps( const ecl_sum_type * ecl_sum , const ecl_sum_vector_type * keylist ) {
+  const int num_keys = ecl_sum_vector_get_size( keylist );
+  const int length = ecl_sum_get_data_length( ecl_sum );
+  double * matrix = util_calloc( num_keys * length , sizeof * matrix );
+
+  ecl_sum_init_data_matrix( ecl_sum , keylist , NULL , matrix );
+  for (int key_index = 0; key_index < num_keys; key_index++) {
+    int params_index = ecl_sum_vector_iget_param_index( keylist , key_index );
+    for (int t = 0; t < length; t++)
+      test_assert_double_equal( ecl_sum_iget( ecl_sum , t , params_index ) , matrix[ key_index * length + t ]);
+  }
+  free( matrix );
+}
+
+
+void test_time_axis( const ecl_sum_type * ecl_sum , const ecl_sum_vector_type * keylist , const stringlist_type * keys) {
+  const int num_keys = ecl_sum_vector_get_size( keylist );
+  const time_t start_time = ecl_sum_get_data_start( ecl_sum );
+  const time_t end_time = ecl_sum_get_end_time( ecl_sum );
+  time_t_vector_type * sim_time = time_t_vector_alloc( 0 , 0 );
+  int num_times;
+
+  time_t_vector_append( sim_time , start_time - 3600 );
+  time_t_vector_append( sim_time , start_time );
+  for (time_t t = start_time + 1000; t < end_time; t += 7777)
+    time_t_vector_append( sim_time , t );
+  time_t_vector_append( sim_time , end_time );
+  time_t_vector_append( sim_time , end_time );
+  time_t_vector_append( sim_time , end_time + 1 );
+  num_times = time_t_vector_size( sim_time );
+
+  {
+    double * matrix = util_calloc( num_keys * num_times , sizeof * matrix );
+    ecl_sum_init_data_matrix( ecl_sum , keylist , sim_time , matrix );
+
+    for (int key_index = 0; key_index < num_keys; key_index++) {
+      const char * key = stringlist_iget( keys , key_index );
+      const smspec_node_type * node = ecl_sum_get_general_var_node( ecl_sum , key );
+      const double * key_data = &matrix[ key_index * num_times ];
+
+      test_assert_true( isnan( key_data[0] ));
+      test_assert_true( isnan( key_data[num_times - 1] ));
+      test_assert_double_equal( ecl_sum_iget( ecl_sum , 0 , smspec_node_get_params_index( node )) , key_data[1] );
+      for (int time_index = 2; time_index < num_times - 1; time_index++)
+        test_assert_double_equal( ecl_sum_get_from_sim_time( ecl_sum , time_t_vector_iget( sim_time , time_index ) , node ) , key_data[time_index] );
+
+      {
+        double_vector_type * resampled = double_vector_alloc( 0 , 0 );
+        time_t_vector_type * inside_time = time_t_vector_alloc( 0 , 0 );
+        for (int time_index = 2; time_index < num_times - 1; time_index++)
+          time_t_vector_append( inside_time , time_t_vector_iget( sim_time , time_index ));
+
+        ecl_sum_resample_from_sim_time( ecl_sum , inside_time , resampled , key );
+        test_assert_int_equal( num_times - 3 , double_vector_size( resampled ));
+        for (int time_index = 2; time_index < num_times - 1; time_index++)
+          test_assert_double_equal( key_data[time_index] , double_vector_iget( resampled , time_index - 2 ));
+
+        time_t_vector_free( inside_time );
+        double_vector_free( resampled );
+      }
+    }
+    free( matrix );
+  }
+  time_t_vector_free( sim_time );
+}
+
+
+void test_matrix( ecl_sum_type * ecl_sum ) {
+  stringlist_type * keys = stringlist_alloc_new();
+  ecl_sum_vector_type * keylist = ecl_sum_vector_alloc( ecl_sum );
+
+  stringlist_append_copy( keys , "FOPR" );
+  stringlist_append_copy( keys , "FOPT" );
+  stringlist_append_copy( keys , "BPR:7" );
+  stringlist_append_copy( keys , "BPR:20" );
+  for (int i = 0; i < stringlist_get_size( keys ); i++)
+    test_assert_true( ecl_sum_vector_add_key( keylist , stringlist_iget( keys , i )));
+
+  test_ministeps( ecl_sum , keylist );
+  test_time_axis( ecl_sum , keylist , keys );
+
+  /* Again - now reading from the column block. */
+  {
+    int length;
+    ecl_sum_iget_column( ecl_sum , 0 , &length );
+  }
+  test_ministeps( ecl_sum , keylist );
+  test_time_axis( ecl_sum , keylist , keys );
+
+  ecl_sum_vector_free( keylist );
+  stringlist_free( keys );
+}
+
+
+int main( int argc , char ** argv) {
+  test_work_area_type * work_area = test_work_area_alloc("sum/data_matrix");
+  time_t start_time = util_make_date_utc( 1,1,2010 );
+  write_summary( "CASE" , start_time , 10 , 13 , 36000 );
+  {
+    ecl_sum_type * ecl_sum = ecl_sum_fread_alloc_case( "CASE" , ":" );
+    test_assert_true( ecl_sum_is_instance( ecl_sum ));
+    test_matrix( ecl_sum );
+    ecl_sum_free( ecl_sum );
+  }
+  test_work_area_free( work_area );
+  exit(0);
+}
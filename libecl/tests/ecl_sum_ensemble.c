@@ -0,0 +1,197 @@
+/*
+   Copyright (C) 2017  Statoil ASA, Norway.
+
+   The file 'ecl_sum_ensemble.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+#include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
+
+#include <ert/util/test_util.h>
+#include <ert/util/time_t_vector.h>
+#include <ert/util/double_vector.h>
+#include <ert/util/stringlist.h>
+#include <ert/util/statistics.h>
+#include <ert/util/util.h>
+#include <ert/util/test_work_area.h>
+
+#include <ert/ecl/ecl_sum.h>
+#include <ert/ecl/ecl_sum_ensemble.h>
+
+
+#define ENS_SIZE 25
+
+
+/*
+  Case iens has num_dates + (iens % 4) report steps; i.e. the cases
+  have differing length. The WWCT:OP-1 vector is only written for
+  the even cases.
+*/
+
+void write_case( const char * name , int iens , time_t start_time ) {
+  ecl_sum_type * ecl_sum = ecl_sum_alloc_writer( name , false , true , ":" , start_time , true , 10 , 10 , 10 );
+  smspec_node_type * node1 = ecl_sum_add_var( ecl_sum , "FOPT" , NULL   , 0 , "Barrels" , 0.0 );
+  smspec_node_type * node2 = NULL;
+  int num_steps = 10 + (iens % 4);
+  double scale = 1 + ((iens * 7) % ENS_SIZE);
+  int step;
+
+  if ((iens % 2) == 0)
+    node2 = ecl_sum_add_var( ecl_sum , "WWCT" , "OP-1" , 0 , "(1)" , 0.0 );
+
+  for (step = 0; step < num_steps; step++) {
+    double sim_seconds = step * 86400.0;
+    ecl_sum_tstep_type * tstep = ecl_sum_add_tstep( ecl_sum , step + 1 , sim_seconds );
+    ecl_sum_tstep_set_from_node( tstep , node1 , scale * step );
+    if (node2)
+      ecl_sum_tstep_set_from_node( tstep , node2 , (step % 3) * 0.25 );
+  }
+  ecl_sum_fwrite( ecl_sum );
+  ecl_sum_free( ecl_sum );
+}
+
+
+void test_quantiles( const ecl_sum_ensemble_type * ensemble , const char * key , int num_quantiles , const double * quantiles ) {
+  const time_t_vector_type * interp_time = ecl_sum_ensemble_get_time_interp( ensemble );
+  const int num_interp = time_t_vector_size( interp_time );
+  const int key_index = ecl_sum_ensemble_get_key_index( ensemble , key );
+  double * values = ecl_sum_ensemble_alloc_quantiles( ensemble , num_quantiles , quantiles );
+  double_vector_type * column = double_vector_alloc( 0 , 0 );
+  int time_index;
+
+  test_assert_true( key_index >= 0 );
+  for (time_index = 0; time_index < num_interp; time_index++) {
+    time_t sim_time = time_t_vector_iget( interp_time , time_index );
+    int iens;
+
+    double_vector_reset( column );
+    for (iens = 0; iens < ecl_sum_ensemble_get_size( ensemble ); iens++) {
+      const ecl_sum_type * ecl_sum = ecl_sum_ensemble_iget_case( ensemble , iens );
+      if (ecl_sum_has_general_var( ecl_sum , key ) &&
+          (sim_time >= ecl_sum_get_start_time( ecl_sum )) &&
+          (sim_time <= ecl_sum_get_end_time( ecl_sum )))
+        double_vector_append( column , ecl_sum_get_general_var_from_sim_time( ecl_sum , sim_time , key ));
+      else
+        test_assert_true( isnan( ecl_sum_ensemble_iget_resampled( ensemble , iens , key_index , time_index )));
+    }
+
+    {
+      int iq;
+      for (iq = 0; iq < num_quantiles; iq++) {
+        double value = values[ ((size_t) key_index * num_interp + time_index) * num_quantiles + iq ];
+        if (double_vector_size( column ) > 0)
+          test_assert_double_equal( statistics_empirical_quantile( column , quantiles[iq] ) , value );
+        else
+          test_assert_true( isnan( value ));
+      }
+    }
+  }
+  double_vector_free( column );
+  free( values );
+}
+
+
+void test_ensemble( int num_threads ) {
+  test_work_area_type * work_area = test_work_area_alloc("sum/ensemble");
+  time_t start_time = util_make_date_utc( 1,1,2010 );
+  stringlist_type * case_list = stringlist_alloc_new();
+  ecl_sum_ensemble_type * ensemble = ecl_sum_ensemble_alloc( num_threads );
+  const double quantiles[] = { 0.10 , 0.50 , 0.90 , 0.0 , 1.0 , 0.333 };
+  int iens;
+
+  test_assert_true( ecl_sum_ensemble_is_instance( ensemble ));
+  for (iens = 0; iens < ENS_SIZE; iens++) {
+    char * name = util_alloc_sprintf("CASE_%d" , iens );
+    write_case( name , iens , start_time );
+    stringlist_append_owned_ref( case_list , name );
+  }
+  stringlist_append_copy( case_list , "DOES_NOT_EXIST" );
+
+  test_assert_int_equal( ENS_SIZE , ecl_sum_ensemble_load_cases( ensemble , case_list , ":" ));
+  test_assert_int_equal( ENS_SIZE , ecl_sum_ensemble_get_size( ensemble ));
+  for (iens = 0; iens < ENS_SIZE; iens++) {
+    const ecl_sum_type * ecl_sum = ecl_sum_ensemble_iget_case( ensemble , iens );
+    char * name = util_alloc_sprintf("CASE_%d" , iens );
+    test_assert_string_equal( name , ecl_sum_get_base( ecl_sum ));
+    free( name );
+  }
+  test_assert_time_t_equal( start_time , ecl_sum_ensemble_get_start_time( ensemble ));
+
+  test_assert_int_equal( 0 , ecl_sum_ensemble_add_key( ensemble , "FOPT" ));
+  test_assert_int_equal( 1 , ecl_sum_ensemble_add_key( ensemble , "WWCT:OP-1" ));
+  test_assert_int_equal( 2 , ecl_sum_ensemble_add_key( ensemble , "FWPT" ));
+  test_assert_int_equal( 0 , ecl_sum_ensemble_add_key( ensemble , "FOPT" ));
+  test_assert_int_equal( 3 , ecl_sum_ensemble_get_num_keys( ensemble ));
+
+  ecl_sum_ensemble_init_time_interp( ensemble , 37 );
+  test_assert_int_equal( 37 , time_t_vector_size( ecl_sum_ensemble_get_time_interp( ensemble )));
+  ecl_sum_ensemble_resample( ensemble );
+
+  test_quantiles( ensemble , "FOPT" , 6 , quantiles );
+  test_quantiles( ensemble , "WWCT:OP-1" , 6 , quantiles );
+  test_quantiles( ensemble , "FWPT" , 3 , quantiles );
+
+  /* The quantiles registered with the ensemble - as used by ecl_quantile. */
+  {
+    double * values = ecl_sum_ensemble_alloc_quantiles( ensemble , 6 , quantiles );
+    const int num_interp = time_t_vector_size( ecl_sum_ensemble_get_time_interp( ensemble ));
+    int iq, key_index, time_index;
+
+    for (iq = 0; iq < 6; iq++)
+      test_assert_int_equal( iq , ecl_sum_ensemble_add_quantile( ensemble , quantiles[iq] ));
+    test_assert_int_equal( 2 , ecl_sum_ensemble_add_quantile( ensemble , 0.90 ));
+    test_assert_int_equal( 6 , ecl_sum_ensemble_get_num_quantiles( ensemble ));
+    test_assert_int_equal( 5 , ecl_sum_ensemble_get_quantile_index( ensemble , 0.333 ));
+    test_assert_int_equal( -1 , ecl_sum_ensemble_get_quantile_index( ensemble , 0.25 ));
+
+    ecl_sum_ensemble_calculate( ensemble );
+    for (key_index = 0; key_index < ecl_sum_ensemble_get_num_keys( ensemble ); key_index++)
+      for (time_index = 0; time_index < num_interp; time_index++)
+        for (iq = 0; iq < 6; iq++) {
+          double expected = values[ ((size_t) key_index * num_interp + time_index) * 6 + iq ];
+          double value = ecl_sum_ensemble_iget_quantile( ensemble , key_index , time_index , iq );
+          if (isnan( expected ))
+            test_assert_true( isnan( value ));
+          else
+            test_assert_double_equal( expected , value );
+        }
+    free( values );
+  }
+
+  {
+    stringlist_type * missing_cases = stringlist_alloc_new();
+    test_assert_true( ecl_sum_ensemble_has_key( ensemble , "FOPT" , missing_cases ));
+    test_assert_int_equal( 0 , stringlist_get_size( missing_cases ));
+
+    test_assert_false( ecl_sum_ensemble_has_key( ensemble , "WWCT:OP-1" , missing_cases ));
+    test_assert_int_equal( ENS_SIZE / 2 , stringlist_get_size( missing_cases ));
+    test_assert_true( stringlist_contains( missing_cases , "CASE_1" ));
+    test_assert_false( stringlist_contains( missing_cases , "CASE_2" ));
+
+    test_assert_false( ecl_sum_ensemble_has_key( ensemble , "FWPT" , NULL ));
+    stringlist_free( missing_cases );
+  }
+
+  ecl_sum_ensemble_free( ensemble );
+  stringlist_free( case_list );
+  test_work_area_free( work_area );
+}
+
+
+int main( int argc , char ** argv) {
+  test_ensemble( 1 );
+  test_ensemble( 4 );
+  exit(0);
+}
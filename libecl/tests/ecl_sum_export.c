@@ -0,0 +1,239 @@
+/*
+   Copyright (C) 2017  Statoil ASA, Norway.
+
+   The file 'ecl_sum_export.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <math.h>
+#include <string.h>
+
+#include <ert/util/test_util.h>
+#include <ert/util/stringlist.h>
+#include <ert/util/util.h>
+#include <ert/util/test_work_area.h>
+
+#include <ert/ecl/ecl_sum.h>
+
+#define NUM_WELLS 80
+
+
+static double well_value( int well , int step ) {
+  switch (well % 5) {
+  case 0:
+    return step / 3.0;
+  case 1:
+    return -1e-5 * step * well;
+  case 2:
+    return 123456789.0 * step;
+  case 3:
+    return step * 0.125;
+  default:
+    return sin( step + well ) * 1e7;
+  }
+}
+
+
+void write_summary( const char * name , time_t start_time , int num_dates, int num_ministep) {
+  ecl_sum_type * ecl_sum = ecl_sum_alloc_writer( name , false , true , ":" , start_time , true , 10 , 10 , 10 );
+  smspec_node_type * fopt = ecl_sum_add_var( ecl_sum , "FOPT" , NULL , 0 , "Barrels" , 99.0 );
+  smspec_node_type * wopr[NUM_WELLS];
+  double sim_seconds = 0;
+
+  for (int i = 0; i < NUM_WELLS; i++) {
+    char * well = util_alloc_sprintf("W%d" , i);
+    wopr[i] = ecl_sum_add_var( ecl_sum , "WOPR" , well , 0 , "Barrels/day" , 0.0 );
+    free( well );
+  }
+
+  for (int report_step = 0; report_step < num_dates; report_step++) {
+    for (int step = 0; step < num_ministep; step++) {
+      int total_step = report_step * num_ministep + step;
+      ecl_sum_tstep_type * tstep = ecl_sum_add_tstep( ecl_sum , report_step + 1 , sim_seconds );
+      ecl_sum_tstep_set_from_node( tstep , fopt , sim_seconds / 7 );
+      for (int i = 0; i < NUM_WELLS; i++)
+        ecl_sum_tstep_set_from_node( tstep , wopr[i] , well_value( i , total_step ));
+      sim_seconds += 11111;
+    }
+  }
+  ecl_sum_fwrite( ecl_sum );
+  ecl_sum_free( ecl_sum );
+}
+
+
+/* Straightforward fprintf() implementation of the csv format. */
+void write_reference_csv( const ecl_sum_type * ecl_sum , const stringlist_type * keys , const char * filename) {
+  FILE * stream = util_fopen( filename , "w");
+  fprintf(stream , "DAYS;DATE");
+  for (int i = 0; i < stringlist_get_size( keys ); i++)
+    if (ecl_sum_has_general_var( ecl_sum , stringlist_iget( keys , i )))
+      fprintf(stream , ";%s" , stringlist_iget( keys , i ));
+  fprintf(stream , "\r\n");
+
+  for (int time_index = 0; time_index < ecl_sum_get_data_length( ecl_sum ); time_index++) {
+    char date_string[128];
+    struct tm ts;
+    time_t sim_time = ecl_sum_iget_sim_time( ecl_sum , time_index );
+    util_time_utc( &sim_time , &ts );
+    strftime( date_string , sizeof date_string - 1 , "%Y-%m-%d" , &ts );
+    fprintf(stream , "%7.2f;%s" , ecl_sum_iget_sim_days( ecl_sum , time_index ) , date_string );
+
+    for (int i = 0; i < stringlist_get_size( keys ); i++) {
+      const char * key = stringlist_iget( keys , i );
+      if (ecl_sum_has_general_var( ecl_sum , key ))
+        fprintf(stream , ";%g" , ecl_sum_get_general_var( ecl_sum , time_index , key ));
+    }
+    fprintf(stream , "\r\n");
+  }
+  fclose( stream );
+}
+
+
+void test_csv( const ecl_sum_type * ecl_sum , const stringlist_type * keys ) {
+  write_reference_csv( ecl_sum , keys , "reference.csv");
+  ecl_sum_export_csv( ecl_sum , "export.csv" , keys , "%Y-%m-%d" , ";");
+  test_assert_true( util_files_equal( "reference.csv" , "export.csv" ));
+}
+
+
+void test_columns( const ecl_sum_type * ecl_sum , const stringlist_type * keys ) {
+  const int num_rows = ecl_sum_get_data_length( ecl_sum );
+  ecl_sum_export_columns( ecl_sum , "export.bin" , keys );
+  {
+    FILE * stream = util_fopen( "export.bin" , "r");
+    int num_columns;
+    int64_t start_time;
+
+    test_assert_int_equal( 0x45434c43 , util_fread_int( stream ));
+    test_assert_int_equal( 1 , util_fread_int( stream ));
+    num_columns = util_fread_int( stream );
+    test_assert_int_equal( stringlist_get_size( keys ) - 1 , num_columns );
+    test_assert_int_equal( num_rows , util_fread_int( stream ));
+    util_fread( &start_time , sizeof start_time , 1 , stream , __func__ );
+    test_assert_true( start_time == ecl_sum_get_start_time( ecl_sum ));
+
+    {
+      stringlist_type * columns = stringlist_alloc_new();
+      for (int i = 0; i < num_columns; i++) {
+        char * key = util_fread_alloc_string( stream );
+        char * unit = util_fread_alloc_string( stream );
+
+        test_assert_string_equal( unit , ecl_sum_get_unit( ecl_sum , key ));
+        stringlist_append_owned_ref( columns , key );
+        free( unit );
+      }
+
+      {
+        double * days = util_calloc( num_rows , sizeof * days );
+        util_fread( days , sizeof * days , num_rows , stream , __func__ );
+        for (int t = 0; t < num_rows; t++)
+          test_assert_double_equal( ecl_sum_iget_sim_days( ecl_sum , t ) , days[t] );
+        free( days );
+      }
+
+      {
+        float * column = util_calloc( num_rows , sizeof * column );
+        for (int i = 0; i < num_columns; i++) {
+          const char * key = stringlist_iget( columns , i );
+          util_fread( column , sizeof * column , num_rows , stream , __func__ );
+          for (int t = 0; t < num_rows; t++)
+            test_assert_true( column[t] == (float) ecl_sum_get_general_var( ecl_sum , t , key ));
+        }
+        free( column );
+      }
+      stringlist_free( columns );
+    }
+    test_assert_int_equal( EOF , fgetc( stream ));
+    fclose( stream );
+  }
+}
+
+
+static stringlist_type * alloc_tokens( const char * filename , int * max_line_length) {
+  char * content = util_fread_alloc_file_content( filename , NULL );
+  stringlist_type * lines = stringlist_alloc_from_split( content , "\n" );
+  stringlist_type * tokens = stringlist_alloc_from_split( content , " \n" );
+
+  *max_line_length = 0;
+  for (int i = 0; i < stringlist_get_size( lines ); i++)
+    *max_line_length = util_int_max( *max_line_length , strlen( stringlist_iget( lines , i )));
+
+  stringlist_free( lines );
+  free( content );
+  return tokens;
+}
+
+
+/*
+  A value format wider than the internal formatting buffer must not
+  overflow it; apart from the padding the output should be equal to
+  the normal summary.x output.
+*/
+
+void test_wide_fmt( const ecl_sum_type * ecl_sum , const stringlist_type * keys ) {
+  char wide_fmt[] = " %300.6g ";
+  ecl_sum_fmt_type fmt;
+
+  ecl_sum_fmt_init_summary_x( ecl_sum , &fmt );
+  {
+    FILE * stream = util_fopen( "normal.txt" , "w");
+    ecl_sum_fprintf( ecl_sum , stream , keys , false , &fmt );
+    fclose( stream );
+  }
+
+  fmt.value_fmt = wide_fmt;
+  {
+    FILE * stream = util_fopen( "wide.txt" , "w");
+    ecl_sum_fprintf( ecl_sum , stream , keys , false , &fmt );
+    fclose( stream );
+  }
+
+  {
+    int normal_length, wide_length;
+    stringlist_type * normal = alloc_tokens( "normal.txt" , &normal_length );
+    stringlist_type * wide = alloc_tokens( "wide.txt" , &wide_length );
+
+    test_assert_true( stringlist_equal( normal , wide ));
+    test_assert_true( wide_length > 300 * (stringlist_get_size( keys ) - 1));
+
+    stringlist_free( normal );
+    stringlist_free( wide );
+  }
+}
+
+
+int main( int argc , char ** argv) {
+  test_work_area_type * work_area = test_work_area_alloc("sum/export");
+  write_summary( "CASE" , util_make_date_utc( 1,1,2010 ) , 10 , 17 );
+  {
+    ecl_sum_type * ecl_sum = ecl_sum_fread_alloc_case( "CASE" , ":" );
+    stringlist_type * keys = stringlist_alloc_new();
+
+    stringlist_append_copy( keys , "FOPT" );
+    stringlist_append_copy( keys , "NO:SUCH:KEY" );
+    for (int i = NUM_WELLS - 1; i >= 0; i--)
+      stringlist_append_owned_ref( keys , util_alloc_sprintf("WOPR:W%d" , i));
+
+    test_csv( ecl_sum , keys );
+    test_columns( ecl_sum , keys );
+    test_wide_fmt( ecl_sum , keys );
+
+    stringlist_free( keys );
+    ecl_sum_free( ecl_sum );
+  }
+  test_work_area_free( work_area );
+  exit(0);
+}
@@ -0,0 +1,84 @@
+/*
+   Copyright (C) 2017  Statoil ASA, Norway.
+
+   The file 'ecl_sum_parallel_load.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include <ert/util/test_util.h>
+#include <ert/util/util.h>
+#include <ert/util/test_work_area.h>
+
+#include <ert/ecl/ecl_sum.h>
+
+
+void write_summary( const char * name , time_t start_time , int num_dates, int num_ministep, double ministep_length) {
+  ecl_sum_type * ecl_sum = ecl_sum_alloc_writer( name , false , false , ":" , start_time , true , 10 , 10 , 10 );
+  smspec_node_type * fopt = ecl_sum_add_var( ecl_sum , "FOPT" , NULL   , 0  , "Barrels" , 99.0 );
+  smspec_node_type * bpr  = ecl_sum_add_var( ecl_sum , "BPR"  , NULL   , 56 , "BARS"    , 0.0  );
+  smspec_node_type * wwct = ecl_sum_add_var( ecl_sum , "WWCT" , "OP-1" , 0  , "(1)"     , 0.0  );
+  double sim_seconds = 0;
+
+  for (int report_step = 0; report_step < num_dates; report_step++) {
+    for (int step = 0; step < num_ministep; step++) {
+      ecl_sum_tstep_type * tstep = ecl_sum_add_tstep( ecl_sum , report_step + 1 , sim_seconds );
+      ecl_sum_tstep_set_from_node( tstep , fopt , sim_seconds );
+      ecl_sum_tstep_set_from_node( tstep , bpr  , report_step );
+      ecl_sum_tstep_set_from_node( tstep , wwct , step );
+      sim_seconds += ministep_length;
+    }
+  }
+  ecl_sum_fwrite( ecl_sum );
+  ecl_sum_free( ecl_sum );
+}
+
+
+void test_equal( const ecl_sum_type * sum1 , const ecl_sum_type * sum2 ) {
+  int params_size = ecl_smspec_get_params_size( ecl_sum_get_smspec( sum1 ));
+
+  test_assert_int_equal( ecl_sum_get_data_length( sum1 ) , ecl_sum_get_data_length( sum2 ));
+  test_assert_int_equal( ecl_sum_get_first_report_step( sum1 ) , ecl_sum_get_first_report_step( sum2 ));
+  test_assert_int_equal( ecl_sum_get_last_report_step( sum1 ) , ecl_sum_get_last_report_step( sum2 ));
+
+  for (int time_index = 0; time_index < ecl_sum_get_data_length( sum1 ); time_index++) {
+    test_assert_time_t_equal( ecl_sum_iget_sim_time( sum1 , time_index ) , ecl_sum_iget_sim_time( sum2 , time_index ));
+    test_assert_int_equal( ecl_sum_iget_report_step( sum1 , time_index ) , ecl_sum_iget_report_step( sum2 , time_index ));
+    for (int params_index = 0; params_index < params_size; params_index++)
+      test_assert_double_equal( ecl_sum_iget( sum1 , time_index , params_index ) , ecl_sum_iget( sum2 , time_index , params_index ));
+  }
+}
+
+
+int main( int argc , char ** argv) {
+  test_work_area_type * work_area = test_work_area_alloc("sum/parallel_load");
+  time_t start_time = util_make_date_utc( 1,1,2010 );
+  write_summary( "CASE" , start_time , 25 , 7 , 36000 );
+  {
+    ecl_sum_type * sum_seq = ecl_sum_fread_alloc_case( "CASE" , ":" );
+    test_assert_true( util_file_exists( "CASE.S0001" ));
+    test_assert_int_equal( ecl_sum_get_data_length( sum_seq ) , 25 * 7 );
+
+    for (int load_threads = 1; load_threads <= 8; load_threads *= 2) {
+      ecl_sum_type * sum_par = ecl_sum_fread_alloc_case_parallel( "CASE" , ":" , true , load_threads );
+      test_assert_true( ecl_sum_is_instance( sum_par ));
+      test_equal( sum_seq , sum_par );
+      ecl_sum_free( sum_par );
+    }
+    ecl_sum_free( sum_seq );
+  }
+  test_work_area_free( work_area );
+  exit(0);
+}
@@ -0,0 +1,253 @@
+/*
+   Copyright (C) 2017  Statoil ASA, Norway.
+
+   The file 'ecl_sum_refresh.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include <ert/util/test_util.h>
+#include <ert/util/util.h>
+#include <ert/util/test_work_area.h>
+
+#include <ert/ecl/ecl_sum.h>
+#include <ert/ecl/ecl_util.h>
+#include <ert/ecl/ecl_smspec.h>
+
+#define NUM_REPORTS  8
+#define NUM_MINISTEP 5
+
+
+void write_summary( const char * name , bool fmt , bool unified , int num_reports) {
+  time_t start_time = util_make_date_utc( 1,1,2010 );
+  ecl_sum_type * ecl_sum = ecl_sum_alloc_writer( name , fmt , unified , ":" , start_time , true , 10 , 10 , 10 );
+  smspec_node_type * fopt = ecl_sum_add_var( ecl_sum , "FOPT" , NULL , 0 , "Barrels" , 99.0 );
+  smspec_node_type * fopr = ecl_sum_add_var( ecl_sum , "FOPR" , NULL , 0 , "Barrels/day" , 99.0 );
+  smspec_node_type * bpr  = ecl_sum_add_var( ecl_sum , "BPR" , NULL , 567 , "BARS" , 0.0 );
+  double sim_seconds = 0;
+
+  for (int report_step = 0; report_step < num_reports; report_step++) {
+    for (int step = 0; step < NUM_MINISTEP; step++) {
+      ecl_sum_tstep_type * tstep = ecl_sum_add_tstep( ecl_sum , report_step + 1 , sim_seconds );
+      ecl_sum_tstep_set_from_node( tstep , fopt , sim_seconds / 100 );
+      ecl_sum_tstep_set_from_node( tstep , fopr , report_step * 10 + step );
+      ecl_sum_tstep_set_from_node( tstep , bpr  , 1000 - step * report_step );
+      sim_seconds += 3600 * (1 + step);
+    }
+  }
+  ecl_sum_fwrite( ecl_sum );
+  ecl_sum_free( ecl_sum );
+}
+
+
+/* Appends the bytes [offset1, offset2) of @src_file to @target_file. */
+void append_bytes( const char * src_file , const char * target_file , long offset1 , long offset2) {
+  FILE * src = util_fopen( src_file , "r");
+  FILE * target = util_fopen( target_file , "a");
+  char * buffer = util_malloc( offset2 - offset1 + 1 );
+
+  util_fseek( src , offset1 , SEEK_SET );
+  util_fread( buffer , 1 , offset2 - offset1 , src , __func__ );
+  util_fwrite( buffer , 1 , offset2 - offset1 , target , __func__ );
+
+  free( buffer );
+  fclose( target );
+  fclose( src );
+}
+
+
+/* The data in @live must be equal to the first part of the data in @full. */
+void assert_prefix( const ecl_sum_type * live , const ecl_sum_type * full ) {
+  const int length = ecl_sum_get_data_length( live );
+  test_assert_true( length <= ecl_sum_get_data_length( full ));
+  for (int t = 0; t < length; t++) {
+    test_assert_true( ecl_sum_iget_sim_time( live , t ) == ecl_sum_iget_sim_time( full , t ));
+    test_assert_int_equal( ecl_sum_iget_report_step( live , t ) , ecl_sum_iget_report_step( full , t ));
+    for (int p = 0; p < ecl_smspec_get_params_size( ecl_sum_get_smspec( live )); p++)
+      test_assert_double_equal( ecl_sum_iget( live , t , p ) , ecl_sum_iget( full , t , p ));
+  }
+
+  if (length > 0) {
+    int last_report = ecl_sum_get_last_report_step( live );
+    test_assert_int_equal( ecl_sum_get_first_report_step( full ) , ecl_sum_get_first_report_step( live ));
+    for (int report = ecl_sum_get_first_report_step( live ); report < last_report; report++) {
+      test_assert_int_equal( ecl_sum_iget_report_start( full , report ) , ecl_sum_iget_report_start( live , report ));
+      test_assert_int_equal( ecl_sum_iget_report_end( full , report ) , ecl_sum_iget_report_end( live , report ));
+    }
+    test_assert_int_equal( ecl_sum_iget_report_start( full , last_report ) , ecl_sum_iget_report_start( live , last_report ));
+    test_assert_int_equal( length - 1 , ecl_sum_iget_report_end( live , last_report ));
+    test_assert_true( ecl_sum_get_end_time( live ) == ecl_sum_iget_sim_time( full , length - 1 ));
+  }
+}
+
+
+void assert_equal( const ecl_sum_type * live , const ecl_sum_type * full ) {
+  test_assert_int_equal( ecl_sum_get_data_length( full ) , ecl_sum_get_data_length( live ));
+  test_assert_int_equal( ecl_sum_get_last_report_step( full ) , ecl_sum_get_last_report_step( live ));
+  assert_prefix( live , full );
+  test_assert_true( ecl_sum_report_step_equal( live , full ));
+}
+
+
+/*
+  The LIVE case is initially written with two report steps, and then
+  the rest of the FULL data is appended in pieces which do not respect
+  the keyword boundaries - as a simulator writing the file would do.
+*/
+
+void test_unified( ) {
+  const char * full_file = "FULL.UNSMRY";
+  const char * live_file = "LIVE.UNSMRY";
+  write_summary( "FULL" , false , true , NUM_REPORTS );
+  write_summary( "LIVE" , false , true , 2 );
+  {
+    ecl_sum_type * full = ecl_sum_fread_alloc_case( "FULL" , ":");
+    ecl_sum_type * live = ecl_sum_fread_alloc_case( "LIVE" , ":");
+    const long full_size = util_file_size( full_file );
+    long offset = util_file_size( live_file );
+    int length = ecl_sum_get_data_length( live );
+
+    test_assert_int_equal( 2 * NUM_MINISTEP , length );
+    test_assert_int_equal( 0 , ecl_sum_fread_refresh( live ));
+    while (offset < full_size) {
+      long next_offset = util_int_min( offset + 97 , full_size );
+      append_bytes( full_file , live_file , offset , next_offset );
+      offset = next_offset;
+
+      {
+        int new_steps = ecl_sum_fread_refresh( live );
+        test_assert_int_equal( length + new_steps , ecl_sum_get_data_length( live ));
+        length += new_steps;
+      }
+      assert_prefix( live , full );
+    }
+    assert_equal( live , full );
+    test_assert_int_equal( 0 , ecl_sum_fread_refresh( live ));
+
+    ecl_sum_free( live );
+    ecl_sum_free( full );
+  }
+}
+
+
+void test_multiple( ) {
+  write_summary( "FULL" , false , false , NUM_REPORTS );
+  write_summary( "LIVE" , false , false , 2 );
+  {
+    ecl_sum_type * full = ecl_sum_fread_alloc_case( "FULL" , ":");
+    ecl_sum_type * live = ecl_sum_fread_alloc_case( "LIVE" , ":");
+
+    for (int report = 3; report <= NUM_REPORTS; report++) {
+      char * full_file = ecl_util_alloc_filename( NULL , "FULL" , ECL_SUMMARY_FILE , false , report );
+      char * live_file = ecl_util_alloc_filename( NULL , "LIVE" , ECL_SUMMARY_FILE , false , report );
+      const long full_size = util_file_size( full_file );
+      long offset = 0;
+
+      while (offset < full_size) {
+        long next_offset = util_int_min( offset + 131 , full_size );
+        append_bytes( full_file , live_file , offset , next_offset );
+        offset = next_offset;
+
+        ecl_sum_fread_refresh( live );
+        assert_prefix( live , full );
+      }
+
+      free( live_file );
+      free( full_file );
+    }
+    assert_equal( live , full );
+
+    ecl_sum_free( live );
+    ecl_sum_free( full );
+  }
+}
+
+
+/* Start from an empty file; the first refresh does all the loading. */
+void test_empty_start( ) {
+  write_summary( "FULL" , false , true , NUM_REPORTS );
+  write_summary( "LIVE" , false , true , 1 );
+  {
+    ecl_sum_type * full = ecl_sum_fread_alloc_case( "FULL" , ":");
+    ecl_sum_type * live = ecl_sum_fread_alloc_case( "LIVE" , ":");
+
+    util_unlink_existing( "LIVE.UNSMRY" );
+    append_bytes( "FULL.UNSMRY" , "LIVE.UNSMRY" , 0 , util_file_size( "FULL.UNSMRY" ));
+    test_assert_int_equal( (NUM_REPORTS - 1) * NUM_MINISTEP , ecl_sum_fread_refresh( live ));
+    assert_equal( live , full );
+
+    ecl_sum_free( live );
+    ecl_sum_free( full );
+  }
+}
+
+
+/*
+  The initial load records where the data of a unified file ends; the
+  first refresh must continue from there, i.e. it must also work when
+  the start of the file can no longer be parsed.
+*/
+void test_initial_offset( ) {
+  write_summary( "FULL" , false , true , NUM_REPORTS );
+  write_summary( "LIVE" , false , true , 2 );
+  {
+    ecl_sum_type * full = ecl_sum_fread_alloc_case( "FULL" , ":");
+    ecl_sum_type * live = ecl_sum_fread_alloc_case( "LIVE" , ":");
+    const long live_size = util_file_size( "LIVE.UNSMRY" );
+
+    {
+      FILE * stream = util_fopen( "LIVE.UNSMRY" , "r+");
+      util_fwrite( "XXXXXXXXXXXXXXXX" , 1 , 16 , stream , __func__ );
+      fclose( stream );
+    }
+    append_bytes( "FULL.UNSMRY" , "LIVE.UNSMRY" , live_size , util_file_size( "FULL.UNSMRY" ));
+    test_assert_int_equal( (NUM_REPORTS - 2) * NUM_MINISTEP , ecl_sum_fread_refresh( live ));
+    assert_equal( live , full );
+
+    ecl_sum_free( live );
+    ecl_sum_free( full );
+  }
+}
+
+
+/* Refresh is not supported for formatted cases. */
+void test_formatted( ) {
+  write_summary( "LIVE" , true , true , 2 );
+  {
+    ecl_sum_type * live = ecl_sum_fread_alloc_case( "LIVE" , ":");
+    int length = ecl_sum_get_data_length( live );
+    test_assert_int_equal( -1 , ecl_sum_fread_refresh( live ));
+    test_assert_int_equal( length , ecl_sum_get_data_length( live ));
+    ecl_sum_free( live );
+  }
+}
+
+
+/* Each test runs in a separate work area. */
+void run_test( const char * name , void (*test)( void )) {
+  test_work_area_type * work_area = test_work_area_alloc( name );
+  test( );
+  test_work_area_free( work_area );
+}
+
+
+int main( int argc , char ** argv) {
+  run_test( "sum/refresh/unified" , test_unified );
+  run_test( "sum/refresh/multiple" , test_multiple );
+  run_test( "sum/refresh/empty_start" , test_empty_start );
+  run_test( "sum/refresh/initial_offset" , test_initial_offset );
+  run_test( "sum/refresh/formatted" , test_formatted );
+  exit(0);
+}
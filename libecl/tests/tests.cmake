@@ -30,6 +30,14 @@ add_executable( ecl_kw_fread ecl_kw_fread.c )
 target_link_libraries( ecl_kw_fread ecl  )
 add_test( ecl_kw_fread ${EXECUTABLE_OUTPUT_PATH}/ecl_kw_fread  )
 
+add_executable( ecl_file_mmap ecl_file_mmap.c )
+target_link_libraries( ecl_file_mmap ecl  )
+add_test( ecl_file_mmap ${EXECUTABLE_OUTPUT_PATH}/ecl_file_mmap  )
+
+add_executable( ecl_file_index ecl_file_index.c )
+target_link_libraries( ecl_file_index ecl  )
+add_test( ecl_file_index ${EXECUTABLE_OUTPUT_PATH}/ecl_file_index  )
+
 add_executable( ecl_valid_basename ecl_valid_basename.c )
 target_link_libraries( ecl_valid_basename ecl  )
 add_test( ecl_valid_basename ${EXECUTABLE_OUTPUT_PATH}/ecl_valid_basename)
@@ -42,6 +50,38 @@ add_executable( ecl_sum_writer ecl_sum_writer.c )
 target_link_libraries( ecl_sum_writer ecl  )
 add_test( ecl_sum_writer ${EXECUTABLE_OUTPUT_PATH}/ecl_sum_writer )
 
+add_executable( ecl_sum_ensemble ecl_sum_ensemble.c )
+target_link_libraries( ecl_sum_ensemble ecl  )
+add_test( ecl_sum_ensemble ${EXECUTABLE_OUTPUT_PATH}/ecl_sum_ensemble )
+
+add_executable( ecl_sum_columns ecl_sum_columns.c )
+target_link_libraries( ecl_sum_columns ecl )
+add_test( ecl_sum_columns ${EXECUTABLE_OUTPUT_PATH}/ecl_sum_columns )
+
+add_executable( ecl_sum_data_matrix ecl_sum_data_matrix.c )
+target_link_libraries( ecl_sum_data_matrix ecl )
+add_test( ecl_sum_data_matrix ${EXECUTABLE_OUTPUT_PATH}/ecl_sum_data_matrix )
+
+add_executable( ecl_sum_export ecl_sum_export.c )
+target_link_libraries( ecl_sum_export ecl )
+add_test( ecl_sum_export ${EXECUTABLE_OUTPUT_PATH}/ecl_sum_export )
+
+add_executable( ecl_sum_refresh ecl_sum_refresh.c )
+target_link_libraries( ecl_sum_refresh ecl )
+add_test( ecl_sum_refresh ${EXECUTABLE_OUTPUT_PATH}/ecl_sum_refresh )
+
+add_executable( ecl_sum_compressed ecl_sum_compressed.c )
+target_link_libraries( ecl_sum_compressed ecl )
+add_test( ecl_sum_compressed ${EXECUTABLE_OUTPUT_PATH}/ecl_sum_compressed )
+
+add_executable( ecl_smspec_node ecl_smspec_node.c )
+target_link_libraries( ecl_smspec_node ecl )
+add_test( ecl_smspec_node ${EXECUTABLE_OUTPUT_PATH}/ecl_smspec_node )
+
+add_executable( ecl_sum_parallel_load ecl_sum_parallel_load.c )
+target_link_libraries( ecl_sum_parallel_load ecl )
+add_test( ecl_sum_parallel_load ${EXECUTABLE_OUTPUT_PATH}/ecl_sum_parallel_load )
+
 add_executable( ecl_grid_add_nnc ecl_grid_add_nnc.c )
 target_link_libraries( ecl_grid_add_nnc ecl  )
 add_test( ecl_grid_add_nnc ${EXECUTABLE_OUTPUT_PATH}/ecl_grid_add_nnc )
@@ -100,6 +140,30 @@ add_executable( ecl_grid_copy ecl_grid_copy.c )
 target_link_libraries( ecl_grid_copy ecl  )
 add_test( ecl_grid_copy ${EXECUTABLE_OUTPUT_PATH}/ecl_grid_copy )
 
+add_executable( ecl_grid_compact ecl_grid_compact.c )
+target_link_libraries( ecl_grid_compact ecl  )
+add_test( ecl_grid_compact ${EXECUTABLE_OUTPUT_PATH}/ecl_grid_compact )
+
+add_executable( ecl_grid_init_threads ecl_grid_init_threads.c )
+target_link_libraries( ecl_grid_init_threads ecl  )
+add_test( ecl_grid_init_threads ${EXECUTABLE_OUTPUT_PATH}/ecl_grid_init_threads )
+
+add_executable( ecl_grid_cache ecl_grid_cache.c )
+target_link_libraries( ecl_grid_cache ecl  )
+add_test( ecl_grid_cache ${EXECUTABLE_OUTPUT_PATH}/ecl_grid_cache )
+
+add_executable( ecl_grid_frozen ecl_grid_frozen.c )
+target_link_libraries( ecl_grid_frozen ecl  )
+add_test( ecl_grid_frozen ${EXECUTABLE_OUTPUT_PATH}/ecl_grid_frozen )
+
+add_executable( ecl_grid_search_index ecl_grid_search_index.c )
+target_link_libraries( ecl_grid_search_index ecl  )
+add_test( ecl_grid_search_index ${EXECUTABLE_OUTPUT_PATH}/ecl_grid_search_index )
+
+add_executable( ecl_grav_common_stations ecl_grav_common_stations.c )
+target_link_libraries( ecl_grav_common_stations ecl  )
+add_test( ecl_grav_common_stations ${EXECUTABLE_OUTPUT_PATH}/ecl_grav_common_stations )
+
 add_executable( ecl_get_num_cpu ecl_get_num_cpu_test.c )
 target_link_libraries( ecl_get_num_cpu ecl  )
 add_test( ecl_get_num_cpu ${EXECUTABLE_OUTPUT_PATH}/ecl_get_num_cpu 
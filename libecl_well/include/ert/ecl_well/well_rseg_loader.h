@@ -33,6 +33,7 @@ extern "C" {
   void                     well_rseg_loader_free(well_rseg_loader_type * well_rseg_loader);
 
   int                      well_rseg_loader_element_count(const well_rseg_loader_type * well_rseg_loader);
+  void                     well_rseg_loader_load_range(well_rseg_loader_type * well_rseg_loader, int rseg_offset, int rseg_size);
   double *                 well_rseg_loader_load_values(const well_rseg_loader_type * well_rseg_loader, int rseg_offset);
 
 #ifdef __cplusplus
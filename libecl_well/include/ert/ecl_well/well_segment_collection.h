@@ -46,7 +46,7 @@ extern "C" {
   int                            well_segment_collection_load_from_kw( well_segment_collection_type * segment_collection , int well_nr , 
                                                                        const ecl_kw_type * iwel_kw , 
                                                                        const ecl_kw_type * iseg_kw , 
-                                                                       const well_rseg_loader_type * rseg_loader ,
+                                                                       well_rseg_loader_type * rseg_loader ,
                                                                        const ecl_rsthead_type * rst_head,
                                                                        bool load_segment_information , bool * is_MSW_well);
   
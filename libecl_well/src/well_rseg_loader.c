@@ -31,12 +31,25 @@
 #include <ert/ecl/fortio.h>
 
 
+/*
+  The rseg loader can either read the four values for one segment
+  with an indexed read directly from the file, or it can serve the
+  values from a block of RSEG data which has been loaded in one go
+  with well_rseg_loader_load_range(). The indexed read costs one seek
+  for each element, so when all the segments of a well are loaded
+  the range based loading is much faster.
+*/
+
 struct well_rseg_loader_struct {
   ecl_file_view_type  * rst_view;
   int_vector_type     * relative_index_map;
   int_vector_type     * absolute_index_map;
   char                * buffer;
   char                * kw;
+  double              * range_data;      /* RSEG values loaded with well_rseg_loader_load_range(). */
+  int                   range_offset;
+  int                   range_size;
+  int                   range_alloc_size;
 };
 
 
@@ -50,6 +63,10 @@ well_rseg_loader_type * well_rseg_loader_alloc(ecl_file_view_type * rst_view) {
     loader->absolute_index_map = int_vector_alloc(0, 0);
     loader->buffer = util_malloc(element_count * sizeof(double));
     loader->kw = RSEG_KW;
+    loader->range_data = NULL;
+    loader->range_offset = 0;
+    loader->range_size = 0;
+    loader->range_alloc_size = 0;
 
     int_vector_append(loader->relative_index_map, RSEG_DEPTH_INDEX);
     int_vector_append(loader->relative_index_map, RSEG_LENGTH_INDEX);
@@ -72,11 +89,50 @@ void well_rseg_loader_free(well_rseg_loader_type * loader) {
   int_vector_free(loader->relative_index_map);
   int_vector_free(loader->absolute_index_map);
   free(loader->buffer);
+  util_safe_free(loader->range_data);
   free(loader);
 }
 
+/**
+   Will load the RSEG elements [rseg_offset, rseg_offset + rseg_size)
+   into memory; subsequent calls to well_rseg_loader_load_values() for
+   segments inside this range will not touch the file. The range is
+   truncated to the size of the RSEG keyword.
+*/
+
+void well_rseg_loader_load_range(well_rseg_loader_type * loader, int rseg_offset, int rseg_size) {
+    int kw_size = ecl_file_view_iget_named_size(loader->rst_view, loader->kw, 0);
+
+    if (rseg_offset < 0 || rseg_offset >= kw_size)
+        rseg_size = 0;
+    else
+        rseg_size = util_int_min(rseg_size, kw_size - rseg_offset);
+
+    if (rseg_size > loader->range_alloc_size) {
+        loader->range_data = util_realloc(loader->range_data, rseg_size * sizeof * loader->range_data);
+        loader->range_alloc_size = rseg_size;
+    }
+
+    if (rseg_size > 0)
+        ecl_file_view_range_fload_kw(loader->rst_view, loader->kw, 0, rseg_offset, rseg_size, (char*) loader->range_data);
+
+    loader->range_offset = rseg_offset;
+    loader->range_size = rseg_size;
+}
+
+
 double * well_rseg_loader_load_values(const well_rseg_loader_type * loader, int rseg_offset) {
     int_vector_type * index_map = loader->absolute_index_map;
+    double * values = (double*) loader->buffer;
+
+    if ((rseg_offset >= loader->range_offset) && (rseg_offset + int_vector_get_max(loader->relative_index_map) < loader->range_offset + loader->range_size)) {
+        int index;
+        for(index = 0; index < int_vector_size(loader->relative_index_map); index++) {
+            int relative_index = int_vector_iget(loader->relative_index_map, index);
+            values[index] = loader->range_data[rseg_offset + relative_index - loader->range_offset];
+        }
+        return values;
+    }
 
     int index = 0;
     for(index = 0; index < int_vector_size(loader->relative_index_map); index++) {
@@ -103,7 +103,7 @@ bool  well_segment_collection_has_segment( const well_segment_collection_type *
 int well_segment_collection_load_from_kw( well_segment_collection_type * segment_collection , int well_nr , 
                                           const ecl_kw_type * iwel_kw , 
                                           const ecl_kw_type * iseg_kw , 
-                                          const well_rseg_loader_type * rseg_loader ,
+                                          well_rseg_loader_type * rseg_loader ,
                                           const ecl_rsthead_type * rst_head , 
                                           bool load_segments , bool * is_MSW_well) {
   
@@ -116,6 +116,15 @@ int well_segment_collection_load_from_kw( well_segment_collection_type * segment
     *is_MSW_well = true;
 
     if (load_segments) {
+      /*
+        All the RSEG data for this well is read in one operation,
+        instead of one indexed read for each segment.
+      */
+      if (rseg_loader != NULL) {
+        int rseg_well_size = rst_head->nrsegz * rst_head->nsegmx;
+        well_rseg_loader_load_range( rseg_loader , rseg_well_size * segment_well_nr , rseg_well_size );
+      }
+
       for (segment_index = 0; segment_index < rst_head->nsegmx; segment_index++) {
         int segment_id = segment_index + WELL_SEGMENT_OFFSET;
         well_segment_type * segment = well_segment_alloc_from_kw( iseg_kw , rseg_loader , rst_head , segment_well_nr , segment_index , segment_id );
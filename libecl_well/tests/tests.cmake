@@ -33,3 +33,8 @@ target_link_libraries( well_segment_collection ecl_well  )
 set_target_properties( well_segment_collection PROPERTIES COMPILE_FLAGS "-Werror")                                    
 add_test( well_segment_collection ${EXECUTABLE_OUTPUT_PATH}/well_segment_collection )
 
+
+add_executable( well_rseg_loader well_rseg_loader.c )
+target_link_libraries( well_rseg_loader ecl_well  )
+set_target_properties( well_rseg_loader PROPERTIES COMPILE_FLAGS "-Werror")
+add_test( well_rseg_loader ${EXECUTABLE_OUTPUT_PATH}/well_rseg_loader )
@@ -0,0 +1,94 @@
+/*
+   Copyright (C) 2017  Statoil ASA, Norway.
+
+   The file 'well_rseg_loader.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include <ert/util/test_util.h>
+#include <ert/util/test_work_area.h>
+#include <ert/util/util.h>
+
+#include <ert/ecl/ecl_endian_flip.h>
+#include <ert/ecl/ecl_kw.h>
+#include <ert/ecl/ecl_file.h>
+#include <ert/ecl/ecl_kw_magic.h>
+#include <ert/ecl/fortio.h>
+
+#include <ert/ecl_well/well_const.h>
+#include <ert/ecl_well/well_rseg_loader.h>
+
+#define RSEG_SIZE 2500
+
+
+void test_values( const ecl_kw_type * rseg_kw , well_rseg_loader_type * loader , int rseg_offset) {
+  const double * values = well_rseg_loader_load_values( loader , rseg_offset );
+  test_assert_double_equal( values[0] , ecl_kw_iget_double( rseg_kw , rseg_offset + RSEG_DEPTH_INDEX ));
+  test_assert_double_equal( values[1] , ecl_kw_iget_double( rseg_kw , rseg_offset + RSEG_LENGTH_INDEX ));
+  test_assert_double_equal( values[2] , ecl_kw_iget_double( rseg_kw , rseg_offset + RSEG_TOTAL_LENGTH_INDEX ));
+  test_assert_double_equal( values[3] , ecl_kw_iget_double( rseg_kw , rseg_offset + RSEG_DIAMETER_INDEX ));
+}
+
+
+void test_load( ) {
+  test_work_area_type * work_area = test_work_area_alloc("well_rseg_loader");
+  ecl_kw_type * rseg_kw = ecl_kw_alloc( RSEG_KW , RSEG_SIZE , ECL_DOUBLE );
+  int i;
+
+  for (i = 0; i < RSEG_SIZE; i++)
+    ecl_kw_iset_double( rseg_kw , i , i * 0.5 + 1 );
+
+  {
+    fortio_type * fortio = fortio_open_writer( "CASE.X0010" , false , ECL_ENDIAN_FLIP );
+    ecl_kw_fwrite( rseg_kw , fortio );
+    fortio_fclose( fortio );
+  }
+
+  {
+    ecl_file_type * rst_file = ecl_file_open( "CASE.X0010" , 0 );
+    well_rseg_loader_type * loader = well_rseg_loader_alloc( ecl_file_get_global_view( rst_file ));
+
+    /* Indexed loading. */
+    test_values( rseg_kw , loader , 0 );
+    test_values( rseg_kw , loader , 995 );
+    test_values( rseg_kw , loader , RSEG_SIZE - 8 );
+
+    /* The range crosses the boundary between two Fortran records. */
+    well_rseg_loader_load_range( loader , 900 , 1200 );
+    for (i = 900; i <= 2092; i += 4)
+      test_values( rseg_kw , loader , i );
+
+    /* Outside the loaded range - falls back to indexed loading. */
+    test_values( rseg_kw , loader , 100 );
+    test_values( rseg_kw , loader , 2096 );
+
+    /* The range is truncated at the end of the keyword. */
+    well_rseg_loader_load_range( loader , RSEG_SIZE - 100 , 1000 );
+    for (i = RSEG_SIZE - 100; i <= RSEG_SIZE - 8; i++)
+      test_values( rseg_kw , loader , i );
+
+    well_rseg_loader_free( loader );
+    ecl_file_close( rst_file );
+  }
+  ecl_kw_free( rseg_kw );
+  test_work_area_free( work_area );
+}
+
+
+int main(int argc , char ** argv) {
+  test_load();
+  exit(0);
+}
@@ -0,0 +1,71 @@
+/*
+   Copyright (C) 2017  Statoil ASA, Norway.
+
+   The file 'endian_flip_bench.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+#include <stdlib.h>
+#include <stdio.h>
+
+#include <ert/util/util.h>
+#include <ert/util/timer.h>
+
+/*
+  Small benchmark of util_endian_flip_vector(); reports the
+  throughput in GB/s for the different element sizes. The buffer
+  size (in MB) can be given on the commandline; with the default
+  size of 4 MB the buffer is mostly cache resident, use a larger
+  value to measure the memory bound case.
+
+     endian_flip_bench [buffer_mb]
+*/
+
+static void bench( char * buffer , size_t buffer_size , int element_size) {
+  timer_type * timer = timer_alloc( false );
+  const double target_bytes = 4e9;
+  int repeat = (int) (target_bytes / buffer_size) + 1;
+  int elements = buffer_size / element_size;
+  double seconds;
+  int i;
+
+  timer_start( timer );
+  for (i = 0; i < repeat; i++)
+    util_endian_flip_vector( buffer , element_size , elements );
+  seconds = timer_stop( timer );
+
+  printf("element_size:%d  %8.2f GB/s\n" , element_size , 1e-9 * repeat * buffer_size / seconds );
+  timer_free( timer );
+}
+
+
+int main(int argc , char ** argv) {
+  int buffer_mb = 4;
+  if (argc > 1)
+    util_sscanf_int( argv[1] , &buffer_mb );
+  {
+    size_t buffer_size = (size_t) buffer_mb * 1024 * 1024;
+    char * buffer = util_malloc( buffer_size );
+    size_t i;
+
+    for (i = 0; i < buffer_size; i++)
+      buffer[i] = (char) i;
+
+    bench( buffer , buffer_size , 2 );
+    bench( buffer , buffer_size , 4 );
+    bench( buffer , buffer_size , 8 );
+
+    free( buffer );
+  }
+  exit(0);
+}
@@ -0,0 +1,102 @@
+/*
+   Copyright (C) 2017  Statoil ASA, Norway.
+
+   The file 'matrix_bench.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+#include <stdlib.h>
+#include <stdio.h>
+
+#include <ert/util/util.h>
+#include <ert/util/timer.h>
+#include <ert/util/rng.h>
+#include <ert/util/matrix.h>
+
+/*
+  Small benchmark of the matrix multiplication kernels for the shapes
+  typical of the ensemble smoother; i.e. a tall matrix with one row
+  per observation/parameter and one column per realization. The
+  number of rows and realizations can be given on the commandline:
+
+     matrix_bench [rows] [ens_size]
+
+  The matrix_gemm() results use BLAS dgemm() when the library is
+  built with BLAS; matrix_gemm_blocked() is the portable kernel.
+*/
+
+typedef void (gemm_ftype) (matrix_type * , const matrix_type * , const matrix_type * , bool , bool , double , double);
+
+
+static void report( const char * name , double flops , double seconds ) {
+  printf("%-40s %8.3f s  %8.2f GFlop/s\n" , name , seconds , 1e-9 * flops / seconds );
+}
+
+
+static void bench_gemm( const char * name , gemm_ftype * gemm , matrix_type * C , const matrix_type * A , const matrix_type * B , bool transA , bool transB) {
+  timer_type * timer = timer_alloc( false );
+  int k = transA ? matrix_get_rows( A ) : matrix_get_columns( A );
+  double flops = 2.0 * matrix_get_rows( C ) * matrix_get_columns( C ) * k;
+
+  timer_start( timer );
+  gemm( C , A , B , transA , transB , 1 , 0 );
+  report( name , flops , timer_stop( timer ));
+  timer_free( timer );
+}
+
+
+int main(int argc , char ** argv) {
+  int rows = 20000;
+  int ens_size = 100;
+  if (argc > 1)
+    util_sscanf_int( argv[1] , &rows );
+  if (argc > 2)
+    util_sscanf_int( argv[2] , &ens_size );
+
+  {
+    rng_type * rng = rng_alloc( MZRAN , INIT_DEFAULT );
+    timer_type * timer = timer_alloc( false );
+    matrix_type * X  = matrix_alloc( rows , ens_size );
+    matrix_type * W  = matrix_alloc( ens_size , ens_size );
+    matrix_type * XW = matrix_alloc( rows , ens_size );
+    matrix_type * G  = matrix_alloc( ens_size , ens_size );
+    matrix_type * XT = matrix_alloc( ens_size , rows );
+
+    matrix_random_init( X , rng );
+    matrix_random_init( W , rng );
+    printf("X: [%d,%d]   W: [%d,%d]\n\n" , rows , ens_size , ens_size , ens_size );
+
+    bench_gemm( "X * W          matrix_gemm_blocked" , matrix_gemm_blocked , XW , X , W , false , false );
+    bench_gemm( "X * W          matrix_gemm"         , matrix_gemm         , XW , X , W , false , false );
+    bench_gemm( "X' * X         matrix_gemm_blocked" , matrix_gemm_blocked , G  , X , X , true  , false );
+    bench_gemm( "X' * X         matrix_gemm"         , matrix_gemm         , G  , X , X , true  , false );
+
+    timer_start( timer );
+    matrix_inplace_matmul( X , W );
+    report( "X = X * W      matrix_inplace_matmul" , 2.0 * rows * ens_size * ens_size , timer_stop( timer ));
+
+    matrix_set( XT , 0 );
+    timer_start( timer );
+    matrix_transpose( X , XT );
+    printf("%-40s %8.3f s\n" , "X'             matrix_transpose" , timer_stop( timer ));
+
+    matrix_free( X );
+    matrix_free( W );
+    matrix_free( XW );
+    matrix_free( G );
+    matrix_free( XT );
+    timer_free( timer );
+    rng_free( rng );
+  }
+  exit(0);
+}
@@ -0,0 +1,96 @@
+/*
+   Copyright (C) 2017  Statoil ASA, Norway.
+
+   The file 'thread_pool_bench.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+#include <stdlib.h>
+#include <stdio.h>
+
+#include <ert/util/util.h>
+#include <ert/util/timer.h>
+#include <ert/util/thread_pool.h>
+
+/*
+  Small benchmark of the thread_pool; reports the throughput of many
+  short jobs, and the time to run small batches of jobs with
+  thread_pool_restart() / thread_pool_join(), i.e. the dispatch
+  latency. The number of threads can be given on the commandline:
+
+     thread_pool_bench [num_threads]
+*/
+
+static void * short_job( void * arg ) {
+  double * value = arg;
+  double sum = 0;
+  int i;
+  for (i = 0; i < 1000; i++)
+    sum += i * 0.5;
+  *value = sum;
+  return NULL;
+}
+
+
+static void bench_throughput( int num_threads , int num_jobs ) {
+  timer_type * timer = timer_alloc( false );
+  double * values = util_calloc( num_jobs , sizeof * values );
+  thread_pool_type * tp = thread_pool_alloc( num_threads , true );
+  double seconds;
+  int i;
+
+  timer_start( timer );
+  for (i = 0; i < num_jobs; i++)
+    thread_pool_add_job( tp , short_job , &values[i] );
+  thread_pool_join( tp );
+  seconds = timer_stop( timer );
+
+  printf("throughput: %d jobs     %10.0f jobs/s\n" , num_jobs , num_jobs / seconds );
+  thread_pool_free( tp );
+  free( values );
+  timer_free( timer );
+}
+
+
+static void bench_batches( int num_threads , int num_batches , int batch_size ) {
+  timer_type * timer = timer_alloc( false );
+  double * values = util_calloc( batch_size , sizeof * values );
+  thread_pool_type * tp = thread_pool_alloc( num_threads , false );
+  double seconds;
+  int batch , i;
+
+  timer_start( timer );
+  for (batch = 0; batch < num_batches; batch++) {
+    thread_pool_restart( tp );
+    for (i = 0; i < batch_size; i++)
+      thread_pool_add_job( tp , short_job , &values[i] );
+    thread_pool_join( tp );
+  }
+  seconds = timer_stop( timer );
+
+  printf("batches:    %d x %d jobs  %10.1f us/batch\n" , num_batches , batch_size , 1e6 * seconds / num_batches );
+  thread_pool_free( tp );
+  free( values );
+  timer_free( timer );
+}
+
+
+int main(int argc , char ** argv) {
+  int num_threads = 4;
+  if (argc > 1)
+    util_sscanf_int( argv[1] , &num_threads );
+
+  bench_throughput( num_threads , 100000 );
+  bench_batches( num_threads , 1000 , 2 * num_threads );
+  exit(0);
+}
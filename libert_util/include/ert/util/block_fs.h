@@ -20,6 +20,7 @@
 #define ERT_BLOCK_FS
 #include <ert/util/buffer.h>
 #include <ert/util/vector.h>
+#include <ert/util/stringlist.h>
 #include <ert/util/type_macros.h>
 
 #ifdef __cplusplus
@@ -55,6 +56,7 @@ extern "C" {
   void            block_fs_fread_file( block_fs_type * block_fs , const char * filename , void * ptr);
   int             block_fs_get_filesize( block_fs_type * block_fs , const char * filename);
   void            block_fs_fread_realloc_buffer( block_fs_type * block_fs , const char * filename , buffer_type * buffer);
+  void            block_fs_fread_realloc_buffers( block_fs_type * block_fs , const stringlist_type * filenames , vector_type * buffers);
   void            block_fs_sync( block_fs_type * block_fs );
   void            block_fs_unlink_file( block_fs_type * block_fs , const char * filename);
   bool            block_fs_has_file( block_fs_type * block_fs , const char * filename);
@@ -118,6 +118,8 @@ typedef struct matrix_struct matrix_type;
   void          matrix_imul(matrix_type * matrix , int i , int j , double value);
 
 
+  void          matrix_gemm(matrix_type * C , const matrix_type * A , const matrix_type * B , bool transA , bool transB , double alpha , double beta);
+  void          matrix_gemm_blocked(matrix_type * C , const matrix_type * A , const matrix_type * B , bool transA , bool transB , double alpha , double beta);
   void          matrix_inplace_matmul(matrix_type * A, const matrix_type * B);
   void          matrix_inplace_matmul_mt1(matrix_type * A, const matrix_type * B , int num_threads);
 #ifdef HAVE_THREAD_POOL
@@ -28,6 +28,7 @@ double      statistics_std( const double_vector_type * data_vector );
 double      statistics_mean( const double_vector_type * data_vector );
 double      statistics_empirical_quantile( double_vector_type * data , double quantile );
 double      statistics_empirical_quantile__( const double_vector_type * data , double quantile );
+void        statistics_empirical_quantiles__( double * data , int size , int num_quantiles , const double * quantiles , double * values);
 
 #ifdef __cplusplus
 }
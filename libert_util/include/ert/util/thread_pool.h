@@ -33,7 +33,11 @@ extern "C" {
   void               thread_pool_restart( thread_pool_type * tp );
   void             * thread_pool_iget_return_value( const thread_pool_type * pool , int queue_index );
   int                thread_pool_get_max_running( const thread_pool_type * pool );
+  int                thread_pool_get_num_complete( thread_pool_type * pool );
   bool               thread_pool_try_join(thread_pool_type * pool, int timeout_seconds);
+  int                thread_pool_submit_job(thread_pool_type * pool , void * (*) (void *) , void *);
+  void             * thread_pool_wait_job( thread_pool_type * pool , int job );
+  bool               thread_pool_job_complete( thread_pool_type * pool , int job );
 
 #ifdef __cplusplus
 }
@@ -130,6 +130,7 @@ typedef enum {left_pad   = 0,
   void         util_fprintf_int(int , int , FILE * );
   void         util_fprintf_string(const char *  , int , string_alignement_type ,  FILE * );
   void         util_fprintf_double(double , int , int , char , FILE *);
+  int          util_sprintf_g( char * buffer , double value );
   bool         util_fscanf_date_utc(FILE * , time_t *);
   bool         util_sscanf_date_utc(const char * , time_t *);
   bool         util_sscanf_isodate(const char * , time_t *);
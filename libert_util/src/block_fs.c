@@ -33,6 +33,8 @@
 #include <ert/util/vector.h>
 #include <ert/util/buffer.h>
 #include <ert/util/long_vector.h>
+#include <ert/util/perm_vector.h>
+#include <ert/util/stringlist.h>
 
 
 #define MOUNT_MAP_MAGIC_INT  8861290
@@ -147,7 +149,6 @@ struct block_fs_struct {
   int              block_size;      /* The size of blocks in bytes. */
   int              lock_fd;         /* The file descriptor for the lock_file. Set to -1 if we do not have write access. */
   
-  pthread_mutex_t  io_lock;         /* Lock held during fread of the data file. */
   pthread_rwlock_t rw_lock;         /* Read-write lock during all access to the fs. */
   
   int              num_free_nodes;   
@@ -185,6 +186,30 @@ static inline void block_fs_fseek(block_fs_type * block_fs , long offset) {
 }
 
 
+/*
+  All reading of node data goes through pread() on the data_fd; since
+  pread() does not use the shared file position concurrent readers
+  holding the read lock do not need any further locking. The writers
+  use the data_stream, and must flush it before the write lock is
+  released.
+*/
+
+static void block_fs_pread(block_fs_type * block_fs , long offset , void * ptr , size_t read_bytes) {
+  char * target = ptr;
+  size_t total_read = 0;
+
+  while (total_read < read_bytes) {
+    ssize_t bytes_read = pread( block_fs->data_fd , &target[total_read] , read_bytes - total_read , offset + total_read );
+    if (bytes_read > 0)
+      total_read += bytes_read;
+    else if ((bytes_read < 0) && (errno == EINTR))
+      continue;
+    else
+      util_abort("%s: only read %zd/%zd bytes from:%s at offset:%ld - aborting: %s(%d) \n",__func__ , total_read , read_bytes , block_fs->data_file , offset , strerror(errno) , errno);
+  }
+}
+
+
 /*****************************************************************/
 /* file_node functions */
 
@@ -661,7 +686,6 @@ static block_fs_type * block_fs_alloc_empty( const char * mount_file ,
   
   block_fs->fragmentation_limit = fragmentation_limit;   
   util_alloc_file_components( mount_file , &block_fs->path , &block_fs->base_name, NULL );
-  pthread_mutex_init( &block_fs->io_lock  , NULL);
   pthread_rwlock_init( &block_fs->rw_lock , NULL);
   {
     FILE * stream            = util_fopen( mount_file , "r");
@@ -1091,6 +1115,10 @@ block_fs_type * block_fs_mount( const char * mount_file ,
       block_fs_open_data( block_fs , block_fs->data_owner ); /* The data_stream is opened for reading AND writing (IFF we are data_owner - otherwise it is still read only) */
       block_fs_fix_nodes( block_fs , fix_nodes );  
       long_vector_free( fix_nodes );
+
+      /* A read-only instance will never modify the index. */
+      if (!block_fs->data_owner)
+        hash_freeze( block_fs->index );
     }
   }
   if (preload) block_fs_preload( block_fs );
@@ -1319,6 +1347,9 @@ static void block_fs_fwrite__(block_fs_type * block_fs , const char * filename ,
     /* Writes the file node header data, including the NODE_END_TAG. */
     file_node_fwrite( node , filename , block_fs->data_stream );
 
+    /* The readers use pread() on the data_fd - must get the data out of the stdio buffer. */
+    fflush( block_fs->data_stream );
+
     block_fs_update_cache_node( block_fs , node , data_size , ptr);
     block_fs->write_count++;
     if (block_fs->fsync_interval && ((block_fs->write_count % block_fs->fsync_interval) == 0)) 
@@ -1389,8 +1420,9 @@ void block_fs_fwrite_buffer(block_fs_type * block_fs , const char * filename , c
 
 
 /**
-   Need extra locking here - because the global rwlock allows many
-   concurrent readers.
+   No extra locking is needed here; the global rwlock allows many
+   concurrent readers, and the pread() calls do not share any file
+   position.
 */
 static void block_fs_fread__(block_fs_type * block_fs , const file_node_type * file_node , void * ptr , size_t read_bytes) {
 
@@ -1402,13 +1434,27 @@ static void block_fs_fread__(block_fs_type * block_fs , const file_node_type * f
     if (true) 
 #endif
 
+      block_fs_pread( block_fs , file_node->node_offset + file_node->data_offset , ptr , read_bytes );
+}
+
+
+static void block_fs_fread_buffer__( block_fs_type * block_fs , const file_node_type * node , buffer_type * buffer) {
+  buffer_clear( buffer );   /* Setting: content_size = 0; pos = 0;  */
+
+#ifdef ENABLE_CACHE
+  if (node->cache != NULL) 
+    file_node_buffer_read_from_cache( node , buffer );
+  else 
+#else
+  if (true)  
+#endif
+
   {
-    pthread_mutex_lock( &block_fs->io_lock );
-    block_fs_fseek_node_data( block_fs , file_node );
-    util_fread( ptr , 1 , read_bytes , block_fs->data_stream , __func__);
-    //file_node_verify_end_tag( file_node , block_fs->data_stream );
-    pthread_mutex_unlock( &block_fs->io_lock );
+    void * data = buffer_fwrite_reserve( buffer , node->data_size );
+    block_fs_pread( block_fs , node->node_offset + node->data_offset , data , node->data_size );
   }
+
+  buffer_rewind( buffer );  /* Setting: pos = 0; */
 }
 
 
@@ -1420,38 +1466,51 @@ void block_fs_fread_realloc_buffer( block_fs_type * block_fs , const char * file
   block_fs_aquire_rlock( block_fs );
   {
     file_node_type * node = hash_get( block_fs->index , filename);
-    
-    buffer_clear( buffer );   /* Setting: content_size = 0; pos = 0;  */
-    {
-      /* 
-         Going low-level - essentially a second implementation of
-         block_fs_fread__():
-      */
-
-#ifdef ENABLE_CACHE
-      if (node->cache != NULL) 
-        file_node_buffer_read_from_cache( node , buffer );
-      else 
-#else
-      if (true)  
-#endif
-
-      {
-        pthread_mutex_lock( &block_fs->io_lock );
-        block_fs_fseek_node_data(block_fs , node );
-        buffer_stream_fread( buffer , node->data_size , block_fs->data_stream );
-        //file_node_verify_end_tag( node , block_fs->data_stream );
-        pthread_mutex_unlock( &block_fs->io_lock );
-      }
-      
-    }
-    buffer_rewind( buffer );  /* Setting: pos = 0; */
+    block_fs_fread_buffer__( block_fs , node , buffer );
   }
   block_fs_release_rwlock( block_fs );
 }
 
 
+/**
+   Batched version of block_fs_fread_realloc_buffer(); the content of
+   file nr i in @filenames is read into buffer nr i in the @buffers
+   vector, which must contain one buffer_type instance for each
+   filename. The reads are issued in the order the nodes are located
+   in the data file, and the read lock is only taken once; when
+   loading many nodes (e.g. all the realisations of one parameter)
+   this is considerably faster than reading them one by one.
+*/
+
+void block_fs_fread_realloc_buffers( block_fs_type * block_fs , const stringlist_type * filenames , vector_type * buffers) {
+  const int num_files = stringlist_get_size( filenames );
+  if (vector_get_size( buffers ) != num_files)
+    util_abort("%s: size mismatch: %d filenames and %d buffers \n",__func__ , num_files , vector_get_size( buffers ));
+
+  block_fs_aquire_rlock( block_fs );
+  {
+    const file_node_type ** nodes = util_calloc( num_files , sizeof * nodes );
+    long_vector_type * offset_list = long_vector_alloc( num_files , 0 );
+    perm_vector_type * perm;
+    int i;
+
+    for (i=0; i < num_files; i++) {
+      nodes[i] = hash_get( block_fs->index , stringlist_iget( filenames , i ));
+      long_vector_iset( offset_list , i , nodes[i]->node_offset );
+    }
 
+    perm = long_vector_alloc_sort_perm( offset_list );
+    for (i=0; i < num_files; i++) {
+      int file_nr = perm_vector_iget( perm , i );
+      block_fs_fread_buffer__( block_fs , nodes[file_nr] , buffer_safe_cast( vector_iget( buffers , file_nr )));
+    }
+
+    perm_vector_free( perm );
+    long_vector_free( offset_list );
+    free( nodes );
+  }
+  block_fs_release_rwlock( block_fs );
+}
 
 
 
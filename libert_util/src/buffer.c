@@ -715,6 +715,28 @@ void buffer_stream_fread( buffer_type * buffer , size_t byte_size , FILE * strea
 }
 
 
+/**
+   Will make room for @byte_size bytes at the current position, and
+   return a pointer to that storage. The position and content size
+   are updated as if @byte_size bytes had been written, and it is the
+   responsability of the calling scope to fill in the data; this is
+   intended for low level reads like pread() directly into the
+   buffer storage.
+*/
+
+void * buffer_fwrite_reserve( buffer_type * buffer , size_t byte_size ) {
+  size_t min_size = byte_size + buffer->pos;
+  void * ptr;
+  if (buffer->alloc_size < min_size)
+    buffer_resize__(buffer , min_size , true);
+
+  ptr = &buffer->data[buffer->pos];
+  buffer->pos          += byte_size;
+  buffer->content_size  = util_size_t_max( buffer->content_size , buffer->pos );
+  return ptr;
+}
+
+
 
 
 /**
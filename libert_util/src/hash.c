@@ -24,7 +24,6 @@
 #include <errno.h>
 
 #include <ert/util/hash.h>
-#include <ert/util/hash_sll.h>
 #include <ert/util/hash_node.h>
 #include <ert/util/node_data.h>
 #include <ert/util/util.h>
@@ -44,23 +43,52 @@ extern "C" {
 #define HASH_DEFAULT_SIZE 16
 #define HASH_TYPE_ID      771065
 
+/*
+  The hash table is implemented with open addressing and linear
+  probing; the table size is always a power of two. Each slot in the
+  table holds a pointer to a hash_node - or NULL for an empty slot, or
+  HASH_DELETED for a slot where a node has been deleted. The full 32
+  bit hash value of each node is stored in a separate array, so that
+  probing only dereferences the node pointer when the hash values
+  match.
+*/
+
+static char hash_deleted_marker;
+#define HASH_DELETED ((hash_node_type *) &hash_deleted_marker)
+
+
 /**
    This is **THE** hash function - which actually does the hashing.
+   The key is consumed eight bytes at a time, with a multiplicative
+   mixing step per word and a final avalanche step. The hash values
+   are only used in memory, i.e. the result may differ between
+   platforms with different endianness.
 */
 
 static uint32_t hash_index(const char *key, size_t len) {
-  uint32_t hash = 0;
-  size_t i;
+  const uint64_t mult = UINT64_C(0x9E3779B97F4A7C15);
+  uint64_t hash = len * mult;
+
+  while (len >= 8) {
+    uint64_t word;
+    memcpy( &word , key , 8 );
+    hash = (hash ^ word) * mult;
+    hash ^= (hash >> 32);
+    key += 8;
+    len -= 8;
+  }
 
-  for (i=0; i < len; i++) {
-    hash += key[i];
-    hash += (hash << 10);
-    hash ^= (hash >>  6);
+  if (len > 0) {
+    uint64_t word = 0;
+    memcpy( &word , key , len );
+    hash = (hash ^ word) * mult;
+    hash ^= (hash >> 32);
   }
-  hash += (hash << 3);
-  hash ^= (hash >> 11);
-  hash += (hash << 15);
-  return hash;
+
+  hash ^= (hash >> 29);
+  hash *= UINT64_C(0xBF58476D1CE4E5B9);
+  hash ^= (hash >> 32);
+  return (uint32_t) hash;
 }
 
 
@@ -68,10 +96,14 @@ struct hash_struct {
   UTIL_TYPE_ID_DECLARATION;
   uint32_t          size;            /* This is the size of the internal table **NOT**NOT** the number of elements in the table. */
   uint32_t          elements;        /* The number of elements in the hash table. */
+  uint32_t          used_slots;      /* The number of slots which are not empty, i.e. elements + deleted slots. */
   double            resize_fill;
-  hash_sll_type   **table;
+  hash_node_type  **table;
+  uint32_t         *hash_values;     /* The hash value of the node in the corresponding table slot. */
   hashf_type       *hashf;
 
+  bool              locking;         /* Should the rwlock be used? - false for hash_alloc_unlocked() instances. */
+  bool              frozen;          /* A frozen table can not be modified, and is read without locking. */
   lock_type         rwlock;
 };
 
@@ -93,21 +125,26 @@ static void __hash_deadlock_abort(hash_type * hash) {
 
 
 static void __hash_rdlock(hash_type * hash) {
-  int lock_error = pthread_rwlock_tryrdlock( &hash->rwlock );
-  if (lock_error != 0)
-    util_abort("%s: did not get hash->read_lock - fix locking in calling scope\n",__func__);
+  if (hash->locking && !hash->frozen) {
+    int lock_error = pthread_rwlock_tryrdlock( &hash->rwlock );
+    if (lock_error != 0)
+      util_abort("%s: did not get hash->read_lock - fix locking in calling scope\n",__func__);
+  }
 }
 
 
 static void __hash_wrlock(hash_type * hash) {
-  int lock_error = pthread_rwlock_trywrlock( &hash->rwlock );
-  if (lock_error != 0)
-    util_abort("%s: did not get hash->write_lock - fix locking in calling scope\n",__func__);
+  if (hash->locking) {
+    int lock_error = pthread_rwlock_trywrlock( &hash->rwlock );
+    if (lock_error != 0)
+      util_abort("%s: did not get hash->write_lock - fix locking in calling scope\n",__func__);
+  }
 }
 
 
 static void __hash_unlock( hash_type * hash) {
-  pthread_rwlock_unlock( &hash->rwlock );
+  if (hash->locking && !hash->frozen)
+    pthread_rwlock_unlock( &hash->rwlock );
 }
 
 
@@ -129,22 +166,62 @@ static void LOCK_INIT(lock_type * rwlock) {}
 
 #endif
 
+
+static void __hash_assert_mutable( const hash_type * hash , const char * caller) {
+  if (hash->frozen)
+    util_abort("%s: tried to modify a frozen hash table\n", caller);
+}
+
 /*****************************************************************/
 /*                    Low level access functions                 */
 /*****************************************************************/
 
 
-static void * __hash_get_node_unlocked(const hash_type *__hash , const char *key, bool abort_on_error) {
-  hash_type * hash = (hash_type *) __hash;  /* The net effect is no change - but .... ?? */
+/*
+  Will locate the slot of @key in the table. If the key is found the
+  slot index is returned and *found is set to true. If the key is not
+  found *found is set to false, and the returned slot index is the
+  slot where the key should be inserted; i.e. the first deleted slot
+  encountered while probing, or otherwise the empty slot which
+  terminated the probing.
+*/
+
+static uint32_t __hash_find_slot(const hash_type * hash , uint32_t global_index , const char * key , bool * found) {
+  const uint32_t mask = hash->size - 1;
+  uint32_t slot = global_index & mask;
+  int64_t insert_slot = -1;
+
+  while (true) {
+    const hash_node_type * node = hash->table[slot];
+    if (node == NULL) {
+      *found = false;
+      return (insert_slot >= 0) ? (uint32_t) insert_slot : slot;
+    }
+
+    if (node == HASH_DELETED) {
+      if (insert_slot < 0)
+        insert_slot = slot;
+    } else if ((hash->hash_values[slot] == global_index) && (strcmp( hash_node_get_key( node ) , key) == 0)) {
+      *found = true;
+      return slot;
+    }
+
+    slot = (slot + 1) & mask;
+  }
+}
+
+
+static void * __hash_get_node_unlocked(const hash_type *hash , const char *key, bool abort_on_error) {
   hash_node_type * node = NULL;
   {
     const uint32_t global_index = hash->hashf(key , strlen(key));
-    const uint32_t table_index  = (global_index % hash->size);
+    bool found;
+    uint32_t slot = __hash_find_slot( hash , global_index , key , &found );
 
-    node = hash_sll_get(hash->table[table_index] , global_index , key);
-    if (node == NULL && abort_on_error)
+    if (found)
+      node = hash->table[slot];
+    else if (abort_on_error)
       util_abort("%s: tried to get from key:%s which does not exist - aborting \n",__func__ , key);
-
   }
   return node;
 }
@@ -153,7 +230,8 @@ static void * __hash_get_node_unlocked(const hash_type *__hash , const char *key
 /*
   This function looks up a hash_node from the hash. This is the common
   low-level function to get content from the hash. The function takes
-  read-lock which is held during execution.
+  read-lock which is held during execution; for frozen tables no lock
+  is taken.
 
   Would strongly preferred that the hash_type * was const - but that is
   difficult due to locking requirements.
@@ -175,46 +253,99 @@ static node_data_type * hash_get_node_data(const hash_type *hash , const char *k
 }
 
 
+static uint32_t __hash_table_size( const hash_type * hash , uint32_t min_size , uint32_t num_elements ) {
+  uint32_t size = HASH_DEFAULT_SIZE;
+  while ((size < min_size) || (size * hash->resize_fill <= num_elements))
+    size *= 2;
+  return size;
+}
+
+
+/*
+  Will rebuild the table with @new_size slots - which must be a power
+  of two; this will also clear out all the deleted slots.
+*/
+
+static void __hash_rehash(hash_type *hash, uint32_t new_size) {
+  hash_node_type ** old_table  = hash->table;
+  uint32_t        * old_values = hash->hash_values;
+  uint32_t          old_size   = hash->size;
+  uint32_t i;
+
+  hash->table       = calloc( new_size , sizeof * hash->table );
+  hash->hash_values = calloc( new_size , sizeof * hash->hash_values );
+  hash->size        = new_size;
+  hash->used_slots  = hash->elements;
+
+  for (i=0; i < old_size; i++) {
+    hash_node_type * node = old_table[i];
+    if ((node != NULL) && (node != HASH_DELETED)) {
+      uint32_t slot = old_values[i] & (new_size - 1);
+      while (hash->table[slot] != NULL)
+        slot = (slot + 1) & (new_size - 1);
+
+      hash->table[slot]       = node;
+      hash->hash_values[slot] = old_values[i];
+    }
+  }
+
+  free( old_table );
+  free( old_values );
+}
 
 
 /**
-   This function resizes the hash table when it has become to full.
-   The table only grows - this function is called from
+   This function resizes the hash table; the table size will be
+   rounded up to a power of two, and will be large enough to hold the
+   current elements. The table grows automatically from
    __hash_insert_node().
 
-   If you know in advance (roughly) how large the hash table will be
-   it can be advantageous to call hash_resize() manually, to avoid
-   repeated internal calls to hash_resize().
+   If you know in advance (roughly) how many elements the hash table
+   will hold it is advantageous to call hash_reserve() up front, to
+   avoid repeated internal calls to hash_resize().
 */
 
 void hash_resize(hash_type *hash, int new_size) {
-  hash_sll_type ** new_table = hash_sll_alloc_table( new_size );
-  hash_node_type * node;
-  uint32_t i;
+  __hash_wrlock( hash );
+  __hash_assert_mutable( hash , __func__ );
+  __hash_rehash( hash , __hash_table_size( hash , util_int_max( new_size , 0 ) , hash->elements ));
+  __hash_unlock( hash );
+}
 
-  for (i=0; i < hash->size; i++) {
-    node = hash_sll_get_head(hash->table[i]);
-    while (node != NULL) {
-      uint32_t new_table_index  = hash_node_set_table_index(node , new_size);
-      hash_node_type *next_node = hash_node_get_next(node);
-      hash_sll_add_node(new_table[new_table_index] , node);
-      node = next_node;
-    }
-  }
 
-  /*
-     Only freeing the table structure, *NOT* calling the node_free()
-     functions, which happens when hash_sll_free() is called.
-  */
+/**
+   Will make sure that the hash table can hold @num_elements elements
+   without any further resizing.
+*/
 
-  {
-    for (i=0; i < hash->size; i++)
-      free( hash->table[i] );
-    free( hash->table );
+void hash_reserve(hash_type *hash, int num_elements) {
+  uint32_t new_size = __hash_table_size( hash , 0 , util_int_max( num_elements , hash->elements ));
+  if (new_size > hash->size) {
+    __hash_wrlock( hash );
+    __hash_assert_mutable( hash , __func__ );
+    __hash_rehash( hash , new_size );
+    __hash_unlock( hash );
   }
+}
 
-  hash->size     = new_size;
-  hash->table    = new_table;
+
+/**
+   A frozen hash table can not be modified; all functions inserting
+   or deleting elements will abort. Reading from a frozen hash table
+   does not take the internal lock, i.e. a frozen table can be read
+   from many threads without any lock traffic. Freezing is final, and
+   should be done before the table is shared between threads.
+*/
+
+void hash_freeze(hash_type * hash) {
+  __hash_wrlock( hash );     /* Asserts that no other thread is using the table. */
+  __hash_unlock( hash );
+  hash->frozen = true;
+}
+
+
+bool hash_is_frozen(const hash_type * hash) {
+  return hash->frozen;
 }
 
 
@@ -226,24 +357,33 @@ void hash_resize(hash_type *hash, int new_size) {
 
 static void __hash_insert_node(hash_type *hash , hash_node_type *node) {
   __hash_wrlock( hash );
+  __hash_assert_mutable( hash , __func__ );
   {
-    uint32_t table_index = hash_node_get_table_index(node);
-    {
-      /*
-        If a node with the same key already exists in the table
-        it is removed.
-      */
-      hash_node_type *existing_node = __hash_get_node_unlocked(hash , hash_node_get_key(node) , false);
-      if (existing_node != NULL) {
-        hash_sll_del_node(hash->table[table_index] , existing_node);
-        hash->elements--;
-      }
+    const uint32_t global_index = hash_node_get_global_index( node );
+    bool found;
+    uint32_t slot = __hash_find_slot( hash , global_index , hash_node_get_key( node ) , &found );
+
+    /*
+      If a node with the same key already exists in the table it is
+      replaced.
+    */
+    if (found)
+      hash_node_free( hash->table[slot] );
+    else {
+      if (hash->table[slot] == NULL)
+        hash->used_slots++;
+      hash->elements++;
     }
 
-    hash_sll_add_node(hash->table[table_index] , node);
-    hash->elements++;
-    if ((1.0 * hash->elements / hash->size) > hash->resize_fill)
-      hash_resize(hash , hash->size * 2);
+    hash->table[slot]       = node;
+    hash->hash_values[slot] = global_index;
+
+    if (hash->used_slots > hash->size * hash->resize_fill) {
+      if (hash->elements * 2 > hash->size * hash->resize_fill)
+        __hash_rehash( hash , hash->size * 2 );
+      else
+        __hash_rehash( hash , hash->size );   /* Mostly deleted slots - just clean up. */
+    }
   }
   __hash_unlock( hash );
 }
@@ -260,43 +400,22 @@ static void __hash_insert_node(hash_type *hash , hash_node_type *node) {
 
 static void hash_del_unlocked__(hash_type *hash , const char *key) {
   const uint32_t global_index = hash->hashf(key , strlen(key));
-  const uint32_t table_index  = (global_index % hash->size);
-  hash_node_type *node        = hash_sll_get(hash->table[table_index] , global_index , key);
+  bool found;
+  uint32_t slot = __hash_find_slot( hash , global_index , key , &found );
 
-  if (node == NULL)
+  __hash_assert_mutable( hash , __func__ );
+  if (!found)
     util_abort("%s: hash does not contain key:%s - aborting \n",__func__ , key);
-  else
-    hash_sll_del_node(hash->table[table_index] , node);
+  else {
+    hash_node_free( hash->table[slot] );
+    hash->table[slot] = HASH_DELETED;
+  }
 
   hash->elements--;
 }
 
 
 
-/**
-   This functions takes a hash_node and finds the "next" hash node by
-   traversing the internal hash structure. Should NOT be confused with
-   the other functions providing iterations to user-space.
-*/
-
-static hash_node_type * hash_internal_iter_next(const hash_type *hash , const hash_node_type * node) {
-  hash_node_type *next_node = hash_node_get_next(node);
-  if (next_node == NULL) {
-    const uint32_t table_index = hash_node_get_table_index(node);
-    if (table_index < hash->size) {
-      uint32_t i = table_index + 1;
-      while (i < hash->size && hash_sll_empty(hash->table[i]))
-        i++;
-
-      if (i < hash->size)
-        next_node = hash_sll_get_head(hash->table[i]);
-    }
-  }
-  return next_node;
-}
-
-
-
 /**
    This is the low level function which traverses a hash table and
    allocates a char ** list of keys.
@@ -315,22 +434,15 @@ static char ** hash_alloc_keylist__(hash_type *hash , bool lock) {
   {
     if (hash->elements > 0) {
       int i = 0;
-      hash_node_type *node = NULL;
+      uint32_t slot;
       keylist = calloc(hash->elements , sizeof *keylist);
-      {
-        uint32_t i = 0;
-        while (i < hash->size && hash_sll_empty(hash->table[i]))
-          i++;
-
-        if (i < hash->size)
-          node = hash_sll_get_head(hash->table[i]);
-      }
 
-      while (node != NULL) {
-        const char *key = hash_node_get_key(node);
-        keylist[i] = util_alloc_string_copy(key);
-        node = hash_internal_iter_next(hash , node);
-        i++;
+      for (slot = 0; slot < hash->size; slot++) {
+        const hash_node_type * node = hash->table[slot];
+        if ((node != NULL) && (node != HASH_DELETED)) {
+          keylist[i] = util_alloc_string_copy( hash_node_get_key( node ));
+          i++;
+        }
       }
     } else keylist = NULL;
   }
@@ -425,6 +537,7 @@ double hash_get_double(const hash_type * hash , const char * key) {
 
 void hash_del(hash_type *hash , const char *key) {
   __hash_wrlock( hash );
+  __hash_assert_mutable( hash , __func__ );
   hash_del_unlocked__(hash , key);
   __hash_unlock( hash );
 }
@@ -436,6 +549,7 @@ void hash_del(hash_type *hash , const char *key) {
 
 void hash_safe_del(hash_type * hash , const char * key) {
   __hash_wrlock( hash );
+  __hash_assert_mutable( hash , __func__ );
   if (__hash_get_node_unlocked(hash , key , false))
     hash_del_unlocked__(hash , key);
   __hash_unlock( hash );
@@ -444,17 +558,17 @@ void hash_safe_del(hash_type * hash , const char * key) {
 
 void hash_clear(hash_type *hash) {
   __hash_wrlock( hash );
+  __hash_assert_mutable( hash , __func__ );
   {
-    int old_size = hash_get_size(hash);
-    if (old_size > 0) {
-      char **keyList = hash_alloc_keylist__( hash , false);
-      int i;
-      for (i=0; i < old_size; i++) {
-        hash_del_unlocked__(hash , keyList[i]);
-        free(keyList[i]);
-      }
-      free(keyList);
+    uint32_t slot;
+    for (slot = 0; slot < hash->size; slot++) {
+      hash_node_type * node = hash->table[slot];
+      if ((node != NULL) && (node != HASH_DELETED))
+        hash_node_free( node );
+      hash->table[slot] = NULL;
     }
+    hash->elements   = 0;
+    hash->used_slots = 0;
   }
   __hash_unlock( hash );
 }
@@ -507,15 +621,19 @@ void * hash_pop( hash_type * hash , const char * key) {
 /******************************************************************/
 
 
-static hash_type * __hash_alloc(int size, double resize_fill , hashf_type *hashf) {
+static hash_type * __hash_alloc(int size, double resize_fill , hashf_type *hashf , bool locking) {
   hash_type* hash;
   hash = util_malloc(sizeof *hash );
   UTIL_TYPE_ID_INIT(hash , HASH_TYPE_ID);
-  hash->size      = size;
-  hash->hashf     = hashf;
-  hash->table     = hash_sll_alloc_table(hash->size);
-  hash->elements  = 0;
-  hash->resize_fill  = resize_fill;
+  hash->size        = size;
+  hash->hashf       = hashf;
+  hash->table       = calloc( hash->size , sizeof * hash->table );
+  hash->hash_values = calloc( hash->size , sizeof * hash->hash_values );
+  hash->elements    = 0;
+  hash->used_slots  = 0;
+  hash->resize_fill = resize_fill;
+  hash->locking     = locking;
+  hash->frozen      = false;
   LOCK_INIT( &hash->rwlock );
 
   return hash;
@@ -523,13 +641,14 @@ static hash_type * __hash_alloc(int size, double resize_fill , hashf_type *hashf
 
 
 hash_type * hash_alloc() {
-  return __hash_alloc(HASH_DEFAULT_SIZE , 0.50 , hash_index);
+  return __hash_alloc(HASH_DEFAULT_SIZE , 0.70 , hash_index , true);
 }
 
 // Purely a helper in the process of removing the internal locking
-// in the hash implementation.
+// in the hash implementation; the returned hash does not use the
+// internal lock at all, the calling scope must serialize access.
 hash_type * hash_alloc_unlocked() {
-  return __hash_alloc(HASH_DEFAULT_SIZE , 0.50 , hash_index);
+  return __hash_alloc(HASH_DEFAULT_SIZE , 0.70 , hash_index , false);
 }
 
 
@@ -539,9 +658,13 @@ UTIL_IS_INSTANCE_FUNCTION(hash , HASH_TYPE_ID)
 
 void hash_free(hash_type *hash) {
   uint32_t i;
-  for (i=0; i < hash->size; i++)
-    hash_sll_free(hash->table[i]);
+  for (i=0; i < hash->size; i++) {
+    hash_node_type * node = hash->table[i];
+    if ((node != NULL) && (node != HASH_DELETED))
+      hash_node_free( node );
+  }
   free(hash->table);
+  free(hash->hash_values);
   LOCK_DESTROY( &hash->rwlock );
   free(hash);
 }
@@ -28,6 +28,9 @@
 #include <ert/util/matrix.h>
 #include <ert/util/arg_pack.h>
 #include <ert/util/rng.h>
+#ifdef ERT_HAVE_LAPACK
+#include <ert/util/matrix_blas.h>
+#endif
 
 /**
    This is V E R Y  S I M P L E matrix implementation. It is not
@@ -1026,15 +1029,29 @@ void matrix_inplace_div(matrix_type * A , const matrix_type * B) {
    will fail in mysterious ways.
 */
 
+#define MATRIX_TRANSPOSE_BLOCK 32
+
 void matrix_transpose(const matrix_type * A , matrix_type * T) {
   if ((A->columns == T->rows) && (A->rows == T->columns)) {
-    int i,j;
-    for (i=0; i < A->rows; i++) {
-      for (j=0; j < A->columns; j++) {
-        size_t src_index    = GET_INDEX(A , i , j );
-        size_t target_index = GET_INDEX(T , j , i );
-
-        T->data[ target_index ] = A->data[ src_index ];
+    int i0,j0;
+    /*
+      The transpose is done in square tiles, so that both the reads
+      from A and the writes to T stay within a small set of cache
+      lines.
+    */
+    for (j0=0; j0 < A->columns; j0 += MATRIX_TRANSPOSE_BLOCK) {
+      int j1 = util_int_min( j0 + MATRIX_TRANSPOSE_BLOCK , A->columns );
+      for (i0=0; i0 < A->rows; i0 += MATRIX_TRANSPOSE_BLOCK) {
+        int i1 = util_int_min( i0 + MATRIX_TRANSPOSE_BLOCK , A->rows );
+        int i,j;
+        for (i=i0; i < i1; i++) {
+          for (j=j0; j < j1; j++) {
+            size_t src_index    = GET_INDEX(A , i , j );
+            size_t target_index = GET_INDEX(T , j , i );
+
+            T->data[ target_index ] = A->data[ src_index ];
+          }
+        }
       }
     }
   } else
@@ -1059,40 +1076,243 @@ matrix_type * matrix_alloc_transpose( const matrix_type * A) {
 
 
 
+/*****************************************************************/
+/* General matrix multiplication. */
+
+/*
+  Block sizes for matrix_gemm_blocked(); a packed MC x KC block of
+  op(A) (256 kB) is intended to stay in the L2 cache, and the columns
+  of C being updated in the inner kernel in L1.
+*/
+#define MATRIX_GEMM_MC 128
+#define MATRIX_GEMM_KC 256
+#define MATRIX_GEMM_NC 512
+#define MATRIX_GEMM_NR   4
+
+/*
+  Will pack the block op(A)[i0:i0+mc , p0:p0+kc] into the contiguous
+  buffer Apack, with the layout Apack[p*mc + i]. The packing takes
+  care of strides and transposition, so the kernel below only sees
+  unit stride data.
+*/
+
+static void matrix_gemm_pack_A( const matrix_type * A , bool transA , int i0 , int mc , int p0 , int kc , double * Apack) {
+  int i,p;
+  for (p=0; p < kc; p++) {
+    double * target = &Apack[ (size_t) p * mc ];
+    if (transA) {
+      for (i=0; i < mc; i++)
+        target[i] = A->data[ GET_INDEX(A , p0 + p , i0 + i) ];
+    } else {
+      const double * src = &A->data[ GET_INDEX(A , i0 , p0 + p) ];
+      if (A->row_stride == 1)
+        memcpy( target , src , mc * sizeof * target );
+      else
+        for (i=0; i < mc; i++)
+          target[i] = src[ (size_t) i * A->row_stride ];
+    }
+  }
+}
+
+
+/*
+  Will pack the block alpha * op(B)[p0:p0+kc , j0:j0+nc] into the
+  contiguous buffer Bpack, with the layout Bpack[j*kc + p].
+*/
+
+static void matrix_gemm_pack_B( const matrix_type * B , bool transB , double alpha , int p0 , int kc , int j0 , int nc , double * Bpack) {
+  int j,p;
+  for (j=0; j < nc; j++) {
+    double * target = &Bpack[ (size_t) j * kc ];
+    for (p=0; p < kc; p++) {
+      if (transB)
+        target[p] = alpha * B->data[ GET_INDEX(B , j0 + j , p0 + p) ];
+      else
+        target[p] = alpha * B->data[ GET_INDEX(B , p0 + p , j0 + j) ];
+    }
+  }
+}
+
+
+/*
+  Inner kernel: C[i0:i0+mc , j0:j0+nc] += Apack * Bpack. The columns
+  of C are updated MATRIX_GEMM_NR at a time in local accumulators;
+  the innermost loops run over unit stride data and are vectorized
+  by the compiler.
+*/
+
+static void matrix_gemm_kernel( matrix_type * C , int i0 , int mc , int j0 , int nc , int kc , const double * Apack , const double * Bpack) {
+  double acc[MATRIX_GEMM_NR][MATRIX_GEMM_MC];
+  int i,j,p,r;
+
+  for (j=0; j < nc; j += MATRIX_GEMM_NR) {
+    int nr = util_int_min( MATRIX_GEMM_NR , nc - j );
+
+    for (r=0; r < nr; r++)
+      for (i=0; i < mc; i++)
+        acc[r][i] = 0;
+
+    if (nr == MATRIX_GEMM_NR) {
+      const double * b0 = &Bpack[ (size_t) (j + 0) * kc ];
+      const double * b1 = &Bpack[ (size_t) (j + 1) * kc ];
+      const double * b2 = &Bpack[ (size_t) (j + 2) * kc ];
+      const double * b3 = &Bpack[ (size_t) (j + 3) * kc ];
+      double * c0 = acc[0];
+      double * c1 = acc[1];
+      double * c2 = acc[2];
+      double * c3 = acc[3];
+
+      for (p=0; p < kc; p++) {
+        const double * a = &Apack[ (size_t) p * mc ];
+        const double s0 = b0[p];
+        const double s1 = b1[p];
+        const double s2 = b2[p];
+        const double s3 = b3[p];
+        for (i=0; i < mc; i++) {
+          c0[i] += a[i] * s0;
+          c1[i] += a[i] * s1;
+          c2[i] += a[i] * s2;
+          c3[i] += a[i] * s3;
+        }
+      }
+    } else {
+      for (r=0; r < nr; r++) {
+        const double * b = &Bpack[ (size_t) (j + r) * kc ];
+        double * c = acc[r];
+        for (p=0; p < kc; p++) {
+          const double * a = &Apack[ (size_t) p * mc ];
+          const double s = b[p];
+          for (i=0; i < mc; i++)
+            c[i] += a[i] * s;
+        }
+      }
+    }
+
+    for (r=0; r < nr; r++) {
+      double * c = &C->data[ GET_INDEX(C , i0 , j0 + j + r) ];
+      if (C->row_stride == 1) {
+        for (i=0; i < mc; i++)
+          c[i] += acc[r][i];
+      } else {
+        for (i=0; i < mc; i++)
+          c[ (size_t) i * C->row_stride ] += acc[r][i];
+      }
+    }
+  }
+}
+
+
+static void matrix_gemm_assert_dims( const matrix_type * C , const matrix_type * A , const matrix_type * B , bool transA , bool transB , const char * caller) {
+  int innerA = transA ? A->rows    : A->columns;
+  int outerA = transA ? A->columns : A->rows;
+  int innerB = transB ? B->columns : B->rows;
+  int outerB = transB ? B->rows    : B->columns;
+
+  if ((innerA != innerB) || (outerA != C->rows) || (outerB != C->columns))
+    util_abort("%s: size mismatch  C:[%d,%d]  op(A):[%d,%d]  op(B):[%d,%d]\n", caller ,
+               C->rows , C->columns , outerA , innerA , innerB , outerB);
+}
+
+
+/**
+   C = alpha * op(A) * op(B)  +  beta * C
+
+   Portable cache blocked implementation of the BLAS dgemm() routine;
+   works for all matrix strides. C must not overlap with A or B. See
+   matrix_gemm() for the function which should normally be used.
+*/
+
+void matrix_gemm_blocked(matrix_type * C , const matrix_type * A , const matrix_type * B , bool transA , bool transB , double alpha , double beta) {
+  const int m = C->rows;
+  const int n = C->columns;
+  const int k = transA ? A->rows : A->columns;
+
+  matrix_gemm_assert_dims( C , A , B , transA , transB , __func__ );
+
+  if (beta == 0)
+    matrix_set( C , 0 );
+  else if (beta != 1)
+    matrix_scale( C , beta );
+
+  if ((alpha == 0) || (k == 0))
+    return;
+
+  {
+    double * Apack = util_malloc( (size_t) MATRIX_GEMM_MC * MATRIX_GEMM_KC * sizeof * Apack );
+    double * Bpack = util_malloc( (size_t) MATRIX_GEMM_KC * MATRIX_GEMM_NC * sizeof * Bpack );
+    int i0,j0,p0;
+
+    for (j0=0; j0 < n; j0 += MATRIX_GEMM_NC) {
+      int nc = util_int_min( MATRIX_GEMM_NC , n - j0 );
+      for (p0=0; p0 < k; p0 += MATRIX_GEMM_KC) {
+        int kc = util_int_min( MATRIX_GEMM_KC , k - p0 );
+        matrix_gemm_pack_B( B , transB , alpha , p0 , kc , j0 , nc , Bpack );
+        for (i0=0; i0 < m; i0 += MATRIX_GEMM_MC) {
+          int mc = util_int_min( MATRIX_GEMM_MC , m - i0 );
+          matrix_gemm_pack_A( A , transA , i0 , mc , p0 , kc , Apack );
+          matrix_gemm_kernel( C , i0 , mc , j0 , nc , kc , Apack , Bpack );
+        }
+      }
+    }
+
+    free( Apack );
+    free( Bpack );
+  }
+}
+
+
+/**
+   C = alpha * op(A) * op(B)  +  beta * C
+
+   When the library is built with BLAS support, and all the matrices
+   are stored in column major order, the multiplication is done with
+   the BLAS dgemm() routine, otherwise with matrix_gemm_blocked().
+*/
+
+void matrix_gemm(matrix_type * C , const matrix_type * A , const matrix_type * B , bool transA , bool transB , double alpha , double beta) {
+#ifdef ERT_HAVE_LAPACK
+  if ((A->row_stride == 1) && (B->row_stride == 1) && (C->row_stride == 1)) {
+    matrix_gemm_assert_dims( C , A , B , transA , transB , __func__ );
+    matrix_dgemm( C , A , B , transA , transB , alpha , beta );
+    return;
+  }
+#endif
+  matrix_gemm_blocked( C , A , B , transA , transB , alpha , beta );
+}
+
+
 /**
    For this function to work the following must be satisfied:
 
      columns in A == rows in B == columns in B
 
    For general matrix multiplactions where A = B * C all have
-   different dimensions you can use matrix_matmul() (which calls the
-   BLAS routine dgemm());
+   different dimensions you can use matrix_gemm().
+
+   The product is calculated in panels of rows of A; each panel is
+   copied to a temporary buffer and multiplied with matrix_gemm().
 */
 
+#define MATRIX_MATMUL_PANEL_ROWS 1024
 
 void matrix_inplace_matmul(matrix_type * A, const matrix_type * B) {
   if ((A->columns == B->rows) && (B->rows == B->columns)) {
-    double * tmp = util_malloc( sizeof * A->data * A->columns );
-    int i,j,k;
+    int panel_rows = util_int_min( MATRIX_MATMUL_PANEL_ROWS , A->rows );
+    matrix_type * tmp = matrix_alloc( panel_rows , A->columns );
+    int row_offset;
 
-    for (i=0; i < A->rows; i++) {
+    for (row_offset = 0; row_offset < A->rows; row_offset += panel_rows) {
+      int rows = util_int_min( panel_rows , A->rows - row_offset );
+      matrix_type * A_panel   = matrix_alloc_shared( A , row_offset , 0 , rows , A->columns );
+      matrix_type * tmp_panel = matrix_alloc_shared( tmp , 0 , 0 , rows , A->columns );
 
-      /* Clearing the tmp vector */
-      for (k=0; k < B->rows; k++)
-        tmp[k] = 0;
+      matrix_assign( tmp_panel , A_panel );
+      matrix_gemm( A_panel , tmp_panel , B , false , false , 1 , 0 );
 
-      for (j=0; j < B->rows; j++) {
-        double scalar_product = 0;
-        for (k=0; k < A->columns; k++)
-          scalar_product += A->data[ GET_INDEX(A,i,k) ] * B->data[ GET_INDEX(B,k,j) ];
-
-        /* Assign first to tmp[j] */
-        tmp[j] = scalar_product;
-      }
-      for (j=0; j < A->columns; j++)
-        A->data[ GET_INDEX(A , i, j) ] = tmp[j];
+      matrix_free( tmp_panel );
+      matrix_free( A_panel );
     }
-    free(tmp);
+    matrix_free( tmp );
   } else
     util_abort("%s: size mismatch: A:[%d,%d]   B:[%d,%d]\n",__func__ , matrix_get_rows(A) , matrix_get_columns(A) , matrix_get_rows(B) , matrix_get_columns(B));
 }
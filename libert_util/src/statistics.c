@@ -55,10 +55,97 @@ double statistics_std( const double_vector_type * data_vector ) {
 
  
 
+/*
+   The quantile is calculated from the sorted values data[0...size];
+   observe that @size is the index of the last element, i.e. the
+   number of elements minus one.
+
+   When data[lower_index] == data[upper_index] the indices are moved
+   outwards until they point to different values. The function will
+   only look at the elements in the range [min_index,max_index]; if
+   the calculation needs an element outside this range the function
+   will return false - the elements outside the range are not
+   necessarily sorted when called from statistics_empirical_quantiles__().
+*/
+
+static bool statistics_empirical_quantile_range( const double * data , int size , int min_index , int max_index , double quantile , double * value) {
+  if ((quantile < 0) || (quantile > 1.0))
+    util_abort("%s: quantile must be in [0,1] \n",__func__);
+
+  if (data[0] == data[size]) {
+    /*
+       All elements are equal - and it is impossible to find a meaingful quantile,
+       we just return "the value".
+    */
+    *value = data[0];
+    return true;
+  } else {
+    double lower_value;
+    double upper_value;
+    double real_index;
+    double upper_quantile;
+    double lower_quantile;
+
+    int    lower_index;
+    int    upper_index;
+
+
+    real_index  = quantile * size;
+    lower_index = floor( real_index );
+    upper_index = ceil( real_index );
+
+    if ((lower_index < min_index) || (upper_index > max_index))
+      return false;
+
+    upper_value    = data[upper_index];
+    lower_value    = data[lower_index];
+
+    /*
+       Will iterate in this loop until we have found upper_value !=
+       lower_value. As long as we know that now all elements are
+       equal (the first test), this is guaranteed to succeed, but of
+       course the estimate will not be very meaningful if the sample
+       consist of a significant number of equal values.
+    */
+    while (true) {
+
+      /*1: Try to shift the upper index up. */
+      if (upper_value == lower_value) {
+        upper_index = util_int_min( size , upper_index + 1);
+        if (upper_index > max_index)
+          return false;
+        upper_value = data[upper_index];
+      } else
+        break;
+
+      /*2: Try to shift the lower index down. */
+      if (upper_value == lower_value) {
+        lower_index = util_int_max( 0 , lower_index - 1);
+        if (lower_index < min_index)
+          return false;
+        lower_value = data[lower_index];
+      } else
+        break;
+
+    }
+
+    upper_quantile = upper_index * 1.0 / size;
+    lower_quantile = lower_index * 1.0 / size;
+    /* Linear interpolation: */
+    {
+      double a = (upper_value - lower_value) / (upper_quantile - lower_quantile);
+
+      *value = lower_value + a*(quantile - lower_quantile);
+      return true;
+    }
+  }
+}
+
+
 /**
    Observe that the data vector will be sorted in place. If the vector is
    already sorted, e.g. from a previous call to statistics_empirical_quantile(),
-   you can call statistics_empirical_quantile__() directly.  
+   you can call statistics_empirical_quantile__() directly.
 */
 
 double statistics_empirical_quantile( double_vector_type * data , double quantile ) {
@@ -74,70 +161,195 @@ double statistics_empirical_quantile( double_vector_type * data , double quantil
 */
 
 double statistics_empirical_quantile__( const double_vector_type * data , double quantile ) {
-  if ((quantile < 0) || (quantile > 1.0))
-    util_abort("%s: quantile must be in [0,1] \n",__func__);
+  const int size = (double_vector_size( data ) - 1);
+  double value;
+  if (size < 0)
+    util_abort("%s: can not calculate quantile of empty vector\n",__func__);
 
-  {
-    const int size = (double_vector_size( data ) - 1);
-    if (double_vector_iget( data , 0) == double_vector_iget( data , size))
-      /* 
-         All elements are equal - and it is impossible to find a meaingful quantile,
-         we just return "the value".
-      */
-      return double_vector_iget( data, 0 );    
-    else {
-      double value;
-      double lower_value;
-      double upper_value;
-      double real_index;
-      double upper_quantile;
-      double lower_quantile;
-      
-      int    lower_index;
-      int    upper_index;
-      
-      
-      real_index  = quantile * size;
-      lower_index = floor( real_index );
-      upper_index = ceil( real_index );
-      
-      upper_value    = double_vector_iget( data , upper_index );
-      lower_value    = double_vector_iget( data , lower_index );
-
-      /* 
-         Will iterate in this loop until we have found upper_value !=
-         lower_value. As long as we know that now all elements are
-         equal (the first test), this is guaranteed to succeed, but of
-         course the estimate will not be very meaningful if the sample
-         consist of a significant number of equal values.
-      */
-      while (true) {
-
-        /*1: Try to shift the upper index up. */
-        if (upper_value == lower_value) {
-          upper_index = util_int_min( size , upper_index + 1);
-          upper_value = double_vector_iget( data , upper_index );
-        } else 
-          break;
-
-        /*2: Try to shift the lower index down. */
-        if (upper_value == lower_value) {
-          lower_index = util_int_max( 0 , lower_index - 1);
-          lower_value = double_vector_iget( data , lower_index );
-        } else 
-          break;
-        
+  statistics_empirical_quantile_range( double_vector_get_const_ptr( data ) , size , 0 , size , quantile , &value );
+  return value;
+}
+
+
+/*****************************************************************/
+
+#define SELECT_INSERTION_SIZE 16
+
+static void statistics_insertion_sort( double * data , int lo , int hi ) {
+  int i;
+  for (i = lo + 1; i <= hi; i++) {
+    double value = data[i];
+    int j = i - 1;
+    while ((j >= lo) && (data[j] > value)) {
+      data[j + 1] = data[j];
+      j--;
+    }
+    data[j + 1] = value;
+  }
+}
+
+
+static int statistics_cmp_double( const void * arg1 , const void * arg2) {
+  double value1 = *((const double *) arg1);
+  double value2 = *((const double *) arg2);
+  if (value1 < value2)
+    return -1;
+  if (value1 > value2)
+    return 1;
+  return 0;
+}
+
+
+static double statistics_median3( double a , double b , double c) {
+  if (a < b) {
+    if (b < c)
+      return b;
+    return (a < c) ? c : a;
+  } else {
+    if (a < c)
+      return a;
+    return (b < c) ? c : b;
+  }
+}
+
+
+/*
+   Will reorder data[lo...hi] so that for all the indices in the
+   sorted list targets[t1...t2) the element data[target] has the same
+   value as in a fully sorted array, and the array is partitioned
+   around it. This is quickselect for several indices in one pass; the
+   partitioning is three way so that many equal elements are handled
+   efficiently.
+*/
+
+static void statistics_multi_select( double * data , int lo , int hi , const int * targets , int t1 , int t2) {
+  while (t1 < t2) {
+    if (hi - lo < SELECT_INSERTION_SIZE) {
+      statistics_insertion_sort( data , lo , hi );
+      return;
+    }
+
+    {
+      const double pivot = statistics_median3( data[lo] , data[lo + (hi - lo) / 2] , data[hi] );
+      int lt = lo;
+      int gt = hi;
+      int i = lo;
+
+      /* [lo,lt): < pivot     [lt,i): == pivot    (gt,hi]: > pivot */
+      while (i <= gt) {
+        double value = data[i];
+        if (value < pivot) {
+          data[i] = data[lt];
+          data[lt] = value;
+          lt++;
+          i++;
+        } else if (value > pivot) {
+          data[i] = data[gt];
+          data[gt] = value;
+          gt--;
+        } else
+          i++;
       }
-      
-      upper_quantile = upper_index * 1.0 / size;
-      lower_quantile = lower_index * 1.0 / size;
-      /* Linear interpolation: */
+
       {
-        double a = (upper_value - lower_value) / (upper_quantile - lower_quantile);
-        
-        value = lower_value + a*(quantile - lower_quantile);
-        return value;
+        int tl = t1;
+        int tg;
+
+        while ((tl < t2) && (targets[tl] < lt))
+          tl++;
+
+        tg = tl;
+        while ((tg < t2) && (targets[tg] <= gt))
+          tg++;
+
+        statistics_multi_select( data , lo , lt - 1 , targets , t1 , tl );
+        lo = gt + 1;
+        t1 = tg;
+      }
+    }
+  }
+}
+
+
+/**
+   Will calculate several empirical quantiles of the @size elements
+   in @data in one pass, the result for quantiles[i] is stored in
+   values[i]. The results are identical to the results from
+   statistics_empirical_quantile(), but instead of sorting the data
+   only the elements needed for the quantiles are selected; the
+   elements in @data are reordered.
+*/
+
+void statistics_empirical_quantiles__( double * data , int size , int num_quantiles , const double * quantiles , double * values) {
+  const int last = size - 1;
+  int * targets;
+  int num_targets = 0;
+  int iq;
+
+  if (size <= 0)
+    util_abort("%s: can not calculate quantile of empty vector\n",__func__);
+
+  /*
+     For each quantile the elements around the lower and upper index
+     are selected, that is normally enough to resolve the shifting
+     for equal values in statistics_empirical_quantile_range().
+  */
+  targets = util_calloc( 4 * num_quantiles + 2 , sizeof * targets );
+  targets[num_targets++] = 0;
+  targets[num_targets++] = last;
+  for (iq = 0; iq < num_quantiles; iq++) {
+    double real_index = quantiles[iq] * last;
+    int lower_index = floor( real_index );
+    int upper_index = ceil( real_index );
+    int offset;
+
+    if ((quantiles[iq] < 0) || (quantiles[iq] > 1.0))
+      util_abort("%s: quantile must be in [0,1] \n",__func__);
+
+    for (offset = -1; offset <= 0; offset++) {
+      targets[num_targets++] = util_int_max( 0 , lower_index + offset );
+      targets[num_targets++] = util_int_min( last , upper_index - offset );
+    }
+  }
+
+  /* Sort and remove duplicates. */
+  {
+    int i, n = 0;
+    for (i = 1; i < num_targets; i++) {
+      int value = targets[i];
+      int j = i - 1;
+      while ((j >= 0) && (targets[j] > value)) {
+        targets[j + 1] = targets[j];
+        j--;
+      }
+      targets[j + 1] = value;
+    }
+    for (i = 0; i < num_targets; i++)
+      if ((n == 0) || (targets[n - 1] != targets[i]))
+        targets[n++] = targets[i];
+    num_targets = n;
+  }
+
+  statistics_multi_select( data , 0 , last , targets , 0 , num_targets );
+  {
+    bool sorted = false;
+    for (iq = 0; iq < num_quantiles; iq++) {
+      double real_index = quantiles[iq] * last;
+      int min_index = util_int_max( 0 , (int) floor( real_index ) - 1);
+      int max_index = util_int_min( last , (int) ceil( real_index ) + 1);
+
+      if (sorted) {
+        min_index = 0;
+        max_index = last;
+      }
+
+      if (!statistics_empirical_quantile_range( data , last , min_index , max_index , quantiles[iq] , &values[iq] )) {
+        /* Many equal values around the quantile - fall back to sorting. */
+        qsort( data , size , sizeof * data , statistics_cmp_double );
+        sorted = true;
+        statistics_empirical_quantile_range( data , last , 0 , last , quantiles[iq] , &values[iq] );
       }
     }
   }
+  free( targets );
 }
@@ -16,11 +16,9 @@
    for more details.
 */
 
-#define  _GNU_SOURCE   /* Must define this to get access to pthread_rwlock_t */
 #include <string.h>
 #include <stdlib.h>
 #include <stdio.h>
-#include <signal.h>
 #include <pthread.h>
 #include <unistd.h>
 
@@ -32,15 +30,24 @@
 
 
 /**
-   This file implements a small thread_pool object based on
-   pthread_create() function calls. The characetristics of this
+   This file implements a small thread_pool object based on a fixed
+   set of persistent worker threads. The characteristics of this
    implementation is as follows:
 
-    1. The jobs are mangaged by a separate thread - dispatch_thread.
-    2. The new jobs are just appended to the queue, the
-       dispatch_thread sees them in the queue and dispatches them.
-    3. The dispatch thread manages a list of thread_pool_job_slot_type
-       instances - one slot for each actually running job.
+    1. When the pool is started the worker threads are created with
+       pthread_create(); the worker threads live until the pool is
+       freed, and are reused when the pool is restarted.
+    2. New jobs are appended to the queue and an idle worker is woken
+       up with a condition variable; the worker threads take jobs from
+       the queue in FIFO order.
+    3. When a job completes the return value is stored in the queue
+       node of the job, and threads waiting in thread_pool_join() or
+       thread_pool_wait_job() are woken up.
+
+   All the shared state is protected by one mutex; the workers only
+   hold the mutex while taking a job from the queue and while storing
+   the result, i.e. never while the user supplied function is
+   running. There is no polling, an idle pool consumes no CPU.
 
    Example
    -------
@@ -80,7 +87,20 @@
 
          thread_pool_iget_return_value( tp , index );
 
-     To get the return value from function nr index.
+     To get the return value from function nr index. The number of
+     jobs which have completed so far can be queried with
+     thread_pool_get_num_complete().
+
+     If you need the result of one particular job before the pool is
+     joined, add it with thread_pool_submit_job() instead; the return
+     value is a handle which can be passed to thread_pool_wait_job():
+
+         int job = thread_pool_submit_job( tp , some_function , arg );
+         ....
+         void * result = thread_pool_wait_job( tp , job );
+
+     The handle is the queue index of the job, i.e. it is only valid
+     until the pool is restarted.
 
 
   5. Optional: The thread pool will probably mainly be used only once,
@@ -100,43 +120,32 @@ typedef void * (start_func_ftype) (void *) ;
    Internal struct which is used as queue node.
 */
 typedef struct {
-  thread_pool_type * pool;                /* A back-reference to the thread_pool holding the queue. */
-  int                slot_index;          /* The index in the space [0,max_running) of the job slot where this job is running. */
-  int                queue_index;         /* The index of the current tp_arg in the queue. */
   void             * func_arg;            /* The arguments to this job - supplied by the calling scope. */
   start_func_ftype * func;                /* The function to call - supplied by the calling scope. */
   void             * return_value;
+  bool               complete;            /* Set by the worker when the job has returned. */
 } thread_pool_arg_type;
 
 
 
-/**
-   Internal struct used to keep track of the job slots.
-*/
-typedef struct {
-  pthread_t  thread;                /* The thread variable currently (or more correct:last) running. */
-  int        run_count;             /* The number of times this slot has been used - just to check whether the slot has been used AT ALL when/if joining. */
-  bool       running;               /* Is the job_slot running now?? */
-} thread_pool_job_slot_type;
-
-
-
 
 #define THREAD_POOL_TYPE_ID 71443207
 struct thread_pool_struct {
   UTIL_TYPE_ID_DECLARATION;
   thread_pool_arg_type      * queue;              /* The jobs to be executed are appended in this vector. */
   int                         queue_index;        /* The index of the next job to run. */
-  int                         queue_size;         /* The number of jobs in the queue - including those which are complete. [Should be protected / atomic / ... ] */
+  int                         queue_size;         /* The number of jobs in the queue - including those which are complete. */
   int                         queue_alloc_size;   /* The allocated size of the queue. */
+  int                         num_complete;       /* The number of jobs which have run to completion. */
 
-  int                         max_running;        /* The max number of concurrently running jobs. */
-  bool                        join;               /* Flag set by the main thread to inform the dispatch thread that joining should start. */
-  bool                        accepting_jobs;     /* True|False whether the dispatch thread is running. */
+  int                         max_running;        /* The max number of concurrently running jobs, i.e. the number of worker threads. */
+  bool                        accepting_jobs;     /* True|False whether the pool has been started and not yet joined. */
+  bool                        shutdown;           /* Flag set by thread_pool_free() to tell the worker threads to exit. */
 
-  thread_pool_job_slot_type * job_slots;          /* A vector to @max_running job slots, each slot can be reused several times.*/
-  pthread_t                   dispatch_thread;
-  pthread_rwlock_t            queue_lock;
+  pthread_t                 * workers;            /* The @max_running worker threads; NULL until the pool is started the first time. */
+  pthread_mutex_t             lock;               /* Protects all the fields above. */
+  pthread_cond_t              job_cond;           /* Signalled when a job is added, or the pool is shut down. */
+  pthread_cond_t              complete_cond;      /* Broadcast every time a job completes. */
 };
 
 
@@ -144,37 +153,13 @@ static UTIL_SAFE_CAST_FUNCTION( thread_pool , THREAD_POOL_TYPE_ID )
 
 
 /**
-   This function will grow the queue. It is called by the main thread
-   (i.e. the context of the calling scope), and the queue is read by
-   the dispatch_thread - i.e. access to the queue must be protected by
-   rwlock.
+   This function will grow the queue; must be called with the lock
+   held.
 */
 
 static void thread_pool_resize_queue( thread_pool_type * pool, int queue_length ) {
-  pthread_rwlock_wrlock( &pool->queue_lock );
-  {
-    pool->queue            = util_realloc( pool->queue , queue_length * sizeof * pool->queue );
-    pool->queue_alloc_size = queue_length;
-  }
-  pthread_rwlock_unlock( &pool->queue_lock );
-}
-
-
-/**
-   This function updates an element in the queue, the function is
-   called by the executing threads, on the same time the main thread
-   might be resizing the thread, we therefor take a read lock during
-   execution of this function. (Write lock is not necessary because we
-   will not change the queue pointer itself, only something it points
-   to.)
-*/
-
-static void thread_pool_iset_return_value( thread_pool_type * pool , int index , void * return_value) {
-  pthread_rwlock_rdlock( &pool->queue_lock );
-  {
-    pool->queue[ index ].return_value = return_value;
-  }
-  pthread_rwlock_unlock( &pool->queue_lock );
+  pool->queue            = util_realloc( pool->queue , queue_length * sizeof * pool->queue );
+  pool->queue_alloc_size = queue_length;
 }
 
 
@@ -183,122 +168,48 @@ void * thread_pool_iget_return_value( const thread_pool_type * pool , int queue_
 }
 
 
-/**
-   The pthread_create() call which this is all about, does not start
-   the user supplied function. Instead it will start an instance of
-   this function, which will do some housekeeping before calling the
-   user supplied function.
-*/
-
-static void * thread_pool_start_job( void * arg ) {
-  thread_pool_arg_type * tp_arg = (thread_pool_arg_type * ) arg;
-  thread_pool_type * tp         =  tp_arg->pool;
-  int slot_index                =  tp_arg->slot_index;
-  void * func_arg               =  tp_arg->func_arg;
-  start_func_ftype * func       =  tp_arg->func;
-  void * return_value;
-
-
-  return_value = func( func_arg );                  /* Starting the real external function */
-  tp->job_slots[ slot_index ].running = false;      /* We mark the job as completed. */
-  free( arg );
-
-  if (return_value != NULL)
-    thread_pool_iset_return_value( tp , tp_arg->queue_index , return_value);
-
-  return NULL;
+int thread_pool_get_num_complete( thread_pool_type * pool ) {
+  int num_complete;
+  pthread_mutex_lock( &pool->lock );
+  num_complete = pool->num_complete;
+  pthread_mutex_unlock( &pool->lock );
+  return num_complete;
 }
 
 
-
 /**
-   This function is run by the dispatch_thread. The thread will keep
-   an eye on the queue, and dispatch new jobs when there are free
-   slots available.
+   This function is run by all the worker threads. The worker will
+   sleep on the job_cond condition variable until there are jobs in
+   the queue, run the job and store the return value. When the pool
+   is shut down the worker will complete all remaining jobs in the
+   queue before it exits.
 */
 
-static void * thread_pool_main_loop( void * arg ) {
+static void * thread_pool_worker( void * arg ) {
   thread_pool_type * tp = thread_pool_safe_cast( arg );
-  {
-    const int usleep_init = 1000;  /* The sleep time when there are free slots available - but no jobs wanting to run. */
-    int internal_offset   = 0;     /* Keep track of the (index of) the last job slot fired off - minor time saving. */
-    while (true) {
-      if (tp->queue_size > tp->queue_index) {
-        /*
-           There are jobs in the queue which would like to run -
-           let us see if we can find a slot for them.
-        */
-        int counter     = 0;
-        bool slot_found = false;
-        do {
-          int slot_index = (counter + internal_offset) % tp->max_running;
-          thread_pool_job_slot_type * job_slot = &tp->job_slots[ slot_index ];
-          if (!job_slot->running) {
-            /* OK thread[slot_index] is ready to take this job.*/
-            thread_pool_arg_type * tp_arg;
-
-            /*
-               The queue might be updated by the main thread - we must
-               take a copy of the node we are interested in.
-            */
-            pthread_rwlock_rdlock( &tp->queue_lock );
-            tp_arg = util_alloc_copy( &tp->queue[ tp->queue_index ] , sizeof * tp_arg );
-            pthread_rwlock_unlock( &tp->queue_lock );
-
-            tp_arg->slot_index = slot_index;
-            job_slot->running = true;
-            /*
-               Here is the actual pthread_create() call creating an
-               additional running thread.
-            */
-
-            /*Cleanup of previous run threads. Needed to avoid memory leak*/
-            if (job_slot->run_count > 0)
-              pthread_join(job_slot->thread, NULL);
-
-            pthread_create( &job_slot->thread , NULL , thread_pool_start_job , tp_arg );
-            job_slot->run_count += 1;
-            tp->queue_index++;
-            internal_offset += (counter + 1);
-            slot_found = true;
-          } else
-            counter++;
-        } while (!slot_found && (counter < tp->max_running));
-
-        if (!slot_found) {
-            util_yield();
-        }
-      } else
-        util_usleep(usleep_init);    /* There are no jobs wanting to run. */
-
-      /*****************************************************************/
-      /*
-        We exit explicitly from this loop when both conditions apply:
-
-         1. tp->join       == true              :  The calling scope has signaled that it will not submit more jobs.
-         2. tp->queue_size == tp->queue_index   :  This function has submitted all the jobs in the queue.
-      */
-      if ((tp->join) && (tp->queue_size == tp->queue_index))
-        break;
-    } /* End of while() loop */
-  }
 
-  /*
-     There are no more jobs in the queue, and the main scope has
-     signaled that join should start. Observe that we join only the
-     jobs corresponding to explicitly running job_slots; when a job
-     slot is used multiple times the first jobs run in the job_slot
-     will not be explicitly joined.
-  */
-  {
-    int i;
-    for (i=0; i < tp->max_running; i++) {
-      thread_pool_job_slot_type job_slot = tp->job_slots[i];
-      if (job_slot.run_count > 0)
-        pthread_join( job_slot.thread , NULL );
-    }
+  pthread_mutex_lock( &tp->lock );
+  while (true) {
+    if (tp->queue_index < tp->queue_size) {
+      int queue_index          = tp->queue_index++;
+      start_func_ftype * func  = tp->queue[ queue_index ].func;
+      void * func_arg          = tp->queue[ queue_index ].func_arg;
+      void * return_value;
+
+      pthread_mutex_unlock( &tp->lock );
+      return_value = func( func_arg );                  /* Starting the real external function */
+      pthread_mutex_lock( &tp->lock );
+
+      tp->queue[ queue_index ].return_value = return_value;
+      tp->queue[ queue_index ].complete     = true;
+      tp->num_complete++;
+      pthread_cond_broadcast( &tp->complete_cond );
+    } else if (tp->shutdown)
+      break;
+    else
+      pthread_cond_wait( &tp->job_cond , &tp->lock );
   }
-  /* When we are here all the jobs have completed. */
+  pthread_mutex_unlock( &tp->lock );
   return NULL;
 }
 
@@ -307,8 +218,9 @@ static void * thread_pool_main_loop( void * arg ) {
 
 /**
    This function initializes a couple of counters, and starts up the
-   dispatch thread. If the thread_pool should be reused after a join,
-   this function must be called before adding new jobs.
+   worker threads the first time it is called. If the thread_pool
+   should be reused after a join, this function must be called before
+   adding new jobs.
 
    The functions thread_pool_restart() and thread_pool_join() should
    be joined up like open/close and malloc/free combinations.
@@ -317,98 +229,72 @@ static void * thread_pool_main_loop( void * arg ) {
 void thread_pool_restart( thread_pool_type * tp ) {
   if (tp->accepting_jobs)
     util_abort("%s: fatal error - tried restart already running thread pool\n",__func__);
+
+  pthread_mutex_lock( &tp->lock );
   {
-    tp->join           = false;
     tp->queue_index    = 0;
     tp->queue_size     = 0;
-    {
-      int i;
-      for (i=0; i < tp->max_running; i++) {
-        tp->job_slots[i].run_count = 0;
-        tp->job_slots[i].running   = false;
-      }
-    }
-
-    /* Starting the dispatch thread. */
-    pthread_create( &tp->dispatch_thread , NULL , thread_pool_main_loop , tp );
+    tp->num_complete   = 0;
     tp->accepting_jobs = true;
   }
+  pthread_mutex_unlock( &tp->lock );
+
+  if ((tp->workers == NULL) && (tp->max_running > 0)) {
+    int i;
+    tp->workers = util_calloc( tp->max_running , sizeof * tp->workers );
+    for (i=0; i < tp->max_running; i++)
+      pthread_create( &tp->workers[i] , NULL , thread_pool_worker , tp );
+  }
 }
 
 
 
 /**
    This function is called by the calling scope when all the jobs have
-   been submitted, and we just wait for them to complete.
-
-   This function just sets the join switch to true - this again tells
-   the dispatch_thread to start the join process on the worker
-   threads.
+   been submitted, and we just wait for them to complete. The worker
+   threads are not stopped, they stay idle until the pool is
+   restarted or freed.
 */
 
 void thread_pool_join(thread_pool_type * pool) {
-  pool->join = true;                               /* Signals to the main thread that joining can start. */
-  if (pool->max_running > 0) {
-    pthread_join( pool->dispatch_thread , NULL );  /* Wait for the main thread to complete. */
+  pthread_mutex_lock( &pool->lock );
+  {
+    while (pool->num_complete < pool->queue_size)
+      pthread_cond_wait( &pool->complete_cond , &pool->lock );
     pool->accepting_jobs = false;
   }
+  pthread_mutex_unlock( &pool->lock );
 }
 
 /*
-  This will try to join the thread; if the manager thread has not
-  completed within @timeout_seconds the function will return false. If
-  the join fails the queue will be reset in a non-joining state and it
-  will be open for more jobs. Probably not in a 100% sane state.
+  This will try to join the pool; if the jobs have not completed
+  within @timeout_seconds the function will return false. If the join
+  fails the pool is left in the running state and it will be open for
+  more jobs.
 */
 
 bool thread_pool_try_join(thread_pool_type * pool, int timeout_seconds) {
   bool join_ok = true;
+  struct timespec ts;
+  time_t timeout_time = time( NULL );
 
-  pool->join = true;                               /* Signals to the main thread that joining can start. */
-  if (pool->max_running > 0) {
-    struct timespec ts;
-    time_t timeout_time = time( NULL );
-
-    util_inplace_forward_seconds_utc(&timeout_time , timeout_seconds );
-    ts.tv_sec = timeout_time;
-    ts.tv_nsec = 0;
-
-#ifdef HAVE_TIMEDJOIN
+  util_inplace_forward_seconds_utc(&timeout_time , timeout_seconds );
+  ts.tv_sec = timeout_time;
+  ts.tv_nsec = 0;
 
-    {
-      int join_return = pthread_timedjoin_np( pool->dispatch_thread , NULL , &ts);  /* Wait for the main thread to complete. */
-      if (join_return == 0)
-        pool->accepting_jobs = false;
-      else {
-        pool->join = false;
-        join_ok = false;
+  pthread_mutex_lock( &pool->lock );
+  {
+    while (pool->num_complete < pool->queue_size) {
+      if (pthread_cond_timedwait( &pool->complete_cond , &pool->lock , &ts ) != 0) {
+        join_ok = (pool->num_complete == pool->queue_size);
+        break;
       }
     }
-
-#else
-
-    while(true) {
-        if (pthread_kill(pool->dispatch_thread, 0) == 0){
-            util_yield();
-        } else {
-            pthread_join(pool->dispatch_thread, NULL);
-            pool->accepting_jobs = false;
-            break;
-        }
-
-        time_t now = time(NULL);
-
-        if(util_difftime_seconds(now, timeout_time) <= 0) {
-            join_ok = false;
-            break;
-        }
-    }
-
-#endif
-
-
-
+    if (join_ok)
+      pool->accepting_jobs = false;
   }
+  pthread_mutex_unlock( &pool->lock );
+
   return join_ok;
 }
 
@@ -417,7 +303,7 @@ bool thread_pool_try_join(thread_pool_type * pool, int timeout_seconds) {
 
 /**
    max_running is the maximum number of concurrent threads. If
-   @start_queue is true the dispatch thread will start immediately. If
+   @start_queue is true the worker threads will start immediately. If
    the function is called with @start_queue == false you must first
    call thread_pool_restart() BEFORE you can start adding jobs.
 */
@@ -425,11 +311,17 @@ bool thread_pool_try_join(thread_pool_type * pool, int timeout_seconds) {
 thread_pool_type * thread_pool_alloc(int max_running , bool start_queue) {
   thread_pool_type * pool = util_malloc( sizeof *pool );
   UTIL_TYPE_ID_INIT( pool , THREAD_POOL_TYPE_ID );
-  pool->job_slots         = util_calloc( max_running , sizeof * pool->job_slots );
   pool->max_running       = max_running;
   pool->queue             = NULL;
+  pool->queue_index       = 0;
+  pool->queue_size        = 0;
+  pool->num_complete      = 0;
   pool->accepting_jobs    = false;
-  pthread_rwlock_init( &pool->queue_lock , NULL);
+  pool->shutdown          = false;
+  pool->workers           = NULL;
+  pthread_mutex_init( &pool->lock , NULL );
+  pthread_cond_init( &pool->job_cond , NULL );
+  pthread_cond_init( &pool->complete_cond , NULL );
   thread_pool_resize_queue( pool  , 32 );
   if (start_queue)
     thread_pool_restart( pool );
@@ -438,44 +330,126 @@ thread_pool_type * thread_pool_alloc(int max_running , bool start_queue) {
 
 
 
+/*
+   Appends a job to the queue and wakes up one idle worker; must be
+   called with the lock held. Returns the queue index of the new job.
+*/
+
+static int thread_pool_append_job__( thread_pool_type * pool , start_func_ftype * start_func , void * func_arg ) {
+  int queue_index;
+  if (!pool->accepting_jobs) {
+    pthread_mutex_unlock( &pool->lock );
+    util_abort("%s: thread_pool is not running - restart with thread_pool_restart()?? \n",__func__);
+  }
+
+  if (pool->queue_size == pool->queue_alloc_size)
+    thread_pool_resize_queue( pool , pool->queue_alloc_size * 2);
+
+  queue_index = pool->queue_size;
+  pool->queue[ queue_index ].func_arg     = func_arg;
+  pool->queue[ queue_index ].func         = start_func;
+  pool->queue[ queue_index ].return_value = NULL;
+  pool->queue[ queue_index ].complete     = false;
+  pool->queue_size++;
+  pthread_cond_signal( &pool->job_cond );   /* Wake up one idle worker. */
+  return queue_index;
+}
+
+
+
 void thread_pool_add_job(thread_pool_type * pool , start_func_ftype * start_func , void * func_arg ) {
   if (pool->max_running == 0) /* Blocking non-threaded mode: */
     start_func( func_arg );
   else {
-    if (pool->accepting_jobs) {
-      if (pool->queue_size == pool->queue_alloc_size)
-        thread_pool_resize_queue( pool , pool->queue_alloc_size * 2);
-
-      /*
-         The new job is added to the queue - the main thread is watching
-         the queue and will pick up the new job.
-      */
-      {
-        int queue_index = pool->queue_size;
-
-        pool->queue[ queue_index ].pool         = pool;
-        pool->queue[ queue_index ].func_arg     = func_arg;
-        pool->queue[ queue_index ].func         = start_func;
-        pool->queue[ queue_index ].return_value = NULL;
-        pool->queue[ queue_index ].queue_index = queue_index;
-      }
-      pool->queue_size++;  /* <- This is shared between this thread and the dispatch thread */
-    } else
-      util_abort("%s: thread_pool is not running - restart with thread_pool_restart()?? \n",__func__);
+    pthread_mutex_lock( &pool->lock );
+    thread_pool_append_job__( pool , start_func , func_arg );
+    pthread_mutex_unlock( &pool->lock );
   }
 }
 
 
+/**
+   Like thread_pool_add_job(), but the return value is a handle which
+   can be used to wait for this particular job with
+   thread_pool_wait_job(). In the blocking non-threaded mode the job
+   has completed when this function returns.
+*/
+
+int thread_pool_submit_job(thread_pool_type * pool , start_func_ftype * start_func , void * func_arg ) {
+  int job;
+  pthread_mutex_lock( &pool->lock );
+  job = thread_pool_append_job__( pool , start_func , func_arg );
+  if (pool->max_running == 0) {
+    pool->queue_index++;
+    pthread_mutex_unlock( &pool->lock );
+    {
+      void * return_value = start_func( func_arg );
+      pthread_mutex_lock( &pool->lock );
+      pool->queue[ job ].return_value = return_value;
+      pool->queue[ job ].complete     = true;
+      pool->num_complete++;
+    }
+  }
+  pthread_mutex_unlock( &pool->lock );
+  return job;
+}
+
+
+/**
+   Will block until the job with handle @job - as returned from
+   thread_pool_submit_job() - has completed, and return the return
+   value of the job. The other jobs in the pool are not waited for.
+*/
+
+void * thread_pool_wait_job( thread_pool_type * pool , int job ) {
+  void * return_value;
+  pthread_mutex_lock( &pool->lock );
+  if ((job < 0) || (job >= pool->queue_size)) {
+    pthread_mutex_unlock( &pool->lock );
+    util_abort("%s: invalid job handle:%d \n",__func__ , job);
+  }
+
+  while (!pool->queue[ job ].complete)
+    pthread_cond_wait( &pool->complete_cond , &pool->lock );
+  return_value = pool->queue[ job ].return_value;
+  pthread_mutex_unlock( &pool->lock );
+  return return_value;
+}
+
+
+bool thread_pool_job_complete( thread_pool_type * pool , int job ) {
+  bool complete;
+  pthread_mutex_lock( &pool->lock );
+  complete = (job >= 0) && (job < pool->queue_size) && pool->queue[ job ].complete;
+  pthread_mutex_unlock( &pool->lock );
+  return complete;
+}
+
+
 
 /*
-  Observe that this function does not join the worker threads,
-  i.e. you should call thread_pool_join() first (otherwise the thing
-  will go up in flames).
+  Will stop the worker threads; jobs still in the queue are run to
+  completion before the worker threads exit. You should still call
+  thread_pool_join() before freeing the pool to get a well defined
+  ordering of the calling scope and the jobs.
 */
 
 
 void thread_pool_free(thread_pool_type * pool) {
-  util_safe_free( pool->job_slots );
+  if (pool->workers) {
+    int i;
+    pthread_mutex_lock( &pool->lock );
+    pool->shutdown = true;
+    pthread_cond_broadcast( &pool->job_cond );
+    pthread_mutex_unlock( &pool->lock );
+
+    for (i=0; i < pool->max_running; i++)
+      pthread_join( pool->workers[i] , NULL );
+    free( pool->workers );
+  }
+  pthread_cond_destroy( &pool->job_cond );
+  pthread_cond_destroy( &pool->complete_cond );
+  pthread_mutex_destroy( &pool->lock );
   util_safe_free( pool->queue );
   free(pool);
 }
@@ -140,7 +140,7 @@
 
 
 static uint16_t util_endian_convert16( uint16_t u ) {
-  return (( u >> 8U ) & 0xFFU) | (( u & 0xFFU) >> 8U);
+  return (( u >> 8U ) & 0xFFU) | (( u & 0xFFU) << 8U);
 }
 
 
@@ -179,7 +179,96 @@ static uint64_t util_endian_convert32_64( uint64_t u ) {
 
 
 
-void util_endian_flip_vector(void *data, int element_size , int elements) {
+#ifdef HAVE_X86_SIMD_DISPATCH
+/*
+  Vectorized endian conversion for x86-64. The best instruction set
+  available on the running cpu is selected at runtime:
+
+    AVX2  : 32 bytes per iteration with _mm256_shuffle_epi8().
+    SSSE3 : 16 bytes per iteration with _mm_shuffle_epi8().
+    SSE2  : 16 bytes per iteration with shifts and word shuffles;
+            SSE2 is part of the x86-64 baseline and always available.
+
+  The functions return the number of bytes which have been converted;
+  the remaining tail is left for the scalar code.
+*/
+
+#include <immintrin.h>
+
+static __m128i util_endian_flip_mask( int element_size ) {
+  if (element_size == 2)
+    return _mm_setr_epi8( 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 );
+  else if (element_size == 4)
+    return _mm_setr_epi8( 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12 );
+  else
+    return _mm_setr_epi8( 7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8 );
+}
+
+
+__attribute__((target("avx2")))
+static size_t util_endian_flip_avx2( char * data , int element_size , size_t size ) {
+  const __m256i mask = _mm256_broadcastsi128_si256( util_endian_flip_mask( element_size ));
+  size_t offset;
+
+  for (offset = 0; offset + 32 <= size; offset += 32) {
+    __m256i v = _mm256_loadu_si256( (const __m256i *) &data[offset] );
+    _mm256_storeu_si256( (__m256i *) &data[offset] , _mm256_shuffle_epi8( v , mask ));
+  }
+  return offset;
+}
+
+
+__attribute__((target("ssse3")))
+static size_t util_endian_flip_ssse3( char * data , int element_size , size_t size ) {
+  const __m128i mask = util_endian_flip_mask( element_size );
+  size_t offset;
+
+  for (offset = 0; offset + 16 <= size; offset += 16) {
+    __m128i v = _mm_loadu_si128( (const __m128i *) &data[offset] );
+    _mm_storeu_si128( (__m128i *) &data[offset] , _mm_shuffle_epi8( v , mask ));
+  }
+  return offset;
+}
+
+
+static size_t util_endian_flip_sse2( char * data , int element_size , size_t size ) {
+  size_t offset;
+
+  for (offset = 0; offset + 16 <= size; offset += 16) {
+    __m128i v = _mm_loadu_si128( (const __m128i *) &data[offset] );
+
+    /* Swap the bytes in every 16 bit word ... */
+    v = _mm_or_si128( _mm_slli_epi16( v , 8 ) , _mm_srli_epi16( v , 8 ));
+
+    /* ... and then reorder the words within each element. */
+    if (element_size == 4) {
+      v = _mm_shufflelo_epi16( v , _MM_SHUFFLE( 2 , 3 , 0 , 1 ));
+      v = _mm_shufflehi_epi16( v , _MM_SHUFFLE( 2 , 3 , 0 , 1 ));
+    } else if (element_size == 8) {
+      v = _mm_shufflelo_epi16( v , _MM_SHUFFLE( 0 , 1 , 2 , 3 ));
+      v = _mm_shufflehi_epi16( v , _MM_SHUFFLE( 0 , 1 , 2 , 3 ));
+    }
+
+    _mm_storeu_si128( (__m128i *) &data[offset] , v );
+  }
+  return offset;
+}
+
+
+static size_t util_endian_flip_simd( char * data , int element_size , size_t size ) {
+  if (__builtin_cpu_supports( "avx2" ))
+    return util_endian_flip_avx2( data , element_size , size );
+
+  if (__builtin_cpu_supports( "ssse3" ))
+    return util_endian_flip_ssse3( data , element_size , size );
+
+  return util_endian_flip_sse2( data , element_size , size );
+}
+
+#endif
+
+
+static void util_endian_flip_vector__(void *data, int element_size , int elements) {
   int i;
   switch (element_size) {
   case(1):
@@ -236,6 +325,22 @@ void util_endian_flip_vector(void *data, int element_size , int elements) {
   }
 }
 
+
+void util_endian_flip_vector(void *data, int element_size , int elements) {
+#ifdef HAVE_X86_SIMD_DISPATCH
+  if ((element_size == 2) || (element_size == 4) || (element_size == 8)) {
+    size_t size = (size_t) element_size * elements;
+    if (size >= 16) {
+      size_t offset = util_endian_flip_simd( data , element_size , size );
+      data = &((char *) data)[offset];
+      elements -= offset / element_size;
+    }
+  }
+#endif
+  util_endian_flip_vector__( data , element_size , elements );
+}
+
+
 void util_endian_flip_vector_old(void *data, int element_size , int elements) {
   int i;
   switch (element_size) {
@@ -4786,6 +4891,123 @@ void util_fprintf_double(double value , int width , int decimals , char base_fmt
 }
 
 
+/**
+   Will format @value into @buffer exactly as sprintf(buffer , "%g" ,
+   value) in a locale where the decimal point is '.', and return the
+   number of characters written. The buffer must have room for at
+   least 32 characters.
+
+   The six significant digits are found with floating point scaling
+   instead of the exact multiprecision conversion done by printf();
+   the scaling error is far below the rounding threshold, and in the
+   rare cases where the value is so close to a rounding tie that the
+   result could be affected - and for non finite, zero and extremely
+   small or large values - we fall back to sprintf().
+*/
+
+static double util_pow10__( int n ) {
+  /* The powers 10^0 ... 10^22 are exactly representable as double. */
+  static const double exact_pow10[] = {1e0 , 1e1 , 1e2 , 1e3 , 1e4 , 1e5 , 1e6 , 1e7 , 1e8 , 1e9 , 1e10 , 1e11,
+                                       1e12 , 1e13 , 1e14 , 1e15 , 1e16 , 1e17 , 1e18 , 1e19 , 1e20 , 1e21 , 1e22};
+  if (n <= 22)
+    return exact_pow10[n];
+  else
+    return pow( 10.0 , n );
+}
+
+
+int util_sprintf_g( char * buffer , double value ) {
+  const int precision = 6;
+  double abs_value = fabs( value );
+  int    exp10;
+  long   digits;
+
+  if (!((abs_value > 1e-300) && (abs_value < 1e300)))
+    return sprintf( buffer , "%g" , value );
+
+  exp10 = (int) floor( log10( abs_value ));
+  {
+    double scaled = 0;
+    double frac;
+    int iter;
+
+    /* The log10() estimate can be off by one close to a power of ten. */
+    for (iter = 0; iter < 2; iter++) {
+      int shift = precision - 1 - exp10;
+      if (shift >= 0)
+        scaled = abs_value * util_pow10__( shift );
+      else
+        scaled = abs_value / util_pow10__( -shift );
+
+      if (scaled < 100000.0)
+        exp10--;
+      else if (scaled >= 1000000.0)
+        exp10++;
+      else
+        break;
+    }
+
+    frac = scaled - floor( scaled );
+    if ((scaled < 100000.0) || (scaled >= 1000000.0) || (fabs( frac - 0.5 ) < 1e-6))
+      return sprintf( buffer , "%g" , value );
+
+    digits = (long) floor( scaled ) + ((frac > 0.5) ? 1 : 0);
+    if (digits == 1000000) {
+      digits = 100000;
+      exp10++;
+    }
+  }
+
+  {
+    char   digit_string[8];
+    char * p = buffer;
+    int    num_digits = precision;
+
+    sprintf( digit_string , "%ld" , digits );
+    while ((num_digits > 1) && (digit_string[num_digits - 1] == '0'))
+      num_digits--;
+
+    if (value < 0)
+      *p++ = '-';
+
+    if ((exp10 < -4) || (exp10 >= precision)) {
+      int abs_exp = abs( exp10 );
+
+      *p++ = digit_string[0];
+      if (num_digits > 1) {
+        *p++ = '.';
+        memcpy( p , &digit_string[1] , num_digits - 1 );
+        p += num_digits - 1;
+      }
+      *p++ = 'e';
+      *p++ = (exp10 < 0) ? '-' : '+';
+      if (abs_exp >= 100)
+        *p++ = '0' + abs_exp / 100;
+      *p++ = '0' + (abs_exp / 10) % 10;
+      *p++ = '0' + abs_exp % 10;
+    } else if (exp10 >= 0) {
+      memcpy( p , digit_string , exp10 + 1 );
+      p += exp10 + 1;
+      if (num_digits > exp10 + 1) {
+        *p++ = '.';
+        memcpy( p , &digit_string[exp10 + 1] , num_digits - exp10 - 1 );
+        p += num_digits - exp10 - 1;
+      }
+    } else {
+      *p++ = '0';
+      *p++ = '.';
+      memset( p , '0' , -exp10 - 1 );
+      p += -exp10 - 1;
+      memcpy( p , digit_string , num_digits );
+      p += num_digits;
+    }
+
+    *p = '\0';
+    return p - buffer;
+  }
+}
+
+
 void util_fprintf_int(int value , int width , FILE * stream) {
   char fmt[32];
   sprintf(fmt , "%%%dd" , width);
@@ -16,12 +16,15 @@
    for more details. 
 */
 #include <stdlib.h>
+#include <string.h>
 #include <stdbool.h>
 #include <sys/types.h>
 #include <unistd.h>
+#include <pthread.h>
 
 
 #include <ert/util/block_fs.h>
+#include <ert/util/stringlist.h>
 #include <ert/util/test_util.h>
 #include <ert/util/test_work_area.h>
 
@@ -101,9 +104,128 @@ void test_lock_conflict() {
 
 
 
+#define NUM_FILES   100
+#define NUM_READERS   8
+
+static void fill_data( int * data , int size , int file_nr ) {
+  int i;
+  for (i=0; i < size; i++)
+    data[i] = file_nr * 1000 + i;
+}
+
+
+static int file_size( int file_nr ) {
+  return 10 + 7 * file_nr;
+}
+
+
+static void buffer_free__( void * arg ) {
+  buffer_free( (buffer_type *) arg );
+}
+
+
+static void * read_all( void * arg ) {
+  block_fs_type * bfs = block_fs_safe_cast( arg );
+  buffer_type * buffer = buffer_alloc( 100 );
+  int iter,file_nr;
+
+  for (iter = 0; iter < 20; iter++) {
+    for (file_nr = 0; file_nr < NUM_FILES; file_nr++) {
+      char * filename = util_alloc_sprintf("FILE:%d" , file_nr);
+      int * data = util_calloc( file_size( file_nr ) , sizeof * data );
+      fill_data( data , file_size( file_nr ) , file_nr );
+
+      block_fs_fread_realloc_buffer( bfs , filename , buffer );
+      test_assert_int_equal( file_size( file_nr ) * sizeof * data , buffer_get_size( buffer ));
+      test_assert_int_equal( 0 , memcmp( data , buffer_get_data( buffer ) , buffer_get_size( buffer )));
+
+      free( data );
+      free( filename );
+    }
+  }
+  buffer_free( buffer );
+  return NULL;
+}
+
+
+void test_read() {
+  test_work_area_type * work_area = test_work_area_alloc("block_fs/read");
+  block_fs_type * bfs = block_fs_mount( "test.mnt" , 1000 , 0 , 1.0 , 0 , false , false , false );
+  int file_nr;
+
+  /* Written without any fsync - the content must still be visible to the readers. */
+  for (file_nr = 0; file_nr < NUM_FILES; file_nr++) {
+    char * filename = util_alloc_sprintf("FILE:%d" , file_nr);
+    int * data = util_calloc( file_size( file_nr ) , sizeof * data );
+    int * read_data = util_calloc( file_size( file_nr ) , sizeof * data );
+
+    fill_data( data , file_size( file_nr ) , 0 );
+    block_fs_fwrite_file( bfs , filename , data , file_size( file_nr ) * sizeof * data );
+    block_fs_fread_file( bfs , filename , read_data );
+    test_assert_int_equal( 0 , memcmp( data , read_data , file_size( file_nr ) * sizeof * data ));
+
+    free( read_data );
+    free( data );
+    free( filename );
+  }
+
+  /* Rewrite the files in reverse order, i.e. in a different order than the nodes in the data file. */
+  for (file_nr = NUM_FILES - 1; file_nr >= 0; file_nr--) {
+    char * filename = util_alloc_sprintf("FILE:%d" , file_nr);
+    int * data = util_calloc( file_size( file_nr ) , sizeof * data );
+
+    fill_data( data , file_size( file_nr ) , file_nr );
+    block_fs_fwrite_file( bfs , filename , data , file_size( file_nr ) * sizeof * data );
+
+    free( data );
+    free( filename );
+  }
+
+  {
+    stringlist_type * filenames = stringlist_alloc_new();
+    vector_type * buffers = vector_alloc_new();
+
+    for (file_nr = 0; file_nr < NUM_FILES; file_nr++) {
+      stringlist_append_owned_ref( filenames , util_alloc_sprintf("FILE:%d" , file_nr));
+      vector_append_owned_ref( buffers , buffer_alloc( 10 ) , buffer_free__ );
+    }
+    block_fs_fread_realloc_buffers( bfs , filenames , buffers );
+
+    for (file_nr = 0; file_nr < NUM_FILES; file_nr++) {
+      const buffer_type * buffer = vector_iget_const( buffers , file_nr );
+      int * data = util_calloc( file_size( file_nr ) , sizeof * data );
+      fill_data( data , file_size( file_nr ) , file_nr );
+
+      test_assert_int_equal( file_size( file_nr ) * sizeof * data , buffer_get_size( buffer ));
+      test_assert_int_equal( 0 , memcmp( data , buffer_get_data( buffer ) , buffer_get_size( buffer )));
+      free( data );
+    }
+
+    vector_free( buffers );
+    stringlist_free( filenames );
+  }
+
+  {
+    pthread_t readers[NUM_READERS];
+    int i;
+
+    for (i=0; i < NUM_READERS; i++)
+      pthread_create( &readers[i] , NULL , read_all , bfs );
+
+    for (i=0; i < NUM_READERS; i++)
+      pthread_join( readers[i] , NULL );
+  }
+
+  block_fs_close( bfs , true );
+  test_work_area_free( work_area );
+}
+
+
+
 
 int main(int argc , char ** argv) {
   test_readonly();
   test_lock_conflict();
+  test_read();
   exit(0);
 }
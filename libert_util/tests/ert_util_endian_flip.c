@@ -0,0 +1,75 @@
+/*
+   Copyright (C) 2017  Statoil ASA, Norway.
+
+   The file 'ert_util_endian_flip.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+#include <stdlib.h>
+#include <string.h>
+
+#include <ert/util/test_util.h>
+#include <ert/util/util.h>
+
+
+/*
+  The vectorized code handles blocks of 16 and 32 bytes, and leaves
+  the tail for the scalar code; the test covers vector lengths and
+  start offsets around these block sizes.
+*/
+
+void test_flip( int element_size , int elements , int byte_offset) {
+  char * storage = util_malloc( element_size * elements + byte_offset + 1 );
+  char * expected = util_malloc( element_size * elements + 1 );
+  char * data = &storage[byte_offset];
+  int i,b;
+
+  for (i = 0; i < element_size * elements; i++)
+    data[i] = (char) (i * 7 + 3);
+
+  for (i = 0; i < elements; i++)
+    for (b = 0; b < element_size; b++)
+      expected[i * element_size + b] = data[i * element_size + element_size - 1 - b];
+
+  util_endian_flip_vector( data , element_size , elements );
+  test_assert_mem_equal( data , expected , element_size * elements );
+
+  util_endian_flip_vector( data , element_size , elements );
+  for (i = 0; i < element_size * elements; i++)
+    test_assert_int_equal( (char) (i * 7 + 3) , data[i] );
+
+  free( expected );
+  free( storage );
+}
+
+
+int main( int argc , char ** argv) {
+  int element_size;
+  for (element_size = 2; element_size <= 8; element_size *= 2) {
+    int elements;
+    for (elements = 0; elements < 80; elements++) {
+      int byte_offset;
+      for (byte_offset = 0; byte_offset < 16; byte_offset += element_size)
+        test_flip( element_size , elements , byte_offset );
+    }
+    test_flip( element_size , 100003 , 0 );
+  }
+
+  {
+    char data[3] = {1,2,3};
+    util_endian_flip_vector( data , 1 , 3 );
+    test_assert_int_equal( data[0] , 1 );
+    test_assert_int_equal( data[2] , 3 );
+  }
+  exit(0);
+}
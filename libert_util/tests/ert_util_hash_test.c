@@ -19,10 +19,87 @@
 #include <stdbool.h>
 
 #include <ert/util/test_util.h>
+#include <ert/util/util.h>
 #include <ert/util/hash.h>
 
-int main(int argc , char ** argv) {
-  
+
+/*
+  Inserts, replaces and deletes many keys; with interleaved deletes
+  and inserts the table will contain many deleted slots.
+*/
+
+void test_insert_delete() {
+  const int num_keys = 20000;
+  hash_type * h = hash_alloc();
+  int i;
+
+  for (i=0; i < num_keys; i++) {
+    char * key = util_alloc_sprintf("KEY:%d" , i);
+    hash_insert_int( h , key , i );
+    free( key );
+  }
+  test_assert_int_equal( num_keys , hash_get_size( h ));
+
+  for (i=0; i < num_keys; i += 2) {
+    char * key = util_alloc_sprintf("KEY:%d" , i);
+    hash_del( h , key );
+    free( key );
+  }
+  test_assert_int_equal( num_keys / 2 , hash_get_size( h ));
+
+  for (i=0; i < num_keys; i++) {
+    char * key = util_alloc_sprintf("KEY:%d" , i);
+    if (i % 2)
+      test_assert_int_equal( i , hash_get_int( h , key ));
+    else
+      test_assert_false( hash_has_key( h , key ));
+
+    hash_insert_int( h , key , -i );
+    free( key );
+  }
+  test_assert_int_equal( num_keys , hash_get_size( h ));
+
+  for (i=0; i < num_keys; i++) {
+    char * key = util_alloc_sprintf("KEY:%d" , i);
+    test_assert_int_equal( -i , hash_get_int( h , key ));
+    free( key );
+  }
+
+  {
+    stringlist_type * keys = hash_alloc_stringlist( h );
+    test_assert_int_equal( num_keys , stringlist_get_size( keys ));
+    stringlist_free( keys );
+  }
+
+  hash_clear( h );
+  test_assert_int_equal( 0 , hash_get_size( h ));
+  test_assert_false( hash_has_key( h , "KEY:1" ));
+  hash_insert_int( h , "KEY:1" , 1 );
+  test_assert_int_equal( 1 , hash_get_int( h , "KEY:1" ));
+  hash_free( h );
+}
+
+
+void test_reserve_freeze() {
+  hash_type * h = hash_alloc();
+  hash_reserve( h , 1000 );
+  hash_resize( h , 10 );     /* Can not shrink below the current content. */
+  hash_insert_ref( h , "" , h );
+  hash_insert_ref( h , "A" , h );
+  hash_insert_ref( h , "AB:1234567890" , h );
+
+  test_assert_false( hash_is_frozen( h ));
+  hash_freeze( h );
+  test_assert_true( hash_is_frozen( h ));
+  test_assert_ptr_equal( h , hash_get( h , "" ));
+  test_assert_ptr_equal( h , hash_get( h , "A" ));
+  test_assert_ptr_equal( h , hash_get( h , "AB:1234567890" ));
+  test_assert_NULL( hash_safe_get( h , "AB:123456789" ));
+  hash_free( h );
+}
+
+
+void test_options() {
   hash_type * h = hash_alloc();
 
   test_assert_bool_equal( hash_add_option( h , "Key" ) , false );
@@ -39,5 +116,12 @@ int main(int argc , char ** argv) {
   test_assert_false( hash_has_key( h , "Key" ));
 
   hash_free( h );
+}
+
+
+int main(int argc , char ** argv) {
+  test_options();
+  test_insert_delete();
+  test_reserve_freeze();
   exit(0);
 }
@@ -228,6 +228,129 @@ void test_inplace_sub_column() {
 }
 
 
+/*
+  Naive reference implementation of C = alpha*op(A)*op(B) + beta*C.
+*/
+
+void reference_gemm( matrix_type * C , const matrix_type * A , const matrix_type * B , bool transA , bool transB , double alpha , double beta) {
+  int k = transA ? matrix_get_rows( A ) : matrix_get_columns( A );
+  for (int i=0; i < matrix_get_rows( C ); i++) {
+    for (int j=0; j < matrix_get_columns( C ); j++) {
+      double sum = 0;
+      for (int p=0; p < k; p++) {
+        double a = transA ? matrix_iget( A , p , i ) : matrix_iget( A , i , p );
+        double b = transB ? matrix_iget( B , j , p ) : matrix_iget( B , p , j );
+        sum += a * b;
+      }
+      matrix_iset( C , i , j , alpha * sum + beta * matrix_iget( C , i , j ));
+    }
+  }
+}
+
+
+void assert_matrix_close( const matrix_type * m1 , const matrix_type * m2 ) {
+  test_assert_int_equal( matrix_get_rows( m1 ) , matrix_get_rows( m2 ));
+  test_assert_int_equal( matrix_get_columns( m1 ) , matrix_get_columns( m2 ));
+  for (int i=0; i < matrix_get_rows( m1 ); i++)
+    for (int j=0; j < matrix_get_columns( m1 ); j++)
+      test_assert_true( fabs( matrix_iget( m1 , i , j ) - matrix_iget( m2 , i , j )) < 1e-9 * (1 + fabs( matrix_iget( m2 , i , j ))));
+}
+
+
+/*
+  The dimensions are chosen to cross the internal block sizes; the
+  input matrices are views into larger matrices to exercise strides.
+*/
+
+void test_gemm_case( rng_type * rng , int m , int n , int k , bool transA , bool transB ) {
+  matrix_type * A_full = transA ? matrix_alloc( k + 3 , m + 2 ) : matrix_alloc( m + 3 , k + 2 );
+  matrix_type * B_full = transB ? matrix_alloc( n + 1 , k + 1 ) : matrix_alloc( k + 1 , n + 1 );
+  matrix_type * A = transA ? matrix_alloc_shared( A_full , 2 , 1 , k , m ) : matrix_alloc_shared( A_full , 2 , 1 , m , k );
+  matrix_type * B = transB ? matrix_alloc_shared( B_full , 1 , 1 , n , k ) : matrix_alloc_shared( B_full , 1 , 1 , k , n );
+  matrix_type * C1 = matrix_alloc( m , n );
+  matrix_type * C2 = matrix_alloc( m , n );
+  matrix_type * C3 = matrix_alloc( m , n );
+
+  matrix_random_init( A_full , rng );
+  matrix_random_init( B_full , rng );
+  matrix_random_init( C1 , rng );
+  matrix_assign( C2 , C1 );
+  matrix_assign( C3 , C1 );
+
+  reference_gemm( C1 , A , B , transA , transB , 0.75 , -0.5 );
+  matrix_gemm_blocked( C2 , A , B , transA , transB , 0.75 , -0.5 );
+  matrix_gemm( C3 , A , B , transA , transB , 0.75 , -0.5 );
+  assert_matrix_close( C2 , C1 );
+  assert_matrix_close( C3 , C1 );
+
+  matrix_free( C1 );
+  matrix_free( C2 );
+  matrix_free( C3 );
+  matrix_free( A );
+  matrix_free( B );
+  matrix_free( A_full );
+  matrix_free( B_full );
+}
+
+
+void test_gemm() {
+  rng_type * rng = rng_alloc( MZRAN , INIT_DEFAULT );
+  for (int transA = 0; transA < 2; transA++) {
+    for (int transB = 0; transB < 2; transB++) {
+      test_gemm_case( rng , 1 , 1 , 1 , transA , transB );
+      test_gemm_case( rng , 7 , 5 , 3 , transA , transB );
+      test_gemm_case( rng , 131 , 9 , 259 , transA , transB );
+      test_gemm_case( rng , 40 , 517 , 20 , transA , transB );
+    }
+  }
+  rng_free( rng );
+}
+
+
+void test_inplace_matmul() {
+  rng_type * rng = rng_alloc( MZRAN , INIT_DEFAULT );
+  matrix_type * A = matrix_alloc( 2500 , 37 );
+  matrix_type * A0 = matrix_alloc( 2500 , 37 );
+  matrix_type * B = matrix_alloc( 37 , 37 );
+  matrix_type * C = matrix_alloc( 2500 , 37 );
+
+  matrix_random_init( A , rng );
+  matrix_random_init( B , rng );
+  matrix_assign( A0 , A );
+
+  reference_gemm( C , A0 , B , false , false , 1 , 0 );
+  matrix_inplace_matmul( A , B );
+  assert_matrix_close( A , C );
+
+  matrix_assign( A , A0 );
+  matrix_inplace_matmul_mt1( A , B , 4 );
+  assert_matrix_close( A , C );
+
+  matrix_free( A );
+  matrix_free( A0 );
+  matrix_free( B );
+  matrix_free( C );
+  rng_free( rng );
+}
+
+
+void test_transpose() {
+  rng_type * rng = rng_alloc( MZRAN , INIT_DEFAULT );
+  matrix_type * A = matrix_alloc( 71 , 45 );
+  matrix_type * T;
+
+  matrix_random_init( A , rng );
+  T = matrix_alloc_transpose( A );
+  for (int i=0; i < matrix_get_rows( A ); i++)
+    for (int j=0; j < matrix_get_columns( A ); j++)
+      test_assert_double_equal( matrix_iget( A , i , j ) , matrix_iget( T , j , i ));
+
+  matrix_free( T );
+  matrix_free( A );
+  rng_free( rng );
+}
+
+
 int main( int argc , char ** argv) {
   test_create_invalid();
   test_resize();
@@ -238,5 +361,8 @@ int main( int argc , char ** argv) {
   test_diag_std();
   test_masked_copy();
   test_inplace_sub_column();
+  test_gemm();
+  test_inplace_matmul();
+  test_transpose();
   exit(0);
 }
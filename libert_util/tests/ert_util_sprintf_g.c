@@ -0,0 +1,78 @@
+/*
+   Copyright (C) 2017  Statoil ASA, Norway.
+
+   The file 'ert_util_sprintf_g.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+
+#include <ert/util/test_util.h>
+#include <ert/util/util.h>
+
+
+void test_value( double value ) {
+  char expected[64];
+  char buffer[64];
+  int expected_length = sprintf( expected , "%g" , value );
+  int length = util_sprintf_g( buffer , value );
+
+  if (strcmp( expected , buffer ) != 0)
+    test_error_exit("util_sprintf_g( %.17g ) = \"%s\" - expected \"%s\" \n", value , buffer , expected );
+  test_assert_int_equal( expected_length , length );
+}
+
+
+void test_special() {
+  double values[] = {0 , -0.0 , 1 , -1 , 0.5 , 10 , 100000 , 999999 , 999999.5 , 999999.4 , 9999995 , 1000000 ,
+                     1234565 , 1234575 , 0.0001 , 0.00001 , 0.000099999951 , 0.00009999995 , 1e-5 , 123456789 ,
+                     1e300 , 1e-300 , 1e-310 , 1.5e100 , -2.5e-100 , 0.1 , 0.2 , 0.3 , 1.0/3 , 2.0/3 , 99.9999951 ,
+                     NAN , INFINITY , -INFINITY , 3.4028234663852886e+38 , 1.1754943508222875e-38 , 1.401298464324817e-45};
+  int i;
+  for (i=0; i < sizeof values / sizeof values[0]; i++)
+    test_value( values[i] );
+}
+
+
+void test_random_float() {
+  int i;
+  srand( 10 );
+  for (i=0; i < 2000000; i++) {
+    uint32_t bits = ((uint32_t) rand() << 16) ^ (uint32_t) rand();
+    float value;
+    memcpy( &value , &bits , sizeof value );
+    test_value( value );
+  }
+}
+
+
+void test_random_int() {
+  int i;
+  for (i=0; i < 200000; i++) {
+    int value = rand() % 20000000 - 10000000;
+    test_value( value );
+    test_value( value * 0.01 );
+  }
+}
+
+
+int main(int argc , char ** argv) {
+  test_special();
+  test_random_float();
+  test_random_int();
+  exit(0);
+}
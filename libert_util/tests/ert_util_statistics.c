@@ -21,6 +21,7 @@
 #include <stdlib.h>
 
 #include <ert/util/test_util.h>
+#include <ert/util/util.h>
 #include <ert/util/statistics.h>
 
 
@@ -35,6 +36,46 @@ void test_mean_std() {
 }
 
 
+void test_quantiles() {
+  const double quantiles[7] = {0.0 , 0.01 , 0.10 , 0.25 , 0.50 , 0.90 , 1.0};
+  const int num_quantiles = 7;
+  int sizes[5] = {1 , 2 , 17 , 101 , 1000};
+  int is;
+
+  for (is = 0; is < 5; is++) {
+    const int size = sizes[is];
+    int pattern;
+    for (pattern = 0; pattern < 3; pattern++) {
+      double_vector_type * d = double_vector_alloc( 0 , 0 );
+      double * data = util_calloc( size , sizeof * data );
+      double values[7];
+      int i, iq;
+
+      for (i = 0; i < size; i++) {
+        double value;
+        if (pattern == 0)
+          value = (i * 7919) % 1013;        /* Distinct values. */
+        else if (pattern == 1)
+          value = (i * 7919) % 5;           /* Many equal values. */
+        else
+          value = (i < size / 2) ? 0 : i;   /* Half the values are zero. */
+
+        double_vector_append( d , value );
+        data[i] = value;
+      }
+
+      statistics_empirical_quantiles__( data , size , num_quantiles , quantiles , values );
+      for (iq = 0; iq < num_quantiles; iq++)
+        test_assert_double_equal( values[iq] , statistics_empirical_quantile( d , quantiles[iq] ));
+
+      free( data );
+      double_vector_free( d );
+    }
+  }
+}
+
+
 int main( int argc , char ** argv ) {
   test_mean_std();
+  test_quantiles();
 }
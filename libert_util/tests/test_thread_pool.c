@@ -16,9 +16,12 @@
    for more details.
 */
 #include <stdlib.h>
+#include <stdbool.h>
 #include <pthread.h>
+#include <unistd.h>
 
 #include <ert/util/test_util.h>
+#include <ert/util/util.h>
 #include <ert/util/thread_pool.h>
 
 
@@ -64,7 +67,199 @@ void run() {
 
 
 
+void * square(void * arg) {
+  int * int_arg = (int *) arg;
+  int_arg[1] = int_arg[0] * int_arg[0];
+  return &int_arg[1];
+}
+
+
+void test_return_value_restart() {
+  int job_size = 500;
+  int * values = util_calloc( 2 * job_size , sizeof * values );
+  thread_pool_type * tp = thread_pool_alloc( 4 , false );
+
+  for (int round = 0; round < 3; round++) {
+    thread_pool_restart( tp );
+    for (int i=0; i < job_size; i++) {
+      values[2*i] = i + round;
+      thread_pool_add_job( tp , square , &values[2*i] );
+    }
+    thread_pool_join( tp );
+
+    test_assert_int_equal( job_size , thread_pool_get_num_complete( tp ));
+    for (int i=0; i < job_size; i++) {
+      int * return_value = thread_pool_iget_return_value( tp , i );
+      test_assert_ptr_equal( return_value , &values[2*i + 1] );
+      test_assert_int_equal( *return_value , (i + round) * (i + round));
+    }
+  }
+  thread_pool_free( tp );
+  free( values );
+}
+
+
+void * sleep_job(void * arg) {
+  usleep( 200000 );
+  return NULL;
+}
+
+
+void test_try_join() {
+  thread_pool_type * tp = thread_pool_alloc( 1 , true );
+  thread_pool_add_job( tp , sleep_job , NULL );
+  thread_pool_add_job( tp , sleep_job , NULL );
+  test_assert_true( thread_pool_try_join( tp , 10 ));
+  test_assert_int_equal( 2 , thread_pool_get_num_complete( tp ));
+  thread_pool_free( tp );
+}
+
+
+/*
+  The job blocks until it is released by the test; try_join() must
+  give up after the timeout and leave the pool running.
+*/
+
+pthread_cond_t release_cond;
+bool           released;
+
+void * blocking_job(void * arg) {
+  pthread_mutex_lock( &lock );
+  while (!released)
+    pthread_cond_wait( &release_cond , &lock );
+  pthread_mutex_unlock( &lock );
+  return arg;
+}
+
+
+void test_try_join_timeout() {
+  thread_pool_type * tp = thread_pool_alloc( 2 , true );
+  int value = 0;
+
+  pthread_mutex_init( &lock , NULL );
+  pthread_cond_init( &release_cond , NULL );
+  released = false;
+
+  thread_pool_add_job( tp , blocking_job , NULL );
+  test_assert_false( thread_pool_try_join( tp , 1 ));
+  test_assert_int_equal( 0 , thread_pool_get_num_complete( tp ));
+
+  /* The pool is still accepting jobs after a failed join. */
+  thread_pool_add_job( tp , inc , &value );
+
+  pthread_mutex_lock( &lock );
+  released = true;
+  pthread_cond_broadcast( &release_cond );
+  pthread_mutex_unlock( &lock );
+
+  test_assert_true( thread_pool_try_join( tp , 10 ));
+  test_assert_int_equal( 2 , thread_pool_get_num_complete( tp ));
+  test_assert_int_equal( 1 , value );
+  thread_pool_free( tp );
+  pthread_cond_destroy( &release_cond );
+  pthread_mutex_destroy( &lock );
+}
+
+
+/*
+  Waiting for one job with thread_pool_wait_job() while an other job
+  in the same pool is still blocked.
+*/
+
+void test_wait_job() {
+  thread_pool_type * tp = thread_pool_alloc( 2 , true );
+  int values[2] = {7 , 0};
+  int blocked_job, square_job;
+
+  pthread_mutex_init( &lock , NULL );
+  pthread_cond_init( &release_cond , NULL );
+  released = false;
+
+  blocked_job = thread_pool_submit_job( tp , blocking_job , &values[1] );
+  square_job  = thread_pool_submit_job( tp , square , values );
+  test_assert_int_not_equal( blocked_job , square_job );
+
+  test_assert_ptr_equal( &values[1] , thread_pool_wait_job( tp , square_job ));
+  test_assert_true( thread_pool_job_complete( tp , square_job ));
+  test_assert_int_equal( 49 , values[1] );
+  test_assert_false( thread_pool_job_complete( tp , blocked_job ));
+
+  pthread_mutex_lock( &lock );
+  released = true;
+  pthread_cond_broadcast( &release_cond );
+  pthread_mutex_unlock( &lock );
+
+  test_assert_ptr_equal( &values[1] , thread_pool_wait_job( tp , blocked_job ));
+  thread_pool_join( tp );
+  test_assert_int_equal( 2 , thread_pool_get_num_complete( tp ));
+  thread_pool_free( tp );
+  pthread_cond_destroy( &release_cond );
+  pthread_mutex_destroy( &lock );
+}
+
+
+/*
+  Jobs which add new jobs to the same pool; thread_pool_join() must
+  wait for the nested jobs as well.
+*/
+
+typedef struct {
+  thread_pool_type * tp;
+  int              * value;
+} nested_arg_type;
+
+
+void * add_nested(void * arg) {
+  nested_arg_type * nested_arg = arg;
+  for (int i=0; i < 10; i++)
+    thread_pool_add_job( nested_arg->tp , inc , nested_arg->value );
+  return NULL;
+}
+
+
+void test_nested() {
+  int value = 0;
+  thread_pool_type * tp = thread_pool_alloc( 4 , true );
+  nested_arg_type nested_arg = { tp , &value };
+
+  pthread_mutex_init(&lock , NULL);
+  for (int i=0; i < 10; i++)
+    thread_pool_add_job( tp , add_nested , &nested_arg );
+
+  thread_pool_join( tp );
+  thread_pool_free( tp );
+  test_assert_int_equal( 100 , value );
+  pthread_mutex_destroy( &lock );
+}
+
+
+void test_blocking() {
+  int value = 0;
+  thread_pool_type * tp = thread_pool_alloc( 0 , true );
+
+  pthread_mutex_init(&lock , NULL);
+  thread_pool_add_job( tp , inc , &value );
+  test_assert_int_equal( 1 , value );
+  {
+    int job = thread_pool_submit_job( tp , inc , &value );
+    test_assert_true( thread_pool_job_complete( tp , job ));
+    test_assert_int_equal( 2 , value );
+    test_assert_NULL( thread_pool_wait_job( tp , job ));
+  }
+  thread_pool_join( tp );
+  thread_pool_free( tp );
+  pthread_mutex_destroy( &lock );
+}
+
+
+
 int main( int argc , char ** argv) {
   create_and_destroy();
   run();
+  test_return_value_restart();
+  test_try_join();
+  test_try_join_timeout();
+  test_wait_job();
+  test_nested();
+  test_blocking();
 }
@@ -196,6 +196,12 @@ class EclFile(BaseCClass):
               in cases where a high number of EclFile instances are
               open concurrently.
 
+           ecl.ECL_FILE_MMAP : The file is memory mapped, and the
+              keywords are loaded directly from the mapping.
+
+           ecl.ECL_FILE_INDEX : An index file '<filename>.index' is
+              used to avoid scanning through the whole file.
+
         When the file has been loaded the EclFile instance can be used
         to query for and get reference to the EclKW instances
         constituting the file, like e.g. SWAT from a restart file or
@@ -91,9 +91,13 @@ class EclFileFlagEnum(BaseCEnum):
     TYPE_NAME="ecl_file_flag_enum"
     ECL_FILE_CLOSE_STREAM = None
     ECL_FILE_WRITABLE = None
+    ECL_FILE_MMAP = None
+    ECL_FILE_INDEX = None
 
 EclFileFlagEnum.addEnum("ECL_FILE_CLOSE_STREAM" , 1 )
 EclFileFlagEnum.addEnum("ECL_FILE_WRITABLE" , 2 )
+EclFileFlagEnum.addEnum("ECL_FILE_MMAP" , 4 )
+EclFileFlagEnum.addEnum("ECL_FILE_INDEX" , 8 )
 
 
 #-----------------------------------------------------------------